@@ -22,50 +22,29 @@ FFTAnalyzer::FFTAnalyzer(int fftSize, int sampleRate)
     }
 
     window = generateHannWindow();
+    plan = RealFFTPlan::forSize(static_cast<size_t>(this->fftSize));
+    fftReal.resize(static_cast<size_t>(this->fftSize / 2));
+    fftImag.resize(static_cast<size_t>(this->fftSize / 2));
     LOG_INFO("FFTAnalyzer created: %d-point, %d Hz sample rate", this->fftSize, sampleRate);
 }
 
 AudioSpectrum FFTAnalyzer::analyze(const std::vector<float>& samples, bool useWindow) {
+    AudioSpectrum spectrum;
+    analyzeInto(samples, spectrum, useWindow);
+    return spectrum;
+}
+
+void FFTAnalyzer::analyzeInto(std::span<const float> samples, AudioSpectrum& spectrum, bool useWindow) {
     if (samples.size() != static_cast<size_t>(fftSize)) {
         LOG_WARNING("Sample size mismatch: expected %d, got %zu", fftSize, samples.size());
     }
 
-    // Apply window
-    std::vector<float> processedSamples = useWindow ? applyWindow(samples) : samples;
-
-    // Convert to complex
-    std::vector<std::complex<float>> input(static_cast<size_t>(fftSize));
-    for (int i = 0; i < fftSize; i++) {
-        input[static_cast<size_t>(i)] = std::complex<float>(processedSamples[static_cast<size_t>(i)], 0.0f);
-    }
-
-    // Perform FFT
-    std::vector<std::complex<float>> output = input;
-    performFFT(input, output);
+    performFFT(samples, useWindow);
+    calculateMagnitudes(spectrum.magnitudes);
 
-    // Calculate magnitudes
-    std::vector<float> magnitudes = calculateMagnitudes(output);
-
-    // Find peak
-    float peakMagnitude = 0.0f;
-    int peakBin = 0;
-    for (int i = 0; i < fftSize / 2; i++) {
-        if (magnitudes[static_cast<size_t>(i)] > peakMagnitude) {
-            peakMagnitude = magnitudes[static_cast<size_t>(i)];
-            peakBin = i;
-        }
-    }
-
-    // Create spectrum
-    AudioSpectrum spectrum;
-    spectrum.magnitudes = magnitudes;
-    spectrum.peakMagnitude = peakMagnitude;
-    spectrum.peakFrequency = binToFrequency(peakBin);
     spectrum.sampleRate = sampleRate;
     spectrum.fftSize = fftSize;
-    spectrum.bandLevels = getBandLevels(spectrum);
-
-    return spectrum;
+    summarize(spectrum);
 }
 
 AudioSpectrum FFTAnalyzer::analyzeStereo(const std::vector<float>& samples, bool useWindow) {
@@ -73,22 +52,25 @@ AudioSpectrum FFTAnalyzer::analyzeStereo(const std::vector<float>& samples, bool
         LOG_WARNING("Stereo sample size mismatch: expected %d, got %zu", fftSize * 2, samples.size());
     }
 
-    // Extract and analyze left channel
-    std::vector<float> left(static_cast<size_t>(fftSize));
-    std::vector<float> right(static_cast<size_t>(fftSize));
+    size_t frames = std::min(samples.size() / 2, static_cast<size_t>(fftSize));
+    channel.assign(static_cast<size_t>(fftSize), 0.0f);
 
-    for (int i = 0; i < fftSize; i++) {
-        left[static_cast<size_t>(i)] = samples[static_cast<size_t>(i) * 2];
-        right[static_cast<size_t>(i)] = samples[static_cast<size_t>(i) * 2 + 1];
+    // Left channel straight into the result
+    for (size_t i = 0; i < frames; i++) {
+        channel[i] = samples[i * 2];
     }
+    AudioSpectrum result;
+    analyzeInto(channel, result, useWindow);
 
-    AudioSpectrum specLeft = analyze(left, useWindow);
-    AudioSpectrum specRight = analyze(right, useWindow);
+    // Right channel, then average the two
+    for (size_t i = 0; i < frames; i++) {
+        channel[i] = samples[i * 2 + 1];
+    }
+    performFFT(channel, useWindow);
+    calculateMagnitudes(channelMagnitudes);
 
-    // Average the two channels
-    AudioSpectrum result = specLeft;
     for (size_t i = 0; i < result.magnitudes.size(); i++) {
-        result.magnitudes[i] = (specLeft.magnitudes[i] + specRight.magnitudes[i]) / 2.0f;
+        result.magnitudes[i] = (result.magnitudes[i] + channelMagnitudes[i]) / 2.0f;
     }
 
     // Recalculate peak
@@ -103,52 +85,21 @@ AudioSpectrum FFTAnalyzer::analyzeStereo(const std::vector<float>& samples, bool
 
     result.peakMagnitude = peakMagnitude;
     result.peakFrequency = binToFrequency(peakBin);
-    result.bandLevels = getBandLevels(result);
+    computeBandLevels(result.magnitudes, result.bandLevels);
 
     return result;
 }
 
 std::vector<float> FFTAnalyzer::getMagnitudes(const std::vector<float>& samples) {
-    std::vector<float> processedSamples = applyWindow(samples);
-
-    std::vector<std::complex<float>> input(static_cast<size_t>(fftSize));
-    for (int i = 0; i < fftSize; i++) {
-        input[static_cast<size_t>(i)] = std::complex<float>(processedSamples[static_cast<size_t>(i)], 0.0f);
-    }
-
-    std::vector<std::complex<float>> output = input;
-    performFFT(input, output);
-
-    return calculateMagnitudes(output);
+    std::vector<float> magnitudes;
+    performFFT(samples, true);
+    calculateMagnitudes(magnitudes);
+    return magnitudes;
 }
 
 std::vector<float> FFTAnalyzer::getBandLevels(const AudioSpectrum& spectrum) const {
-    std::vector<float> bandLevels(7);
-
-    std::vector<std::pair<float, float>> bandRanges = {
-        {20, 60},           // Subbass
-        {60, 250},          // Bass
-        {250, 500},         // Lowmid
-        {500, 2000},        // Mid
-        {2000, 4000},       // Highmid
-        {4000, 6000},       // Presence
-        {6000, 20000}       // Brilliance
-    };
-
-    for (size_t i = 0; i < bandRanges.size(); i++) {
-        auto [minBin, maxBin] = getBandBinRange(static_cast<FrequencyBand>(i));
-        maxBin = std::min(maxBin, static_cast<int>(spectrum.magnitudes.size() - 1));
-
-        float bandEnergy = 0.0f;
-        for (int bin = minBin; bin <= maxBin; bin++) {
-            bandEnergy += spectrum.magnitudes[static_cast<size_t>(bin)];
-        }
-
-        // Average the band energy
-        int binCount = maxBin - minBin + 1;
-        bandLevels[i] = binCount > 0 ? bandEnergy / static_cast<float>(binCount) : 0.0f;
-    }
-
+    std::vector<float> bandLevels;
+    computeBandLevels(spectrum.magnitudes, bandLevels);
     return bandLevels;
 }
 
@@ -170,48 +121,26 @@ std::pair<int, int> FFTAnalyzer::getBandBinRange(FrequencyBand band) const {
     return {frequencyToBin(minFreq), frequencyToBin(maxFreq)};
 }
 
-void FFTAnalyzer::performFFT(const std::vector<std::complex<float>>& input,
-                            std::vector<std::complex<float>>& output) {
-    output = input;
-    bitReversal(output);
-
-    for (int s = 1; s <= static_cast<int>(std::log2(fftSize)); s++) {
-        int m = 1 << s;
-        int halfM = m / 2;
-
-        std::complex<float> w(1.0f, 0.0f);
-        std::complex<float> wm = std::exp(std::complex<float>(0.0f, -2.0f * static_cast<float>(M_PI) / static_cast<float>(m)));
+void FFTAnalyzer::performFFT(std::span<const float> samples, bool useWindow) {
+    size_t size = static_cast<size_t>(fftSize);
+    fftReal.resize(size / 2);
+    fftImag.resize(size / 2);
 
-        for (int k = 0; k < halfM; k++) {
-            for (int j = k; j < fftSize; j += m) {
-                int t = j + halfM;
-                std::complex<float> u = output[static_cast<size_t>(j)];
-                std::complex<float> v = output[static_cast<size_t>(t)] * w;
-                output[static_cast<size_t>(j)] = u + v;
-                output[static_cast<size_t>(t)] = u - v;
-            }
-
-            w *= wm;
-        }
+    if (!plan) {
+        std::fill(fftReal.begin(), fftReal.end(), 0.0f);
+        std::fill(fftImag.begin(), fftImag.end(), 0.0f);
+        return;
     }
-}
-
-void FFTAnalyzer::bitReversal(std::vector<std::complex<float>>& data) {
-    int n = static_cast<int>(data.size());
-    int j = 0;
 
-    for (int i = 0; i < n - 1; i++) {
-        if (i < j) {
-            std::swap(data[static_cast<size_t>(i)], data[static_cast<size_t>(j)]);
-        }
-
-        int mask = n / 2;
-        while (j & mask) {
-            j &= ~mask;
-            mask >>= 1;
-        }
-        j |= mask;
+    // Zero-pad short input; extra samples are ignored
+    const float* input = samples.data();
+    if (samples.size() < size) {
+        paddedInput.assign(size, 0.0f);
+        std::copy(samples.begin(), samples.end(), paddedInput.begin());
+        input = paddedInput.data();
     }
+
+    plan->forward(input, useWindow ? window.data() : nullptr, fftReal.data(), fftImag.data());
 }
 
 std::vector<float> FFTAnalyzer::generateHannWindow() const {
@@ -225,36 +154,62 @@ std::vector<float> FFTAnalyzer::generateHannWindow() const {
     return windowCoeffs;
 }
 
-std::vector<float> FFTAnalyzer::applyWindow(const std::vector<float>& samples) const {
-    std::vector<float> windowed(samples.size());
+void FFTAnalyzer::calculateMagnitudes(std::vector<float>& magnitudes) const {
+    magnitudes.resize(fftReal.size());
+    const float scale = 2.0f / static_cast<float>(fftSize);
+    const float powerScale = scale * scale;
+    constexpr float FLOOR_POWER = 1e-12f;   // -120 dB
 
-    for (size_t i = 0; i < samples.size(); i++) {
-        windowed[i] = samples[i] * window[i];
+    for (size_t i = 0; i < magnitudes.size(); i++) {
+        float real = fftReal[i];
+        float imag = fftImag[i];
+
+        // Normalized power, so 0 dB is a full-scale sine
+        float power = (real * real + imag * imag) * powerScale;
+
+        // Log scale: -120 dB..0 dB maps to 0..1
+        if (power <= FLOOR_POWER) {
+            magnitudes[i] = 0.0f;
+        } else {
+            float decibels = 10.0f * std::log10(power);
+            magnitudes[i] = std::clamp(1.0f + decibels / 120.0f, 0.0f, 1.0f);
+        }
     }
-
-    return windowed;
 }
 
-std::vector<float> FFTAnalyzer::calculateMagnitudes(
-    const std::vector<std::complex<float>>& fft) const {
-    std::vector<float> magnitudes(fft.size() / 2);
+void FFTAnalyzer::summarize(AudioSpectrum& spectrum) const {
+    float peakMagnitude = 0.0f;
+    int peakBin = 0;
+    for (size_t i = 0; i < spectrum.magnitudes.size(); i++) {
+        if (spectrum.magnitudes[i] > peakMagnitude) {
+            peakMagnitude = spectrum.magnitudes[i];
+            peakBin = static_cast<int>(i);
+        }
+    }
 
-    for (size_t i = 0; i < magnitudes.size(); i++) {
-        float real = fft[i].real();
-        float imag = fft[i].imag();
-        float magnitude = std::sqrt(real * real + imag * imag);
+    spectrum.peakMagnitude = peakMagnitude;
+    spectrum.peakFrequency = binToFrequency(peakBin);
+    computeBandLevels(spectrum.magnitudes, spectrum.bandLevels);
+}
 
-        // Normalize
-        magnitudes[i] = magnitude / (static_cast<float>(fftSize) / 2.0f);
+void FFTAnalyzer::computeBandLevels(const std::vector<float>& magnitudes,
+                                    std::vector<float>& bandLevels) const {
+    constexpr size_t BAND_COUNT = 7;   // SUBBASS..BRILLIANCE
+    bandLevels.resize(BAND_COUNT);
 
-        // Log scale (20 * log10)
-        if (magnitudes[i] > 0.0f) {
-            magnitudes[i] = 20.0f * std::log10(magnitudes[i] + 1e-6f) / 120.0f;
-            magnitudes[i] = std::clamp(magnitudes[i], 0.0f, 1.0f);
+    for (size_t i = 0; i < BAND_COUNT; i++) {
+        auto [minBin, maxBin] = getBandBinRange(static_cast<FrequencyBand>(i));
+        maxBin = std::min(maxBin, static_cast<int>(magnitudes.size()) - 1);
+
+        float bandEnergy = 0.0f;
+        for (int bin = minBin; bin <= maxBin; bin++) {
+            bandEnergy += magnitudes[static_cast<size_t>(bin)];
         }
-    }
 
-    return magnitudes;
+        // Average the band energy
+        int binCount = maxBin - minBin + 1;
+        bandLevels[i] = binCount > 0 ? bandEnergy / static_cast<float>(binCount) : 0.0f;
+    }
 }
 
 // ===== BeatDetector Implementation =====
@@ -274,20 +229,31 @@ std::vector<BeatInfo> BeatDetector::detectBeats(
     // Calculate band energy
     float bassEnergy = calculateBandEnergy(spectrum, m_minFrequency, m_maxFrequency);
 
-    // Store in history
-    int32_t currentTime = static_cast<int32_t>(spectrum.fftSize * 1000 / spectrum.sampleRate);
-    m_energyHistory.push_back({currentTime, bassEnergy});
-
-    if (m_energyHistory.size() > MAX_HISTORY) {
-        m_energyHistory.erase(m_energyHistory.begin());
+    // Timestamp of this frame, then advance to the next one
+    int32_t currentTime = static_cast<int32_t>(m_sampleTime * 1000 / std::max(spectrum.sampleRate, 1));
+    m_sampleTime += m_hopSize > 0 ? m_hopSize : spectrum.fftSize;
+
+    // Store in history, overwriting the oldest entry once full
+    if (m_historyCount == MAX_HISTORY) {
+        m_historySum -= m_energyHistory[m_historyStart].second;
+        m_energyHistory[m_historyStart] = {currentTime, bassEnergy};
+        m_historyStart = (m_historyStart + 1) % MAX_HISTORY;
+    } else {
+        m_energyHistory[(m_historyStart + m_historyCount) % MAX_HISTORY] = {currentTime, bassEnergy};
+        m_historyCount++;
     }
+    m_historySum += bassEnergy;
 
-    // Calculate average energy over history
-    float avgEnergy = 0.0f;
-    for (const auto& [time, energy] : m_energyHistory) {
-        avgEnergy += energy;
+    // Re-sum once per lap so rounding in the running sum cannot build up
+    if (m_historyStart == 0 && m_historyCount == MAX_HISTORY) {
+        m_historySum = 0.0f;
+        for (const auto& entry : m_energyHistory) {
+            m_historySum += entry.second;
+        }
     }
-    avgEnergy /= static_cast<float>(m_energyHistory.size());
+
+    // Average energy over history
+    float avgEnergy = m_historySum / static_cast<float>(m_historyCount);
 
     // Detect beat if energy spike
     float threshold = avgEnergy * (1.0f + m_sensitivity);
@@ -313,7 +279,8 @@ std::vector<int32_t> BeatDetector::getRecentBeats(int timeWindowMs) const {
 
     int32_t cutoffTime = m_lastBeatTime - timeWindowMs;
 
-    for (const auto& [time, energy] : m_energyHistory) {
+    for (size_t i = 0; i < m_historyCount; i++) {
+        int32_t time = m_energyHistory[(m_historyStart + i) % MAX_HISTORY].first;
         if (time >= cutoffTime) {
             recentBeats.push_back(time);
         }
@@ -350,9 +317,14 @@ float BeatDetector::calculateBandEnergy(
     minBin = std::max(0, minBin);
     maxBin = std::min(static_cast<int>(spectrum.magnitudes.size() - 1), maxBin);
 
+    // Magnitudes are dB levels; undo the log so the energy is linear power
+    // and the threshold in detectBeats() is a ratio of powers
     float energy = 0.0f;
     for (int i = minBin; i <= maxBin; i++) {
-        energy += spectrum.magnitudes[static_cast<size_t>(i)];
+        float level = spectrum.magnitudes[static_cast<size_t>(i)];
+        if (level > 0.0f) {
+            energy += std::pow(10.0f, (level - 1.0f) * 12.0f);
+        }
     }
 
     return energy / static_cast<float>(maxBin - minBin + 1);
@@ -1,12 +1,16 @@
 #ifndef CLIPFORGE_AUDIO_ANALYZER_H
 #define CLIPFORGE_AUDIO_ANALYZER_H
 
+#include <array>
 #include <vector>
 #include <complex>
 #include <memory>
+#include <span>
 #include <cstdint>
 #include <cmath>
 
+#include "fft_plan.h"
+
 namespace clipforge {
 namespace audio {
 
@@ -29,7 +33,7 @@ enum class FrequencyBand {
  * @brief Frequency domain representation of audio
  */
 struct AudioSpectrum {
-    std::vector<float> magnitudes;           // Magnitude of each frequency bin
+    std::vector<float> magnitudes;           // Level of each frequency bin (-120..0 dB as 0-1)
     std::vector<float> phases;               // Phase of each frequency bin
     std::vector<float> bandLevels;           // Energy in each frequency band (0-1)
     float peakFrequency = 0.0f;              // Dominant frequency
@@ -60,9 +64,12 @@ struct BeatInfo {
  * - Frequency-specific effect control
  *
  * Performance:
- * - O(n log n) complexity
+ * - O(n log n) complexity, real input transformed as an N/2-point
+ *   complex FFT with shared precomputed tables (see RealFFTPlan)
  * - 1024/2048/4096 point FFT
- * - ~1-2ms for 2048 point FFT on mobile
+ * - analyzeInto() reuses the caller's spectrum and does not allocate
+ *
+ * Not thread-safe (holds FFT scratch buffers); use one analyzer per thread.
  */
 class FFTAnalyzer {
 public:
@@ -88,6 +95,17 @@ public:
      */
     [[nodiscard]] AudioSpectrum analyze(const std::vector<float>& samples, bool useWindow = true);
 
+    /**
+     * @brief Perform FFT into an existing spectrum without allocating
+     * @param samples Audio samples (fftSize long; shorter input is zero-padded)
+     * @param spectrum Receives the result; its buffers are reused
+     * @param useWindow Apply Hann window to avoid spectral leakage
+     *
+     * Once the spectrum has been filled for this FFT size, repeated calls
+     * perform no heap allocation. Phases are not computed.
+     */
+    void analyzeInto(std::span<const float> samples, AudioSpectrum& spectrum, bool useWindow = true);
+
     /**
      * @brief Perform FFT on interleaved stereo audio
      * @param samples Stereo samples (length = fftSize * 2)
@@ -178,20 +196,19 @@ private:
     int fftSize;
     int sampleRate;
     std::vector<float> window;  // Hann window coefficients
+    std::shared_ptr<const RealFFTPlan> plan;
+    std::vector<float> fftReal;     // FFT output, bins 0..fftSize/2-1
+    std::vector<float> fftImag;
+    std::vector<float> paddedInput; // Used when the input is shorter than fftSize
+    std::vector<float> channel;     // One channel of stereo input
+    std::vector<float> channelMagnitudes;
 
     /**
-     * @brief Cooley-Tukey FFT algorithm
-     * @param input Complex input signal
-     * @param output Complex output spectrum
-     */
-    void performFFT(const std::vector<std::complex<float>>& input,
-                   std::vector<std::complex<float>>& output);
-
-    /**
-     * @brief Bit-reversal permutation
-     * @param data Complex data array
+     * @brief Run the FFT on fftSize samples into fftReal/fftImag
+     * @param samples Audio samples
+     * @param useWindow Apply the Hann window
      */
-    void bitReversal(std::vector<std::complex<float>>& data);
+    void performFFT(std::span<const float> samples, bool useWindow);
 
     /**
      * @brief Generate Hann window coefficients
@@ -200,19 +217,23 @@ private:
     [[nodiscard]] std::vector<float> generateHannWindow() const;
 
     /**
-     * @brief Apply window to samples
-     * @param samples Input samples
-     * @return Windowed samples
+     * @brief Calculate magnitude spectrum from the last FFT
+     * @param magnitudes Receives fftSize/2 magnitudes (0-1 normalized)
      */
-    [[nodiscard]] std::vector<float> applyWindow(const std::vector<float>& samples) const;
+    void calculateMagnitudes(std::vector<float>& magnitudes) const;
 
     /**
-     * @brief Calculate magnitude spectrum from complex FFT result
-     * @param fft Complex FFT output
-     * @return Magnitude spectrum (0-1 normalized)
+     * @brief Fill peak and band levels from the magnitudes
+     * @param spectrum Spectrum with magnitudes set
      */
-    [[nodiscard]] std::vector<float> calculateMagnitudes(
-        const std::vector<std::complex<float>>& fft) const;
+    void summarize(AudioSpectrum& spectrum) const;
+
+    /**
+     * @brief Compute the 7 band levels into an existing vector
+     * @param magnitudes Magnitude spectrum
+     * @param bandLevels Receives the levels
+     */
+    void computeBandLevels(const std::vector<float>& magnitudes, std::vector<float>& bandLevels) const;
 };
 
 /**
@@ -221,6 +242,16 @@ private:
  *
  * Uses spectral flux and energy analysis to detect beats in audio.
  * Particularly responsive to kicks and drums in bass frequencies.
+ * Each call to detectBeats() is one frame; frames are assumed to be
+ * setHopSize() samples apart (fftSize by default).
+ *
+ * Bass energy is the mean linear power of the bins in the frequency
+ * range, converted back from the dB levels in AudioSpectrum::magnitudes.
+ * A frame is a beat when its energy exceeds the recent average by a
+ * factor of (1 + sensitivity); with the default of 1.0 that is 3 dB.
+ *
+ * For whole files, BeatTracker (beat_tracker.h) produces a beat grid
+ * and tempo estimate offline.
  */
 class BeatDetector {
 public:
@@ -256,12 +287,21 @@ public:
         m_maxFrequency = maxHz;
     }
 
+    /**
+     * @brief Set distance between consecutive frames
+     * @param samples Hop in samples (0 = spectrum fftSize, no overlap)
+     */
+    void setHopSize(int samples) { m_hopSize = samples; }
+
     /**
      * @brief Reset beat detector state
      */
     void reset() {
         m_lastBeatTime = 0;
-        m_energyHistory.clear();
+        m_sampleTime = 0;
+        m_historyStart = 0;
+        m_historyCount = 0;
+        m_historySum = 0.0f;
     }
 
     /**
@@ -275,8 +315,15 @@ private:
     float m_minFrequency = 60.0f;   // Focus on bass region
     float m_maxFrequency = 250.0f;
     int32_t m_lastBeatTime = 0;
-    std::vector<std::pair<int32_t, float>> m_energyHistory;  // timestamp, energy
-    static constexpr int MAX_HISTORY = 200;
+    int m_hopSize = 0;
+    int64_t m_sampleTime = 0;       // Start of the current frame in samples
+
+    // Ring buffer of (timestamp, energy), oldest at m_historyStart
+    static constexpr size_t MAX_HISTORY = 200;
+    std::array<std::pair<int32_t, float>, MAX_HISTORY> m_energyHistory{};
+    size_t m_historyStart = 0;
+    size_t m_historyCount = 0;
+    float m_historySum = 0.0f;      // Sum of the energies in the ring
 
     /**
      * @brief Calculate spectral flux (change between spectra)
@@ -294,7 +341,7 @@ private:
      * @param spectrum Audio spectrum
      * @param minFreq Minimum frequency
      * @param maxFreq Maximum frequency
-     * @return Energy level (0-1)
+     * @return Mean linear power of the bins (1 = full-scale sine)
      */
     [[nodiscard]] float calculateBandEnergy(
         const AudioSpectrum& spectrum,
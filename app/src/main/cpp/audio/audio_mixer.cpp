@@ -0,0 +1,434 @@
+#include "audio_mixer.h"
+#include "../utils/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace clipforge {
+namespace audio {
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+
+// EQ bands: frequency in Hz and gain at a setting of +/-1
+constexpr float BASS_FREQUENCY = 250.0f;
+constexpr float MID_FREQUENCY = 1000.0f;
+constexpr float MID_Q = 0.7f;
+constexpr float TREBLE_FREQUENCY = 4000.0f;
+constexpr float EQ_RANGE_DB = 12.0f;
+
+// Below this a filter state is flushed to zero, avoiding denormal slowdowns
+constexpr float DENORMAL_THRESHOLD = 1e-15f;
+
+typedef float Float4 __attribute__((vector_size(16)));
+
+inline Float4 load4(const float* p) {
+    Float4 v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void store4(float* p, Float4 v) {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+/**
+ * @brief Keep a filter frequency below Nyquist at low sample rates
+ */
+float limitFrequency(float frequency, int sampleRate) {
+    return std::min(frequency, 0.45f * static_cast<float>(sampleRate));
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// MixerTrackSettings Implementation
+// ============================================================================
+
+MixerTrackSettings MixerTrackSettings::fromTrack(const models::AudioTrack& track) {
+    MixerTrackSettings settings;
+    settings.volume = std::clamp(track.getVolume(), 0.0f, 2.0f);
+    settings.pan = std::clamp(track.getPan(), -1.0f, 1.0f);
+    settings.enabled = track.isEnabled();
+    settings.muted = track.isMuted();
+    settings.solo = track.isSolo();
+    settings.bass = std::clamp(track.getBass(), -1.0f, 1.0f);
+    settings.midrange = std::clamp(track.getMidrange(), -1.0f, 1.0f);
+    settings.treble = std::clamp(track.getTreble(), -1.0f, 1.0f);
+    return settings;
+}
+
+// ============================================================================
+// AudioMixer Implementation
+// ============================================================================
+
+AudioMixer::AudioMixer(int sampleRate)
+    : m_sampleRate(sampleRate) {
+    for (auto& channel : m_bus) {
+        channel.assign(BLOCK_SIZE, 0.0f);
+    }
+    m_eqLanes.reserve(MAX_TRACKS * MAX_CHANNELS);
+    m_laneBuffer.assign(BLOCK_SIZE * 4, 0.0f);
+
+    LOG_INFO("AudioMixer created: %d Hz, %zu-frame blocks", sampleRate, BLOCK_SIZE);
+}
+
+AudioMixer::~AudioMixer() {
+    stop();
+}
+
+int AudioMixer::addTrack(std::shared_ptr<AudioSource> source) {
+    if (!source) {
+        LOG_ERROR("AudioMixer: null source");
+        return -1;
+    }
+
+    size_t channels = source->getChannelCount();
+    if (channels == 0 || channels > MAX_CHANNELS) {
+        LOG_ERROR("AudioMixer: unsupported channel count %zu", channels);
+        return -1;
+    }
+
+    for (size_t i = 0; i < MAX_TRACKS; i++) {
+        TrackSlot& slot = m_slots[i];
+        if (slot.state.load(std::memory_order_acquire) != SLOT_EMPTY) continue;
+
+        // The audio thread ignores empty slots, so everything can be set up here
+        slot.source = std::move(source);
+        slot.channels = channels;
+        for (auto& buffer : slot.buffers) {
+            buffer.assign(BLOCK_SIZE, 0.0f);
+        }
+        slot.appliedGains.fill(0.0f);
+        slot.designedEq.fill(0.0f);
+        slot.eq.fill(Biquad{});
+        slot.eqActive = false;
+        for (auto& state : slot.eqState) {
+            state.fill(0.0f);
+        }
+        setTrackSettings(static_cast<int>(i), MixerTrackSettings{});
+
+        slot.state.store(SLOT_ACTIVE, std::memory_order_release);
+        LOG_DEBUG("AudioMixer: track added to slot %zu (%zu channels)", i, channels);
+        return static_cast<int>(i);
+    }
+
+    LOG_WARNING("AudioMixer: all %zu track slots in use", MAX_TRACKS);
+    return -1;
+}
+
+bool AudioMixer::removeTrack(int slotIndex) {
+    if (slotIndex < 0 || static_cast<size_t>(slotIndex) >= MAX_TRACKS) return false;
+
+    TrackSlot& slot = m_slots[static_cast<size_t>(slotIndex)];
+    if (slot.state.load(std::memory_order_acquire) != SLOT_ACTIVE) return false;
+
+    slot.state.store(SLOT_RETIRING, std::memory_order_seq_cst);
+
+    // A block that saw the slot as active ends by the next epoch
+    uint64_t epoch = m_renderEpoch.load(std::memory_order_seq_cst);
+    while (m_running.load() && m_renderEpoch.load(std::memory_order_acquire) == epoch) {
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+    if (m_audioThread && !m_running.load()) {
+        // The thread may still be finishing its last block
+        m_audioThread->join();
+        m_audioThread.reset();
+    }
+
+    slot.source.reset();
+    slot.state.store(SLOT_EMPTY, std::memory_order_release);
+    LOG_DEBUG("AudioMixer: track removed from slot %d", slotIndex);
+    return true;
+}
+
+bool AudioMixer::setTrackSettings(int slotIndex, const MixerTrackSettings& settings) {
+    if (slotIndex < 0 || static_cast<size_t>(slotIndex) >= MAX_TRACKS) return false;
+
+    TrackSlot& slot = m_slots[static_cast<size_t>(slotIndex)];
+    if (!slot.source) return false;
+
+    slot.volume.store(settings.volume, std::memory_order_relaxed);
+    slot.pan.store(std::clamp(settings.pan, -1.0f, 1.0f), std::memory_order_relaxed);
+    slot.enabled.store(settings.enabled, std::memory_order_relaxed);
+    slot.muted.store(settings.muted, std::memory_order_relaxed);
+    slot.solo.store(settings.solo, std::memory_order_relaxed);
+    slot.bass.store(std::clamp(settings.bass, -1.0f, 1.0f), std::memory_order_relaxed);
+    slot.midrange.store(std::clamp(settings.midrange, -1.0f, 1.0f), std::memory_order_relaxed);
+    slot.treble.store(std::clamp(settings.treble, -1.0f, 1.0f), std::memory_order_relaxed);
+    return true;
+}
+
+void AudioMixer::renderBlock(float* left, float* right) {
+    for (auto& channel : m_bus) {
+        std::fill(channel.begin(), channel.end(), 0.0f);
+    }
+
+    // Pull every active source, even silent ones, so all stay in sync
+    bool anySolo = false;
+    m_eqLanes.clear();
+
+    for (TrackSlot& slot : m_slots) {
+        if (slot.state.load() != SLOT_ACTIVE) continue;
+
+        float* channels[MAX_CHANNELS] = {slot.buffers[0].data(), slot.buffers[1].data()};
+        size_t frames = std::min(slot.source->read(channels, BLOCK_SIZE), BLOCK_SIZE);
+        for (size_t c = 0; c < slot.channels; c++) {
+            std::fill(slot.buffers[c].begin() + static_cast<std::ptrdiff_t>(frames),
+                      slot.buffers[c].end(), 0.0f);
+        }
+
+        if (slot.enabled.load(std::memory_order_relaxed) && slot.solo.load(std::memory_order_relaxed)) {
+            anySolo = true;
+        }
+
+        updateEqualizer(slot);
+        if (slot.eqActive) {
+            for (size_t c = 0; c < slot.channels; c++) {
+                m_eqLanes.push_back({&slot, c});
+            }
+        }
+    }
+
+    // Equalize four channels at a time
+    for (size_t i = 0; i < m_eqLanes.size(); i += 4) {
+        equalizeLanes(m_eqLanes.data() + i, std::min<size_t>(4, m_eqLanes.size() - i));
+    }
+
+    for (TrackSlot& slot : m_slots) {
+        if (slot.state.load() != SLOT_ACTIVE) continue;
+
+        bool audible = slot.enabled.load(std::memory_order_relaxed)
+            && !slot.muted.load(std::memory_order_relaxed)
+            && (!anySolo || slot.solo.load(std::memory_order_relaxed));
+        mixSlot(slot, audible);
+    }
+
+    std::memcpy(left, m_bus[0].data(), BLOCK_SIZE * sizeof(float));
+    std::memcpy(right, m_bus[1].data(), BLOCK_SIZE * sizeof(float));
+
+    m_renderEpoch.fetch_add(1, std::memory_order_release);
+}
+
+bool AudioMixer::start(BlockCallback callback) {
+    if (m_running.load()) {
+        LOG_WARNING("AudioMixer: already running");
+        return false;
+    }
+
+    // Reap a thread that stopped itself
+    if (m_audioThread) {
+        m_audioThread->join();
+        m_audioThread.reset();
+    }
+
+    m_running = true;
+    m_audioThread = std::make_unique<std::thread>(&AudioMixer::audioLoop, this, std::move(callback));
+    LOG_INFO("AudioMixer: audio thread started");
+    return true;
+}
+
+void AudioMixer::stop() {
+    m_running = false;
+    if (m_audioThread) {
+        m_audioThread->join();
+        m_audioThread.reset();
+        LOG_INFO("AudioMixer: audio thread stopped");
+    }
+}
+
+void AudioMixer::audioLoop(BlockCallback callback) {
+    std::array<float, BLOCK_SIZE> left{};
+    std::array<float, BLOCK_SIZE> right{};
+
+    while (m_running.load(std::memory_order_relaxed)) {
+        renderBlock(left.data(), right.data());
+        if (!callback(left.data(), right.data(), BLOCK_SIZE)) {
+            m_running = false;
+        }
+    }
+}
+
+void AudioMixer::updateEqualizer(TrackSlot& slot) {
+    std::array<float, 3> settings = {
+        slot.bass.load(std::memory_order_relaxed),
+        slot.midrange.load(std::memory_order_relaxed),
+        slot.treble.load(std::memory_order_relaxed),
+    };
+
+    bool active = std::any_of(settings.begin(), settings.end(),
+                              [](float value) { return std::fabs(value) > 1e-4f; });
+    if (!active) {
+        slot.eqActive = false;
+        return;
+    }
+    if (!slot.eqActive) {
+        // Coming out of bypass: start from silence
+        for (auto& state : slot.eqState) {
+            state.fill(0.0f);
+        }
+        slot.eqActive = true;
+    } else if (settings == slot.designedEq) {
+        return;
+    }
+    slot.designedEq = settings;
+
+    // RBJ cookbook filters, normalized by a0
+    const float sampleRate = static_cast<float>(m_sampleRate);
+    auto normalize = [](float b0, float b1, float b2, float a0, float a1, float a2) {
+        return Biquad{b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0};
+    };
+    auto shelf = [&](float frequency, float amount, bool high) {
+        float A = std::pow(10.0f, amount * EQ_RANGE_DB / 40.0f);
+        float w0 = 2.0f * PI * limitFrequency(frequency, m_sampleRate) / sampleRate;
+        float cosW = std::cos(w0);
+        float alpha = std::sin(w0) / 2.0f * std::sqrt(2.0f);    // Shelf slope 1
+        float beta = 2.0f * std::sqrt(A) * alpha;
+        float sign = high ? -1.0f : 1.0f;
+
+        return normalize(A * ((A + 1.0f) - sign * (A - 1.0f) * cosW + beta),
+                         sign * 2.0f * A * ((A - 1.0f) - sign * (A + 1.0f) * cosW),
+                         A * ((A + 1.0f) - sign * (A - 1.0f) * cosW - beta),
+                         (A + 1.0f) + sign * (A - 1.0f) * cosW + beta,
+                         -sign * 2.0f * ((A - 1.0f) + sign * (A + 1.0f) * cosW),
+                         (A + 1.0f) + sign * (A - 1.0f) * cosW - beta);
+    };
+    auto peak = [&](float frequency, float q, float amount) {
+        float A = std::pow(10.0f, amount * EQ_RANGE_DB / 40.0f);
+        float w0 = 2.0f * PI * limitFrequency(frequency, m_sampleRate) / sampleRate;
+        float cosW = std::cos(w0);
+        float alpha = std::sin(w0) / (2.0f * q);
+
+        return normalize(1.0f + alpha * A, -2.0f * cosW, 1.0f - alpha * A,
+                         1.0f + alpha / A, -2.0f * cosW, 1.0f - alpha / A);
+    };
+
+    slot.eq[0] = shelf(BASS_FREQUENCY, settings[0], false);
+    slot.eq[1] = peak(MID_FREQUENCY, MID_Q, settings[1]);
+    slot.eq[2] = shelf(TREBLE_FREQUENCY, settings[2], true);
+}
+
+void AudioMixer::equalizeLanes(const EqLane* lanes, size_t laneCount) {
+    float* packed = m_laneBuffer.data();
+
+    // Coefficients and states of each stage, one lane per channel;
+    // unused lanes get zero coefficients and stay silent
+    float coefficients[EQ_STAGES][5][4] = {};
+    float states[EQ_STAGES][2][4] = {};
+
+    for (size_t lane = 0; lane < 4; lane++) {
+        if (lane < laneCount) {
+            const TrackSlot& slot = *lanes[lane].slot;
+            const float* input = slot.buffers[lanes[lane].channel].data();
+            for (size_t i = 0; i < BLOCK_SIZE; i++) {
+                packed[i * 4 + lane] = input[i];
+            }
+            for (size_t s = 0; s < EQ_STAGES; s++) {
+                const Biquad& biquad = slot.eq[s];
+                coefficients[s][0][lane] = biquad.b0;
+                coefficients[s][1][lane] = biquad.b1;
+                coefficients[s][2][lane] = biquad.b2;
+                coefficients[s][3][lane] = biquad.a1;
+                coefficients[s][4][lane] = biquad.a2;
+                states[s][0][lane] = slot.eqState[lanes[lane].channel][2 * s];
+                states[s][1][lane] = slot.eqState[lanes[lane].channel][2 * s + 1];
+            }
+        } else {
+            for (size_t i = 0; i < BLOCK_SIZE; i++) {
+                packed[i * 4 + lane] = 0.0f;
+            }
+        }
+    }
+
+    Float4 b0[EQ_STAGES], b1[EQ_STAGES], b2[EQ_STAGES], a1[EQ_STAGES], a2[EQ_STAGES];
+    Float4 z1[EQ_STAGES], z2[EQ_STAGES];
+    for (size_t s = 0; s < EQ_STAGES; s++) {
+        b0[s] = load4(coefficients[s][0]);
+        b1[s] = load4(coefficients[s][1]);
+        b2[s] = load4(coefficients[s][2]);
+        a1[s] = load4(coefficients[s][3]);
+        a2[s] = load4(coefficients[s][4]);
+        z1[s] = load4(states[s][0]);
+        z2[s] = load4(states[s][1]);
+    }
+
+    // Transposed direct form II, all stages per sample
+    for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        Float4 x = load4(packed + i * 4);
+        for (size_t s = 0; s < EQ_STAGES; s++) {
+            Float4 y = b0[s] * x + z1[s];
+            z1[s] = b1[s] * x - a1[s] * y + z2[s];
+            z2[s] = b2[s] * x - a2[s] * y;
+            x = y;
+        }
+        store4(packed + i * 4, x);
+    }
+
+    for (size_t s = 0; s < EQ_STAGES; s++) {
+        store4(states[s][0], z1[s]);
+        store4(states[s][1], z2[s]);
+    }
+
+    for (size_t lane = 0; lane < laneCount; lane++) {
+        TrackSlot& slot = *lanes[lane].slot;
+        float* output = slot.buffers[lanes[lane].channel].data();
+        for (size_t i = 0; i < BLOCK_SIZE; i++) {
+            output[i] = packed[i * 4 + lane];
+        }
+
+        auto& state = slot.eqState[lanes[lane].channel];
+        for (size_t s = 0; s < EQ_STAGES; s++) {
+            for (size_t k = 0; k < 2; k++) {
+                float value = states[s][k][lane];
+                state[2 * s + k] = std::fabs(value) < DENORMAL_THRESHOLD ? 0.0f : value;
+            }
+        }
+    }
+}
+
+void AudioMixer::mixSlot(TrackSlot& slot, bool audible) {
+    // Bus gains this block should end on
+    std::array<float, MAX_CHANNELS> targets{};
+    if (audible) {
+        float gain = slot.volume.load(std::memory_order_relaxed) * m_masterVolume.load(std::memory_order_relaxed);
+        float pan = slot.pan.load(std::memory_order_relaxed);
+
+        if (slot.channels == 1) {
+            // Constant power, so a mono source keeps its loudness across the field
+            float angle = (pan + 1.0f) * PI / 4.0f;
+            targets[0] = gain * std::cos(angle);
+            targets[1] = gain * std::sin(angle);
+        } else {
+            // Balance: pan attenuates the opposite channel
+            targets[0] = gain * (pan > 0.0f ? 1.0f - pan : 1.0f);
+            targets[1] = gain * (pan < 0.0f ? 1.0f + pan : 1.0f);
+        }
+    }
+
+    for (size_t c = 0; c < MAX_CHANNELS; c++) {
+        float start = slot.appliedGains[c];
+        float target = targets[c];
+        slot.appliedGains[c] = target;
+        if (start == 0.0f && target == 0.0f) continue;
+
+        // Mono sources feed both sides of the bus
+        const float* input = slot.buffers[slot.channels == 1 ? 0 : c].data();
+        float* bus = m_bus[c].data();
+
+        if (start == target) {
+            for (size_t i = 0; i < BLOCK_SIZE; i++) {
+                bus[i] += input[i] * target;
+            }
+        } else {
+            float step = (target - start) / static_cast<float>(BLOCK_SIZE);
+            for (size_t i = 0; i < BLOCK_SIZE; i++) {
+                bus[i] += input[i] * (start + step * static_cast<float>(i + 1));
+            }
+        }
+    }
+}
+
+} // namespace audio
+} // namespace clipforge
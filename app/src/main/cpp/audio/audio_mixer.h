@@ -0,0 +1,268 @@
+#ifndef CLIPFORGE_AUDIO_MIXER_H
+#define CLIPFORGE_AUDIO_MIXER_H
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+#include "../models/audio_track.h"
+
+namespace clipforge {
+namespace audio {
+
+/**
+ * @class AudioSource
+ * @brief Supplies PCM for one mixer track
+ *
+ * Called on the audio thread; implementations must not block or
+ * allocate (decode ahead into a buffer instead).
+ */
+class AudioSource {
+public:
+    virtual ~AudioSource() = default;
+
+    /**
+     * @brief Get number of channels produced (1 or 2)
+     */
+    [[nodiscard]] virtual size_t getChannelCount() const = 0;
+
+    /**
+     * @brief Read the next frames at the mixer's sample rate
+     * @param channels One planar buffer per channel
+     * @param frames Frames wanted
+     * @return Frames written; the rest of the block is treated as silence
+     */
+    virtual size_t read(float* const* channels, size_t frames) = 0;
+};
+
+/**
+ * @struct MixerTrackSettings
+ * @brief Mix parameters of one track
+ */
+struct MixerTrackSettings {
+    float volume = 1.0f;       // Gain (0-2)
+    float pan = 0.0f;          // -1 left, 0 centre, 1 right
+    bool enabled = true;
+    bool muted = false;
+    bool solo = false;
+    float bass = 0.0f;         // -1 to 1 (+/-12 dB low shelf at 250 Hz)
+    float midrange = 0.0f;     // -1 to 1 (+/-12 dB peak at 1 kHz)
+    float treble = 0.0f;       // -1 to 1 (+/-12 dB high shelf at 4 kHz)
+
+    /**
+     * @brief Take the settings of a timeline track
+     */
+    static MixerTrackSettings fromTrack(const models::AudioTrack& track);
+};
+
+/**
+ * @class AudioMixer
+ * @brief Block-based float mixer for audio tracks
+ *
+ * Every block of BLOCK_SIZE frames, each active track's source is
+ * pulled into planar buffers, equalized, then summed into the stereo
+ * bus with its gain and pan. Gain changes are ramped across a block so
+ * parameter moves do not click. When any track is solo, only solo
+ * tracks are heard; muted tracks keep being read so they stay in sync.
+ *
+ * The EQ is three cascaded biquads per channel. Channels of all tracks
+ * with EQ are packed four to a SIMD vector (one lane each), so the
+ * recursion runs four channels at once.
+ *
+ * Threading: control methods (addTrack, removeTrack, setTrackSettings,
+ * setMasterVolume) come from one control thread; blocks are rendered
+ * either by start()'s audio thread or by renderBlock() for offline
+ * export. The audio thread never locks or allocates: settings are
+ * atomics it reads each block, track buffers are allocated by addTrack,
+ * and removeTrack waits for the block in flight before releasing a
+ * source.
+ *
+ * Usage:
+ * @code
+ * AudioMixer mixer(48000);
+ * int slot = mixer.addTrack(source);
+ * mixer.setTrackSettings(slot, MixerTrackSettings::fromTrack(track));
+ * mixer.start([&](const float* left, const float* right, size_t frames) {
+ *     return output.write(left, right, frames);
+ * });
+ * @endcode
+ */
+class AudioMixer {
+public:
+    static constexpr size_t BLOCK_SIZE = 256;       // Frames per block
+    static constexpr size_t MAX_TRACKS = 64;
+    static constexpr size_t MAX_CHANNELS = 2;       // Per track and on the bus
+
+    /**
+     * @brief Receives each rendered block on the audio thread
+     * @return false to stop the audio thread
+     */
+    using BlockCallback = std::function<bool(const float* left, const float* right, size_t frames)>;
+
+    /**
+     * @brief Create mixer
+     * @param sampleRate Output sample rate in Hz; sources must match it
+     */
+    explicit AudioMixer(int sampleRate = 48000);
+
+    /**
+     * @brief Destructor - stops the audio thread
+     */
+    ~AudioMixer();
+
+    // Prevent copying
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    /**
+     * @brief Add a track
+     * @param source PCM source (1 or 2 channels)
+     * @return Slot index, or -1 if full or the source is invalid
+     */
+    int addTrack(std::shared_ptr<AudioSource> source);
+
+    /**
+     * @brief Remove a track
+     * @param slot Slot returned by addTrack
+     * @return true if removed; the source is released before returning
+     */
+    bool removeTrack(int slot);
+
+    /**
+     * @brief Update a track's settings (applied from the next block)
+     * @param slot Slot returned by addTrack
+     * @param settings New settings
+     * @return true if the slot holds a track
+     */
+    bool setTrackSettings(int slot, const MixerTrackSettings& settings);
+
+    /**
+     * @brief Set gain of the output bus
+     * @param volume Gain (0-2)
+     */
+    void setMasterVolume(float volume) { m_masterVolume = volume; }
+
+    /**
+     * @brief Render one block
+     * @param left Receives BLOCK_SIZE frames
+     * @param right Receives BLOCK_SIZE frames
+     *
+     * For offline use; must not be called while the audio thread runs.
+     */
+    void renderBlock(float* left, float* right);
+
+    /**
+     * @brief Start the audio thread
+     * @param callback Consumes each block; its blocking paces the thread
+     * @return false if already running
+     */
+    bool start(BlockCallback callback);
+
+    /**
+     * @brief Stop the audio thread and wait for it
+     */
+    void stop();
+
+    /**
+     * @brief Check if the audio thread is running
+     */
+    [[nodiscard]] bool isRunning() const { return m_running.load(); }
+
+    [[nodiscard]] int getSampleRate() const { return m_sampleRate; }
+
+private:
+    enum SlotState : int {
+        SLOT_EMPTY = 0,
+        SLOT_ACTIVE,
+        SLOT_RETIRING,
+    };
+
+    /**
+     * @struct Biquad
+     * @brief Normalized biquad coefficients (a0 = 1)
+     */
+    struct Biquad {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    };
+
+    static constexpr size_t EQ_STAGES = 3;
+
+    /**
+     * @struct TrackSlot
+     * @brief One track: control-thread settings plus audio-thread state
+     */
+    struct TrackSlot {
+        std::atomic<int> state{SLOT_EMPTY};
+        std::shared_ptr<AudioSource> source;
+        size_t channels = 0;
+
+        // Written by the control thread, read each block
+        std::atomic<float> volume{1.0f};
+        std::atomic<float> pan{0.0f};
+        std::atomic<bool> enabled{true};
+        std::atomic<bool> muted{false};
+        std::atomic<bool> solo{false};
+        std::atomic<float> bass{0.0f};
+        std::atomic<float> midrange{0.0f};
+        std::atomic<float> treble{0.0f};
+
+        // Audio thread only
+        std::array<std::vector<float>, MAX_CHANNELS> buffers;
+        std::array<float, MAX_CHANNELS> appliedGains{};       // Bus gains reached by the last block
+        std::array<float, 3> designedEq{};                    // bass, mid, treble of the coefficients
+        std::array<Biquad, EQ_STAGES> eq{};
+        bool eqActive = false;
+        std::array<std::array<float, 2 * EQ_STAGES>, MAX_CHANNELS> eqState{};  // z1, z2 per stage
+    };
+
+    /**
+     * @struct EqLane
+     * @brief One channel fed through the vectorized EQ
+     */
+    struct EqLane {
+        TrackSlot* slot;
+        size_t channel;
+    };
+
+    int m_sampleRate;
+    std::array<TrackSlot, MAX_TRACKS> m_slots;
+    std::atomic<float> m_masterVolume{1.0f};
+
+    // Audio thread
+    std::unique_ptr<std::thread> m_audioThread;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_renderEpoch{0};        // Blocks finished
+    std::array<std::vector<float>, MAX_CHANNELS> m_bus;
+    std::vector<EqLane> m_eqLanes;                 // Reserved for every channel of every slot
+    std::vector<float> m_laneBuffer;               // Four interleaved lanes
+
+    /**
+     * @brief Audio thread main loop
+     */
+    void audioLoop(BlockCallback callback);
+
+    /**
+     * @brief Redesign a slot's EQ if its settings changed
+     */
+    void updateEqualizer(TrackSlot& slot);
+
+    /**
+     * @brief Run the EQ over up to four lanes
+     */
+    void equalizeLanes(const EqLane* lanes, size_t laneCount);
+
+    /**
+     * @brief Add a slot's buffers to the bus, ramping its gains
+     */
+    void mixSlot(TrackSlot& slot, bool audible);
+};
+
+} // namespace audio
+} // namespace clipforge
+
+#endif // CLIPFORGE_AUDIO_MIXER_H
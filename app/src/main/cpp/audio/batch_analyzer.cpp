@@ -0,0 +1,138 @@
+#include "batch_analyzer.h"
+#include "../utils/logger.h"
+#include <algorithm>
+
+namespace clipforge {
+namespace audio {
+
+// ============================================================================
+// BatchAudioAnalyzer Implementation
+// ============================================================================
+
+BatchAudioAnalyzer::BatchAudioAnalyzer(utils::ThreadPool& pool)
+    : m_pool(pool) {
+    LOG_INFO("BatchAudioAnalyzer created with %zu threads", pool.getThreadCount());
+}
+
+bool BatchAudioAnalyzer::analyze(const std::vector<AudioTrackInput>& tracks,
+                                 std::vector<TrackAnalysis>& results) {
+    m_cancelled = false;
+    m_framesDone = 0;
+    m_totalFrames = 0;
+
+    constexpr size_t HOP = BeatTracker::HOP_SIZE;
+
+    // Size the results and cut every track into segments
+    results.assign(tracks.size(), TrackAnalysis{});
+    std::vector<Segment> segments;
+    std::vector<bool> valid(tracks.size(), false);
+
+    for (size_t i = 0; i < tracks.size(); i++) {
+        const AudioTrackInput& track = tracks[i];
+        results[i].id = track.id;
+
+        if (track.sampleRate <= 0 || track.channels <= 0) {
+            LOG_ERROR("BatchAudioAnalyzer: track %s has invalid format (%d Hz, %d channels)",
+                      track.id.c_str(), track.sampleRate, track.channels);
+            continue;
+        }
+        valid[i] = true;
+
+        size_t samples = track.samples.size() / static_cast<size_t>(track.channels);
+        size_t frames = (samples + HOP - 1) / HOP;
+        results[i].onsetCurve.assign(frames, 0.0f);
+        results[i].energy.assign(frames, 0.0f);
+
+        for (size_t first = 0; first < frames; first += SEGMENT_FRAMES) {
+            segments.push_back({i, first, std::min(SEGMENT_FRAMES, frames - first)});
+        }
+        m_totalFrames += frames;
+    }
+
+    LOG_INFO("BatchAudioAnalyzer: %zu tracks, %zu segments", tracks.size(), segments.size());
+
+    m_trackers.resize(m_pool.getThreadCount());
+
+    // Onsets and energy, segment by segment on every thread
+    m_pool.parallelForThreaded(segments.size(), [&](size_t index, size_t thread) {
+        if (m_cancelled) return;
+
+        const Segment& segment = segments[index];
+        const AudioTrackInput& track = tracks[segment.track];
+        processSegment(track, segment, trackerFor(thread, track), results[segment.track]);
+        reportProgress(segment.frameCount);
+    });
+
+    if (m_cancelled) {
+        LOG_INFO("BatchAudioAnalyzer: cancelled");
+        return false;
+    }
+
+    // Tempo and beats per track on the merged curves
+    m_pool.parallelForThreaded(tracks.size(), [&](size_t index, size_t thread) {
+        if (!valid[index]) return;
+
+        const AudioTrackInput& track = tracks[index];
+        TrackAnalysis& result = results[index];
+        int64_t samples = static_cast<int64_t>(track.samples.size() / static_cast<size_t>(track.channels));
+
+        result.beatGrid = trackerFor(thread, track).analyzeOnsets(result.onsetCurve, samples);
+        result.completed = true;
+    });
+
+    if (m_progressCallback) {
+        std::lock_guard<std::mutex> lock(m_progressMutex);
+        m_progressCallback(1.0f);
+    }
+    return true;
+}
+
+void BatchAudioAnalyzer::processSegment(const AudioTrackInput& track, const Segment& segment,
+                                        BeatTracker& tracker, TrackAnalysis& result) {
+    constexpr size_t HOP = BeatTracker::HOP_SIZE;
+    const size_t channels = static_cast<size_t>(track.channels);
+    const size_t trackSamples = track.samples.size() / channels;
+
+    // Start early so the ring and previous bands match a continuous run
+    size_t startFrame = segment.firstFrame >= BeatTracker::WARMUP_FRAMES
+        ? segment.firstFrame - BeatTracker::WARMUP_FRAMES : 0;
+    size_t startSample = startFrame * HOP;
+    size_t endSample = std::min((segment.firstFrame + segment.frameCount) * HOP, trackSamples);
+
+    tracker.reset();
+    tracker.push(track.samples.subspan(startSample * channels, (endSample - startSample) * channels));
+    if (endSample == trackSamples) {
+        tracker.flush();
+    }
+
+    // Drop the warm-up frames and copy into the segment's slice
+    size_t skip = segment.firstFrame - startFrame;
+    auto copySlice = [&](const std::vector<float>& source, std::vector<float>& target) {
+        size_t available = source.size() > skip ? std::min(source.size() - skip, segment.frameCount) : 0;
+        std::copy_n(source.begin() + static_cast<std::ptrdiff_t>(skip), available,
+                    target.begin() + static_cast<std::ptrdiff_t>(segment.firstFrame));
+    };
+    copySlice(tracker.getOnsetCurve(), result.onsetCurve);
+    copySlice(tracker.getEnergyCurve(), result.energy);
+}
+
+BeatTracker& BatchAudioAnalyzer::trackerFor(size_t thread, const AudioTrackInput& track) {
+    std::unique_ptr<BeatTracker>& tracker = m_trackers[thread];
+    if (!tracker || tracker->getSampleRate() != track.sampleRate || tracker->getChannels() != track.channels) {
+        tracker = std::make_unique<BeatTracker>(track.sampleRate, track.channels);
+    }
+    return *tracker;
+}
+
+void BatchAudioAnalyzer::reportProgress(size_t frames) {
+    m_framesDone += frames;
+    if (!m_progressCallback || m_totalFrames == 0) return;
+
+    // Read the counter under the lock so reported values never go backwards
+    std::lock_guard<std::mutex> lock(m_progressMutex);
+    float progress = static_cast<float>(m_framesDone.load()) / static_cast<float>(m_totalFrames);
+    m_progressCallback(std::min(progress, 1.0f));
+}
+
+} // namespace audio
+} // namespace clipforge
@@ -0,0 +1,153 @@
+#ifndef CLIPFORGE_BATCH_ANALYZER_H
+#define CLIPFORGE_BATCH_ANALYZER_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <span>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+
+#include "beat_tracker.h"
+#include "../utils/thread_pool.h"
+
+namespace clipforge {
+namespace audio {
+
+/**
+ * @struct AudioTrackInput
+ * @brief Decoded PCM of one track to analyze
+ *
+ * The samples are not copied; they must stay valid until analyze() returns.
+ */
+struct AudioTrackInput {
+    std::string id;
+    std::span<const float> samples;   // Interleaved PCM
+    int sampleRate = 44100;
+    int channels = 2;
+};
+
+/**
+ * @struct TrackAnalysis
+ * @brief Analysis results for one track
+ */
+struct TrackAnalysis {
+    std::string id;
+    BeatGrid beatGrid;
+    std::vector<float> onsetCurve;    // Onset strength per BeatTracker::HOP_SIZE samples
+    std::vector<float> energy;        // RMS of the mono mix per hop
+    bool completed = false;           // False if the track was invalid or cancelled
+};
+
+/**
+ * @class BatchAudioAnalyzer
+ * @brief Analyzes many tracks in parallel
+ *
+ * Tracks are cut into segments of SEGMENT_FRAMES hops. Each segment is
+ * an independent task on the thread pool, whose shared index counter
+ * lets idle threads take the next segment of any track, so one long
+ * track spreads across all cores as well as many short ones.
+ *
+ * A segment starts BeatTracker::WARMUP_FRAMES hops early (the overlap),
+ * which makes its onsets bit-identical to a single pass over the track.
+ * Segments write straight into their slice of the track's curves, so
+ * merging is ordered by position, not completion, and results do not
+ * depend on the thread count. Tempo and beat tracking then run per
+ * track on the merged curve.
+ *
+ * Each pool thread keeps its own BeatTracker (FFT scratch and ring
+ * buffer), so segments allocate nothing; the FFT tables are shared.
+ *
+ * Usage:
+ * @code
+ * BatchAudioAnalyzer analyzer(pool);
+ * analyzer.setProgressCallback([](float progress) { ... });
+ * std::vector<TrackAnalysis> results;
+ * if (analyzer.analyze(tracks, results)) { ... }
+ * @endcode
+ */
+class BatchAudioAnalyzer {
+public:
+    static constexpr size_t SEGMENT_FRAMES = 1024;   // Hops per segment (~12 s at 44.1 kHz)
+
+    using ProgressCallback = std::function<void(float progress)>;
+
+    /**
+     * @brief Create analyzer
+     * @param pool Threads to run segments on
+     */
+    explicit BatchAudioAnalyzer(utils::ThreadPool& pool);
+
+    /**
+     * @brief Analyze tracks
+     * @param tracks Tracks to analyze
+     * @param results Receives one entry per track, in the same order
+     * @return true if all segments ran, false if cancelled
+     */
+    bool analyze(const std::vector<AudioTrackInput>& tracks, std::vector<TrackAnalysis>& results);
+
+    /**
+     * @brief Stop a running analyze() after the segments in progress
+     */
+    void cancel() { m_cancelled = true; }
+
+    /**
+     * @brief Check if the last analyze() was cancelled
+     * @return true if cancelled
+     */
+    [[nodiscard]] bool wasCancelled() const { return m_cancelled.load(); }
+
+    /**
+     * @brief Set progress callback
+     * @param callback Called with 0-1 as segments finish; may run on any
+     *                 pool thread, but never concurrently
+     */
+    void setProgressCallback(ProgressCallback callback) { m_progressCallback = std::move(callback); }
+
+private:
+    /**
+     * @struct Segment
+     * @brief Hops [firstFrame, firstFrame + frameCount) of one track
+     */
+    struct Segment {
+        size_t track;
+        size_t firstFrame;
+        size_t frameCount;
+    };
+
+    utils::ThreadPool& m_pool;
+    std::vector<std::unique_ptr<BeatTracker>> m_trackers;   // One per pool thread
+    std::atomic<bool> m_cancelled{false};
+
+    ProgressCallback m_progressCallback;
+    std::mutex m_progressMutex;
+    std::atomic<size_t> m_framesDone{0};
+    size_t m_totalFrames = 0;
+
+    /**
+     * @brief Compute the onsets and energy of one segment
+     * @param track Track the segment belongs to
+     * @param segment Segment to process
+     * @param tracker The calling thread's tracker
+     * @param result Track results to write the segment's slice of
+     */
+    static void processSegment(const AudioTrackInput& track, const Segment& segment,
+                               BeatTracker& tracker, TrackAnalysis& result);
+
+    /**
+     * @brief Get the calling thread's tracker, configured for a track
+     */
+    BeatTracker& trackerFor(size_t thread, const AudioTrackInput& track);
+
+    /**
+     * @brief Count a finished segment and report progress
+     */
+    void reportProgress(size_t frames);
+};
+
+} // namespace audio
+} // namespace clipforge
+
+#endif // CLIPFORGE_BATCH_ANALYZER_H
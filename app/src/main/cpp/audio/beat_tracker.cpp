@@ -0,0 +1,338 @@
+#include "beat_tracker.h"
+#include "../utils/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace clipforge {
+namespace audio {
+
+namespace {
+
+constexpr float LOG_COMPRESSION = 10.0f;   // log(1 + C * energy) before the flux
+constexpr float LOWEST_BAND_HZ = 40.0f;
+constexpr size_t LOCAL_MEAN_RADIUS = 16;   // Frames each side (~190 ms at 44.1 kHz)
+constexpr float TEMPO_PRIOR_BPM = 120.0f;  // Centre of the tempo weighting
+constexpr float TEMPO_PRIOR_OCTAVES = 1.0f;
+constexpr float TIGHTNESS = 100.0f;        // Penalty for beats off the period
+
+} // namespace
+
+// ===== BeatTracker Implementation =====
+
+BeatTracker::BeatTracker(int sampleRate, int channels)
+    : m_sampleRate(std::max(sampleRate, 1)), m_channels(std::max(channels, 1)) {
+    m_plan = RealFFTPlan::forSize(FRAME_SIZE);
+
+    // Periodic Hann window for 50% overlap
+    m_window.resize(FRAME_SIZE);
+    for (size_t i = 0; i < FRAME_SIZE; i++) {
+        double phase = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(FRAME_SIZE);
+        m_window[i] = static_cast<float>(0.5 * (1.0 - std::cos(phase)));
+    }
+
+    // Log-spaced band edges; at least one bin per band at the bottom
+    const size_t bins = FRAME_SIZE / 2;
+    float binHz = static_cast<float>(m_sampleRate) / static_cast<float>(FRAME_SIZE);
+    float ratio = static_cast<float>(m_sampleRate) / 2.0f / LOWEST_BAND_HZ;
+    m_bandEdges.resize(BAND_COUNT + 1);
+    m_bandEdges[0] = 1;   // DC skipped
+    for (size_t band = 1; band <= BAND_COUNT; band++) {
+        float hz = LOWEST_BAND_HZ * std::pow(ratio, static_cast<float>(band) / static_cast<float>(BAND_COUNT));
+        uint32_t edge = static_cast<uint32_t>(std::lround(hz / binHz));
+        edge = std::max(edge, m_bandEdges[band - 1] + 1);
+        m_bandEdges[band] = std::min(edge, static_cast<uint32_t>(bins));
+    }
+    m_bandEdges[BAND_COUNT] = static_cast<uint32_t>(bins);
+
+    m_frame.resize(FRAME_SIZE);
+    m_real.resize(FRAME_SIZE / 2);
+    m_imag.resize(FRAME_SIZE / 2);
+    reset();
+}
+
+void BeatTracker::setTempoRange(float minBpm, float maxBpm) {
+    if (minBpm <= 0.0f || maxBpm <= minBpm) {
+        LOG_WARNING("BeatTracker: invalid tempo range %.1f-%.1f BPM", minBpm, maxBpm);
+        return;
+    }
+    m_minBpm = minBpm;
+    m_maxBpm = maxBpm;
+}
+
+BeatGrid BeatTracker::analyzeTrack(std::span<const float> samples) {
+    reset();
+    m_onsets.reserve(samples.size() / static_cast<size_t>(m_channels) / HOP_SIZE + 2);
+    m_energy.reserve(m_onsets.capacity());
+
+    // Stream in hop-sized chunks, as a decoder would deliver them
+    const size_t chunk = HOP_SIZE * static_cast<size_t>(m_channels);
+    for (size_t offset = 0; offset < samples.size(); offset += chunk) {
+        push(samples.subspan(offset, std::min(chunk, samples.size() - offset)));
+    }
+    return finish();
+}
+
+void BeatTracker::push(std::span<const float> samples) {
+    const float channelScale = 1.0f / static_cast<float>(m_channels);
+
+    for (float sample : samples) {
+        m_partialSum += sample;
+        if (++m_partialChannels == m_channels) {
+            pushMono(m_partialSum * channelScale);
+            m_partialSum = 0.0f;
+            m_partialChannels = 0;
+        }
+    }
+}
+
+void BeatTracker::flush() {
+    if (m_pendingSamples == 0) return;
+
+    // The padding adds nothing to the energy sum; average over real samples
+    size_t realSamples = m_pendingSamples;
+    int64_t total = m_totalSamples;
+    while (m_pendingSamples > 0) {
+        pushMono(0.0f);
+    }
+    m_totalSamples = total;
+    m_energy.back() *= std::sqrt(static_cast<float>(HOP_SIZE) / static_cast<float>(realSamples));
+}
+
+BeatGrid BeatTracker::finish() {
+    flush();
+    return analyzeOnsets(m_onsets, m_totalSamples);
+}
+
+BeatGrid BeatTracker::analyzeOnsets(std::span<const float> rawOnsets, int64_t sampleCount) const {
+    BeatGrid grid;
+    grid.durationMs = static_cast<int32_t>(sampleCount * 1000 / m_sampleRate);
+
+    std::vector<float> onsets = normalizedOnsets(rawOnsets);
+    float period = estimatePeriod(onsets, grid.confidence);
+    if (period <= 0.0f) {
+        LOG_WARNING("BeatTracker: no tempo found in %d ms of audio", grid.durationMs);
+        return grid;
+    }
+
+    float framesPerMinute = 60.0f * static_cast<float>(m_sampleRate) / static_cast<float>(HOP_SIZE);
+    grid.bpm = framesPerMinute / period;
+
+    // The autocorrelation peak is coarse; the mean beat interval of the
+    // tracked grid gives the tempo to a fraction of a BPM
+    std::vector<size_t> beatFrames = trackBeats(onsets, period);
+    if (beatFrames.size() >= 2 && beatFrames.back() > beatFrames.front()) {
+        float span = static_cast<float>(beatFrames.back() - beatFrames.front());
+        grid.bpm = framesPerMinute * static_cast<float>(beatFrames.size() - 1) / span;
+    }
+
+    float maxOnset = *std::max_element(onsets.begin(), onsets.end());
+    for (size_t frame : beatFrames) {
+        BeatInfo beat;
+        beat.timestamp = frameToMs(frame);
+        beat.strength = maxOnset > 0.0f ? std::clamp(onsets[frame] / maxOnset, 0.0f, 1.0f) : 0.0f;
+        grid.beats.push_back(beat);
+    }
+
+    LOG_INFO("BeatTracker: %.1f BPM (confidence %.2f), %zu beats in %d ms",
+             grid.bpm, grid.confidence, grid.beats.size(), grid.durationMs);
+    return grid;
+}
+
+void BeatTracker::reset() {
+    m_ring.assign(FRAME_SIZE, 0.0f);
+    m_ringPosition = 0;
+    m_pendingSamples = 0;
+    m_partialSum = 0.0f;
+    m_partialChannels = 0;
+    m_totalSamples = 0;
+    m_hopSumSquares = 0.0f;
+    m_previousLog.assign(BAND_COUNT, 0.0f);
+    m_onsets.clear();
+    m_energy.clear();
+}
+
+void BeatTracker::pushMono(float sample) {
+    m_ring[m_ringPosition] = sample;
+    m_ringPosition = (m_ringPosition + 1) % FRAME_SIZE;
+    m_totalSamples++;
+    m_hopSumSquares += sample * sample;
+
+    if (++m_pendingSamples == HOP_SIZE) {
+        m_pendingSamples = 0;
+        m_energy.push_back(std::sqrt(m_hopSumSquares / static_cast<float>(HOP_SIZE)));
+        m_hopSumSquares = 0.0f;
+        processFrame();
+    }
+}
+
+void BeatTracker::processFrame() {
+    if (!m_plan) return;
+
+    // Unroll the ring, oldest sample first
+    size_t tail = FRAME_SIZE - m_ringPosition;
+    std::memcpy(m_frame.data(), m_ring.data() + m_ringPosition, tail * sizeof(float));
+    std::memcpy(m_frame.data() + tail, m_ring.data(), m_ringPosition * sizeof(float));
+
+    m_plan->forward(m_frame.data(), m_window.data(), m_real.data(), m_imag.data());
+
+    // Rectified flux of the log band energies
+    float flux = 0.0f;
+    for (size_t band = 0; band < BAND_COUNT; band++) {
+        uint32_t first = m_bandEdges[band];
+        uint32_t last = m_bandEdges[band + 1];
+        if (first >= last) continue;
+
+        float energy = 0.0f;
+        for (uint32_t k = first; k < last; k++) {
+            energy += m_real[k] * m_real[k] + m_imag[k] * m_imag[k];
+        }
+        energy /= static_cast<float>(last - first);
+
+        float logEnergy = std::log1p(LOG_COMPRESSION * energy);
+        flux += std::max(logEnergy - m_previousLog[band], 0.0f);
+        m_previousLog[band] = logEnergy;
+    }
+    m_onsets.push_back(flux);
+}
+
+std::vector<float> BeatTracker::normalizedOnsets(std::span<const float> onsets) {
+    const size_t count = onsets.size();
+    std::vector<float> result(count, 0.0f);
+    if (count == 0) return result;
+
+    // Subtract a centred moving average (running sum) and half-wave rectify
+    double windowSum = 0.0;
+    size_t windowStart = 0;
+    size_t windowEnd = 0;   // Exclusive
+    for (size_t i = 0; i < count; i++) {
+        size_t wantStart = i > LOCAL_MEAN_RADIUS ? i - LOCAL_MEAN_RADIUS : 0;
+        size_t wantEnd = std::min(count, i + LOCAL_MEAN_RADIUS + 1);
+        while (windowEnd < wantEnd) windowSum += onsets[windowEnd++];
+        while (windowStart < wantStart) windowSum -= onsets[windowStart++];
+
+        float mean = static_cast<float>(windowSum / static_cast<double>(windowEnd - windowStart));
+        result[i] = std::max(onsets[i] - mean, 0.0f);
+    }
+
+    // Unit standard deviation so the DP tightness is independent of level
+    double sumSquares = 0.0;
+    for (float value : result) {
+        sumSquares += static_cast<double>(value) * value;
+    }
+    float deviation = static_cast<float>(std::sqrt(sumSquares / static_cast<double>(count)));
+    if (deviation > 0.0f) {
+        for (float& value : result) {
+            value /= deviation;
+        }
+    }
+    return result;
+}
+
+float BeatTracker::estimatePeriod(const std::vector<float>& onsets, float& confidence) const {
+    confidence = 0.0f;
+
+    float framesPerMinute = 60.0f * static_cast<float>(m_sampleRate) / static_cast<float>(HOP_SIZE);
+    size_t minLag = std::max<size_t>(2, static_cast<size_t>(std::floor(framesPerMinute / m_maxBpm)));
+    size_t maxLag = static_cast<size_t>(std::ceil(framesPerMinute / m_minBpm));
+
+    // Need a few periods of signal to estimate from
+    const size_t count = onsets.size();
+    if (count < 2 * maxLag + 2) return 0.0f;
+
+    auto autocorrelation = [&](size_t lag) {
+        double sum = 0.0;
+        const float* a = onsets.data();
+        const float* b = onsets.data() + lag;
+        for (size_t i = 0, n = count - lag; i < n; i++) {
+            sum += static_cast<double>(a[i] * b[i]);
+        }
+        return static_cast<float>(sum / static_cast<double>(count - lag));
+    };
+
+    // Lags one past each end are kept for the interpolation
+    std::vector<float> correlation(maxLag + 2, 0.0f);
+    for (size_t lag = minLag - 1; lag <= maxLag + 1; lag++) {
+        correlation[lag] = autocorrelation(lag);
+    }
+
+    size_t bestLag = 0;
+    float bestScore = 0.0f;
+    for (size_t lag = minLag; lag <= maxLag; lag++) {
+        float bpm = framesPerMinute / static_cast<float>(lag);
+        float octaves = std::log2(bpm / TEMPO_PRIOR_BPM) / TEMPO_PRIOR_OCTAVES;
+        float score = correlation[lag] * std::exp(-0.5f * octaves * octaves);
+        if (score > bestScore) {
+            bestScore = score;
+            bestLag = lag;
+        }
+    }
+    if (bestLag == 0) return 0.0f;
+
+    // Parabolic interpolation around the peak for a fractional period
+    float period = static_cast<float>(bestLag);
+    float left = correlation[bestLag - 1];
+    float centre = correlation[bestLag];
+    float right = correlation[bestLag + 1];
+    float curvature = left - 2.0f * centre + right;
+    if (curvature < 0.0f) {
+        period += std::clamp(0.5f * (left - right) / curvature, -0.5f, 0.5f);
+    }
+
+    float zeroLag = autocorrelation(0);
+    confidence = zeroLag > 0.0f ? std::clamp(centre / zeroLag, 0.0f, 1.0f) : 0.0f;
+    return period;
+}
+
+std::vector<size_t> BeatTracker::trackBeats(const std::vector<float>& onsets, float period) {
+    const size_t count = onsets.size();
+    constexpr size_t NO_BEAT = std::numeric_limits<size_t>::max();
+
+    // Predecessors are searched from half to twice the period back
+    size_t minStep = std::max<size_t>(1, static_cast<size_t>(std::lround(period / 2.0f)));
+    size_t maxStep = static_cast<size_t>(std::lround(period * 2.0f));
+    std::vector<float> penalty(maxStep + 1, 0.0f);
+    for (size_t step = minStep; step <= maxStep; step++) {
+        float deviation = std::log(static_cast<float>(step) / period);
+        penalty[step] = -TIGHTNESS * deviation * deviation;
+    }
+
+    std::vector<float> score(count);
+    std::vector<size_t> previous(count, NO_BEAT);
+    for (size_t t = 0; t < count; t++) {
+        float best = -std::numeric_limits<float>::infinity();
+        size_t bestFrame = NO_BEAT;
+        for (size_t step = minStep; step <= maxStep && step <= t; step++) {
+            float candidate = score[t - step] + penalty[step];
+            if (candidate > best) {
+                best = candidate;
+                bestFrame = t - step;
+            }
+        }
+
+        score[t] = onsets[t] + (bestFrame != NO_BEAT ? best : 0.0f);
+        previous[t] = bestFrame;
+    }
+
+    // Last beat: best score within the final period, then trace back
+    size_t searchStart = count > maxStep / 2 ? count - maxStep / 2 : 0;
+    size_t last = searchStart;
+    for (size_t t = searchStart; t < count; t++) {
+        if (score[t] > score[last]) last = t;
+    }
+
+    std::vector<size_t> beats;
+    for (size_t t = last; t != NO_BEAT; t = previous[t]) {
+        beats.push_back(t);
+    }
+    std::reverse(beats.begin(), beats.end());
+    return beats;
+}
+
+int32_t BeatTracker::frameToMs(size_t frame) const {
+    return static_cast<int32_t>(static_cast<int64_t>(frame * HOP_SIZE) * 1000 / m_sampleRate);
+}
+
+} // namespace audio
+} // namespace clipforge
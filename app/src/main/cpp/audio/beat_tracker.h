@@ -0,0 +1,213 @@
+#ifndef CLIPFORGE_BEAT_TRACKER_H
+#define CLIPFORGE_BEAT_TRACKER_H
+
+#include <vector>
+#include <memory>
+#include <span>
+#include <cstdint>
+
+#include "audio_analyzer.h"
+#include "fft_plan.h"
+
+namespace clipforge {
+namespace audio {
+
+/**
+ * @struct BeatGrid
+ * @brief Beats and tempo of a whole track
+ */
+struct BeatGrid {
+    std::vector<BeatInfo> beats;     // In time order; timestamp in milliseconds
+    float bpm = 0.0f;                // Estimated tempo (0 if none was found)
+    float confidence = 0.0f;         // Strength of the tempo estimate (0-1)
+    int32_t durationMs = 0;          // Length of the analyzed audio
+};
+
+/**
+ * @class BeatTracker
+ * @brief Offline beat grid and tempo estimation for whole tracks
+ *
+ * PCM is streamed through push() in chunks of any size. Every HOP_SIZE
+ * samples a FRAME_SIZE window (50% overlap) is taken from a ring buffer
+ * and reduced to one onset strength value: the rectified flux of the
+ * log energies in BAND_COUNT log-spaced bands. Banding (like a mel
+ * spectrum) keeps broadband noise such as hi-hats from outweighing
+ * kicks and bass, and needs one log per band rather than per bin.
+ * finish() then
+ * - estimates the tempo from the autocorrelation of the onset curve,
+ *   weighted towards 120 BPM to avoid picking half or double tempo, and
+ * - places beats by dynamic programming (Ellis 2007), trading onset
+ *   strength against deviation from the beat period, so the grid
+ *   follows small tempo drift.
+ *
+ * Memory grows by one float per hop (about 100 KB for 5 minutes).
+ * Not thread-safe; use one tracker per track.
+ *
+ * Usage:
+ * @code
+ * BeatTracker tracker(44100, 2);
+ * BeatGrid grid = tracker.analyzeTrack(interleavedSamples);
+ * @endcode
+ */
+class BeatTracker {
+public:
+    static constexpr size_t HOP_SIZE = 512;
+    static constexpr size_t FRAME_SIZE = 2 * HOP_SIZE;
+    static constexpr size_t BAND_COUNT = 32;
+
+    // Frames a run must start early for its onsets to match a run from
+    // the start of the track (the ring plus the previous frame's bands)
+    static constexpr size_t WARMUP_FRAMES = FRAME_SIZE / HOP_SIZE;
+
+    /**
+     * @brief Create tracker
+     * @param sampleRate Sample rate in Hz
+     * @param channels Interleaved channels in the input (mixed to mono)
+     */
+    explicit BeatTracker(int sampleRate = 44100, int channels = 2);
+
+    /**
+     * @brief Set the tempo range searched
+     * @param minBpm Slowest tempo (default 60)
+     * @param maxBpm Fastest tempo (default 180)
+     */
+    void setTempoRange(float minBpm, float maxBpm);
+
+    /**
+     * @brief Analyze a complete track in one call
+     * @param samples Interleaved PCM samples
+     * @return Beat grid (the tracker is reset first)
+     */
+    [[nodiscard]] BeatGrid analyzeTrack(std::span<const float> samples);
+
+    /**
+     * @brief Feed the next chunk of the track
+     * @param samples Interleaved PCM samples, any length
+     */
+    void push(std::span<const float> samples);
+
+    /**
+     * @brief Complete the last partial hop with silence
+     *
+     * The onset curve then covers every pushed sample.
+     */
+    void flush();
+
+    /**
+     * @brief Analyze everything pushed so far
+     * @return Beat grid
+     *
+     * Flushes; call reset() before pushing another track.
+     */
+    [[nodiscard]] BeatGrid finish();
+
+    /**
+     * @brief Estimate tempo and beats from a complete onset curve
+     * @param onsets Onset strength per hop, e.g. segments computed in parallel
+     * @param sampleCount Length of the track in (mono) samples
+     * @return Beat grid
+     *
+     * Does not touch the streaming state, so one tracker can analyze
+     * several curves concurrently.
+     */
+    [[nodiscard]] BeatGrid analyzeOnsets(std::span<const float> onsets, int64_t sampleCount) const;
+
+    /**
+     * @brief Discard pushed audio
+     */
+    void reset();
+
+    /**
+     * @brief Get onset strength per hop (frame i is centred on sample i * HOP_SIZE)
+     * @return Onset curve computed so far
+     */
+    [[nodiscard]] const std::vector<float>& getOnsetCurve() const { return m_onsets; }
+
+    /**
+     * @brief Get RMS of the mono mix per hop (hop i covers samples from i * HOP_SIZE)
+     * @return Energy curve computed so far
+     */
+    [[nodiscard]] const std::vector<float>& getEnergyCurve() const { return m_energy; }
+
+    /**
+     * @brief Get sample rate
+     * @return Sample rate in Hz
+     */
+    [[nodiscard]] int getSampleRate() const { return m_sampleRate; }
+
+    /**
+     * @brief Get number of interleaved input channels
+     * @return Channel count
+     */
+    [[nodiscard]] int getChannels() const { return m_channels; }
+
+private:
+    int m_sampleRate;
+    int m_channels;
+    float m_minBpm = 60.0f;
+    float m_maxBpm = 180.0f;
+    std::shared_ptr<const RealFFTPlan> m_plan;
+    std::vector<float> m_window;
+    std::vector<uint32_t> m_bandEdges;  // First bin of each band, plus the end
+
+    // Streaming state
+    std::vector<float> m_ring;          // Last FRAME_SIZE mono samples
+    size_t m_ringPosition = 0;          // Next write index
+    size_t m_pendingSamples = 0;        // Samples since the last frame
+    float m_partialSum = 0.0f;          // Channels seen of an incomplete sample frame
+    int m_partialChannels = 0;
+    int64_t m_totalSamples = 0;         // Mono samples pushed
+    float m_hopSumSquares = 0.0f;       // Of the samples since the last frame
+
+    // Per-frame scratch, reused
+    std::vector<float> m_frame;
+    std::vector<float> m_real;
+    std::vector<float> m_imag;
+    std::vector<float> m_previousLog;   // Log band energies of the last frame
+
+    std::vector<float> m_onsets;        // Onset strength per hop
+    std::vector<float> m_energy;        // RMS per hop
+
+    /**
+     * @brief Append one mono sample, running a frame every HOP_SIZE samples
+     */
+    void pushMono(float sample);
+
+    /**
+     * @brief Compute the onset strength of the frame in the ring buffer
+     */
+    void processFrame();
+
+    /**
+     * @brief Remove the local mean from an onset curve and normalize it
+     * @param onsets Raw onset curve
+     * @return Processed curve
+     */
+    [[nodiscard]] static std::vector<float> normalizedOnsets(std::span<const float> onsets);
+
+    /**
+     * @brief Estimate the beat period from the onset autocorrelation
+     * @param onsets Normalized onset curve
+     * @param confidence Receives the estimate's strength (0-1)
+     * @return Period in hops, 0 if the track is too short or has no onsets
+     */
+    [[nodiscard]] float estimatePeriod(const std::vector<float>& onsets, float& confidence) const;
+
+    /**
+     * @brief Choose beat frames by dynamic programming
+     * @param onsets Normalized onset curve
+     * @param period Beat period in hops
+     * @return Frame index of each beat, in order
+     */
+    [[nodiscard]] static std::vector<size_t> trackBeats(const std::vector<float>& onsets, float period);
+
+    /**
+     * @brief Convert a frame index to milliseconds
+     */
+    [[nodiscard]] int32_t frameToMs(size_t frame) const;
+};
+
+} // namespace audio
+} // namespace clipforge
+
+#endif // CLIPFORGE_BEAT_TRACKER_H
@@ -0,0 +1,196 @@
+#include "fft_plan.h"
+#include "../utils/logger.h"
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace clipforge {
+namespace audio {
+
+namespace {
+
+// Four floats in one SSE/NEON register; GCC and Clang lower the
+// arithmetic operators to vector instructions on both architectures
+typedef float Float4 __attribute__((vector_size(16)));
+
+inline Float4 load4(const float* p) {
+    Float4 v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void store4(float* p, Float4 v) {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+} // namespace
+
+// ============================================================================
+// RealFFTPlan Implementation
+// ============================================================================
+
+std::shared_ptr<const RealFFTPlan> RealFFTPlan::forSize(size_t size) {
+    if (size < 4 || (size & (size - 1)) != 0) {
+        LOG_ERROR("RealFFTPlan: size %zu is not a power of 2 >= 4", size);
+        return nullptr;
+    }
+
+    static std::mutex cacheMutex;
+    static std::map<size_t, std::shared_ptr<const RealFFTPlan>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& plan = cache[size];
+    if (!plan) {
+        plan = std::make_shared<const RealFFTPlan>(size);
+        LOG_DEBUG("RealFFTPlan: created %zu-point plan", size);
+    }
+    return plan;
+}
+
+RealFFTPlan::RealFFTPlan(size_t size)
+    : m_size(size), m_half(size / 2) {
+    // Bit reversal of log2(N/2) bits
+    m_bitReverse.resize(m_half);
+    int bits = 0;
+    while ((size_t{1} << bits) < m_half) bits++;
+    for (size_t i = 0; i < m_half; ++i) {
+        uint32_t reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            reversed |= static_cast<uint32_t>(((i >> b) & 1u) << (bits - 1 - b));
+        }
+        m_bitReverse[i] = reversed;
+    }
+
+    // Stage twiddles exp(-i pi k / h), computed in double for accuracy
+    m_twiddleReal.assign(m_half, 0.0f);
+    m_twiddleImag.assign(m_half, 0.0f);
+    for (size_t h = 1; h < m_half; h *= 2) {
+        for (size_t k = 0; k < h; ++k) {
+            double angle = -M_PI * static_cast<double>(k) / static_cast<double>(h);
+            m_twiddleReal[h + k] = static_cast<float>(std::cos(angle));
+            m_twiddleImag[h + k] = static_cast<float>(std::sin(angle));
+        }
+    }
+
+    m_unpackReal.resize(m_half);
+    m_unpackImag.resize(m_half);
+    for (size_t k = 0; k < m_half; ++k) {
+        double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(m_size);
+        m_unpackReal[k] = static_cast<float>(std::cos(angle));
+        m_unpackImag[k] = static_cast<float>(std::sin(angle));
+    }
+}
+
+void RealFFTPlan::forward(const float* input, const float* window,
+                          float* outReal, float* outImag) const {
+    loadInput(input, window, outReal, outImag);
+    runStages(outReal, outImag);
+    unpack(outReal, outImag);
+}
+
+void RealFFTPlan::loadInput(const float* input, const float* window, float* re, float* im) const {
+    // Even samples become real parts, odd samples imaginary parts
+    for (size_t n = 0; n < m_half; ++n) {
+        uint32_t target = m_bitReverse[n];
+        float even = input[2 * n];
+        float odd = input[2 * n + 1];
+        if (window) {
+            even *= window[2 * n];
+            odd *= window[2 * n + 1];
+        }
+        re[target] = even;
+        im[target] = odd;
+    }
+
+    if (m_half < 4) {
+        // N = 4: a single radix-2 stage
+        float r0 = re[0], i0 = im[0];
+        re[0] = r0 + re[1];
+        im[0] = i0 + im[1];
+        re[1] = r0 - re[1];
+        im[1] = i0 - im[1];
+        return;
+    }
+
+    // Stages 1 and 2 together; their twiddles are 1 and -i
+    for (size_t j = 0; j < m_half; j += 4) {
+        float b0r = re[j] + re[j + 1], b0i = im[j] + im[j + 1];
+        float b1r = re[j] - re[j + 1], b1i = im[j] - im[j + 1];
+        float b2r = re[j + 2] + re[j + 3], b2i = im[j + 2] + im[j + 3];
+        float b3r = re[j + 2] - re[j + 3], b3i = im[j + 2] - im[j + 3];
+
+        re[j] = b0r + b2r;
+        im[j] = b0i + b2i;
+        re[j + 2] = b0r - b2r;
+        im[j + 2] = b0i - b2i;
+        re[j + 1] = b1r + b3i;
+        im[j + 1] = b1i - b3r;
+        re[j + 3] = b1r - b3i;
+        im[j + 3] = b1i + b3r;
+    }
+}
+
+void RealFFTPlan::runStages(float* re, float* im) const {
+    const float* twiddleReal = m_twiddleReal.data();
+    const float* twiddleImag = m_twiddleImag.data();
+
+    // Half-sizes from 4 up are multiples of the vector width
+    for (size_t h = 4; h < m_half; h *= 2) {
+        for (size_t j = 0; j < m_half; j += 2 * h) {
+            float* topReal = re + j;
+            float* topImag = im + j;
+            float* bottomReal = re + j + h;
+            float* bottomImag = im + j + h;
+
+            for (size_t k = 0; k < h; k += 4) {
+                Float4 wr = load4(twiddleReal + h + k);
+                Float4 wi = load4(twiddleImag + h + k);
+                Float4 ar = load4(topReal + k);
+                Float4 ai = load4(topImag + k);
+                Float4 br = load4(bottomReal + k);
+                Float4 bi = load4(bottomImag + k);
+
+                Float4 vr = br * wr - bi * wi;
+                Float4 vi = br * wi + bi * wr;
+
+                store4(topReal + k, ar + vr);
+                store4(topImag + k, ai + vi);
+                store4(bottomReal + k, ar - vr);
+                store4(bottomImag + k, ai - vi);
+            }
+        }
+    }
+}
+
+void RealFFTPlan::unpack(float* re, float* im) const {
+    // DC: sum of the even and odd spectra (the Nyquist bin is not kept)
+    float dc = re[0] + im[0];
+    re[0] = dc;
+    im[0] = 0.0f;
+
+    for (size_t k = 1; k <= m_half / 2; ++k) {
+        size_t mirror = m_half - k;
+        float ar = re[k], ai = im[k];
+        float cr = re[mirror], ci = im[mirror];
+
+        // Spectra of the even and odd samples
+        float evenReal = 0.5f * (ar + cr);
+        float evenImag = 0.5f * (ai - ci);
+        float oddReal = 0.5f * (ai + ci);
+        float oddImag = -0.5f * (ar - cr);
+
+        float wr = m_unpackReal[k];
+        float wi = m_unpackImag[k];
+        float tr = oddReal * wr - oddImag * wi;
+        float ti = oddReal * wi + oddImag * wr;
+
+        re[k] = evenReal + tr;
+        im[k] = evenImag + ti;
+        re[mirror] = evenReal - tr;
+        im[mirror] = -(evenImag - ti);
+    }
+}
+
+} // namespace audio
+} // namespace clipforge
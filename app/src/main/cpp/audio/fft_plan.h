@@ -0,0 +1,95 @@
+#ifndef CLIPFORGE_FFT_PLAN_H
+#define CLIPFORGE_FFT_PLAN_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace clipforge {
+namespace audio {
+
+/**
+ * @class RealFFTPlan
+ * @brief Precomputed tables for a forward FFT of real input
+ *
+ * An N-point real signal is packed into N/2 complex values (even samples
+ * as real parts, odd samples as imaginary parts), transformed with an
+ * iterative radix-2 FFT, and unpacked into bins 0..N/2-1. Bit-reversal
+ * indices and twiddles are computed once per size; forSize() shares
+ * plans between analyzers. Data is kept in split real/imaginary arrays
+ * so butterflies run four at a time (SSE or NEON through the compiler's
+ * vector extensions).
+ *
+ * Plans are immutable and can be used from several threads at once;
+ * each caller provides its own output arrays.
+ *
+ * Usage:
+ * @code
+ * auto plan = RealFFTPlan::forSize(2048);
+ * std::vector<float> re(1024), im(1024);
+ * plan->forward(samples.data(), window.data(), re.data(), im.data());
+ * @endcode
+ */
+class RealFFTPlan {
+public:
+    /**
+     * @brief Get the shared plan for a size, creating it on first use
+     * @param size Transform size (power of 2, at least 4)
+     * @return Plan, or nullptr if the size is invalid
+     */
+    [[nodiscard]] static std::shared_ptr<const RealFFTPlan> forSize(size_t size);
+
+    /**
+     * @brief Build a plan
+     * @param size Transform size (power of 2, at least 4)
+     */
+    explicit RealFFTPlan(size_t size);
+
+    /**
+     * @brief Transform real samples
+     * @param input size() samples
+     * @param window size() coefficients multiplied into the input, or nullptr
+     * @param outReal Receives size() / 2 real parts (bins 0..N/2-1)
+     * @param outImag Receives size() / 2 imaginary parts
+     *
+     * Does not allocate.
+     */
+    void forward(const float* input, const float* window, float* outReal, float* outImag) const;
+
+    /**
+     * @brief Get transform size
+     * @return Number of real input samples
+     */
+    [[nodiscard]] size_t getSize() const { return m_size; }
+
+private:
+    size_t m_size;                          // Real input length N
+    size_t m_half;                          // Complex FFT length N/2
+    std::vector<uint32_t> m_bitReverse;     // Bit-reversed index of each complex input
+    std::vector<float> m_twiddleReal;       // Stage with half-size h uses [h, 2h)
+    std::vector<float> m_twiddleImag;
+    std::vector<float> m_unpackReal;        // exp(-2 pi i k / N) for unpacking
+    std::vector<float> m_unpackImag;
+
+    /**
+     * @brief Load, window and bit-reverse the packed input, then run the
+     *        first two stages as radix-4 butterflies
+     */
+    void loadInput(const float* input, const float* window, float* re, float* im) const;
+
+    /**
+     * @brief Run the remaining radix-2 stages
+     */
+    void runStages(float* re, float* im) const;
+
+    /**
+     * @brief Turn the N/2-point complex spectrum into the real spectrum
+     */
+    void unpack(float* re, float* im) const;
+};
+
+} // namespace audio
+} // namespace clipforge
+
+#endif // CLIPFORGE_FFT_PLAN_H
@@ -0,0 +1,422 @@
+#include "peak_cache.h"
+#include "../utils/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clipforge {
+namespace audio {
+
+namespace {
+
+// ===== File format =====
+//
+// FileHeader, LevelHeader[levelCount], source path, then each level's
+// int16 triples (min, max, rms scaled by 32767) and the uint8 band
+// levels (scaled by 255). Sections start on 8-byte boundaries. Native
+// byte order: the cache never leaves the device.
+
+constexpr char MAGIC[4] = {'C', 'F', 'P', 'K'};
+constexpr uint32_t FORMAT_VERSION = 1;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceModifiedNs;
+    uint32_t pathLength;
+    uint32_t sampleRate;
+    uint32_t channels;
+    uint32_t levelCount;
+    uint64_t sampleCount;
+    uint32_t bandCount;
+    uint32_t spectrogramHop;
+    uint64_t spectrogramColumns;
+    uint64_t spectrogramOffset;
+};
+
+struct LevelHeader {
+    uint32_t blockSize;
+    uint32_t reserved;
+    uint64_t blockCount;
+    uint64_t offset;
+};
+
+constexpr size_t VALUES_PER_BLOCK = 3;     // min, max, rms
+
+size_t alignUp(size_t value) {
+    return (value + 7) & ~size_t{7};
+}
+
+int16_t quantize(float value) {
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+float dequantize(int16_t value) {
+    return static_cast<float>(value) / 32767.0f;
+}
+
+uint64_t hashPath(const std::string& path) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : path) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+// ===== PeakCacheKey Implementation =====
+
+bool PeakCacheKey::fromFile(const std::string& path, PeakCacheKey& key) {
+    struct stat info {};
+    if (stat(path.c_str(), &info) != 0) {
+        LOG_WARNING("PeakCacheKey: cannot stat %s", path.c_str());
+        return false;
+    }
+
+    key.sourcePath = path;
+    key.fileSize = static_cast<uint64_t>(info.st_size);
+    key.modifiedTimeNs = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    return true;
+}
+
+std::string PeakCacheKey::getCacheFileName() const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.cfpk", static_cast<unsigned long long>(hashPath(sourcePath)));
+    return name;
+}
+
+// ===== PeakCacheBuilder Implementation =====
+
+PeakCacheBuilder::PeakCacheBuilder(int sampleRate, int channels, bool withSpectrogram)
+    : m_sampleRate(std::max(sampleRate, 1)), m_channels(std::max(channels, 1)),
+      m_withSpectrogram(withSpectrogram) {
+    if (m_withSpectrogram) {
+        m_analyzer = std::make_unique<FFTAnalyzer>(SPECTROGRAM_HOP, m_sampleRate);
+        m_monoBlock.reserve(SPECTROGRAM_HOP);
+    }
+}
+
+void PeakCacheBuilder::push(std::span<const float> samples) {
+    const size_t channels = static_cast<size_t>(m_channels);
+    const float channelScale = 1.0f / static_cast<float>(m_channels);
+
+    for (float sample : samples) {
+        // A new block starts with the first channel of every BASE_BLOCK-th sample
+        if (m_channelIndex == 0 && m_sampleCount % BASE_BLOCK == 0) {
+            m_blocks.resize(m_blocks.size() + channels);
+        }
+
+        Block& block = m_blocks[m_blocks.size() - channels + m_channelIndex];
+        if (block.count == 0) {
+            block.min = sample;
+            block.max = sample;
+        } else {
+            block.min = std::min(block.min, sample);
+            block.max = std::max(block.max, sample);
+        }
+        block.sumSquares += static_cast<double>(sample) * sample;
+        block.count++;
+
+        if (m_withSpectrogram) {
+            m_monoSum += sample;
+        }
+
+        if (++m_channelIndex == channels) {
+            m_channelIndex = 0;
+            m_sampleCount++;
+
+            if (m_withSpectrogram) {
+                m_monoBlock.push_back(m_monoSum * channelScale);
+                m_monoSum = 0.0f;
+                if (m_monoBlock.size() == static_cast<size_t>(SPECTROGRAM_HOP)) {
+                    addSpectrogramColumn();
+                }
+            }
+        }
+    }
+}
+
+void PeakCacheBuilder::addSpectrogramColumn() {
+    m_analyzer->analyzeInto(m_monoBlock, m_spectrum);
+    for (float level : m_spectrum.bandLevels) {
+        m_bandLevels.push_back(static_cast<uint8_t>(std::lround(std::clamp(level, 0.0f, 1.0f) * 255.0f)));
+    }
+    m_monoBlock.clear();
+}
+
+bool PeakCacheBuilder::write(const std::string& cachePath, const PeakCacheKey& key) {
+    const size_t channels = static_cast<size_t>(m_channels);
+
+    // Analyze the last partial hop (zero-padded by the analyzer)
+    if (m_withSpectrogram && !m_monoBlock.empty()) {
+        addSpectrogramColumn();
+    }
+    const uint32_t bandCount = m_withSpectrogram ? static_cast<uint32_t>(m_spectrum.bandLevels.size()) : 0;
+
+    // Every level in float first, merging LEVEL_FACTOR blocks of the one below
+    std::vector<std::vector<Block>> levels;
+    levels.push_back(m_blocks);
+    for (uint32_t level = 1; level < LEVEL_COUNT; level++) {
+        const std::vector<Block>& below = levels.back();
+        size_t belowBlocks = below.size() / channels;
+        size_t blockCount = (belowBlocks + LEVEL_FACTOR - 1) / LEVEL_FACTOR;
+
+        std::vector<Block> merged(blockCount * channels);
+        for (size_t block = 0; block < blockCount; block++) {
+            for (size_t channel = 0; channel < channels; channel++) {
+                Block& target = merged[block * channels + channel];
+                size_t last = std::min(belowBlocks, (block + 1) * LEVEL_FACTOR);
+                for (size_t source = block * LEVEL_FACTOR; source < last; source++) {
+                    const Block& child = below[source * channels + channel];
+                    target.min = target.count == 0 ? child.min : std::min(target.min, child.min);
+                    target.max = target.count == 0 ? child.max : std::max(target.max, child.max);
+                    target.sumSquares += child.sumSquares;
+                    target.count += child.count;
+                }
+            }
+        }
+        levels.push_back(std::move(merged));
+    }
+
+    // Lay out the file
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.sourceSize = key.fileSize;
+    header.sourceModifiedNs = key.modifiedTimeNs;
+    header.pathLength = static_cast<uint32_t>(key.sourcePath.size());
+    header.sampleRate = static_cast<uint32_t>(m_sampleRate);
+    header.channels = static_cast<uint32_t>(m_channels);
+    header.levelCount = LEVEL_COUNT;
+    header.sampleCount = m_sampleCount;
+    header.bandCount = bandCount;
+    header.spectrogramHop = static_cast<uint32_t>(SPECTROGRAM_HOP);
+    header.spectrogramColumns = bandCount > 0 ? m_bandLevels.size() / bandCount : 0;
+
+    std::vector<LevelHeader> levelHeaders(LEVEL_COUNT);
+    size_t offset = alignUp(sizeof(FileHeader) + sizeof(LevelHeader) * LEVEL_COUNT + key.sourcePath.size());
+    for (uint32_t level = 0; level < LEVEL_COUNT; level++) {
+        levelHeaders[level].blockSize = BASE_BLOCK * static_cast<uint32_t>(std::pow(LEVEL_FACTOR, level));
+        levelHeaders[level].blockCount = levels[level].size() / channels;
+        levelHeaders[level].offset = offset;
+        offset = alignUp(offset + levels[level].size() * VALUES_PER_BLOCK * sizeof(int16_t));
+    }
+    header.spectrogramOffset = offset;
+
+    std::string tempPath = cachePath + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_ERROR("PeakCacheBuilder: cannot create %s", tempPath.c_str());
+        return false;
+    }
+
+    auto padTo = [&file](size_t position) {
+        static const char zeros[8] = {};
+        size_t current = static_cast<size_t>(file.tellp());
+        file.write(zeros, static_cast<std::streamsize>(position - current));
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(levelHeaders.data()),
+               static_cast<std::streamsize>(sizeof(LevelHeader) * levelHeaders.size()));
+    file.write(key.sourcePath.data(), static_cast<std::streamsize>(key.sourcePath.size()));
+
+    std::vector<int16_t> values;
+    for (uint32_t level = 0; level < LEVEL_COUNT; level++) {
+        padTo(levelHeaders[level].offset);
+
+        values.clear();
+        values.reserve(levels[level].size() * VALUES_PER_BLOCK);
+        for (const Block& block : levels[level]) {
+            float rms = block.count > 0
+                ? static_cast<float>(std::sqrt(block.sumSquares / static_cast<double>(block.count))) : 0.0f;
+            values.push_back(quantize(block.min));
+            values.push_back(quantize(block.max));
+            values.push_back(quantize(rms));
+        }
+        file.write(reinterpret_cast<const char*>(values.data()),
+                   static_cast<std::streamsize>(values.size() * sizeof(int16_t)));
+    }
+
+    padTo(header.spectrogramOffset);
+    file.write(reinterpret_cast<const char*>(m_bandLevels.data()),
+               static_cast<std::streamsize>(m_bandLevels.size()));
+    file.close();
+
+    if (!file || std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        LOG_ERROR("PeakCacheBuilder: failed to write %s", cachePath.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    LOG_INFO("PeakCacheBuilder: wrote %s (%zu bytes, %llu samples)", cachePath.c_str(),
+             static_cast<size_t>(header.spectrogramOffset + m_bandLevels.size()),
+             static_cast<unsigned long long>(m_sampleCount));
+    return true;
+}
+
+// ===== PeakCacheFile Implementation =====
+
+std::unique_ptr<PeakCacheFile> PeakCacheFile::open(const std::string& cachePath, const PeakCacheKey& key) {
+    int fd = ::open(cachePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+        close(fd);
+        LOG_WARNING("PeakCacheFile: %s is truncated", cachePath.c_str());
+        return nullptr;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR("PeakCacheFile: cannot map %s", cachePath.c_str());
+        return nullptr;
+    }
+
+    std::unique_ptr<PeakCacheFile> cache(new PeakCacheFile());
+    cache->m_mapping = mapping;
+    cache->m_mappingSize = size;
+
+    const auto* base = static_cast<const uint8_t*>(mapping);
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION) {
+        LOG_WARNING("PeakCacheFile: %s has an unknown format", cachePath.c_str());
+        return nullptr;
+    }
+
+    size_t tableEnd = sizeof(FileHeader) + sizeof(LevelHeader) * header.levelCount;
+    if (header.channels == 0 || header.levelCount == 0 || tableEnd + header.pathLength > size) {
+        LOG_WARNING("PeakCacheFile: %s is corrupt", cachePath.c_str());
+        return nullptr;
+    }
+
+    // Stale if the source changed since the cache was built
+    std::string_view storedPath(reinterpret_cast<const char*>(base + tableEnd), header.pathLength);
+    if (header.sourceSize != key.fileSize || header.sourceModifiedNs != key.modifiedTimeNs ||
+        storedPath != key.sourcePath) {
+        LOG_DEBUG("PeakCacheFile: %s is stale", cachePath.c_str());
+        return nullptr;
+    }
+
+    cache->m_sampleRate = static_cast<int>(header.sampleRate);
+    cache->m_channels = static_cast<int>(header.channels);
+    cache->m_sampleCount = static_cast<int64_t>(header.sampleCount);
+
+    for (uint32_t level = 0; level < header.levelCount; level++) {
+        LevelHeader levelHeader;
+        std::memcpy(&levelHeader, base + sizeof(FileHeader) + sizeof(LevelHeader) * level, sizeof(levelHeader));
+
+        uint64_t bytes = levelHeader.blockCount * header.channels * VALUES_PER_BLOCK * sizeof(int16_t);
+        if (levelHeader.blockSize == 0 || levelHeader.offset % alignof(int16_t) != 0 ||
+            levelHeader.offset > size || bytes > size - levelHeader.offset) {
+            LOG_WARNING("PeakCacheFile: %s has a corrupt level %u", cachePath.c_str(), level);
+            return nullptr;
+        }
+        cache->m_levels.push_back({levelHeader.blockSize, levelHeader.blockCount,
+                                   reinterpret_cast<const int16_t*>(base + levelHeader.offset)});
+    }
+
+    if (header.bandCount > 0) {
+        uint64_t bytes = header.spectrogramColumns * header.bandCount;
+        if (header.spectrogramHop == 0 || header.spectrogramOffset > size ||
+            bytes > size - header.spectrogramOffset) {
+            LOG_WARNING("PeakCacheFile: %s has a corrupt spectrogram", cachePath.c_str());
+            return nullptr;
+        }
+        cache->m_bandCount = header.bandCount;
+        cache->m_spectrogramHop = header.spectrogramHop;
+        cache->m_spectrogramColumns = header.spectrogramColumns;
+        cache->m_spectrogram = base + header.spectrogramOffset;
+    }
+
+    return cache;
+}
+
+PeakCacheFile::~PeakCacheFile() {
+    if (m_mapping) {
+        munmap(m_mapping, m_mappingSize);
+    }
+}
+
+bool PeakCacheFile::getPeaks(int channel, int64_t startSample, int64_t endSample, size_t pixelCount,
+                             std::vector<WaveformPeak>& outPeaks) const {
+    if (channel < 0 || channel >= m_channels || pixelCount == 0 || endSample <= startSample) {
+        return false;
+    }
+    outPeaks.assign(pixelCount, WaveformPeak{});
+
+    // Coarsest level with at least one block per pixel
+    double samplesPerPixel = static_cast<double>(endSample - startSample) / static_cast<double>(pixelCount);
+    const LevelView* level = &m_levels[0];
+    for (const LevelView& candidate : m_levels) {
+        if (static_cast<double>(candidate.blockSize) <= samplesPerPixel) {
+            level = &candidate;
+        }
+    }
+
+    const size_t channels = static_cast<size_t>(m_channels);
+    const int64_t blockSize = level->blockSize;
+    const int64_t blockCount = static_cast<int64_t>(level->blockCount);
+
+    for (size_t pixel = 0; pixel < pixelCount; pixel++) {
+        int64_t first = startSample + static_cast<int64_t>(samplesPerPixel * static_cast<double>(pixel));
+        int64_t last = startSample + static_cast<int64_t>(samplesPerPixel * static_cast<double>(pixel + 1));
+
+        // At least one block, even when zoomed in past the base level
+        int64_t firstBlock = std::max<int64_t>(0, first / blockSize);
+        int64_t lastBlock = std::min(blockCount, std::max(firstBlock + 1, (last + blockSize - 1) / blockSize));
+        if (firstBlock >= lastBlock) continue;
+
+        WaveformPeak& peak = outPeaks[pixel];
+        float sumSquares = 0.0f;
+        for (int64_t block = firstBlock; block < lastBlock; block++) {
+            const int16_t* values = level->values +
+                (static_cast<size_t>(block) * channels + static_cast<size_t>(channel)) * VALUES_PER_BLOCK;
+            float minValue = dequantize(values[0]);
+            float maxValue = dequantize(values[1]);
+            float rms = dequantize(values[2]);
+
+            peak.min = block == firstBlock ? minValue : std::min(peak.min, minValue);
+            peak.max = block == firstBlock ? maxValue : std::max(peak.max, maxValue);
+            sumSquares += rms * rms;
+        }
+        peak.rms = std::sqrt(sumSquares / static_cast<float>(lastBlock - firstBlock));
+    }
+    return true;
+}
+
+bool PeakCacheFile::getBandLevels(int64_t sample, std::vector<float>& outLevels) const {
+    if (!m_spectrogram || m_spectrogramColumns == 0) {
+        return false;
+    }
+
+    uint64_t column = static_cast<uint64_t>(std::max<int64_t>(0, sample)) / m_spectrogramHop;
+    column = std::min(column, m_spectrogramColumns - 1);
+
+    const uint8_t* levels = m_spectrogram + column * m_bandCount;
+    outLevels.resize(m_bandCount);
+    for (uint32_t band = 0; band < m_bandCount; band++) {
+        outLevels[band] = static_cast<float>(levels[band]) / 255.0f;
+    }
+    return true;
+}
+
+} // namespace audio
+} // namespace clipforge
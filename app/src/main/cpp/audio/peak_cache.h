@@ -0,0 +1,222 @@
+#ifndef CLIPFORGE_PEAK_CACHE_H
+#define CLIPFORGE_PEAK_CACHE_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+
+#include "audio_analyzer.h"
+
+namespace clipforge {
+namespace audio {
+
+/**
+ * @struct WaveformPeak
+ * @brief Waveform summary of a range of samples
+ */
+struct WaveformPeak {
+    float min = 0.0f;      // Lowest sample (-1 to 1)
+    float max = 0.0f;      // Highest sample (-1 to 1)
+    float rms = 0.0f;      // Root mean square (0 to 1)
+};
+
+/**
+ * @struct PeakCacheKey
+ * @brief Identifies the source a cache file was built from
+ *
+ * A cache is only used when the source's path, size and modification
+ * time all match, so edited or replaced files are re-analyzed.
+ */
+struct PeakCacheKey {
+    std::string sourcePath;
+    uint64_t fileSize = 0;
+    int64_t modifiedTimeNs = 0;
+
+    /**
+     * @brief Build the key of a file on disk
+     * @param path Source audio file
+     * @param key Receives the key
+     * @return true if the file could be stat'ed
+     */
+    static bool fromFile(const std::string& path, PeakCacheKey& key);
+
+    /**
+     * @brief Get the cache file name for this source
+     * @return Hash of the path plus extension, e.g. "3f2a...c1.cfpk"
+     */
+    [[nodiscard]] std::string getCacheFileName() const;
+};
+
+/**
+ * @class PeakCacheBuilder
+ * @brief Builds a peak cache file from decoded PCM
+ *
+ * Samples are streamed through push(). Min/max/RMS is kept per channel
+ * for blocks of BASE_BLOCK samples; each further level merges LEVEL_FACTOR
+ * blocks of the one below (256, 1024, ... 65536 samples), so any zoom
+ * reads at most a few entries per pixel. With the spectrogram enabled,
+ * the mono mix is also cut into SPECTROGRAM_HOP blocks whose
+ * FFTAnalyzer band levels are stored as 8-bit values.
+ *
+ * Usage:
+ * @code
+ * PeakCacheBuilder builder(44100, 2, true);
+ * while (decoder.read(chunk)) builder.push(chunk);
+ * builder.write(cacheDir + "/" + key.getCacheFileName(), key);
+ * @endcode
+ */
+class PeakCacheBuilder {
+public:
+    static constexpr uint32_t BASE_BLOCK = 256;
+    static constexpr uint32_t LEVEL_FACTOR = 4;
+    static constexpr uint32_t LEVEL_COUNT = 5;
+    static constexpr int SPECTROGRAM_HOP = 2048;    // Also the FFT size
+
+    /**
+     * @brief Create builder
+     * @param sampleRate Sample rate in Hz
+     * @param channels Interleaved channels in the input
+     * @param withSpectrogram Also store band levels over time
+     */
+    PeakCacheBuilder(int sampleRate, int channels, bool withSpectrogram = false);
+
+    /**
+     * @brief Add the next chunk of the track
+     * @param samples Interleaved PCM samples, any length
+     */
+    void push(std::span<const float> samples);
+
+    /**
+     * @brief Write the cache file
+     * @param cachePath Destination; written to a temporary file, then renamed
+     * @param key Source the samples came from
+     * @return true if the file was written
+     */
+    bool write(const std::string& cachePath, const PeakCacheKey& key);
+
+private:
+    /**
+     * @struct Block
+     * @brief Running summary of one block of one channel
+     */
+    struct Block {
+        float min = 0.0f;
+        float max = 0.0f;
+        double sumSquares = 0.0;
+        uint32_t count = 0;
+    };
+
+    int m_sampleRate;
+    int m_channels;
+    uint64_t m_sampleCount = 0;
+    size_t m_channelIndex = 0;           // Next channel in the interleaved input
+    std::vector<Block> m_blocks;         // BASE_BLOCK blocks, channel-interleaved
+
+    bool m_withSpectrogram;
+    std::unique_ptr<FFTAnalyzer> m_analyzer;
+    AudioSpectrum m_spectrum;
+    std::vector<float> m_monoBlock;      // Mono mix of the current hop
+    float m_monoSum = 0.0f;              // Channels of the current sample
+    std::vector<uint8_t> m_bandLevels;   // Columns of FFT band levels
+
+    /**
+     * @brief Analyze a full mono hop into one spectrogram column
+     */
+    void addSpectrogramColumn();
+};
+
+/**
+ * @class PeakCacheFile
+ * @brief Read-only, memory-mapped peak cache
+ *
+ * Opening maps the file and checks its header; peaks are then read
+ * straight from the mapping without decoding or copying the file.
+ * Instances are immutable and safe to share between threads.
+ *
+ * Usage:
+ * @code
+ * auto cache = PeakCacheFile::open(path, key);
+ * if (cache) cache->getPeaks(0, start, end, widthPixels, peaks);
+ * @endcode
+ */
+class PeakCacheFile {
+public:
+    /**
+     * @brief Map a cache file
+     * @param cachePath File written by PeakCacheBuilder
+     * @param key Expected source; a mismatch means the cache is stale
+     * @return Cache, or nullptr if missing, stale or corrupt
+     */
+    [[nodiscard]] static std::unique_ptr<PeakCacheFile> open(const std::string& cachePath,
+                                                             const PeakCacheKey& key);
+
+    /**
+     * @brief Destructor - unmaps the file
+     */
+    ~PeakCacheFile();
+
+    // Prevent copying
+    PeakCacheFile(const PeakCacheFile&) = delete;
+    PeakCacheFile& operator=(const PeakCacheFile&) = delete;
+
+    /**
+     * @brief Get waveform peaks for display
+     * @param channel Channel index
+     * @param startSample First sample of the range
+     * @param endSample End of the range (exclusive)
+     * @param pixelCount Number of peaks wanted
+     * @param outPeaks Receives pixelCount peaks
+     * @return false if the channel or range is invalid
+     *
+     * Uses the coarsest level that still has a block per pixel.
+     */
+    bool getPeaks(int channel, int64_t startSample, int64_t endSample, size_t pixelCount,
+                  std::vector<WaveformPeak>& outPeaks) const;
+
+    /**
+     * @brief Get the band levels around a position
+     * @param sample Sample position
+     * @param outLevels Receives one level per FrequencyBand (0-1)
+     * @return false if there is no spectrogram
+     */
+    bool getBandLevels(int64_t sample, std::vector<float>& outLevels) const;
+
+    [[nodiscard]] int getSampleRate() const { return m_sampleRate; }
+    [[nodiscard]] int getChannels() const { return m_channels; }
+    [[nodiscard]] int64_t getSampleCount() const { return m_sampleCount; }
+    [[nodiscard]] bool hasSpectrogram() const { return m_bandCount > 0; }
+
+private:
+    /**
+     * @struct LevelView
+     * @brief One zoom level inside the mapping
+     */
+    struct LevelView {
+        uint32_t blockSize;
+        uint64_t blockCount;
+        const int16_t* values;           // min, max, rms per block and channel
+    };
+
+    void* m_mapping = nullptr;
+    size_t m_mappingSize = 0;
+
+    int m_sampleRate = 0;
+    int m_channels = 0;
+    int64_t m_sampleCount = 0;
+    std::vector<LevelView> m_levels;
+
+    uint32_t m_bandCount = 0;
+    uint32_t m_spectrogramHop = 0;
+    uint64_t m_spectrogramColumns = 0;
+    const uint8_t* m_spectrogram = nullptr;
+
+    PeakCacheFile() = default;
+};
+
+} // namespace audio
+} // namespace clipforge
+
+#endif // CLIPFORGE_PEAK_CACHE_H
@@ -0,0 +1,134 @@
+#include "frame_buffer.h"
+#include "../utils/logger.h"
+#include <cstddef>
+#include <iterator>
+
+namespace clipforge {
+namespace core {
+
+// ============================================================================
+// FrameBuffer Implementation
+// ============================================================================
+
+FrameBuffer::FrameBuffer(int32_t width, int32_t height, int32_t bytesPerPixel)
+    : m_width(width), m_height(height), m_bytesPerPixel(bytesPerPixel),
+      m_data(static_cast<size_t>(width) * static_cast<size_t>(height) *
+             static_cast<size_t>(bytesPerPixel)) {
+}
+
+void FrameBuffer::reshape(int32_t width, int32_t height, int32_t bytesPerPixel) {
+    m_width = width;
+    m_height = height;
+    m_bytesPerPixel = bytesPerPixel;
+}
+
+// ============================================================================
+// FramePool Implementation
+// ============================================================================
+
+FramePool::FramePool(size_t maxFreeBuffers)
+    : m_shared(std::make_shared<Shared>()) {
+    m_shared->m_maxFreeBuffers = maxFreeBuffers;
+}
+
+FramePool::~FramePool() {
+    std::lock_guard<std::mutex> lock(m_shared->m_mutex);
+    m_shared->m_closed = true;
+    m_shared->releaseIdle(0);
+}
+
+FrameBufferPtr FramePool::acquire(int32_t width, int32_t height, int32_t bytesPerPixel) {
+    if (width <= 0 || height <= 0 || bytesPerPixel <= 0) {
+        return nullptr;
+    }
+
+    size_t bytes = static_cast<size_t>(width) * static_cast<size_t>(height) *
+                   static_cast<size_t>(bytesPerPixel);
+
+    std::unique_ptr<FrameBuffer> buffer;
+    {
+        std::lock_guard<std::mutex> lock(m_shared->m_mutex);
+        auto& freeBuffers = m_shared->m_freeBuffers;
+
+        // Most recently released first, as it is the likeliest to be cached
+        for (auto it = freeBuffers.rbegin(); it != freeBuffers.rend(); ++it) {
+            if ((*it)->size() == bytes) {
+                buffer = std::move(*it);
+                freeBuffers.erase(std::next(it).base());
+                buffer->reshape(width, height, bytesPerPixel);
+                m_shared->m_reuses++;
+                break;
+            }
+        }
+
+        if (!buffer) {
+            // Frame size changed (e.g. new preview resolution): drop idle
+            // buffers of the old size before growing the pool
+            size_t maxFree = m_shared->m_maxFreeBuffers;
+            m_shared->releaseIdle(maxFree > 0 ? maxFree - 1 : 0);
+            m_shared->m_allocations++;
+        }
+        m_shared->m_buffersInUse++;
+        m_shared->m_bytesInUse += bytes;
+    }
+
+    if (!buffer) {
+        buffer = std::make_unique<FrameBuffer>(width, height, bytesPerPixel);
+        LOG_DEBUG("FramePool allocated %dx%d buffer", width, height);
+    }
+
+    std::shared_ptr<Shared> shared = m_shared;
+    return FrameBufferPtr(buffer.release(), [shared](FrameBuffer* released) { shared->release(released); });
+}
+
+void FramePool::trim() {
+    std::lock_guard<std::mutex> lock(m_shared->m_mutex);
+    m_shared->releaseIdle(m_shared->m_maxFreeBuffers);
+}
+
+void FramePool::clear() {
+    std::lock_guard<std::mutex> lock(m_shared->m_mutex);
+    m_shared->releaseIdle(0);
+}
+
+FramePoolStats FramePool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_shared->m_mutex);
+    FramePoolStats stats;
+    stats.allocations = m_shared->m_allocations;
+    stats.reuses = m_shared->m_reuses;
+    stats.buffersInUse = m_shared->m_buffersInUse;
+    stats.buffersFree = m_shared->m_freeBuffers.size();
+    stats.bytesPooled = m_shared->m_bytesInUse;
+    for (const auto& buffer : m_shared->m_freeBuffers) {
+        stats.bytesPooled += buffer->size();
+    }
+    return stats;
+}
+
+void FramePool::Shared::release(FrameBuffer* buffer) {
+    // Freed after the lock is released
+    std::unique_ptr<FrameBuffer> owned(buffer);
+    std::unique_ptr<FrameBuffer> evicted;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffersInUse--;
+    m_bytesInUse -= owned->size();
+    if (m_closed || m_maxFreeBuffers == 0) {
+        return;
+    }
+    if (m_freeBuffers.size() >= m_maxFreeBuffers) {
+        evicted = std::move(m_freeBuffers.front());
+        m_freeBuffers.erase(m_freeBuffers.begin());
+    }
+    m_freeBuffers.push_back(std::move(owned));
+}
+
+void FramePool::Shared::releaseIdle(size_t keep) {
+    if (m_freeBuffers.size() > keep) {
+        m_freeBuffers.erase(m_freeBuffers.begin(),
+                            m_freeBuffers.begin() + static_cast<std::ptrdiff_t>(m_freeBuffers.size() - keep));
+    }
+}
+
+} // namespace core
+} // namespace clipforge
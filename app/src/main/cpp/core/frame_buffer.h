@@ -0,0 +1,179 @@
+#ifndef CLIPFORGE_FRAME_BUFFER_H
+#define CLIPFORGE_FRAME_BUFFER_H
+
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+namespace clipforge {
+namespace core {
+
+/**
+ * @class FrameBuffer
+ * @brief Pixel storage for one frame
+ *
+ * Handed out by FramePool as a shared FrameBufferPtr. A buffer is
+ * written once by its producer and treated as read-only after it has
+ * been published, so any number of consumers can borrow it without
+ * copying.
+ */
+class FrameBuffer {
+public:
+    /**
+     * @brief Allocate storage for a frame
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param bytesPerPixel Bytes per pixel (4 for RGBA8)
+     */
+    FrameBuffer(int32_t width, int32_t height, int32_t bytesPerPixel);
+
+    // Prevent copying
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+    /**
+     * @brief Get writable pixel data
+     * @return Pointer to first byte
+     */
+    [[nodiscard]] uint8_t* data() { return m_data.data(); }
+
+    /**
+     * @brief Get pixel data
+     * @return Pointer to first byte
+     */
+    [[nodiscard]] const uint8_t* data() const { return m_data.data(); }
+
+    /**
+     * @brief Get size of pixel data
+     * @return Size in bytes
+     */
+    [[nodiscard]] size_t size() const { return m_data.size(); }
+
+    [[nodiscard]] int32_t getWidth() const { return m_width; }
+    [[nodiscard]] int32_t getHeight() const { return m_height; }
+
+    /**
+     * @brief Get bytes per row
+     * @return Row stride in bytes
+     */
+    [[nodiscard]] int32_t getStride() const { return m_width * m_bytesPerPixel; }
+
+    [[nodiscard]] int32_t getBytesPerPixel() const { return m_bytesPerPixel; }
+
+private:
+    friend class FramePool;
+
+    int32_t m_width;
+    int32_t m_height;
+    int32_t m_bytesPerPixel;
+    std::vector<uint8_t> m_data;
+
+    /**
+     * @brief Reinterpret storage for new dimensions of the same byte size
+     */
+    void reshape(int32_t width, int32_t height, int32_t bytesPerPixel);
+};
+
+using FrameBufferPtr = std::shared_ptr<FrameBuffer>;
+
+/**
+ * @struct FramePoolStats
+ * @brief Frame pool counters
+ */
+struct FramePoolStats {
+    int64_t allocations = 0;       // Buffers allocated from the heap
+    int64_t reuses = 0;            // Acquires served by a recycled buffer
+    size_t buffersInUse = 0;       // Buffers currently borrowed
+    size_t buffersFree = 0;        // Buffers ready for reuse
+    size_t bytesPooled = 0;        // Pixel bytes owned by the pool
+};
+
+/**
+ * @class FramePool
+ * @brief Recycling pool of frame buffers
+ *
+ * Borrowed buffers carry a deleter that puts them back on the pool's
+ * free list when the last reference is dropped, and the next acquire()
+ * of the same byte size reuses them. The free list is capped, so
+ * dropping many frames at once (e.g. clearing the preview cache) does
+ * not leave them all pooled. Steady state acquires allocate no
+ * pixel storage, only the small reference count block.
+ *
+ * Buffers may outlive the pool; they are freed when released after it.
+ *
+ * Thread-safe.
+ */
+class FramePool {
+public:
+    /**
+     * @brief Create a pool
+     * @param maxFreeBuffers Idle buffers kept for reuse before trimming
+     */
+    explicit FramePool(size_t maxFreeBuffers = 8);
+
+    ~FramePool();
+
+    // Prevent copying
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    /**
+     * @brief Borrow a buffer for a frame
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param bytesPerPixel Bytes per pixel (4 for RGBA8)
+     * @return Buffer with unspecified contents, or nullptr for empty dimensions
+     */
+    [[nodiscard]] FrameBufferPtr acquire(int32_t width, int32_t height, int32_t bytesPerPixel = 4);
+
+    /**
+     * @brief Release idle buffers beyond the free limit
+     */
+    void trim();
+
+    /**
+     * @brief Release all idle buffers
+     */
+    void clear();
+
+    /**
+     * @brief Get pool counters
+     * @return Snapshot of statistics
+     */
+    [[nodiscard]] FramePoolStats getStats() const;
+
+private:
+    /**
+     * @struct Shared
+     * @brief Pool state, shared with the deleters of borrowed buffers
+     */
+    struct Shared {
+        std::mutex m_mutex;
+        std::vector<std::unique_ptr<FrameBuffer>> m_freeBuffers;   // Oldest first
+        size_t m_buffersInUse = 0;
+        size_t m_bytesInUse = 0;
+        int64_t m_allocations = 0;
+        int64_t m_reuses = 0;
+        size_t m_maxFreeBuffers = 0;    // Idle buffers kept; the oldest beyond it are freed
+        bool m_closed = false;          // Pool destroyed; returned buffers are freed
+
+        /**
+         * @brief Take back a borrowed buffer
+         */
+        void release(FrameBuffer* buffer);
+
+        /**
+         * @brief Drop the oldest idle buffers until at most a number remain (m_mutex held)
+         * @param keep Idle buffers to keep
+         */
+        void releaseIdle(size_t keep);
+    };
+
+    std::shared_ptr<Shared> m_shared;
+};
+
+} // namespace core
+} // namespace clipforge
+
+#endif // CLIPFORGE_FRAME_BUFFER_H
@@ -0,0 +1,129 @@
+#include "preview_cache.h"
+#include "../utils/logger.h"
+#include <functional>
+#include <iterator>
+
+namespace clipforge {
+namespace core {
+
+// ============================================================================
+// PreviewCache Implementation
+// ============================================================================
+
+size_t PreviewCache::KeyHash::operator()(const PreviewCacheKey& key) const {
+    size_t h = std::hash<uint64_t>()(key.revision);
+    h ^= std::hash<int64_t>()(key.frameIndex) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int32_t>()(key.height) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+PreviewCache::PreviewCache(size_t capacityBytes)
+    : m_capacityBytes(capacityBytes) {
+    m_stats.capacityBytes = capacityBytes;
+}
+
+void PreviewCache::setCapacity(size_t capacityBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacityBytes = capacityBytes;
+    m_stats.capacityBytes = capacityBytes;
+    evictTo(capacityBytes);
+    LOG_DEBUG("Preview cache capacity set to %zu bytes", capacityBytes);
+}
+
+bool PreviewCache::get(const PreviewCacheKey& key, PreviewFrame& outFrame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        m_stats.misses++;
+        return false;
+    }
+
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    m_stats.hits++;
+    outFrame = it->second->frame;
+    return true;
+}
+
+bool PreviewCache::put(const PreviewCacheKey& key, const PreviewFrame& frame, uint64_t epoch) {
+    if (!frame.buffer) return false;
+
+    size_t bytes = frame.buffer->size();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Rendered across an edit: pixels may predate the change
+    if (epoch != m_epoch || bytes > m_capacityBytes) {
+        return false;
+    }
+
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        erase(it->second);
+    }
+
+    evictTo(m_capacityBytes - bytes);
+
+    m_lru.push_front(Entry{key, frame, bytes});
+    m_index[key] = m_lru.begin();
+    m_bytesUsed += bytes;
+    return true;
+}
+
+uint64_t PreviewCache::getEpoch() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_epoch;
+}
+
+void PreviewCache::invalidateRange(int64_t startMs, int64_t endMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_epoch++;
+
+    int64_t dropped = 0;
+    for (auto it = m_lru.begin(); it != m_lru.end();) {
+        int64_t timestampMs = it->frame.timestampMs;
+        if (timestampMs >= startMs && timestampMs <= endMs) {
+            it = erase(it);
+            dropped++;
+        } else {
+            ++it;
+        }
+    }
+
+    m_stats.invalidations += dropped;
+    LOG_DEBUG("Preview cache invalidated %lld frames in %lld-%lld ms",
+              static_cast<long long>(dropped), static_cast<long long>(startMs),
+              static_cast<long long>(endMs));
+}
+
+void PreviewCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_epoch++;
+    m_stats.invalidations += static_cast<int64_t>(m_lru.size());
+    m_lru.clear();
+    m_index.clear();
+    m_bytesUsed = 0;
+}
+
+PreviewCacheStats PreviewCache::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PreviewCacheStats stats = m_stats;
+    stats.entryCount = m_lru.size();
+    stats.bytesUsed = m_bytesUsed;
+    return stats;
+}
+
+void PreviewCache::evictTo(size_t budget) {
+    while (m_bytesUsed > budget && !m_lru.empty()) {
+        erase(std::prev(m_lru.end()));
+        m_stats.evictions++;
+    }
+}
+
+PreviewCache::EntryList::iterator PreviewCache::erase(EntryList::iterator it) {
+    m_bytesUsed -= it->bytes;
+    m_index.erase(it->key);
+    return m_lru.erase(it);
+}
+
+} // namespace core
+} // namespace clipforge
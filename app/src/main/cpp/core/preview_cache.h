@@ -0,0 +1,166 @@
+#ifndef CLIPFORGE_PREVIEW_CACHE_H
+#define CLIPFORGE_PREVIEW_CACHE_H
+
+#include <memory>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+#include "preview_scheduler.h"
+
+namespace clipforge {
+namespace core {
+
+/**
+ * @struct PreviewCacheKey
+ * @brief Identifies one rendered preview frame
+ */
+struct PreviewCacheKey {
+    uint64_t revision = 0;         // Timeline revision the frame was rendered from
+    int64_t frameIndex = 0;        // Frame number on the timeline
+    int32_t height = 0;            // Preview resolution (lines)
+
+    bool operator==(const PreviewCacheKey& other) const {
+        return revision == other.revision && frameIndex == other.frameIndex &&
+               height == other.height;
+    }
+};
+
+/**
+ * @struct PreviewCacheStats
+ * @brief Preview cache counters
+ */
+struct PreviewCacheStats {
+    int64_t hits = 0;              // Lookups served from the cache
+    int64_t misses = 0;            // Lookups that required a render
+    int64_t evictions = 0;         // Frames evicted to stay within budget
+    int64_t invalidations = 0;     // Frames discarded because of edits
+    size_t entryCount = 0;         // Frames currently cached
+    size_t bytesUsed = 0;          // Pixel bytes currently cached
+    size_t capacityBytes = 0;      // Byte budget
+};
+
+/**
+ * @class PreviewCache
+ * @brief Byte-budgeted LRU cache of rendered preview frames
+ *
+ * Frames are kept in a recency list with a hash index into it, so
+ * lookup, insertion and eviction of the least recently used frame are
+ * all O(1). Edits invalidate only the frames whose timestamps fall in
+ * the time span they touched.
+ *
+ * Every invalidation bumps an epoch. A renderer reads the epoch before
+ * rendering and passes it to put(); frames rendered across an
+ * invalidation are rejected so stale pixels never enter the cache.
+ *
+ * Thread-safe.
+ */
+class PreviewCache {
+public:
+    /**
+     * @brief Create a cache
+     * @param capacityBytes Pixel byte budget (0 disables caching)
+     */
+    explicit PreviewCache(size_t capacityBytes = 0);
+
+    // Prevent copying
+    PreviewCache(const PreviewCache&) = delete;
+    PreviewCache& operator=(const PreviewCache&) = delete;
+
+    // ===== Configuration =====
+
+    /**
+     * @brief Set byte budget, evicting frames if it shrank
+     * @param capacityBytes Pixel byte budget (0 disables caching)
+     */
+    void setCapacity(size_t capacityBytes);
+
+    // ===== Access =====
+
+    /**
+     * @brief Look up a frame and mark it most recently used
+     * @param key Frame key
+     * @param outFrame Receives the frame, sharing its pixel buffer
+     * @return true on a hit
+     */
+    bool get(const PreviewCacheKey& key, PreviewFrame& outFrame);
+
+    /**
+     * @brief Insert a rendered frame
+     * @param key Frame key
+     * @param frame Rendered frame; its buffer must not be written afterwards
+     * @param epoch Value of getEpoch() read before rendering started
+     * @return true if the frame was cached
+     */
+    bool put(const PreviewCacheKey& key, const PreviewFrame& frame, uint64_t epoch);
+
+    /**
+     * @brief Get the invalidation epoch
+     * @return Counter bumped by every invalidation
+     */
+    [[nodiscard]] uint64_t getEpoch() const;
+
+    // ===== Invalidation =====
+
+    /**
+     * @brief Drop frames whose timestamp lies in [startMs, endMs]
+     * @param startMs Range start in milliseconds
+     * @param endMs Range end in milliseconds
+     */
+    void invalidateRange(int64_t startMs, int64_t endMs);
+
+    /**
+     * @brief Drop all frames
+     */
+    void clear();
+
+    // ===== Statistics =====
+
+    /**
+     * @brief Get cache counters
+     * @return Snapshot of statistics
+     */
+    [[nodiscard]] PreviewCacheStats getStats() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const PreviewCacheKey& key) const;
+    };
+
+    struct Entry {
+        PreviewCacheKey key;
+        PreviewFrame frame;
+        size_t bytes = 0;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    size_t m_capacityBytes;
+    size_t m_bytesUsed = 0;
+    uint64_t m_epoch = 0;
+
+    EntryList m_lru;  // Most recently used first
+    std::unordered_map<PreviewCacheKey, EntryList::iterator, KeyHash> m_index;
+
+    PreviewCacheStats m_stats;
+    mutable std::mutex m_mutex;
+
+    /**
+     * @brief Evict least recently used frames until within budget
+     * @param budget Byte budget to satisfy
+     */
+    void evictTo(size_t budget);
+
+    /**
+     * @brief Remove an entry
+     * @param it Entry to remove
+     * @return Iterator to the following entry
+     */
+    EntryList::iterator erase(EntryList::iterator it);
+};
+
+} // namespace core
+} // namespace clipforge
+
+#endif // CLIPFORGE_PREVIEW_CACHE_H
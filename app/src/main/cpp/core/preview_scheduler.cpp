@@ -0,0 +1,219 @@
+#include "preview_scheduler.h"
+#include "../utils/logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace clipforge {
+namespace core {
+
+// ============================================================================
+// PreviewScheduler Implementation
+// ============================================================================
+
+PreviewScheduler::PreviewScheduler(size_t queueCapacity)
+    : m_queueCapacity(std::max<size_t>(1, queueCapacity)) {
+    LOG_DEBUG("PreviewScheduler created (queue capacity %zu)", m_queueCapacity);
+}
+
+PreviewScheduler::~PreviewScheduler() {
+    stop();
+}
+
+bool PreviewScheduler::start(FrameSource source, float frameRate, int64_t startMs, int64_t endMs,
+                             PresentCallback onPresent, FinishedCallback onFinished) {
+    if (!source || frameRate <= 0.0f || endMs < startMs) {
+        LOG_ERROR("PreviewScheduler: invalid start parameters (fps %.2f, %lld-%lld ms)",
+                  frameRate, static_cast<long long>(startMs), static_cast<long long>(endMs));
+        return false;
+    }
+
+    stop();
+
+    m_source = std::move(source);
+    m_presentCallback = std::move(onPresent);
+    m_finishedCallback = std::move(onFinished);
+    m_frameRate = frameRate;
+    m_firstFrame = timeToFrame(startMs, frameRate);
+    m_lastFrame = timeToFrame(endMs, frameRate);
+    m_presentFrame = m_firstFrame;
+    m_positionMs = startMs;
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queue.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats = PreviewStats{};
+        m_jitterSumMs = 0.0;
+    }
+
+    m_running = true;
+    m_renderThread = std::make_unique<std::thread>(&PreviewScheduler::renderLoop, this);
+    m_presentThread = std::make_unique<std::thread>(&PreviewScheduler::presentLoop, this);
+
+    LOG_DEBUG("PreviewScheduler started: frames %lld-%lld @ %.2f fps",
+              static_cast<long long>(m_firstFrame), static_cast<long long>(m_lastFrame), frameRate);
+    return true;
+}
+
+void PreviewScheduler::stop() {
+    m_running = false;
+    m_queueNotFull.notify_all();
+
+    // A callback may call stop() from the presentation thread; it cannot join itself
+    auto self = std::this_thread::get_id();
+    for (auto* thread : {&m_renderThread, &m_presentThread}) {
+        if (*thread && (*thread)->joinable() && (*thread)->get_id() != self) {
+            (*thread)->join();
+            thread->reset();
+        }
+    }
+}
+
+PreviewStats PreviewScheduler::getStats() const {
+    PreviewStats stats;
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        stats = m_stats;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        stats.queueDepth = m_queue.size();
+    }
+    return stats;
+}
+
+int64_t PreviewScheduler::timeToFrame(int64_t timeMs, float frameRate) {
+    return static_cast<int64_t>(std::floor(static_cast<double>(timeMs) *
+                                           static_cast<double>(frameRate) / 1000.0));
+}
+
+int64_t PreviewScheduler::frameToTime(int64_t frameIndex, float frameRate) {
+    return static_cast<int64_t>(std::llround(static_cast<double>(frameIndex) * 1000.0 /
+                                             static_cast<double>(frameRate)));
+}
+
+void PreviewScheduler::renderLoop() {
+    int64_t next = m_firstFrame;
+
+    while (m_running && next <= m_lastFrame) {
+        // Never render frames the presenter has already moved past
+        next = std::max(next, m_presentFrame.load());
+
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueNotFull.wait(lock, [this] {
+                return !m_running || m_queue.size() < m_queueCapacity;
+            });
+        }
+        if (!m_running) break;
+
+        PreviewFrame frame;
+        int64_t timestampMs = frameToTime(next, m_frameRate);
+        if (m_source(next, timestampMs, frame)) {
+            frame.frameIndex = next;
+            frame.timestampMs = timestampMs;
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                m_queue.push_back(std::move(frame));
+            }
+            std::lock_guard<std::mutex> lock(m_statsMutex);
+            m_stats.framesRendered++;
+        }
+        ++next;
+    }
+
+    LOG_DEBUG("PreviewScheduler render loop exited");
+}
+
+void PreviewScheduler::presentLoop() {
+    using Seconds = std::chrono::duration<double>;
+    const Seconds frameDuration(1.0 / static_cast<double>(m_frameRate));
+    const auto origin = Clock::now();
+
+    int64_t tick = 0;  // Deadline number relative to the first frame
+    int64_t lastPresented = m_firstFrame - 1;
+    bool reachedEnd = false;
+
+    while (m_running) {
+        auto deadline = origin + std::chrono::duration_cast<Clock::duration>(frameDuration * tick);
+        std::this_thread::sleep_until(deadline);
+        if (!m_running) break;
+
+        // If we woke past later deadlines, skip straight to the current one
+        auto now = Clock::now();
+        auto missed = static_cast<int64_t>(Seconds(now - deadline) / frameDuration);
+        if (missed > 0) {
+            tick += missed;
+            deadline = origin + std::chrono::duration_cast<Clock::duration>(frameDuration * tick);
+        }
+
+        int64_t target = m_firstFrame + tick;
+        if (target > m_lastFrame) {
+            reachedEnd = true;
+            break;
+        }
+        m_presentFrame = target;
+
+        // Present the newest frame due by now; anything older is dropped
+        PreviewFrame frame;
+        bool haveFrame = false;
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            while (!m_queue.empty() && m_queue.front().frameIndex <= target) {
+                frame = std::move(m_queue.front());
+                m_queue.pop_front();
+                haveFrame = true;
+            }
+        }
+        m_queueNotFull.notify_all();
+
+        {
+            std::lock_guard<std::mutex> lock(m_statsMutex);
+            if (haveFrame) {
+                // Indices passed since the last presented frame, overslept or overtaken
+                m_stats.framesDropped += frame.frameIndex - lastPresented - 1;
+                lastPresented = frame.frameIndex;
+                m_stats.framesPresented++;
+            } else {
+                m_stats.framesRepeated++;  // Previous frame stays on screen
+            }
+        }
+        recordJitter(std::chrono::duration<double, std::milli>(Clock::now() - deadline).count());
+
+        m_positionMs = frameToTime(target, m_frameRate);
+        if (haveFrame && m_presentCallback) {
+            m_presentCallback(frame);
+        }
+
+        ++tick;
+    }
+
+    bool finished = reachedEnd && m_running.exchange(false);
+    m_queueNotFull.notify_all();
+
+    if (reachedEnd) {
+        // Frames at the end of the range that were never shown
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats.framesDropped += m_lastFrame - lastPresented;
+    }
+
+    if (finished) {
+        LOG_DEBUG("PreviewScheduler reached end of range");
+        if (m_finishedCallback) {
+            m_finishedCallback();
+        }
+    }
+}
+
+void PreviewScheduler::recordJitter(double jitterMs) {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_jitterSumMs += jitterMs;
+    int64_t samples = m_stats.framesPresented + m_stats.framesRepeated;
+    m_stats.meanJitterMs = samples > 0 ? m_jitterSumMs / static_cast<double>(samples) : 0.0;
+    m_stats.maxJitterMs = std::max(m_stats.maxJitterMs, jitterMs);
+}
+
+} // namespace core
+} // namespace clipforge
@@ -0,0 +1,209 @@
+#ifndef CLIPFORGE_PREVIEW_SCHEDULER_H
+#define CLIPFORGE_PREVIEW_SCHEDULER_H
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+#include "frame_buffer.h"
+
+namespace clipforge {
+namespace core {
+
+/**
+ * @struct PreviewFrame
+ * @brief A rendered preview frame ready for presentation
+ *
+ * Copying a PreviewFrame shares its pixel buffer rather than the pixels.
+ */
+struct PreviewFrame {
+    int64_t frameIndex = -1;       // Frame number on the timeline
+    int64_t timestampMs = 0;       // Presentation time (ms)
+    FrameBufferPtr buffer;         // RGBA8 pixel data and dimensions
+};
+
+/**
+ * @struct PreviewStats
+ * @brief Playback quality counters for a preview session
+ */
+struct PreviewStats {
+    int64_t framesRendered = 0;    // Frames produced by the frame source
+    int64_t framesPresented = 0;   // New frames handed to the present callback
+    int64_t framesDropped = 0;     // Frame indices passed without being presented
+    int64_t framesRepeated = 0;    // Deadlines where the previous frame was shown again
+    double meanJitterMs = 0.0;     // Mean lateness of presentation vs deadline
+    double maxJitterMs = 0.0;      // Worst lateness of presentation vs deadline
+    size_t queueDepth = 0;         // Frames currently decoded ahead
+};
+
+/**
+ * @class PreviewScheduler
+ * @brief Clock-driven preview playback
+ *
+ * Derives frame deadlines from the timeline frame rate on a monotonic
+ * clock. A render thread decodes ahead into a bounded queue while a
+ * presentation thread sleeps until each deadline and hands the newest
+ * frame due by then to the present callback. Every frame index passed
+ * without being presented, whether overtaken by a later frame or
+ * overslept, counts once as dropped; deadlines with no new frame ready
+ * repeat the previous one. Either way the clock never
+ * drifts.
+ *
+ * The scheduler only depends on a FrameSource callback, so it runs
+ * headless with a synthetic source.
+ *
+ * Usage:
+ * @code
+ * PreviewScheduler scheduler;
+ * scheduler.start([](int64_t index, int64_t timeMs, PreviewFrame& out) {
+ *     return renderer.render(timeMs, out);
+ * }, 30.0f, 0, durationMs, [](const PreviewFrame& f) { upload(f); });
+ * @endcode
+ */
+class PreviewScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Produces the frame for a timeline frame index
+     *
+     * Called on the render thread with (frameIndex, timestampMs, outFrame).
+     * Returns false if the frame could not be produced.
+     */
+    using FrameSource = std::function<bool(int64_t, int64_t, PreviewFrame&)>;
+
+    /// Called on the presentation thread for every presented frame
+    using PresentCallback = std::function<void(const PreviewFrame&)>;
+
+    /// Called on the presentation thread when playback reaches the end
+    using FinishedCallback = std::function<void()>;
+
+    /**
+     * @brief Create an idle scheduler
+     * @param queueCapacity Maximum frames decoded ahead
+     */
+    explicit PreviewScheduler(size_t queueCapacity = 4);
+
+    /**
+     * @brief Destructor - stops playback
+     */
+    ~PreviewScheduler();
+
+    // Prevent copying
+    PreviewScheduler(const PreviewScheduler&) = delete;
+    PreviewScheduler& operator=(const PreviewScheduler&) = delete;
+
+    // ===== Control =====
+
+    /**
+     * @brief Start playback
+     * @param source Frame producer
+     * @param frameRate Timeline frames per second
+     * @param startMs Position to start from (ms)
+     * @param endMs Position to stop at (ms)
+     * @param onPresent Receives each presented frame
+     * @param onFinished Invoked once when the last frame is presented
+     * @return true if playback started
+     *
+     * The callbacks are installed after the previous session has been
+     * stopped, so they never change while the presentation thread runs.
+     */
+    bool start(FrameSource source, float frameRate, int64_t startMs, int64_t endMs,
+               PresentCallback onPresent = nullptr, FinishedCallback onFinished = nullptr);
+
+    /**
+     * @brief Stop playback and join worker threads
+     */
+    void stop();
+
+    /**
+     * @brief Check if playback is running
+     * @return true between start() and end of playback or stop()
+     */
+    [[nodiscard]] bool isRunning() const { return m_running.load(); }
+
+    // ===== Monitoring =====
+
+    /**
+     * @brief Get current presentation position
+     * @return Position in milliseconds
+     */
+    [[nodiscard]] int64_t getPositionMs() const { return m_positionMs.load(); }
+
+    /**
+     * @brief Get playback statistics
+     * @return Snapshot of counters for the current/last session
+     */
+    [[nodiscard]] PreviewStats getStats() const;
+
+    /**
+     * @brief Convert a time to a frame index
+     * @param timeMs Time in milliseconds
+     * @param frameRate Frames per second
+     * @return Frame containing that time
+     */
+    [[nodiscard]] static int64_t timeToFrame(int64_t timeMs, float frameRate);
+
+    /**
+     * @brief Convert a frame index to its presentation time
+     * @param frameIndex Frame number
+     * @param frameRate Frames per second
+     * @return Time in milliseconds
+     */
+    [[nodiscard]] static int64_t frameToTime(int64_t frameIndex, float frameRate);
+
+private:
+    size_t m_queueCapacity;
+    FrameSource m_source;
+    PresentCallback m_presentCallback;
+    FinishedCallback m_finishedCallback;
+
+    float m_frameRate = 30.0f;
+    int64_t m_firstFrame = 0;
+    int64_t m_lastFrame = 0;
+
+    std::atomic<bool> m_running{false};
+    std::atomic<int64_t> m_positionMs{0};
+    std::atomic<int64_t> m_presentFrame{0};   // Frame the presenter currently needs
+
+    // Decode-ahead queue (ordered by frame index)
+    std::deque<PreviewFrame> m_queue;
+    mutable std::mutex m_queueMutex;
+    std::condition_variable m_queueNotFull;
+
+    PreviewStats m_stats;
+    double m_jitterSumMs = 0.0;
+    mutable std::mutex m_statsMutex;
+
+    std::unique_ptr<std::thread> m_renderThread;
+    std::unique_ptr<std::thread> m_presentThread;
+
+    /**
+     * @brief Render thread: produce frames ahead of the presenter
+     */
+    void renderLoop();
+
+    /**
+     * @brief Presentation thread: wait for deadlines and present frames
+     */
+    void presentLoop();
+
+    /**
+     * @brief Record presentation lateness
+     * @param jitterMs Milliseconds past the deadline
+     */
+    void recordJitter(double jitterMs);
+};
+
+} // namespace core
+} // namespace clipforge
+
+#endif // CLIPFORGE_PREVIEW_SCHEDULER_H
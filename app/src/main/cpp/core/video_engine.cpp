@@ -1,7 +1,10 @@
 #include "video_engine.h"
+#include "../models/project_file.h"
 #include "../utils/logger.h"
+#include "../utils/id_generator.h"
 #include <thread>
 #include <chrono>
+#include <algorithm>
 
 namespace clipforge {
 namespace core {
@@ -28,12 +31,18 @@ bool VideoEngine::initialize(const EngineConfig& config) {
     }
 
     m_config = config;
+    m_previewCache.setCapacity(m_config.enablePreviewCache ? m_config.maxCacheSize : 0);
     LOG_INFO("VideoEngine initialized with config");
     LOG_INFO("  Preview Quality: %d", m_config.previewQuality);
     LOG_INFO("  Hardware Accel: %s", m_config.useHardwareAccel ? "true" : "false");
     LOG_INFO("  Max Threads: %d", m_config.maxRenderThreads);
+    LOG_INFO("  Preview Cache: %s (%zu bytes)",
+            m_config.enablePreviewCache ? "true" : "false", m_config.maxCacheSize);
 
     // Initialize subsystems
+    m_effectsProcessor = std::make_unique<effects::EffectsProcessor>(
+        static_cast<size_t>(std::max(1, m_config.maxRenderThreads)));
+
     if (!loadEffectsLibrary()) {
         setError("Failed to load effects library");
         return false;
@@ -49,11 +58,10 @@ void VideoEngine::shutdown() {
     LOG_INFO("Shutting down VideoEngine");
 
     // Stop preview if running
-    if (m_previewPlaying.exchange(false)) {
-        if (m_previewThread && m_previewThread->joinable()) {
-            m_previewThread->join();
-        }
+    if (m_previewScheduler) {
+        m_previewScheduler->stop();
     }
+    m_previewPlaying = false;
 
     // Cancel export if in progress
     if (m_exporting.exchange(false)) {
@@ -63,7 +71,12 @@ void VideoEngine::shutdown() {
         }
     }
 
+    m_previewCache.clear();
+    m_framePool.clear();
     m_timeline = nullptr;
+    m_history.clear();
+    m_historyIndex = 0;
+    publishSnapshot(nullptr);
     m_state = EngineState::SHUTDOWN;
 }
 
@@ -82,71 +95,102 @@ bool VideoEngine::setTimeline(std::shared_ptr<models::Timeline> timeline) {
         return false;
     }
 
+    // The journal describes the previous timeline
+    m_journal.reset();
+    m_projectPath.clear();
+
     m_timeline = timeline;
+
+    // Undo starts over from the new timeline
+    m_history.assign(1, timeline->snapshot());
+    m_historyIndex = 0;
+    publishSnapshot(m_history.front());
+
+    // After publishing, so frames rendered from the old timeline miss
+    m_staleSpans.clear();
+    m_timelineRevision++;
+    m_previewCache.clear();
     LOG_INFO("Timeline set: %d clips, %lld ms duration",
             timeline->getClipCount(), timeline->getTotalDuration());
     return true;
 }
 
-std::string VideoEngine::addClip(const std::string& sourcePath,
-                                int64_t startPosition, int32_t trackIndex) {
+models::ClipHandle VideoEngine::findClip(const std::string& clipId) const {
+    if (!m_timeline) return {};
+    return m_timeline->findClip(clipId);
+}
+
+std::string VideoEngine::getClipId(models::ClipHandle handle) const {
+    auto clip = m_timeline ? m_timeline->getClip(handle) : nullptr;
+    return clip ? clip->getId() : "";
+}
+
+models::ClipHandle VideoEngine::addClip(const std::string& sourcePath,
+                                        int64_t startPosition, int32_t trackIndex) {
     if (!m_timeline) {
         setError("No timeline set");
-        return "";
+        return {};
     }
 
     // Create new clip
-    auto clip = std::make_shared<models::VideoClip>("clip_" + std::to_string(std::time(nullptr)),
-                                                     sourcePath);
+    auto clip = std::make_shared<models::VideoClip>(utils::generateId("clip"), sourcePath);
     clip->setStartPosition(startPosition);
     clip->setTrackIndex(trackIndex);
 
     if (!m_timeline->addClip(clip)) {
         setError("Failed to add clip to timeline");
-        return "";
+        return {};
     }
+    invalidateClipSpan(*clip);
+    if (m_journal) m_journal->recordClipAdded(*clip);
+    commitEdit();
 
     LOG_INFO("Clip added: %s (track %d, pos %lld ms)",
             clip->getId().c_str(), trackIndex, startPosition);
-    return clip->getId();
+    return clip->getHandle();
 }
 
-bool VideoEngine::removeClip(const std::string& clipId) {
+bool VideoEngine::removeClip(models::ClipHandle handle) {
     if (!m_timeline) {
         setError("No timeline set");
         return false;
     }
 
-    if (!m_timeline->removeClip(clipId)) {
-        setError("Clip not found: " + clipId);
+    auto clip = m_timeline->getClip(handle);
+    if (!clip || !m_timeline->removeClip(handle)) {
+        setError("Clip not found");
         return false;
     }
+    invalidateClipSpan(*clip);
+    if (m_journal) m_journal->recordClipRemoved(clip->getId());
+    commitEdit();
 
-    LOG_INFO("Clip removed: %s", clipId.c_str());
+    LOG_INFO("Clip removed: %s", clip->getId().c_str());
     return true;
 }
 
-bool VideoEngine::moveClip(const std::string& clipId, int64_t newStartPosition,
+bool VideoEngine::moveClip(models::ClipHandle handle, int64_t newStartPosition,
                           int32_t newTrackIndex) {
-    auto clip = m_timeline->getClip(clipId);
+    auto clip = m_timeline->getClip(handle);
     if (!clip) {
-        setError("Clip not found: " + clipId);
+        setError("Clip not found");
         return false;
     }
 
-    clip->setStartPosition(newStartPosition);
-    clip->setTrackIndex(newTrackIndex);
-
-    m_timeline->updateDuration();
+    invalidateClipSpan(*clip);
+    m_timeline->moveClip(handle, newStartPosition, newTrackIndex);
+    invalidateClipSpan(*clip);
+    if (m_journal) m_journal->recordClipMoved(*clip);
+    commitEdit();
     LOG_DEBUG("Clip moved: %s (new pos %lld ms, track %d)",
-             clipId.c_str(), newStartPosition, newTrackIndex);
+             clip->getId().c_str(), newStartPosition, newTrackIndex);
     return true;
 }
 
-bool VideoEngine::trimClip(const std::string& clipId, int64_t trimStart, int64_t trimEnd) {
-    auto clip = m_timeline->getClip(clipId);
+bool VideoEngine::trimClip(models::ClipHandle handle, int64_t trimStart, int64_t trimEnd) {
+    auto clip = m_timeline->getClip(handle);
     if (!clip) {
-        setError("Clip not found: " + clipId);
+        setError("Clip not found");
         return false;
     }
 
@@ -158,46 +202,60 @@ bool VideoEngine::trimClip(const std::string& clipId, int64_t trimStart, int64_t
     clip->setTrimStart(trimStart);
     clip->setTrimEnd(trimEnd);
     clip->updateModificationTime();
+    m_timeline->touchClip(handle);
+    invalidateClipSpan(*clip);
+    if (m_journal) m_journal->recordClipTrimmed(*clip);
+    commitEdit();
 
     LOG_DEBUG("Clip trimmed: %s (%lld-%lld ms)",
-             clipId.c_str(), trimStart, trimEnd);
+             clip->getId().c_str(), trimStart, trimEnd);
     return true;
 }
 
-bool VideoEngine::setClipSpeed(const std::string& clipId, float speed) {
-    auto clip = m_timeline->getClip(clipId);
+bool VideoEngine::setClipSpeed(models::ClipHandle handle, float speed) {
+    auto clip = m_timeline->getClip(handle);
     if (!clip) {
-        setError("Clip not found: " + clipId);
+        setError("Clip not found");
         return false;
     }
 
     clip->setSpeed(speed);
-    LOG_DEBUG("Clip speed set: %s (%.2fx)", clipId.c_str(), speed);
+    m_timeline->touchClip(handle);
+    invalidateClipSpan(*clip);
+    if (m_journal) m_journal->recordClipSpeed(*clip);
+    commitEdit();
+    LOG_DEBUG("Clip speed set: %s (%.2fx)", clip->getId().c_str(), speed);
     return true;
 }
 
-bool VideoEngine::setClipVolume(const std::string& clipId, float volume) {
-    auto clip = m_timeline->getClip(clipId);
+bool VideoEngine::setClipVolume(models::ClipHandle handle, float volume) {
+    auto clip = m_timeline->getClip(handle);
     if (!clip) {
-        setError("Clip not found: " + clipId);
+        setError("Clip not found");
         return false;
     }
 
     clip->setVolume(volume);
-    LOG_DEBUG("Clip volume set: %s (%.2f)", clipId.c_str(), volume);
+    m_timeline->touchClip(handle);
+    if (m_journal) m_journal->recordClipVolume(*clip);
+    commitEdit();
+    LOG_DEBUG("Clip volume set: %s (%.2f)", clip->getId().c_str(), volume);
     return true;
 }
 
-std::string VideoEngine::splitClip(const std::string& clipId, int64_t splitTime) {
-    auto clip = m_timeline->getClip(clipId);
+models::ClipHandle VideoEngine::splitClip(models::ClipHandle handle, int64_t splitTime) {
+    auto clip = m_timeline->getClip(handle);
     if (!clip) {
-        setError("Clip not found: " + clipId);
-        return "";
+        setError("Clip not found");
+        return {};
     }
 
+    // Both halves stay within the original span
+    invalidateClipSpan(*clip);
+
     // Create new clip for the second part
     auto newClip = std::make_shared<models::VideoClip>(
-        "clip_" + std::to_string(std::time(nullptr)),
+        utils::generateId("clip"),
         clip->getSourceFile()
     );
 
@@ -207,49 +265,98 @@ std::string VideoEngine::splitClip(const std::string& clipId, int64_t splitTime)
     newClip->setStartPosition(clip->getStartPosition() + splitTime);
     newClip->setTrimStart(clip->getTrimStart() + splitTime);
     newClip->setTrimEnd(clip->getTrimEnd());
+    newClip->setDuration(clip->getDuration() - splitTime);
 
     if (!m_timeline->addClip(newClip)) {
         setError("Failed to create split clip");
-        return "";
+        return {};
     }
 
     // Update original clip
     clip->setDuration(splitTime);
     clip->setTrimEnd(clip->getTrimStart() + splitTime);
+    m_timeline->refreshClip(handle);
+
+    if (m_journal) {
+        m_journal->recordClipAdded(*newClip);
+        m_journal->recordClipTrimmed(*clip);
+    }
+    commitEdit();
 
     LOG_INFO("Clip split: %s at %lld ms, created %s",
-            clipId.c_str(), splitTime, newClip->getId().c_str());
-    return newClip->getId();
+            clip->getId().c_str(), splitTime, newClip->getId().c_str());
+    return newClip->getHandle();
 }
 
-bool VideoEngine::applyEffect(const std::string& clipId,
+bool VideoEngine::applyEffect(models::ClipHandle handle,
                              std::shared_ptr<models::Effect> effect) {
-    auto clip = m_timeline->getClip(clipId);
+    auto clip = m_timeline->getClip(handle);
     if (!clip) {
-        setError("Clip not found: " + clipId);
+        setError("Clip not found");
         return false;
     }
 
     clip->applyEffect(effect);
+    m_timeline->touchClip(handle);
+    invalidateClipSpan(*clip);
+    if (m_journal) m_journal->recordEffectAdded(*clip, *effect);
+    commitEdit();
     LOG_DEBUG("Effect applied: %s to clip %s",
-             effect->getName().c_str(), clipId.c_str());
+             effect->getName().c_str(), clip->getId().c_str());
     return true;
 }
 
-bool VideoEngine::removeEffect(const std::string& clipId, const std::string& effectId) {
-    auto clip = m_timeline->getClip(clipId);
+bool VideoEngine::removeEffect(models::ClipHandle handle, const std::string& effectId) {
+    auto clip = m_timeline->getClip(handle);
     if (!clip) {
-        setError("Clip not found: " + clipId);
+        setError("Clip not found");
         return false;
     }
 
+    // Journaled first: the record addresses the effect by its position
+    if (m_journal) m_journal->recordEffectRemoved(*clip, effectId);
     if (!clip->removeEffect(effectId)) {
         setError("Effect not found: " + effectId);
         return false;
     }
+    m_timeline->touchClip(handle);
+    invalidateClipSpan(*clip);
+    commitEdit();
 
     LOG_DEBUG("Effect removed: %s from clip %s",
-             effectId.c_str(), clipId.c_str());
+             effectId.c_str(), clip->getId().c_str());
+    return true;
+}
+
+bool VideoEngine::setEffectParameter(models::ClipHandle handle, const std::string& effectId,
+                                     const std::string& paramName, float value) {
+    auto clip = m_timeline->getClip(handle);
+    if (!clip) {
+        setError("Clip not found");
+        return false;
+    }
+
+    auto& effects = clip->getEffects();
+    auto it = std::find_if(effects.begin(), effects.end(),
+                           [&effectId](const std::shared_ptr<models::Effect>& effect) {
+                               return effect && effect->getId() == effectId;
+                           });
+    if (it == effects.end()) {
+        setError("Effect not found: " + effectId);
+        return false;
+    }
+
+    if (!(*it)->setParameterValue(paramName, value)) {
+        setError("Effect parameter not found: " + paramName);
+        return false;
+    }
+    m_timeline->touchClip(handle);
+    invalidateClipSpan(*clip);
+    if (m_journal) m_journal->recordEffectParameter(*clip, **it, paramName);
+    commitEdit();
+
+    LOG_DEBUG("Effect parameter set: %s.%s = %.3f on clip %s",
+             effectId.c_str(), paramName.c_str(), value, clip->getId().c_str());
     return true;
 }
 
@@ -286,53 +393,74 @@ std::shared_ptr<models::Effect> VideoEngine::createEffect(const std::string& eff
     return nullptr;
 }
 
-std::string VideoEngine::addAudioTrack(const std::string& name, const std::string& type) {
+models::AudioTrackHandle VideoEngine::findAudioTrack(const std::string& trackId) const {
+    if (!m_timeline) return {};
+    return m_timeline->findAudioTrack(trackId);
+}
+
+std::string VideoEngine::getAudioTrackId(models::AudioTrackHandle handle) const {
+    auto track = m_timeline ? m_timeline->getAudioTrack(handle) : nullptr;
+    return track ? track->getId() : "";
+}
+
+models::AudioTrackHandle VideoEngine::addAudioTrack(const std::string& name, const std::string& type) {
     if (!m_timeline) {
         setError("No timeline set");
-        return "";
+        return {};
     }
 
-    std::string trackId = m_timeline->addAudioTrack(name, type);
-    LOG_INFO("Audio track added: %s (type: %s)", trackId.c_str(), type.c_str());
-    return trackId;
+    auto track = m_timeline->getAudioTrack(m_timeline->addAudioTrack(name, type));
+    if (m_journal) m_journal->recordAudioTrackAdded(*track);
+    commitEdit();
+    LOG_INFO("Audio track added: %s (type: %s)", track->getId().c_str(), type.c_str());
+    return track->getHandle();
 }
 
-bool VideoEngine::removeAudioTrack(const std::string& trackId) {
+bool VideoEngine::removeAudioTrack(models::AudioTrackHandle handle) {
     if (!m_timeline) {
         setError("No timeline set");
         return false;
     }
 
-    if (!m_timeline->removeAudioTrack(trackId)) {
-        setError("Audio track not found: " + trackId);
+    auto track = m_timeline->getAudioTrack(handle);
+    if (!track || !m_timeline->removeAudioTrack(handle)) {
+        setError("Audio track not found");
         return false;
     }
+    if (m_journal) m_journal->recordAudioTrackRemoved(track->getId());
+    commitEdit();
 
-    LOG_INFO("Audio track removed: %s", trackId.c_str());
+    LOG_INFO("Audio track removed: %s", track->getId().c_str());
     return true;
 }
 
-bool VideoEngine::setAudioTrackVolume(const std::string& trackId, float volume) {
-    auto track = m_timeline->getAudioTrack(trackId);
+bool VideoEngine::setAudioTrackVolume(models::AudioTrackHandle handle, float volume) {
+    auto track = m_timeline->getAudioTrack(handle);
     if (!track) {
-        setError("Audio track not found: " + trackId);
+        setError("Audio track not found");
         return false;
     }
 
     track->setVolume(volume);
-    LOG_DEBUG("Audio track volume set: %s (%.2f)", trackId.c_str(), volume);
+    m_timeline->touchAudioTrack(handle);
+    if (m_journal) m_journal->recordAudioTrackVolume(*track);
+    commitEdit();
+    LOG_DEBUG("Audio track volume set: %s (%.2f)", track->getId().c_str(), volume);
     return true;
 }
 
-bool VideoEngine::setAudioTrackMuted(const std::string& trackId, bool muted) {
-    auto track = m_timeline->getAudioTrack(trackId);
+bool VideoEngine::setAudioTrackMuted(models::AudioTrackHandle handle, bool muted) {
+    auto track = m_timeline->getAudioTrack(handle);
     if (!track) {
-        setError("Audio track not found: " + trackId);
+        setError("Audio track not found");
         return false;
     }
 
     track->setMuted(muted);
-    LOG_DEBUG("Audio track muted: %s (%s)", trackId.c_str(),
+    m_timeline->touchAudioTrack(handle);
+    if (m_journal) m_journal->recordAudioTrackMuted(*track);
+    commitEdit();
+    LOG_DEBUG("Audio track muted: %s (%s)", track->getId().c_str(),
              muted ? "true" : "false");
     return true;
 }
@@ -342,6 +470,31 @@ int64_t VideoEngine::getTimelineDuration() const {
     return m_timeline->getTotalDuration();
 }
 
+std::shared_ptr<const models::TimelineSnapshot> VideoEngine::getTimelineSnapshot() const {
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    return m_publishedSnapshot;
+}
+
+bool VideoEngine::undo() {
+    if (!m_timeline || !canUndo()) {
+        return false;
+    }
+
+    restoreSnapshot(m_history[--m_historyIndex]);
+    LOG_DEBUG("Undo (%zu more available)", m_historyIndex);
+    return true;
+}
+
+bool VideoEngine::redo() {
+    if (!m_timeline || !canRedo()) {
+        return false;
+    }
+
+    restoreSnapshot(m_history[++m_historyIndex]);
+    LOG_DEBUG("Redo (%zu more available)", m_history.size() - m_historyIndex - 1);
+    return true;
+}
+
 bool VideoEngine::startPreview() {
     if (m_previewPlaying) {
         return false;  // Already playing
@@ -352,9 +505,14 @@ bool VideoEngine::startPreview() {
         return false;
     }
 
-    m_previewPlaying = true;
-    m_previewThread = std::make_unique<std::thread>(
-        &VideoEngine::previewPlaybackThread, this);
+    if (m_previewPosition >= m_timeline->getTotalDuration()) {
+        m_previewPosition = 0;  // Restart from the beginning after reaching the end
+    }
+
+    if (!startPreviewScheduler()) {
+        setError("Failed to start preview scheduler");
+        return false;
+    }
 
     setState(EngineState::PREVIEW_PLAYING);
     LOG_INFO("Preview started");
@@ -367,6 +525,10 @@ bool VideoEngine::pausePreview() {
     }
 
     m_previewPlaying = false;
+    if (m_previewScheduler) {
+        m_previewScheduler->stop();
+        m_previewPosition = m_previewScheduler->getPositionMs();
+    }
     setState(EngineState::IDLE);
     LOG_INFO("Preview paused");
     return true;
@@ -377,8 +539,8 @@ bool VideoEngine::stopPreview() {
         return false;
     }
 
-    if (m_previewThread && m_previewThread->joinable()) {
-        m_previewThread->join();
+    if (m_previewScheduler) {
+        m_previewScheduler->stop();
     }
 
     m_previewPosition = 0;
@@ -393,6 +555,14 @@ bool VideoEngine::seekPreview(int64_t timeMs) {
     }
 
     m_previewPosition = timeMs;
+
+    // Restart the clock at the new position so deadlines stay aligned
+    if (m_previewPlaying && !startPreviewScheduler()) {
+        m_previewPlaying = false;
+        setError("Failed to restart preview after seek");
+        return false;
+    }
+
     LOG_DEBUG("Preview seeked to %lld ms", timeMs);
     return true;
 }
@@ -402,14 +572,47 @@ bool VideoEngine::isPreviewPlaying() const {
 }
 
 int64_t VideoEngine::getPreviewPosition() const {
+    if (m_previewPlaying && m_previewScheduler) {
+        return m_previewScheduler->getPositionMs();
+    }
     return m_previewPosition.load();
 }
 
-std::vector<uint8_t> VideoEngine::getPreviewFrame(int64_t timeMs) {
+void VideoEngine::setPreviewFrameCallback(PreviewScheduler::PresentCallback callback) {
+    m_previewFrameCallback = std::move(callback);
+}
+
+PreviewStats VideoEngine::getPreviewStats() const {
+    if (!m_previewScheduler) return PreviewStats{};
+    return m_previewScheduler->getStats();
+}
+
+PreviewCacheStats VideoEngine::getPreviewCacheStats() const {
+    return m_previewCache.getStats();
+}
+
+FramePoolStats VideoEngine::getFramePoolStats() const {
+    return m_framePool.getStats();
+}
+
+void VideoEngine::invalidatePreviewCache() {
+    m_timelineRevision++;
+    m_previewCache.clear();
+}
+
+FrameBufferPtr VideoEngine::getPreviewFrame(int64_t timeMs) {
     LOG_DEBUG("Requesting preview frame at %lld ms", timeMs);
-    // Placeholder: return empty vector
-    // Real implementation would decode frame from timeline
-    return std::vector<uint8_t>();
+
+    if (!m_timeline) {
+        return nullptr;
+    }
+
+    PreviewFrame frame;
+    if (!fetchPreviewFrame(
+            PreviewScheduler::timeToFrame(timeMs, m_timeline->getProperties().frameRate), frame)) {
+        return nullptr;
+    }
+    return frame.buffer;
 }
 
 bool VideoEngine::startExport(const std::string& outputPath, const std::string& format,
@@ -462,13 +665,86 @@ std::string VideoEngine::getExportOutputPath() const {
 
 bool VideoEngine::saveProject(const std::string& projectPath) {
     LOG_INFO("Saving project to: %s", projectPath.c_str());
-    // Placeholder: implement project serialization
+    if (!m_timeline) {
+        setError("No timeline to save");
+        return false;
+    }
+
+    // The snapshot covers every edit journaled so far
+    uint64_t sequence = m_journal ? m_journal->getLastSequence() : 0;
+    if (!models::ProjectFileWriter::write(projectPath, *m_timeline, sequence)) {
+        setError("Failed to save project: " + projectPath);
+        return false;
+    }
+
+    if (!m_journal || projectPath != m_projectPath) {
+        m_journal = std::make_unique<models::EditJournal>();
+        m_journal->open(models::EditJournal::pathFor(projectPath));
+    }
+    if (!m_journal->reset(sequence)) {
+        // Still saved; autosaves fall back to full snapshots
+        LOG_WARNING("Edit journal unavailable for %s", projectPath.c_str());
+        m_journal.reset();
+    }
+
+    m_projectPath = projectPath;
+    m_timeline->clearChangesFlag();
     return true;
 }
 
 bool VideoEngine::loadProject(const std::string& projectPath) {
     LOG_INFO("Loading project from: %s", projectPath.c_str());
-    // Placeholder: implement project deserialization
+
+    // Maps the file; clips are built straight from the fixed-size records
+    auto project = models::ProjectFile::open(projectPath);
+    auto timeline = std::make_shared<models::Timeline>();
+    if (!project || !project->loadTimeline(*timeline)) {
+        setError("Failed to load project: " + projectPath);
+        return false;
+    }
+
+    // Recover edits journaled after the snapshot was written
+    auto journal = std::make_unique<models::EditJournal>();
+    uint64_t sequence = project->getJournalSequence();
+    if (!journal->open(models::EditJournal::pathFor(projectPath))) {
+        journal.reset();
+    } else if (journal->getBaseSequence() > sequence) {
+        // Edits between the snapshot and the journal are lost; applying the
+        // journal would produce a timeline that never existed
+        setError("Edit journal does not continue from the saved project: " + projectPath);
+        return false;
+    } else if (journal->getLastSequence() <= sequence) {
+        // Nothing newer; a crash may have left records the snapshot already holds
+        if (!journal->reset(sequence)) journal.reset();
+    } else {
+        size_t replayed = journal->replay(*timeline, sequence);
+        LOG_INFO("Recovered %zu journaled edits", replayed);
+        timeline->clearChangesFlag();
+    }
+
+    if (!setTimeline(timeline)) {
+        return false;
+    }
+    m_projectPath = projectPath;
+    m_journal = std::move(journal);
+    return true;
+}
+
+bool VideoEngine::autosaveProject() {
+    if (!m_timeline || m_projectPath.empty()) {
+        setError("No saved project to autosave");
+        return false;
+    }
+
+    // Fold a long journal into a new snapshot to keep recovery fast
+    if (!m_journal || m_journal->getSize() >= m_config.journalCompactSize) {
+        return saveProject(m_projectPath);
+    }
+
+    if (!m_journal->sync()) {
+        setError("Failed to autosave project: " + m_projectPath);
+        return false;
+    }
     return true;
 }
 
@@ -488,8 +764,8 @@ std::string VideoEngine::getChangesSummary() const {
 }
 
 size_t VideoEngine::getMemoryUsage() const {
-    // Placeholder: implement memory profiling
-    return 0;
+    // Preview frames (cached or borrowed) are the only sizeable engine-owned allocation so far
+    return m_framePool.getStats().bytesPooled;
 }
 
 size_t VideoEngine::getClipCount() const {
@@ -513,22 +789,167 @@ std::string VideoEngine::getVersion() {
     return "1.0.0";
 }
 
-void VideoEngine::previewPlaybackThread() {
-    LOG_DEBUG("Preview playback thread started");
-
-    while (m_previewPlaying) {
-        // Simulate playback
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));  // ~60 FPS
-        m_previewPosition += 16;
+bool VideoEngine::startPreviewScheduler() {
+    if (!m_previewScheduler) {
+        m_previewScheduler = std::make_unique<PreviewScheduler>();
+    }
 
-        if (m_previewPosition > m_timeline->getTotalDuration()) {
-            m_previewPosition = m_timeline->getTotalDuration();
+    m_previewPlaying = true;
+    return m_previewScheduler->start(
+        [this](int64_t frameIndex, int64_t timestampMs, PreviewFrame& outFrame) {
+            (void)timestampMs;
+            return fetchPreviewFrame(frameIndex, outFrame);
+        },
+        m_timeline->getProperties().frameRate,
+        m_previewPosition.load(),
+        m_timeline->getTotalDuration(),
+        m_previewFrameCallback,
+        [this]() {
+            m_previewPosition = m_previewScheduler->getPositionMs();
             m_previewPlaying = false;
-            setState(EngineState::IDLE);
+            // Runs on the presentation thread: avoid m_stateMutex, which
+            // shutdown() holds while joining this thread
+            m_state = EngineState::IDLE;
             LOG_DEBUG("Preview playback completed");
-            break;
+        });
+}
+
+bool VideoEngine::fetchPreviewFrame(int64_t frameIndex, PreviewFrame& outFrame) {
+    // Edits publish their snapshot before invalidating, so reading the
+    // epoch and revision first means a frame rendered from a snapshot
+    // that an edit has since replaced is rejected by put()
+    uint64_t epoch = m_previewCache.getEpoch();
+    uint64_t revision = m_timelineRevision.load();
+
+    // Held for the whole frame while edits publish newer snapshots
+    auto snapshot = getTimelineSnapshot();
+    if (!snapshot) return false;
+    const auto& props = snapshot->getProperties();
+
+    PreviewCacheKey key;
+    key.revision = revision;
+    key.frameIndex = frameIndex;
+    key.height = getPreviewHeight(props);
+
+    if (m_previewCache.get(key, outFrame)) {
+        return true;
+    }
+
+    int64_t timeMs = PreviewScheduler::frameToTime(frameIndex, props.frameRate);
+    if (!renderPreviewFrame(*snapshot, timeMs, outFrame)) {
+        return false;
+    }
+    outFrame.frameIndex = frameIndex;
+
+    m_previewCache.put(key, outFrame, epoch);
+    return true;
+}
+
+bool VideoEngine::renderPreviewFrame(const models::TimelineSnapshot& snapshot, int64_t timeMs,
+                                     PreviewFrame& outFrame) {
+    // Preview is rendered at previewQuality lines, keeping the project aspect ratio
+    const auto& props = snapshot.getProperties();
+    int32_t height = getPreviewHeight(props);
+    int32_t width = props.height > 0
+        ? static_cast<int32_t>(static_cast<int64_t>(props.width) * height / props.height)
+        : 0;
+    width &= ~1;
+    if (width <= 0 || height <= 0) return false;
+
+    // Recycled buffers hold stale pixels: every byte is overwritten below
+    outFrame.buffer = m_framePool.acquire(width, height, 4);
+    if (!outFrame.buffer) return false;
+    outFrame.timestampMs = timeMs;
+
+    // Opaque black canvas; source decoding is not wired up yet
+    uint8_t* pixels = outFrame.buffer->data();
+    for (size_t i = 0; i < outFrame.buffer->size(); i += 4) {
+        pixels[i] = 0;
+        pixels[i + 1] = 0;
+        pixels[i + 2] = 0;
+        pixels[i + 3] = 0xFF;
+    }
+
+    if (m_effectsProcessor) {
+        for (const auto& clip : snapshot.getClipsAtTime(timeMs)) {
+            if (clip && !clip->getEffectChain().isEmpty()) {
+                m_effectsProcessor->process(clip->getEffectChain(), pixels, width, height,
+                                            outFrame.buffer->getStride());
+            }
+        }
+    }
+
+    return true;
+}
+
+int32_t VideoEngine::getPreviewHeight(const models::TimelineProperties& properties) const {
+    return std::min(m_config.previewQuality, properties.height);
+}
+
+void VideoEngine::invalidateClipSpan(const models::VideoClip& clip) {
+    m_staleSpans.emplace_back(clip.getStartPosition(), clip.getEndPosition());
+}
+
+void VideoEngine::flushStaleSpans() {
+    for (const auto& [startMs, endMs] : m_staleSpans) {
+        m_previewCache.invalidateRange(startMs, endMs);
+    }
+    m_staleSpans.clear();
+}
+
+void VideoEngine::commitEdit() {
+    auto snapshot = m_timeline->snapshot();
+
+    // A new edit discards the redo branch
+    m_history.erase(m_history.begin() + static_cast<std::ptrdiff_t>(std::min(m_historyIndex + 1, m_history.size())),
+                    m_history.end());
+    m_history.push_back(snapshot);
+    if (m_history.size() > m_config.maxUndoSteps + 1) {
+        m_history.erase(m_history.begin());
+    }
+    m_historyIndex = m_history.size() - 1;
+
+    publishSnapshot(std::move(snapshot));
+    flushStaleSpans();
+}
+
+void VideoEngine::publishSnapshot(std::shared_ptr<const models::TimelineSnapshot> snapshot) {
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    m_publishedSnapshot = std::move(snapshot);
+}
+
+void VideoEngine::restoreSnapshot(const std::shared_ptr<const models::TimelineSnapshot>& target) {
+    auto current = m_timeline->snapshot();
+
+    // Only clips that differ are replaced: drop their preview frames and
+    // journal them as a removal plus an addition
+    models::ClipTree::ClipList removed, added;
+    models::ClipTree::diff(current->getClipTree(), target->getClipTree(),
+                           [&](const models::ClipTree::ClipPtr& from, const models::ClipTree::ClipPtr& to) {
+                               if (from) removed.push_back(from);
+                               if (to) added.push_back(to);
+                           });
+    for (const auto& clip : removed) {
+        invalidateClipSpan(*clip);
+        if (m_journal) m_journal->recordClipRemoved(clip->getId());
+    }
+    for (const auto& clip : added) {
+        invalidateClipSpan(*clip);
+        if (m_journal) m_journal->recordClipAdded(*clip);
+    }
+
+    if (m_journal && current->getAllAudioTracks() != target->getAllAudioTracks()) {
+        for (const auto& track : current->getAllAudioTracks()) {
+            m_journal->recordAudioTrackRemoved(track->getId());
+        }
+        for (const auto& track : target->getAllAudioTracks()) {
+            m_journal->recordAudioTrackAdded(*track);
         }
     }
+
+    m_timeline->restore(target);
+    publishSnapshot(target);
+    flushStaleSpans();
 }
 
 void VideoEngine::exportRenderingThread(const std::string& outputPath,
@@ -541,15 +962,19 @@ void VideoEngine::exportRenderingThread(const std::string& outputPath,
 
     LOG_DEBUG("Export rendering thread started");
 
+    // Export the timeline as it was when the export started; later edits do not reach it
+    auto snapshot = getTimelineSnapshot();
+    const int64_t duration = snapshot ? snapshot->getTotalDuration() : 0;
+
     // Simulate rendering progress
     {
         std::lock_guard<std::mutex> lock(m_exportMutex);
-        m_exportProgress.totalFrames = m_timeline->getTotalDuration() / 33;  // ~30 fps
+        m_exportProgress.totalFrames = duration / 33;  // ~30 fps
         m_exportProgress.status = "Starting export...";
     }
 
     // Simulate frame-by-frame export
-    for (int64_t i = 0; i < m_timeline->getTotalDuration() && m_exporting; i += 33) {
+    for (int64_t i = 0; i < duration && m_exporting; i += 33) {
         if (m_cancelExport) {
             std::lock_guard<std::mutex> lock(m_exportMutex);
             m_exportProgress.status = "Export cancelled";
@@ -584,6 +1009,14 @@ void VideoEngine::setError(const std::string& message) {
 
 bool VideoEngine::validateTimeline() const {
     if (!m_timeline) return false;
+
+    // Cached, so only clips edited since the last check are revisited
+    const auto& overlaps = m_timeline->getOverlaps();
+    if (!overlaps.empty()) {
+        LOG_WARNING("Timeline has %zu overlapping clip pairs (first on track %d at %lld ms)",
+                    overlaps.size(), overlaps.front().trackIndex,
+                    static_cast<long long>(overlaps.front().start));
+    }
     return m_timeline->isValid();
 }
 
@@ -4,6 +4,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <utility>
 #include <unordered_map>
 #include <atomic>
 #include <thread>
@@ -14,6 +15,12 @@
 #include "../models/video_clip.h"
 #include "../models/audio_track.h"
 #include "../models/effect.h"
+#include "../models/edit_journal.h"
+#include "../models/timeline_snapshot.h"
+#include "../effects/effects_processor.h"
+#include "preview_scheduler.h"
+#include "preview_cache.h"
+#include "frame_buffer.h"
 
 namespace clipforge {
 namespace core {
@@ -42,6 +49,8 @@ struct EngineConfig {
     bool enablePreviewCache = true; // Cache preview frames
     size_t maxCacheSize = 500 * 1024 * 1024; // 500 MB cache
     std::string tempDirectory = "/tmp/clipforge";
+    size_t journalCompactSize = 4 * 1024 * 1024; // Autosave rewrites the project past this journal size
+    size_t maxUndoSteps = 100;     // Edits that can be undone
 
     EngineConfig() = default;
 };
@@ -172,85 +181,118 @@ public:
      */
     [[nodiscard]] bool hasTimeline() const { return m_timeline != nullptr; }
 
+    /**
+     * @brief Get the snapshot of the timeline after the last edit
+     * @return Immutable snapshot, or nullptr without a timeline
+     *
+     * Safe to call from any thread. Preview and export render from a
+     * snapshot they hold, so edits made meanwhile never race with them.
+     */
+    [[nodiscard]] std::shared_ptr<const models::TimelineSnapshot> getTimelineSnapshot() const;
+
     // ===== Clip Management =====
 
+    /**
+     * @brief Resolve a persistent clip ID (e.g. from Java) to its handle
+     * @param clipId Clip ID
+     * @return Clip handle, or a null handle if not found
+     */
+    [[nodiscard]] models::ClipHandle findClip(const std::string& clipId) const;
+
+    /**
+     * @brief Get the persistent ID of a clip
+     * @param clip Clip handle
+     * @return Clip ID, or empty string if the handle is stale
+     */
+    [[nodiscard]] std::string getClipId(models::ClipHandle clip) const;
+
     /**
      * @brief Add a video clip to the timeline
      * @param sourcePath Path to video file
      * @param startPosition Position on timeline (ms)
      * @param trackIndex Track number
-     * @return Clip ID if successful, empty string on error
+     * @return Clip handle if successful, null handle on error
      */
-    std::string addClip(const std::string& sourcePath, int64_t startPosition = 0,
-                       int32_t trackIndex = 0);
+    models::ClipHandle addClip(const std::string& sourcePath, int64_t startPosition = 0,
+                               int32_t trackIndex = 0);
 
     /**
      * @brief Remove a clip from timeline
-     * @param clipId ID of clip to remove
+     * @param clip Clip to remove
      * @return true if removed successfully
      */
-    bool removeClip(const std::string& clipId);
+    bool removeClip(models::ClipHandle clip);
 
     /**
      * @brief Move a clip to a new position/track
-     * @param clipId Clip ID
+     * @param clip Clip handle
      * @param newStartPosition New position on timeline (ms)
      * @param newTrackIndex New track number
      * @return true if moved successfully
      */
-    bool moveClip(const std::string& clipId, int64_t newStartPosition,
-                 int32_t newTrackIndex);
+    bool moveClip(models::ClipHandle clip, int64_t newStartPosition, int32_t newTrackIndex);
 
     /**
      * @brief Trim a clip
-     * @param clipId Clip ID
+     * @param clip Clip handle
      * @param trimStart Trim start in source (ms)
      * @param trimEnd Trim end in source (ms)
      * @return true if trimmed successfully
      */
-    bool trimClip(const std::string& clipId, int64_t trimStart, int64_t trimEnd);
+    bool trimClip(models::ClipHandle clip, int64_t trimStart, int64_t trimEnd);
 
     /**
      * @brief Set clip playback speed
-     * @param clipId Clip ID
+     * @param clip Clip handle
      * @param speed Speed multiplier (0.25-4.0)
      * @return true if set successfully
      */
-    bool setClipSpeed(const std::string& clipId, float speed);
+    bool setClipSpeed(models::ClipHandle clip, float speed);
 
     /**
      * @brief Set clip volume
-     * @param clipId Clip ID
+     * @param clip Clip handle
      * @param volume Volume multiplier (0.0-2.0)
      * @return true if set successfully
      */
-    bool setClipVolume(const std::string& clipId, float volume);
+    bool setClipVolume(models::ClipHandle clip, float volume);
 
     /**
      * @brief Split a clip at a specific time
-     * @param clipId Clip to split
+     * @param clip Clip to split
      * @param splitTime Time in clip to split at (ms from clip start)
-     * @return ID of new clip created, empty string on error
+     * @return Handle of new clip created, null handle on error
      */
-    std::string splitClip(const std::string& clipId, int64_t splitTime);
+    models::ClipHandle splitClip(models::ClipHandle clip, int64_t splitTime);
 
     // ===== Effects =====
 
     /**
      * @brief Apply an effect to a clip
-     * @param clipId Clip ID
+     * @param clip Clip handle
      * @param effect Effect to apply
      * @return true if applied successfully
      */
-    bool applyEffect(const std::string& clipId, std::shared_ptr<models::Effect> effect);
+    bool applyEffect(models::ClipHandle clip, std::shared_ptr<models::Effect> effect);
 
     /**
      * @brief Remove an effect from a clip
-     * @param clipId Clip ID
+     * @param clip Clip handle
      * @param effectId Effect ID
      * @return true if removed successfully
      */
-    bool removeEffect(const std::string& clipId, const std::string& effectId);
+    bool removeEffect(models::ClipHandle clip, const std::string& effectId);
+
+    /**
+     * @brief Set a parameter of an applied effect
+     * @param clip Clip handle
+     * @param effectId Effect ID
+     * @param paramName Parameter name
+     * @param value New value (clamped to the parameter range)
+     * @return true if the parameter was set
+     */
+    bool setEffectParameter(models::ClipHandle clip, const std::string& effectId,
+                            const std::string& paramName, float value);
 
     /**
      * @brief Get available effects library
@@ -267,37 +309,51 @@ public:
 
     // ===== Audio Management =====
 
+    /**
+     * @brief Resolve a persistent audio track ID to its handle
+     * @param trackId Track ID
+     * @return Track handle, or a null handle if not found
+     */
+    [[nodiscard]] models::AudioTrackHandle findAudioTrack(const std::string& trackId) const;
+
+    /**
+     * @brief Get the persistent ID of an audio track
+     * @param track Track handle
+     * @return Track ID, or empty string if the handle is stale
+     */
+    [[nodiscard]] std::string getAudioTrackId(models::AudioTrackHandle track) const;
+
     /**
      * @brief Add an audio track
      * @param name Track display name
      * @param type Track type (main, voiceover, music, sfx)
-     * @return Track ID if successful, empty string on error
+     * @return Track handle if successful, null handle on error
      */
-    std::string addAudioTrack(const std::string& name = "Audio",
-                             const std::string& type = "main");
+    models::AudioTrackHandle addAudioTrack(const std::string& name = "Audio",
+                                          const std::string& type = "main");
 
     /**
      * @brief Remove an audio track
-     * @param trackId Track ID
+     * @param track Track handle
      * @return true if removed successfully
      */
-    bool removeAudioTrack(const std::string& trackId);
+    bool removeAudioTrack(models::AudioTrackHandle track);
 
     /**
      * @brief Set audio track volume
-     * @param trackId Track ID
+     * @param track Track handle
      * @param volume Volume multiplier (0.0-2.0)
      * @return true if set successfully
      */
-    bool setAudioTrackVolume(const std::string& trackId, float volume);
+    bool setAudioTrackVolume(models::AudioTrackHandle track, float volume);
 
     /**
      * @brief Set audio track mute state
-     * @param trackId Track ID
+     * @param track Track handle
      * @param muted true to mute
      * @return true if set successfully
      */
-    bool setAudioTrackMuted(const std::string& trackId, bool muted);
+    bool setAudioTrackMuted(models::AudioTrackHandle track, bool muted);
 
     /**
      * @brief Get total timeline duration
@@ -305,6 +361,23 @@ public:
      */
     [[nodiscard]] int64_t getTimelineDuration() const;
 
+    // ===== Undo/Redo =====
+
+    /**
+     * @brief Undo the last edit made through the engine
+     * @return true if an edit was undone
+     */
+    bool undo();
+
+    /**
+     * @brief Redo the last undone edit
+     * @return true if an edit was redone
+     */
+    bool redo();
+
+    [[nodiscard]] bool canUndo() const { return m_historyIndex > 0; }
+    [[nodiscard]] bool canRedo() const { return m_historyIndex + 1 < m_history.size(); }
+
     // ===== Preview =====
 
     /**
@@ -344,15 +417,50 @@ public:
      */
     [[nodiscard]] int64_t getPreviewPosition() const;
 
+    /**
+     * @brief Set callback receiving frames during preview playback
+     * @param callback Invoked on the presentation thread for each frame
+     */
+    void setPreviewFrameCallback(PreviewScheduler::PresentCallback callback);
+
+    /**
+     * @brief Get preview playback statistics
+     * @return Jitter and dropped/repeated frame counters
+     */
+    [[nodiscard]] PreviewStats getPreviewStats() const;
+
+    /**
+     * @brief Get preview frame cache statistics
+     * @return Hit/miss/eviction counters and memory use
+     */
+    [[nodiscard]] PreviewCacheStats getPreviewCacheStats() const;
+
+    /**
+     * @brief Get preview frame pool statistics
+     * @return Allocation/reuse counters and pooled memory
+     */
+    [[nodiscard]] FramePoolStats getFramePoolStats() const;
+
+    /**
+     * @brief Discard all cached preview frames
+     *
+     * Edits made through the engine invalidate only the affected time
+     * range. Call this after changing the timeline directly.
+     */
+    void invalidatePreviewCache();
+
     /**
      * @brief Get preview frame at specific time
      * @param timeMs Time in milliseconds
-     * @return Raw frame data (ownership transferred to caller)
+     * @return Shared RGBA frame buffer, or nullptr on error
      *
-     * Warning: This is an expensive operation. Prefer using callbacks
+     * The buffer is borrowed, not copied: it must be treated as read-only
+     * and returns to the frame pool once the caller drops it. Frames are
+     * served from the preview cache when possible, so scrubbing over the
+     * same region only renders each frame once. Prefer using callbacks
      * for real-time preview.
      */
-    [[nodiscard]] std::vector<uint8_t> getPreviewFrame(int64_t timeMs);
+    [[nodiscard]] FrameBufferPtr getPreviewFrame(int64_t timeMs);
 
     // ===== Export =====
 
@@ -396,6 +504,9 @@ public:
      * @brief Save project to file
      * @param projectPath Where to save project file
      * @return true if saved successfully
+     *
+     * Writes a full snapshot and starts an empty edit journal next to it;
+     * later edits made through the engine are journaled.
      */
     bool saveProject(const std::string& projectPath);
 
@@ -403,9 +514,23 @@ public:
      * @brief Load project from file
      * @param projectPath Path to project file
      * @return true if loaded successfully
+     *
+     * Edits journaled after the snapshot, e.g. before a crash, are replayed.
+     * Fails, leaving both files untouched, if the journal starts after the
+     * snapshot, as the edits in between are missing.
      */
     bool loadProject(const std::string& projectPath);
 
+    /**
+     * @brief Make edits since the last save durable
+     * @return true if saved
+     *
+     * Syncs the edit journal, costing the size of the edits. Once the
+     * journal exceeds journalCompactSize the project is rewritten with
+     * saveProject() instead. Requires a prior saveProject() or loadProject().
+     */
+    bool autosaveProject();
+
     /**
      * @brief Check if project has unsaved changes
      * @return true if modified since last save
@@ -456,7 +581,25 @@ private:
     // Preview
     std::atomic<bool> m_previewPlaying{false};
     std::atomic<int64_t> m_previewPosition{0};
-    std::unique_ptr<std::thread> m_previewThread;
+    std::unique_ptr<PreviewScheduler> m_previewScheduler;
+    PreviewScheduler::PresentCallback m_previewFrameCallback;
+    PreviewCache m_previewCache;
+    FramePool m_framePool;
+
+    // CPU effect rendering (sized from maxRenderThreads)
+    std::unique_ptr<effects::EffectsProcessor> m_effectsProcessor;
+    std::atomic<uint64_t> m_timelineRevision{0};  // Bumped when the timeline is replaced
+
+    // Snapshots: the published one is read by preview and export threads
+    std::shared_ptr<const models::TimelineSnapshot> m_publishedSnapshot;
+    mutable std::mutex m_snapshotMutex;
+    std::vector<std::shared_ptr<const models::TimelineSnapshot>> m_history; // Undo history, oldest first
+    size_t m_historyIndex = 0;     // Entry matching the timeline
+    std::vector<std::pair<int64_t, int64_t>> m_staleSpans; // Invalidated once the edit is published
+
+    // Persistence
+    std::string m_projectPath;                    // Last saved or loaded project
+    std::unique_ptr<models::EditJournal> m_journal; // Edits since m_projectPath was written
 
     // Export
     std::atomic<bool> m_exporting{false};
@@ -467,9 +610,68 @@ private:
     mutable std::mutex m_exportMutex;
 
     /**
-     * @brief Preview playback thread function
+     * @brief Start the preview scheduler from the current position
+     * @return true if playback started
+     */
+    bool startPreviewScheduler();
+
+    /**
+     * @brief Get a preview frame from the cache, rendering it on a miss
+     * @param frameIndex Timeline frame number
+     * @param outFrame Receives the frame
+     * @return true if the frame is available
+     */
+    bool fetchPreviewFrame(int64_t frameIndex, PreviewFrame& outFrame);
+
+    /**
+     * @brief Render a snapshot at a time into a preview-resolution frame
+     * @param snapshot Timeline state to render
+     * @param timeMs Time in milliseconds
+     * @param outFrame Receives a pooled RGBA buffer
+     * @return true if rendered
+     */
+    bool renderPreviewFrame(const models::TimelineSnapshot& snapshot, int64_t timeMs,
+                            PreviewFrame& outFrame);
+
+    /**
+     * @brief Get preview resolution height for a timeline
+     * @param properties Timeline properties
+     * @return Height in lines
+     */
+    [[nodiscard]] int32_t getPreviewHeight(const models::TimelineProperties& properties) const;
+
+    /**
+     * @brief Publish the edited timeline and add it to the undo history
+     *
+     * Called after every successful edit.
+     */
+    void commitEdit();
+
+    /**
+     * @brief Publish a timeline snapshot for preview and export
+     * @param snapshot Snapshot to publish
+     */
+    void publishSnapshot(std::shared_ptr<const models::TimelineSnapshot> snapshot);
+
+    /**
+     * @brief Return the timeline to a snapshot from the undo history
+     * @param target Snapshot to restore
+     */
+    void restoreSnapshot(const std::shared_ptr<const models::TimelineSnapshot>& target);
+
+    /**
+     * @brief Mark the preview frames covered by a clip as stale
+     * @param clip Clip whose current span is invalidated
+     *
+     * The frames are dropped by flushStaleSpans() once the edit's
+     * snapshot is published, never before.
+     */
+    void invalidateClipSpan(const models::VideoClip& clip);
+
+    /**
+     * @brief Drop the preview frames marked by invalidateClipSpan()
      */
-    void previewPlaybackThread();
+    void flushStaleSpans();
 
     /**
      * @brief Export rendering thread function
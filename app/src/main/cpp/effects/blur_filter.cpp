@@ -0,0 +1,504 @@
+#include "blur_filter.h"
+#include "color_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CLIPFORGE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CLIPFORGE_NEON_KERNELS 1
+#include <arm_neon.h>
+#endif
+
+namespace clipforge {
+namespace effects {
+
+namespace {
+
+constexpr int32_t GAUSSIAN_BAND_ROWS = 16;     // Output rows per Gaussian task
+constexpr size_t BOX_STRIP_BYTES = 256;        // Column strip per box task (64 pixels)
+constexpr int32_t TRANSPOSE_BLOCK = 32;        // 32x32 pixels = 4 KB
+
+/**
+ * @brief Round to nearest even and clamp to a byte, like the SIMD paths
+ */
+inline uint8_t toByte(float value) {
+    float rounded = std::nearbyint(value);
+    return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, rounded)));
+}
+
+inline int32_t clampRow(int32_t y, int32_t height) {
+    return std::min(height - 1, std::max(0, y));
+}
+
+// ===== Scalar kernels =====
+
+/**
+ * @brief dst[i] = w[0] * centre[i] + sum of w[k] * (above_k[i] + below_k[i])
+ * @param rows 2 * radius + 1 row pointers, centre at rows[radius]
+ */
+void gaussianScalar(const uint8_t* const* rows, const float* weights, int32_t radius,
+                    uint8_t* dst, size_t begin, size_t end) {
+    const uint8_t* centre = rows[radius];
+    for (size_t i = begin; i < end; ++i) {
+        float sum = weights[0] * static_cast<float>(centre[i]);
+        for (int32_t k = 1; k <= radius; ++k) {
+            sum += weights[k] * static_cast<float>(rows[radius - k][i] + rows[radius + k][i]);
+        }
+        dst[i] = toByte(sum);
+    }
+}
+
+/**
+ * @brief Emit one box-filtered row and slide the running sums down a row
+ */
+void boxScalar(uint16_t* sums, const uint8_t* add, const uint8_t* sub, uint8_t* dst,
+               size_t begin, size_t end, uint32_t multiplier, uint16_t bias) {
+    for (size_t i = begin; i < end; ++i) {
+        dst[i] = static_cast<uint8_t>(((sums[i] + bias) * multiplier) >> 16);
+        sums[i] = static_cast<uint16_t>(sums[i] + add[i] - sub[i]);
+    }
+}
+
+// ===== x86 kernels =====
+
+#if defined(CLIPFORGE_X86_KERNELS)
+
+/**
+ * @brief Convert the low four 16-bit lanes to floats
+ */
+__attribute__((target("sse4.1")))
+inline __m128 wordsToFloat(__m128i words) {
+    return _mm_cvtepi32_ps(_mm_cvtepu16_epi32(words));
+}
+
+__attribute__((target("sse4.1")))
+void gaussianSse41(const uint8_t* const* rows, const float* weights, int32_t radius,
+                   uint8_t* dst, size_t n) {
+    const uint8_t* centre = rows[radius];
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i c = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(centre + i)));
+        __m128 w = _mm_set1_ps(weights[0]);
+        __m128 lo = _mm_mul_ps(w, wordsToFloat(c));
+        __m128 hi = _mm_mul_ps(w, wordsToFloat(_mm_srli_si128(c, 8)));
+
+        for (int32_t k = 1; k <= radius; ++k) {
+            __m128i a = _mm_cvtepu8_epi16(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rows[radius - k] + i)));
+            __m128i b = _mm_cvtepu8_epi16(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rows[radius + k] + i)));
+            __m128i pair = _mm_add_epi16(a, b);
+            w = _mm_set1_ps(weights[k]);
+            lo = _mm_add_ps(lo, _mm_mul_ps(w, wordsToFloat(pair)));
+            hi = _mm_add_ps(hi, _mm_mul_ps(w, wordsToFloat(_mm_srli_si128(pair, 8))));
+        }
+
+        __m128i words = _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(words, words));
+    }
+    gaussianScalar(rows, weights, radius, dst, i, n);
+}
+
+__attribute__((target("avx2")))
+void gaussianAvx2(const uint8_t* const* rows, const float* weights, int32_t radius,
+                  uint8_t* dst, size_t n) {
+    const uint8_t* centre = rows[radius];
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i c = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(centre + i)));
+        __m256 w = _mm256_set1_ps(weights[0]);
+        __m256 lo = _mm256_mul_ps(w, _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(c))));
+        __m256 hi = _mm256_mul_ps(w, _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(c, 1))));
+
+        for (int32_t k = 1; k <= radius; ++k) {
+            __m256i a = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[radius - k] + i)));
+            __m256i b = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[radius + k] + i)));
+            __m256i pair = _mm256_add_epi16(a, b);
+            w = _mm256_set1_ps(weights[k]);
+            lo = _mm256_add_ps(lo, _mm256_mul_ps(w, _mm256_cvtepi32_ps(
+                                       _mm256_cvtepu16_epi32(_mm256_castsi256_si128(pair)))));
+            hi = _mm256_add_ps(hi, _mm256_mul_ps(w, _mm256_cvtepi32_ps(
+                                       _mm256_cvtepu16_epi32(_mm256_extracti128_si256(pair, 1)))));
+        }
+
+        // packs works per 128-bit lane; reorder the 64-bit halves afterwards
+        __m256i words = _mm256_permute4x64_epi64(
+            _mm256_packs_epi32(_mm256_cvtps_epi32(lo), _mm256_cvtps_epi32(hi)), 0xD8);
+        __m128i out = _mm_packus_epi16(_mm256_castsi256_si128(words),
+                                       _mm256_extracti128_si256(words, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+    }
+    gaussianScalar(rows, weights, radius, dst, i, n);
+}
+
+__attribute__((target("sse4.1")))
+void boxSse41(uint16_t* sums, const uint8_t* add, const uint8_t* sub, uint8_t* dst,
+              size_t n, uint32_t multiplier, uint16_t bias) {
+    const __m128i mul = _mm_set1_epi16(static_cast<short>(multiplier));
+    const __m128i offset = _mm_set1_epi16(static_cast<short>(bias));
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + i + 8));
+        __m128i outLo = _mm_mulhi_epu16(_mm_add_epi16(lo, offset), mul);
+        __m128i outHi = _mm_mulhi_epu16(_mm_add_epi16(hi, offset), mul);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(outLo, outHi));
+
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(add + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sub + i));
+        lo = _mm_sub_epi16(_mm_add_epi16(lo, _mm_cvtepu8_epi16(a)), _mm_cvtepu8_epi16(b));
+        hi = _mm_sub_epi16(_mm_add_epi16(hi, _mm_cvtepu8_epi16(_mm_srli_si128(a, 8))),
+                           _mm_cvtepu8_epi16(_mm_srli_si128(b, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + i), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + i + 8), hi);
+    }
+    boxScalar(sums, add, sub, dst, i, n, multiplier, bias);
+}
+
+__attribute__((target("avx2")))
+void boxAvx2(uint16_t* sums, const uint8_t* add, const uint8_t* sub, uint8_t* dst,
+             size_t n, uint32_t multiplier, uint16_t bias) {
+    const __m256i mul = _mm256_set1_epi16(static_cast<short>(multiplier));
+    const __m256i offset = _mm256_set1_epi16(static_cast<short>(bias));
+
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sums + i));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sums + i + 16));
+        __m256i outLo = _mm256_mulhi_epu16(_mm256_add_epi16(lo, offset), mul);
+        __m256i outHi = _mm256_mulhi_epu16(_mm256_add_epi16(hi, offset), mul);
+        __m256i out = _mm256_permute4x64_epi64(_mm256_packus_epi16(outLo, outHi), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+
+        __m128i aLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(add + i));
+        __m128i aHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(add + i + 16));
+        __m128i bLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sub + i));
+        __m128i bHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sub + i + 16));
+        lo = _mm256_sub_epi16(_mm256_add_epi16(lo, _mm256_cvtepu8_epi16(aLo)), _mm256_cvtepu8_epi16(bLo));
+        hi = _mm256_sub_epi16(_mm256_add_epi16(hi, _mm256_cvtepu8_epi16(aHi)), _mm256_cvtepu8_epi16(bHi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums + i), lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums + i + 16), hi);
+    }
+    boxScalar(sums, add, sub, dst, i, n, multiplier, bias);
+}
+
+#endif // CLIPFORGE_X86_KERNELS
+
+// ===== ARM kernels =====
+
+#if defined(CLIPFORGE_NEON_KERNELS)
+
+inline float32x4_t wordsToFloat(uint16x4_t words) {
+    return vcvtq_f32_u32(vmovl_u16(words));
+}
+
+inline uint16x4_t roundToWords(float32x4_t v) {
+#if defined(__aarch64__)
+    return vqmovun_s32(vcvtnq_s32_f32(v));
+#else
+    // ARMv7 has no round-to-nearest conversion; blurred values are >= 0
+    return vqmovun_s32(vcvtq_s32_f32(vaddq_f32(v, vdupq_n_f32(0.5f))));
+#endif
+}
+
+void gaussianNeon(const uint8_t* const* rows, const float* weights, int32_t radius,
+                  uint8_t* dst, size_t n) {
+    const uint8_t* centre = rows[radius];
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t c = vmovl_u8(vld1_u8(centre + i));
+        float32x4_t lo = vmulq_n_f32(wordsToFloat(vget_low_u16(c)), weights[0]);
+        float32x4_t hi = vmulq_n_f32(wordsToFloat(vget_high_u16(c)), weights[0]);
+
+        for (int32_t k = 1; k <= radius; ++k) {
+            uint16x8_t pair = vaddl_u8(vld1_u8(rows[radius - k] + i), vld1_u8(rows[radius + k] + i));
+            lo = vaddq_f32(lo, vmulq_n_f32(wordsToFloat(vget_low_u16(pair)), weights[k]));
+            hi = vaddq_f32(hi, vmulq_n_f32(wordsToFloat(vget_high_u16(pair)), weights[k]));
+        }
+
+        vst1_u8(dst + i, vqmovn_u16(vcombine_u16(roundToWords(lo), roundToWords(hi))));
+    }
+    gaussianScalar(rows, weights, radius, dst, i, n);
+}
+
+void boxNeon(uint16_t* sums, const uint8_t* add, const uint8_t* sub, uint8_t* dst,
+             size_t n, uint32_t multiplier, uint16_t bias) {
+    const uint16x4_t mul = vdup_n_u16(static_cast<uint16_t>(multiplier));
+    const uint16x8_t offset = vdupq_n_u16(bias);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t s = vld1q_u16(sums + i);
+        uint16x8_t biased = vaddq_u16(s, offset);
+        uint16x4_t outLo = vshrn_n_u32(vmull_u16(vget_low_u16(biased), mul), 16);
+        uint16x4_t outHi = vshrn_n_u32(vmull_u16(vget_high_u16(biased), mul), 16);
+        vst1_u8(dst + i, vmovn_u16(vcombine_u16(outLo, outHi)));
+
+        s = vsubw_u8(vaddw_u8(s, vld1_u8(add + i)), vld1_u8(sub + i));
+        vst1q_u16(sums + i, s);
+    }
+    boxScalar(sums, add, sub, dst, i, n, multiplier, bias);
+}
+
+#endif // CLIPFORGE_NEON_KERNELS
+
+void gaussianRow(const uint8_t* const* rows, const float* weights, int32_t radius,
+                 uint8_t* dst, size_t n) {
+    switch (ColorKernels::getLevel()) {
+#if defined(CLIPFORGE_X86_KERNELS)
+        case SimdLevel::AVX2:
+            gaussianAvx2(rows, weights, radius, dst, n);
+            return;
+        case SimdLevel::SSE41:
+            gaussianSse41(rows, weights, radius, dst, n);
+            return;
+#endif
+#if defined(CLIPFORGE_NEON_KERNELS)
+        case SimdLevel::NEON:
+            gaussianNeon(rows, weights, radius, dst, n);
+            return;
+#endif
+        default:
+            gaussianScalar(rows, weights, radius, dst, 0, n);
+            return;
+    }
+}
+
+void boxRow(uint16_t* sums, const uint8_t* add, const uint8_t* sub, uint8_t* dst,
+            size_t n, uint32_t multiplier, uint16_t bias) {
+    switch (ColorKernels::getLevel()) {
+#if defined(CLIPFORGE_X86_KERNELS)
+        case SimdLevel::AVX2:
+            boxAvx2(sums, add, sub, dst, n, multiplier, bias);
+            return;
+        case SimdLevel::SSE41:
+            boxSse41(sums, add, sub, dst, n, multiplier, bias);
+            return;
+#endif
+#if defined(CLIPFORGE_NEON_KERNELS)
+        case SimdLevel::NEON:
+            boxNeon(sums, add, sub, dst, n, multiplier, bias);
+            return;
+#endif
+        default:
+            boxScalar(sums, add, sub, dst, 0, n, multiplier, bias);
+            return;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// BlurKernel Implementation
+// ============================================================================
+
+std::vector<float> BlurKernel::gaussianWeights(float radius) {
+    radius = std::min(MAX_RADIUS, std::max(0.5f, radius));
+    auto reach = static_cast<int32_t>(std::ceil(radius));
+    float sigma = radius / 3.0f;
+
+    std::vector<float> weights(static_cast<size_t>(reach) + 1);
+    float total = 0.0f;
+    for (int32_t k = 0; k <= reach; ++k) {
+        float weight = std::exp(-static_cast<float>(k * k) / (2.0f * sigma * sigma));
+        weights[static_cast<size_t>(k)] = weight;
+        total += k == 0 ? weight : 2.0f * weight;
+    }
+    for (auto& weight : weights) {
+        weight /= total;
+    }
+    return weights;
+}
+
+std::array<int32_t, 3> BlurKernel::boxRadii(float radius) {
+    radius = std::min(MAX_RADIUS, std::max(0.5f, radius));
+    float sigma = radius / 3.0f;
+
+    // Widths of three boxes whose convolution has the Gaussian's variance
+    // (W. Jarosz, "Fast Image Convolutions"; P. Kovesi's integer widths)
+    constexpr int32_t PASSES = 3;
+    float variance = 12.0f * sigma * sigma;
+    auto lower = static_cast<int32_t>(std::floor(std::sqrt(variance / PASSES + 1.0f)));
+    if (lower % 2 == 0) lower--;
+    lower = std::max(1, lower);
+    int32_t upper = lower + 2;
+    auto lowerCount = static_cast<int32_t>(std::lround(
+        (variance - static_cast<float>(PASSES * lower * lower + 4 * PASSES * lower + 3 * PASSES)) /
+        static_cast<float>(-4 * lower - 4)));
+
+    std::array<int32_t, 3> radii{};
+    for (int32_t pass = 0; pass < PASSES; ++pass) {
+        int32_t width = pass < lowerCount ? lower : upper;
+        radii[static_cast<size_t>(pass)] = std::min(MAX_BOX_RADIUS, (width - 1) / 2);
+    }
+    return radii;
+}
+
+void BlurKernel::linearTaps(const std::vector<float>& weights,
+                            std::vector<float>& outOffsets, std::vector<float>& outWeights) {
+    outOffsets.clear();
+    outWeights.clear();
+    if (weights.empty()) return;
+
+    outOffsets.push_back(0.0f);
+    outWeights.push_back(weights[0]);
+    for (size_t k = 1; k < weights.size(); k += 2) {
+        float first = weights[k];
+        float second = k + 1 < weights.size() ? weights[k + 1] : 0.0f;
+        float sum = first + second;
+        outWeights.push_back(sum);
+        outOffsets.push_back(sum > 0.0f
+            ? (static_cast<float>(k) * first + static_cast<float>(k + 1) * second) / sum
+            : static_cast<float>(k));
+    }
+}
+
+// ============================================================================
+// BlurFilter Implementation
+// ============================================================================
+
+void BlurFilter::apply(const ImageView& image, float radius, float intensity,
+                       BlurQuality quality, utils::ThreadPool& pool) {
+    if (radius < 0.5f || intensity <= 0.0f || image.width <= 0 || image.height <= 0) return;
+
+    if (quality == BlurQuality::HIGH) {
+        m_weights = BlurKernel::gaussianWeights(radius);
+    } else {
+        m_boxRadii = BlurKernel::boxRadii(radius);
+    }
+
+    size_t frameBytes = static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * 4;
+    m_first.resize(frameBytes);
+    m_second.resize(frameBytes);
+
+    // Columns: image -> first
+    int32_t rowBytes = image.width * 4;
+    ImageView first{m_first.data(), image.width, image.height, rowBytes};
+    ImageView second{m_second.data(), image.width, image.height, rowBytes};
+    blurColumns(image, first, second, quality, pool);
+
+    // Rows, as the columns of the transpose: first -> second -> first
+    int32_t transposedBytes = image.height * 4;
+    ImageView firstT{m_first.data(), image.height, image.width, transposedBytes};
+    ImageView secondT{m_second.data(), image.height, image.width, transposedBytes};
+    transpose(first, secondT, 256, pool);
+    blurColumns(secondT, firstT, secondT, quality, pool);
+
+    // Back into the frame, mixed with the original by intensity
+    auto weight = static_cast<int32_t>(std::lround(std::min(1.0f, intensity) * 256.0f));
+    transpose(firstT, image, weight, pool);
+}
+
+void BlurFilter::blurColumns(const ImageView& src, const ImageView& dst, const ImageView& spare,
+                             BlurQuality quality, utils::ThreadPool& pool) {
+    if (quality == BlurQuality::HIGH) {
+        gaussianColumns(src, dst, pool);
+        return;
+    }
+
+    // src -> dst -> spare -> dst; src is read only by the first pass
+    boxColumns(src, dst, m_boxRadii[0], pool);
+    boxColumns(dst, spare, m_boxRadii[1], pool);
+    boxColumns(spare, dst, m_boxRadii[2], pool);
+}
+
+void BlurFilter::gaussianColumns(const ImageView& src, const ImageView& dst,
+                                 utils::ThreadPool& pool) {
+    auto radius = static_cast<int32_t>(m_weights.size()) - 1;
+    auto rowBytes = static_cast<size_t>(src.width) * 4;
+    size_t bands = static_cast<size_t>((src.height + GAUSSIAN_BAND_ROWS - 1) / GAUSSIAN_BAND_ROWS);
+
+    pool.parallelFor(bands, [&](size_t band) {
+        std::vector<const uint8_t*> rows(static_cast<size_t>(2 * radius + 1));
+        int32_t begin = static_cast<int32_t>(band) * GAUSSIAN_BAND_ROWS;
+        int32_t end = std::min(src.height, begin + GAUSSIAN_BAND_ROWS);
+
+        for (int32_t y = begin; y < end; ++y) {
+            for (int32_t k = -radius; k <= radius; ++k) {
+                rows[static_cast<size_t>(k + radius)] = src.row(clampRow(y + k, src.height));
+            }
+            gaussianRow(rows.data(), m_weights.data(), radius, dst.row(y), rowBytes);
+        }
+    });
+}
+
+void BlurFilter::boxColumns(const ImageView& src, const ImageView& dst, int32_t radius,
+                            utils::ThreadPool& pool) {
+    auto rowBytes = static_cast<size_t>(src.width) * 4;
+    if (radius <= 0) {
+        for (int32_t y = 0; y < src.height; ++y) {
+            std::memcpy(dst.row(y), src.row(y), rowBytes);
+        }
+        return;
+    }
+
+    // Rounded division by the box width as a 16-bit multiply-high
+    uint32_t width = static_cast<uint32_t>(2 * radius + 1);
+    uint32_t multiplier = (65536u + width / 2) / width;
+    auto bias = static_cast<uint16_t>(width / 2);
+    size_t strips = (rowBytes + BOX_STRIP_BYTES - 1) / BOX_STRIP_BYTES;
+
+    pool.parallelFor(strips, [&](size_t strip) {
+        size_t offset = strip * BOX_STRIP_BYTES;
+        size_t count = std::min(BOX_STRIP_BYTES, rowBytes - offset);
+        uint16_t sums[BOX_STRIP_BYTES];
+
+        // Window for row 0, with edge rows repeated
+        std::fill(sums, sums + count, static_cast<uint16_t>(0));
+        for (int32_t k = -radius; k <= radius; ++k) {
+            const uint8_t* row = src.row(clampRow(k, src.height)) + offset;
+            for (size_t i = 0; i < count; ++i) {
+                sums[i] = static_cast<uint16_t>(sums[i] + row[i]);
+            }
+        }
+
+        for (int32_t y = 0; y < src.height; ++y) {
+            const uint8_t* add = src.row(clampRow(y + radius + 1, src.height)) + offset;
+            const uint8_t* sub = src.row(clampRow(y - radius, src.height)) + offset;
+            boxRow(sums, add, sub, dst.row(y) + offset, count, multiplier, bias);
+        }
+    });
+}
+
+void BlurFilter::transpose(const ImageView& src, const ImageView& dst, int32_t weight,
+                           utils::ThreadPool& pool) {
+    size_t bands = static_cast<size_t>((src.height + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK);
+
+    pool.parallelFor(bands, [&](size_t band) {
+        int32_t y0 = static_cast<int32_t>(band) * TRANSPOSE_BLOCK;
+        int32_t y1 = std::min(src.height, y0 + TRANSPOSE_BLOCK);
+
+        for (int32_t x0 = 0; x0 < src.width; x0 += TRANSPOSE_BLOCK) {
+            int32_t x1 = std::min(src.width, x0 + TRANSPOSE_BLOCK);
+            for (int32_t y = y0; y < y1; ++y) {
+                const uint8_t* in = src.row(y);
+                for (int32_t x = x0; x < x1; ++x) {
+                    uint8_t* out = dst.row(x) + static_cast<ptrdiff_t>(y) * 4;
+                    const uint8_t* pixel = in + static_cast<ptrdiff_t>(x) * 4;
+                    if (weight >= 256) {
+                        std::memcpy(out, pixel, 4);
+                        continue;
+                    }
+                    for (int c = 0; c < 4; ++c) {
+                        out[c] = static_cast<uint8_t>(
+                            (out[c] * (256 - weight) + pixel[c] * weight + 128) >> 8);
+                    }
+                }
+            }
+        }
+    });
+}
+
+} // namespace effects
+} // namespace clipforge
@@ -0,0 +1,118 @@
+#ifndef CLIPFORGE_BLUR_FILTER_H
+#define CLIPFORGE_BLUR_FILTER_H
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "../utils/thread_pool.h"
+#include "filter_library.h"
+
+namespace clipforge {
+namespace effects {
+
+/**
+ * @class BlurKernel
+ * @brief Blur weights shared by the CPU filter and the GLSL blur
+ *
+ * The radius is the reach of the kernel in pixels: the Gaussian has
+ * sigma = radius / 3 and is truncated at 3 sigma.
+ */
+class BlurKernel {
+public:
+    static constexpr float MAX_RADIUS = 50.0f;
+    static constexpr int32_t MAX_BOX_RADIUS = 127;   // Keeps 16-bit running sums exact
+
+    /**
+     * @brief Get one side of a normalized Gaussian kernel
+     * @param radius Blur radius in pixels (0.5 to 50)
+     * @return weights[0] for the centre and weights[k] for offsets +/-k;
+     *         centre + 2 * sides sum to 1
+     */
+    [[nodiscard]] static std::vector<float> gaussianWeights(float radius);
+
+    /**
+     * @brief Get box radii whose three passes approximate the Gaussian
+     * @param radius Blur radius in pixels (0.5 to 50)
+     * @return Radius of each pass (box width 2r + 1), 0 for no-op passes
+     */
+    [[nodiscard]] static std::array<int32_t, 3> boxRadii(float radius);
+
+    /**
+     * @brief Merge pairs of taps into bilinear samples for the GPU
+     * @param weights One side of a symmetric kernel (see gaussianWeights)
+     * @param outOffsets Receives tap offsets in texels, 0 first
+     * @param outWeights Receives the weight of each tap (per side)
+     *
+     * Two neighbouring texels a and b are read by one GL_LINEAR fetch
+     * at (a * wa + b * wb) / (wa + wb), roughly halving the taps.
+     */
+    static void linearTaps(const std::vector<float>& weights,
+                           std::vector<float>& outOffsets, std::vector<float>& outWeights);
+};
+
+/**
+ * @class BlurFilter
+ * @brief Separable CPU blur for RGBA8 frames
+ *
+ * Both quality levels run column passes over whole rows, which the
+ * SIMD kernels (selected like ColorKernels) handle 16 or 32 bytes at a
+ * time, and blur rows by transposing the frame in cache-sized blocks.
+ *
+ * - HIGH: exact Gaussian; mirrored taps are added before weighting, so
+ *   cost grows with the radius at half the multiplies.
+ * - FAST: three box passes with running sums; cost is independent of
+ *   the radius. The mean difference from HIGH is about one code value,
+ *   more on fine detail the box shape treats differently.
+ *
+ * Not thread-safe; owners serialize calls (scratch frames are reused).
+ */
+class BlurFilter {
+public:
+    /**
+     * @brief Blur a frame in place
+     * @param image Frame to blur
+     * @param radius Blur radius in pixels (clamped to 50)
+     * @param intensity Mix between the original (0) and the blur (1)
+     * @param quality Gaussian or box approximation
+     * @param pool Threads to split the passes across
+     */
+    void apply(const ImageView& image, float radius, float intensity,
+               BlurQuality quality, utils::ThreadPool& pool);
+
+private:
+    std::vector<uint8_t> m_first;      // Scratch frames, reused between calls
+    std::vector<uint8_t> m_second;
+    std::vector<float> m_weights;
+    std::array<int32_t, 3> m_boxRadii{};
+
+    /**
+     * @brief Blur the columns of src into dst (spare is clobbered)
+     */
+    void blurColumns(const ImageView& src, const ImageView& dst, const ImageView& spare,
+                     BlurQuality quality, utils::ThreadPool& pool);
+
+    /**
+     * @brief Gaussian over columns: each output row weights 2R + 1 input rows
+     */
+    void gaussianColumns(const ImageView& src, const ImageView& dst, utils::ThreadPool& pool);
+
+    /**
+     * @brief Box over columns with running sums, one vertical strip per task
+     */
+    static void boxColumns(const ImageView& src, const ImageView& dst, int32_t radius,
+                           utils::ThreadPool& pool);
+
+    /**
+     * @brief Transpose src into dst, optionally mixing with dst's current contents
+     * @param weight Weight of src in 1/256 (256 overwrites dst)
+     */
+    static void transpose(const ImageView& src, const ImageView& dst, int32_t weight,
+                          utils::ThreadPool& pool);
+};
+
+} // namespace effects
+} // namespace clipforge
+
+#endif // CLIPFORGE_BLUR_FILTER_H
@@ -0,0 +1,564 @@
+#include "color_kernels.h"
+#include "../utils/logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CLIPFORGE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CLIPFORGE_NEON_KERNELS 1
+#include <arm_neon.h>
+#endif
+
+namespace clipforge {
+namespace effects {
+
+namespace {
+
+// BT.601 full-range conversion with chroma centred on zero
+constexpr float RGB_TO_YUV[3][3] = {
+    { 0.299f,     0.587f,     0.114f},
+    {-0.168736f, -0.331264f,  0.5f},
+    { 0.5f,      -0.418688f, -0.081312f},
+};
+constexpr float YUV_TO_RGB[3][3] = {
+    {1.0f,  0.0f,       1.402f},
+    {1.0f, -0.344136f, -0.714136f},
+    {1.0f,  1.772f,     0.0f},
+};
+
+constexpr float SEPIA[3][3] = {
+    {0.393f, 0.769f, 0.189f},
+    {0.349f, 0.686f, 0.168f},
+    {0.272f, 0.534f, 0.131f},
+};
+
+/**
+ * @brief Build (1 - t) * I + t * (weights in every row)
+ */
+ColorMatrix mixWithRows(const float weights[3], float identityScale, float rowScale) {
+    ColorMatrix result;
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            result.m[row][col] = (row == col ? identityScale : 0.0f) + rowScale * weights[col];
+        }
+        result.m[row][3] = 0.0f;
+    }
+    return result;
+}
+
+/**
+ * @brief Round to nearest even and clamp to a byte, like the SIMD paths
+ */
+inline uint8_t toByte(float value) {
+    float rounded = std::nearbyint(value);
+    return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, rounded)));
+}
+
+SimdLevel detectLevel() {
+#if defined(CLIPFORGE_NEON_KERNELS)
+    return SimdLevel::NEON;
+#elif defined(CLIPFORGE_X86_KERNELS)
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return SimdLevel::SSE41;
+    return SimdLevel::SCALAR;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+std::atomic<SimdLevel>& activeLevel() {
+    static std::atomic<SimdLevel> level{[] {
+        SimdLevel detected = detectLevel();
+        LOG_INFO("Color kernels using %s", ColorKernels::getLevelName(detected));
+        return detected;
+    }()};
+    return level;
+}
+
+// ===== Scalar kernels =====
+
+void rgbaScalar(const ColorMatrix& cm, uint8_t* p, size_t count) {
+    const auto& m = cm.m;
+    for (size_t i = 0; i < count; ++i, p += 4) {
+        float r = p[0];
+        float g = p[1];
+        float b = p[2];
+        // Same association as the vector paths
+        for (int row = 0; row < 3; ++row) {
+            p[row] = toByte((m[row][0] * r + m[row][1] * g) + (m[row][2] * b + m[row][3]));
+        }
+    }
+}
+
+void affineScalar(uint8_t* p, size_t count, float scale, float offset) {
+    for (size_t i = 0; i < count; ++i) {
+        p[i] = toByte(scale * static_cast<float>(p[i]) + offset);
+    }
+}
+
+// ===== x86 kernels =====
+
+#if defined(CLIPFORGE_X86_KERNELS)
+
+__attribute__((target("sse4.1")))
+void rgbaSse41(const ColorMatrix& cm, uint8_t* p, size_t count) {
+    const auto& m = cm.m;
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi32(255);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4, p += 16) {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128 r = _mm_cvtepi32_ps(_mm_and_si128(px, byteMask));
+        __m128 g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 8), byteMask));
+        __m128 b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 16), byteMask));
+
+        __m128i out = _mm_and_si128(px, alphaMask);
+        for (int row = 0; row < 3; ++row) {
+            __m128 v = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[row][0]), r),
+                           _mm_mul_ps(_mm_set1_ps(m[row][1]), g)),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[row][2]), b), _mm_set1_ps(m[row][3])));
+            __m128i c = _mm_min_epi32(_mm_max_epi32(_mm_cvtps_epi32(v), zero), max);
+            out = _mm_or_si128(out, _mm_slli_epi32(c, 8 * row));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), out);
+    }
+    rgbaScalar(cm, p, count - i);
+}
+
+__attribute__((target("avx2")))
+void rgbaAvx2(const ColorMatrix& cm, uint8_t* p, size_t count) {
+    const auto& m = cm.m;
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi32(255);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8, p += 32) {
+        __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256 r = _mm256_cvtepi32_ps(_mm256_and_si256(px, byteMask));
+        __m256 g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(px, 8), byteMask));
+        __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(px, 16), byteMask));
+
+        __m256i out = _mm256_and_si256(px, alphaMask);
+        for (int row = 0; row < 3; ++row) {
+            __m256 v = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[row][0]), r),
+                              _mm256_mul_ps(_mm256_set1_ps(m[row][1]), g)),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[row][2]), b),
+                              _mm256_set1_ps(m[row][3])));
+            __m256i c = _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(v), zero), max);
+            out = _mm256_or_si256(out, _mm256_slli_epi32(c, 8 * row));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), out);
+    }
+    rgbaSse41(cm, p, count - i);
+}
+
+/**
+ * @brief Scale the low four bytes of a vector to rounded 32-bit lanes
+ */
+__attribute__((target("sse4.1")))
+inline __m128i affineQuarterSse41(__m128i bytes, __m128 scale, __m128 offset) {
+    __m128 v = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(bytes));
+    return _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), offset));
+}
+
+__attribute__((target("sse4.1")))
+void affineSse41(uint8_t* p, size_t count, float scale, float offset) {
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 o = _mm_set1_ps(offset);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16, p += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // Byte shifts need immediates, so the four quarters are spelled out
+        __m128i lo = _mm_packs_epi32(affineQuarterSse41(bytes, s, o),
+                                     affineQuarterSse41(_mm_srli_si128(bytes, 4), s, o));
+        __m128i hi = _mm_packs_epi32(affineQuarterSse41(_mm_srli_si128(bytes, 8), s, o),
+                                     affineQuarterSse41(_mm_srli_si128(bytes, 12), s, o));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(lo, hi));
+    }
+    affineScalar(p, count - i, scale, offset);
+}
+
+__attribute__((target("avx2")))
+void affineAvx2(uint8_t* p, size_t count, float scale, float offset) {
+    const __m256 s = _mm256_set1_ps(scale);
+    const __m256 o = _mm256_set1_ps(offset);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16, p += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes));
+        __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8)));
+        __m256i loI = _mm256_cvtps_epi32(_mm256_add_ps(_mm256_mul_ps(lo, s), o));
+        __m256i hiI = _mm256_cvtps_epi32(_mm256_add_ps(_mm256_mul_ps(hi, s), o));
+
+        // packs works per 128-bit lane; reorder the 64-bit halves afterwards
+        __m256i words = _mm256_permute4x64_epi64(_mm256_packs_epi32(loI, hiI), 0xD8);
+        __m128i out = _mm_packus_epi16(_mm256_castsi256_si128(words),
+                                       _mm256_extracti128_si256(words, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), out);
+    }
+    affineScalar(p, count - i, scale, offset);
+}
+
+#endif // CLIPFORGE_X86_KERNELS
+
+// ===== ARM kernels =====
+
+#if defined(CLIPFORGE_NEON_KERNELS)
+
+inline int32x4_t roundToInt(float32x4_t v) {
+#if defined(__aarch64__)
+    return vcvtnq_s32_f32(v);
+#else
+    // ARMv7 has no round-to-nearest conversion; values are clamped to >= 0 below
+    return vcvtq_s32_f32(vaddq_f32(v, vdupq_n_f32(0.5f)));
+#endif
+}
+
+inline uint8x8_t narrowToBytes(float32x4_t lo, float32x4_t hi) {
+    uint16x8_t words = vcombine_u16(vqmovun_s32(roundToInt(lo)), vqmovun_s32(roundToInt(hi)));
+    return vqmovn_u16(words);
+}
+
+void rgbaNeon(const ColorMatrix& cm, uint8_t* p, size_t count) {
+    const auto& m = cm.m;
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8, p += 32) {
+        uint8x8x4_t px = vld4_u8(p);
+        uint16x8_t r16 = vmovl_u8(px.val[0]);
+        uint16x8_t g16 = vmovl_u8(px.val[1]);
+        uint16x8_t b16 = vmovl_u8(px.val[2]);
+        float32x4_t r[2] = {vcvtq_f32_u32(vmovl_u16(vget_low_u16(r16))),
+                            vcvtq_f32_u32(vmovl_u16(vget_high_u16(r16)))};
+        float32x4_t g[2] = {vcvtq_f32_u32(vmovl_u16(vget_low_u16(g16))),
+                            vcvtq_f32_u32(vmovl_u16(vget_high_u16(g16)))};
+        float32x4_t b[2] = {vcvtq_f32_u32(vmovl_u16(vget_low_u16(b16))),
+                            vcvtq_f32_u32(vmovl_u16(vget_high_u16(b16)))};
+
+        for (int row = 0; row < 3; ++row) {
+            float32x4_t v[2];
+            for (int h = 0; h < 2; ++h) {
+                v[h] = vaddq_f32(
+                    vaddq_f32(vmulq_n_f32(r[h], m[row][0]), vmulq_n_f32(g[h], m[row][1])),
+                    vaddq_f32(vmulq_n_f32(b[h], m[row][2]), vdupq_n_f32(m[row][3])));
+            }
+            px.val[row] = narrowToBytes(v[0], v[1]);
+        }
+        vst4_u8(p, px);
+    }
+    rgbaScalar(cm, p, count - i);
+}
+
+void affineNeon(uint8_t* p, size_t count, float scale, float offset) {
+    const float32x4_t o = vdupq_n_f32(offset);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8, p += 8) {
+        uint16x8_t words = vmovl_u8(vld1_u8(p));
+        float32x4_t lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(words)));
+        float32x4_t hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(words)));
+        lo = vaddq_f32(vmulq_n_f32(lo, scale), o);
+        hi = vaddq_f32(vmulq_n_f32(hi, scale), o);
+        vst1_u8(p, narrowToBytes(lo, hi));
+    }
+    affineScalar(p, count - i, scale, offset);
+}
+
+#endif // CLIPFORGE_NEON_KERNELS
+
+/**
+ * @brief Apply a matrix to NV12 by converting each 2x2 block through RGB
+ *
+ * With an odd width or height the last column or row forms 2x1, 1x2 or
+ * 1x1 blocks with their own chroma sample.
+ */
+void nv12ViaRgb(const ColorMatrix& cm, const Nv12Image& image) {
+    const auto& m = cm.m;
+
+    for (int32_t by = 0; by < image.height; by += 2) {
+        uint8_t* uvRow = image.uv + static_cast<ptrdiff_t>(by / 2) * image.uvStride;
+        const int32_t rows = std::min(2, image.height - by);
+
+        for (int32_t bx = 0; bx < image.width; bx += 2) {
+            const int32_t cols = std::min(2, image.width - bx);
+            float u = static_cast<float>(uvRow[bx]) - 128.0f;
+            float v = static_cast<float>(uvRow[bx + 1]) - 128.0f;
+            float uSum = 0.0f;
+            float vSum = 0.0f;
+
+            for (int32_t dy = 0; dy < rows; ++dy) {
+                uint8_t* yRow = image.y + static_cast<ptrdiff_t>(by + dy) * image.yStride;
+                for (int32_t dx = 0; dx < cols; ++dx) {
+                    float luma = yRow[bx + dx];
+                    float rgb[3];
+                    float out[3];
+                    for (int c = 0; c < 3; ++c) {
+                        rgb[c] = luma + YUV_TO_RGB[c][1] * u + YUV_TO_RGB[c][2] * v;
+                    }
+                    for (int c = 0; c < 3; ++c) {
+                        out[c] = m[c][0] * rgb[0] + m[c][1] * rgb[1] + m[c][2] * rgb[2] + m[c][3];
+                        out[c] = std::min(255.0f, std::max(0.0f, out[c]));
+                    }
+                    yRow[bx + dx] = toByte(RGB_TO_YUV[0][0] * out[0] + RGB_TO_YUV[0][1] * out[1] +
+                                           RGB_TO_YUV[0][2] * out[2]);
+                    uSum += RGB_TO_YUV[1][0] * out[0] + RGB_TO_YUV[1][1] * out[1] +
+                            RGB_TO_YUV[1][2] * out[2];
+                    vSum += RGB_TO_YUV[2][0] * out[0] + RGB_TO_YUV[2][1] * out[1] +
+                            RGB_TO_YUV[2][2] * out[2];
+                }
+            }
+
+            const float weight = 1.0f / static_cast<float>(rows * cols);
+            uvRow[bx] = toByte(uSum * weight + 128.0f);
+            uvRow[bx + 1] = toByte(vSum * weight + 128.0f);
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// ColorMatrix Implementation
+// ============================================================================
+
+ColorMatrix ColorMatrix::brightness(float brightness, float intensity) {
+    ColorMatrix result;
+    for (int row = 0; row < 3; ++row) {
+        result.m[row][3] = brightness * intensity * 255.0f;
+    }
+    return result;
+}
+
+ColorMatrix ColorMatrix::contrast(float contrast, float intensity) {
+    ColorMatrix result;
+    float scale = 1.0f - intensity + intensity * contrast;
+    for (int row = 0; row < 3; ++row) {
+        result.m[row][row] = scale;
+        result.m[row][3] = 127.5f * intensity * (1.0f - contrast);
+    }
+    return result;
+}
+
+ColorMatrix ColorMatrix::saturation(float saturation, float intensity) {
+    return mixWithRows(RGB_TO_YUV[0], 1.0f - intensity + intensity * saturation,
+                       intensity * (1.0f - saturation));
+}
+
+ColorMatrix ColorMatrix::grayscale(float intensity) {
+    return mixWithRows(RGB_TO_YUV[0], 1.0f - intensity, intensity);
+}
+
+ColorMatrix ColorMatrix::sepia(float intensity) {
+    ColorMatrix result;
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            result.m[row][col] = (row == col ? 1.0f - intensity : 0.0f) + intensity * SEPIA[row][col];
+        }
+    }
+    return result;
+}
+
+ColorMatrix ColorMatrix::temperature(float temperature, float intensity) {
+    ColorMatrix result;
+    result.m[0][3] = 25.5f * temperature * intensity;
+    result.m[2][3] = -25.5f * temperature * intensity;
+    return result;
+}
+
+ColorMatrix ColorMatrix::tint(float tint, float intensity) {
+    ColorMatrix result;
+    result.m[1][3] = 25.5f * tint * intensity;
+    return result;
+}
+
+ColorMatrix ColorMatrix::invert(float intensity) {
+    ColorMatrix result;
+    for (int row = 0; row < 3; ++row) {
+        result.m[row][row] = 1.0f - 2.0f * intensity;
+        result.m[row][3] = 255.0f * intensity;
+    }
+    return result;
+}
+
+bool ColorMatrix::isPerChannel() const {
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            if (row != col && m[row][col] != 0.0f) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void ColorMatrix::getOutputRange(int row, float& outMin, float& outMax) const {
+    // Affine over a box: each term reaches its extremes independently
+    outMin = m[row][3];
+    outMax = m[row][3];
+    for (int col = 0; col < 3; ++col) {
+        float term = m[row][col] * 255.0f;
+        outMin += std::min(0.0f, term);
+        outMax += std::max(0.0f, term);
+    }
+}
+
+ColorMatrix ColorMatrix::after(const ColorMatrix& first) const {
+    ColorMatrix result;
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            float sum = col == 3 ? m[row][3] : 0.0f;
+            for (int k = 0; k < 3; ++k) {
+                sum += m[row][k] * first.m[k][col];
+            }
+            result.m[row][col] = sum;
+        }
+    }
+    return result;
+}
+
+// ============================================================================
+// ColorKernels Implementation
+// ============================================================================
+
+SimdLevel ColorKernels::getLevel() {
+    return activeLevel().load(std::memory_order_relaxed);
+}
+
+bool ColorKernels::setLevel(SimdLevel level) {
+    if (!isSupported(level)) {
+        return false;
+    }
+    activeLevel().store(level, std::memory_order_relaxed);
+    return true;
+}
+
+bool ColorKernels::isSupported(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR:
+            return true;
+#if defined(CLIPFORGE_X86_KERNELS)
+        case SimdLevel::SSE41:
+            return __builtin_cpu_supports("sse4.1");
+        case SimdLevel::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+#if defined(CLIPFORGE_NEON_KERNELS)
+        case SimdLevel::NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* ColorKernels::getLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR: return "scalar";
+        case SimdLevel::SSE41: return "SSE4.1";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::NEON: return "NEON";
+    }
+    return "unknown";
+}
+
+void ColorKernels::applyRgba(const ColorMatrix& matrix, uint8_t* pixels, size_t pixelCount) {
+    switch (getLevel()) {
+#if defined(CLIPFORGE_X86_KERNELS)
+        case SimdLevel::AVX2:
+            rgbaAvx2(matrix, pixels, pixelCount);
+            return;
+        case SimdLevel::SSE41:
+            rgbaSse41(matrix, pixels, pixelCount);
+            return;
+#endif
+#if defined(CLIPFORGE_NEON_KERNELS)
+        case SimdLevel::NEON:
+            rgbaNeon(matrix, pixels, pixelCount);
+            return;
+#endif
+        default:
+            rgbaScalar(matrix, pixels, pixelCount);
+            return;
+    }
+}
+
+void ColorKernels::applyAffine(uint8_t* data, size_t count, float scale, float offset) {
+    switch (getLevel()) {
+#if defined(CLIPFORGE_X86_KERNELS)
+        case SimdLevel::AVX2:
+            affineAvx2(data, count, scale, offset);
+            return;
+        case SimdLevel::SSE41:
+            affineSse41(data, count, scale, offset);
+            return;
+#endif
+#if defined(CLIPFORGE_NEON_KERNELS)
+        case SimdLevel::NEON:
+            affineNeon(data, count, scale, offset);
+            return;
+#endif
+        default:
+            affineScalar(data, count, scale, offset);
+            return;
+    }
+}
+
+void ColorKernels::applyNv12(const ColorMatrix& matrix, const Nv12Image& image) {
+    if (!image.y || !image.uv || image.width <= 0 || image.height <= 0) return;
+
+    // Express the transform in YUV: yuv' = A * M * A^-1 * yuv + A * offset
+    float yuv[3][4] = {};
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            for (int j = 0; j < 3; ++j) {
+                for (int k = 0; k < 3; ++k) {
+                    yuv[row][col] += RGB_TO_YUV[row][j] * matrix.m[j][k] * YUV_TO_RGB[k][col];
+                }
+            }
+        }
+        for (int j = 0; j < 3; ++j) {
+            yuv[row][3] += RGB_TO_YUV[row][j] * matrix.m[j][3];
+        }
+    }
+
+    constexpr float EPSILON = 1e-3f;
+    bool separable = std::fabs(yuv[0][1]) < EPSILON && std::fabs(yuv[0][2]) < EPSILON &&
+                     std::fabs(yuv[1][0]) < EPSILON && std::fabs(yuv[2][0]) < EPSILON &&
+                     std::fabs(yuv[1][2]) < EPSILON && std::fabs(yuv[2][1]) < EPSILON &&
+                     std::fabs(yuv[1][1] - yuv[2][2]) < EPSILON &&
+                     std::fabs(yuv[1][3]) < 0.05f && std::fabs(yuv[2][3]) < 0.05f;
+
+    if (!separable) {
+        nv12ViaRgb(matrix, image);
+        return;
+    }
+
+    // Luma and chroma map independently: one affine pass per plane
+    for (int32_t row = 0; row < image.height; ++row) {
+        applyAffine(image.y + static_cast<ptrdiff_t>(row) * image.yStride,
+                    static_cast<size_t>(image.width), yuv[0][0], yuv[0][3]);
+    }
+    float chromaScale = yuv[1][1];
+    for (int32_t row = 0; row < (image.height + 1) / 2; ++row) {
+        applyAffine(image.uv + static_cast<ptrdiff_t>(row) * image.uvStride,
+                    static_cast<size_t>((image.width + 1) & ~1), chromaScale,
+                    128.0f * (1.0f - chromaScale));
+    }
+}
+
+} // namespace effects
+} // namespace clipforge
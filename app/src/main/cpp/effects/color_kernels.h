@@ -0,0 +1,201 @@
+#ifndef CLIPFORGE_COLOR_KERNELS_H
+#define CLIPFORGE_COLOR_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace clipforge {
+namespace effects {
+
+/**
+ * @enum SimdLevel
+ * @brief Instruction set used by the color kernels
+ */
+enum class SimdLevel {
+    SCALAR,            // Portable C++
+    SSE41,             // x86 SSE4.1, 4 pixels per step
+    AVX2,              // x86 AVX2, 8 pixels per step
+    NEON,              // ARM NEON, 8 pixels per step
+};
+
+/**
+ * @struct ColorMatrix
+ * @brief Affine RGB transform on 0-255 values
+ *
+ * out = m[row][0] * R + m[row][1] * G + m[row][2] * B + m[row][3] for
+ * rows R, G, B. Alpha is passed through unchanged.
+ */
+struct ColorMatrix {
+    float m[3][4] = {
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+    };
+
+    /**
+     * @brief Get the identity transform
+     */
+    [[nodiscard]] static ColorMatrix identity() { return ColorMatrix(); }
+
+    /**
+     * @brief Brightness shift mixed by intensity
+     * @param brightness Offset in normalized units (-1 to 1)
+     * @param intensity Effect strength (0 to 1)
+     */
+    [[nodiscard]] static ColorMatrix brightness(float brightness, float intensity);
+
+    /**
+     * @brief Contrast around mid-grey mixed by intensity
+     * @param contrast Contrast factor (1 = unchanged)
+     * @param intensity Effect strength (0 to 1)
+     */
+    [[nodiscard]] static ColorMatrix contrast(float contrast, float intensity);
+
+    /**
+     * @brief Saturation around BT.601 luma mixed by intensity
+     * @param saturation Saturation factor (0 = grey, 1 = unchanged)
+     * @param intensity Effect strength (0 to 1)
+     */
+    [[nodiscard]] static ColorMatrix saturation(float saturation, float intensity);
+
+    /**
+     * @brief Grayscale (FRAGMENT_GRAYSCALE) mixed by intensity
+     * @param intensity Effect strength (0 to 1)
+     */
+    [[nodiscard]] static ColorMatrix grayscale(float intensity);
+
+    /**
+     * @brief Sepia tone mixed by intensity
+     * @param intensity Effect strength (0 to 1)
+     */
+    [[nodiscard]] static ColorMatrix sepia(float intensity);
+
+    /**
+     * @brief White balance shift mixed by intensity
+     * @param temperature Warmth (-1 cool to 1 warm), +/-0.1 on red and blue at the extremes
+     * @param intensity Effect strength (0 to 1)
+     */
+    [[nodiscard]] static ColorMatrix temperature(float temperature, float intensity);
+
+    /**
+     * @brief Green-magenta shift mixed by intensity
+     * @param tint Tint (-1 magenta to 1 green), +/-0.1 on green at the extremes
+     * @param intensity Effect strength (0 to 1)
+     */
+    [[nodiscard]] static ColorMatrix tint(float tint, float intensity);
+
+    /**
+     * @brief Negative (FRAGMENT_INVERT) mixed by intensity
+     * @param intensity Effect strength (0 to 1)
+     */
+    [[nodiscard]] static ColorMatrix invert(float intensity);
+
+    /**
+     * @brief Check if every output channel depends only on the same input channel
+     * @return true if the off-diagonal terms are zero
+     */
+    [[nodiscard]] bool isPerChannel() const;
+
+    /**
+     * @brief Compose transforms
+     * @param first Transform applied first
+     * @return this applied after first
+     */
+    [[nodiscard]] ColorMatrix after(const ColorMatrix& first) const;
+
+    /**
+     * @brief Range of an output channel over all RGB inputs in 0-255
+     * @param row Output channel (0 = R, 1 = G, 2 = B)
+     * @param outMin Receives the smallest value
+     * @param outMax Receives the largest value
+     */
+    void getOutputRange(int row, float& outMin, float& outMax) const;
+};
+
+/**
+ * @struct Nv12Image
+ * @brief Non-owning view of an NV12 image (Y plane + interleaved UV plane)
+ */
+struct Nv12Image {
+    uint8_t* y = nullptr;          // Luma plane
+    uint8_t* uv = nullptr;         // Interleaved Cb/Cr plane, (width + 1) / 2 pairs by (height + 1) / 2 rows
+    int32_t width = 0;             // Width in pixels
+    int32_t height = 0;            // Height in pixels
+    int32_t yStride = 0;           // Bytes per luma row
+    int32_t uvStride = 0;          // Bytes per chroma row
+};
+
+/**
+ * @class ColorKernels
+ * @brief Vectorized color matrix kernels with runtime ISA dispatch
+ *
+ * The best instruction set the CPU supports is selected on first use.
+ * x86 kernels are compiled with per-function target attributes, so the
+ * library still runs on CPUs without SSE4.1/AVX2. Every level performs
+ * the same float math with round-to-nearest-even, so outputs agree
+ * across levels to within one code value (from FMA contraction or the
+ * ARMv7 rounding fallback).
+ *
+ * NV12 uses full-range BT.601, matching the luma weights of the effects.
+ * Transforms that act on luma and chroma independently (brightness,
+ * contrast, saturation, grayscale) run as vectorized per-plane affine
+ * maps; others (sepia) convert each 2x2 block through RGB.
+ */
+class ColorKernels {
+public:
+    /**
+     * @brief Get the instruction set in use
+     * @return Active SIMD level
+     */
+    [[nodiscard]] static SimdLevel getLevel();
+
+    /**
+     * @brief Force an instruction set (for benchmarking and testing)
+     * @param level Requested level
+     * @return true if the CPU supports it and it is now active
+     */
+    static bool setLevel(SimdLevel level);
+
+    /**
+     * @brief Check if the CPU supports an instruction set
+     * @param level Level to check
+     * @return true if supported
+     */
+    [[nodiscard]] static bool isSupported(SimdLevel level);
+
+    /**
+     * @brief Get display name of an instruction set
+     * @param level Level
+     * @return Name such as "AVX2"
+     */
+    [[nodiscard]] static const char* getLevelName(SimdLevel level);
+
+    /**
+     * @brief Apply a color matrix to contiguous RGBA8 pixels in place
+     * @param matrix Transform
+     * @param pixels First pixel
+     * @param pixelCount Number of pixels
+     */
+    static void applyRgba(const ColorMatrix& matrix, uint8_t* pixels, size_t pixelCount);
+
+    /**
+     * @brief Apply a color matrix to an NV12 image in place
+     * @param matrix Transform (RGB domain)
+     * @param image Image to modify
+     */
+    static void applyNv12(const ColorMatrix& matrix, const Nv12Image& image);
+
+    /**
+     * @brief Apply out = scale * in + offset to bytes in place
+     * @param data First byte
+     * @param count Number of bytes
+     * @param scale Multiplier
+     * @param offset Offset added after scaling
+     */
+    static void applyAffine(uint8_t* data, size_t count, float scale, float offset);
+};
+
+} // namespace effects
+} // namespace clipforge
+
+#endif // CLIPFORGE_COLOR_KERNELS_H
@@ -0,0 +1,149 @@
+#include "color_pipeline.h"
+#include <algorithm>
+#include <cmath>
+
+namespace clipforge {
+namespace effects {
+
+namespace {
+
+/**
+ * @brief Round and clamp to a byte, as when a pass is written to RGBA8
+ */
+inline uint8_t toByte(float value) {
+    return static_cast<uint8_t>(std::lround(std::min(255.0f, std::max(0.0f, value))));
+}
+
+/**
+ * @brief Check if rounding the matrix output never needs clamping
+ */
+bool staysInRange(const ColorMatrix& matrix) {
+    for (int row = 0; row < 3; ++row) {
+        float low = 0.0f;
+        float high = 0.0f;
+        matrix.getOutputRange(row, low, high);
+        if (low < -0.5f || high > 255.5f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// ColorPipeline Implementation
+// ============================================================================
+
+bool ColorPipeline::isFusable(const FilterSettings& filter) {
+    ColorMatrix unused;
+    return filter.type == models::EffectType::SPECIAL_POSTERIZE ||
+           FilterLibrary::toColorMatrix(filter, unused);
+}
+
+bool ColorPipeline::append(const FilterSettings& filter) {
+    ColorMatrix matrix;
+    if (FilterLibrary::toColorMatrix(filter, matrix)) {
+        foldMatrix(matrix);
+    } else if (filter.type == models::EffectType::SPECIAL_POSTERIZE) {
+        foldPosterize(filter);
+    } else {
+        return false;
+    }
+
+    m_stages.back().effectCount++;
+    m_effectCount++;
+    return true;
+}
+
+void ColorPipeline::apply(uint8_t* pixels, size_t pixelCount) const {
+    // Run every stage on an L1-sized block before moving on, so memory
+    // is read and written once however many stages there are
+    for (size_t start = 0; start < pixelCount; start += BLOCK_PIXELS) {
+        uint8_t* block = pixels + start * 4;
+        size_t count = std::min(BLOCK_PIXELS, pixelCount - start);
+
+        for (const auto& stage : m_stages) {
+            if (stage.hasMatrix) {
+                ColorKernels::applyRgba(stage.matrix, block, count);
+            }
+            if (!stage.hasLut) continue;
+
+            const auto& lut = stage.lut;
+            uint8_t* p = block;
+            for (size_t i = 0; i < count; ++i, p += 4) {
+                p[0] = lut[0][p[0]];
+                p[1] = lut[1][p[1]];
+                p[2] = lut[2][p[2]];
+                p[3] = lut[3][p[3]];
+            }
+        }
+    }
+}
+
+void ColorPipeline::clear() {
+    m_stages.clear();
+    m_effectCount = 0;
+}
+
+void ColorPipeline::foldMatrix(const ColorMatrix& matrix) {
+    if (!m_stages.empty()) {
+        FusedColorStage& stage = m_stages.back();
+
+        // Composing skips the clamp between the two, so only when it is a no-op
+        if (!stage.hasLut && staysInRange(stage.matrix)) {
+            stage.matrix = matrix.after(stage.matrix);
+            stage.hasMatrix = true;
+            return;
+        }
+
+        // A per-channel map can follow the clamp in the curves
+        if (matrix.isPerChannel()) {
+            auto& lut = lastStageWithLut().lut;
+            for (int c = 0; c < 3; ++c) {
+                for (auto& value : lut[static_cast<size_t>(c)]) {
+                    value = toByte(matrix.m[c][c] * static_cast<float>(value) + matrix.m[c][3]);
+                }
+            }
+            return;
+        }
+    }
+
+    FusedColorStage stage;
+    stage.matrix = matrix;
+    stage.hasMatrix = true;
+    m_stages.push_back(stage);
+}
+
+void ColorPipeline::foldPosterize(const FilterSettings& filter) {
+    auto& lut = lastStageWithLut().lut;
+
+    // FRAGMENT_POSTERIZE, alpha included
+    for (auto& channel : lut) {
+        for (auto& value : channel) {
+            float x = static_cast<float>(value) * (1.0f / 255.0f);
+            float posterized = std::floor(x * filter.levels) / filter.levels;
+            value = toByte((x + (posterized - x) * filter.intensity) * 255.0f);
+        }
+    }
+}
+
+FusedColorStage& ColorPipeline::lastStageWithLut() {
+    if (m_stages.empty()) {
+        m_stages.emplace_back();
+    }
+
+    FusedColorStage& stage = m_stages.back();
+    if (!stage.hasLut) {
+        for (auto& channel : stage.lut) {
+            for (size_t i = 0; i < channel.size(); ++i) {
+                channel[i] = static_cast<uint8_t>(i);
+            }
+        }
+        stage.hasLut = true;
+    }
+    return stage;
+}
+
+} // namespace effects
+} // namespace clipforge
@@ -0,0 +1,111 @@
+#ifndef CLIPFORGE_COLOR_PIPELINE_H
+#define CLIPFORGE_COLOR_PIPELINE_H
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "color_kernels.h"
+#include "filter_library.h"
+
+namespace clipforge {
+namespace effects {
+
+/**
+ * @struct FusedColorStage
+ * @brief One pass of a compiled color pipeline: a matrix, then per-channel curves
+ */
+struct FusedColorStage {
+    ColorMatrix matrix;                          // Applied first (RGB)
+    std::array<std::array<uint8_t, 256>, 4> lut{};  // Applied second (RGBA), if hasLut
+    bool hasMatrix = false;                      // false if matrix is the identity
+    bool hasLut = false;
+    size_t effectCount = 0;                      // Effects folded into this stage
+};
+
+/**
+ * @class ColorPipeline
+ * @brief Compiles consecutive per-pixel colour effects into fused passes
+ *
+ * Brightness, contrast, saturation, temperature, tint, grayscale, sepia
+ * and invert are affine and compose into one 3x4 matrix; posterize and
+ * any per-channel affine effect that follows a clipping one become a
+ * 256-entry curve per channel. A typical chain therefore costs a single
+ * matrix-plus-lookup pass instead of one pass per effect.
+ *
+ * Rendering each effect on its own clamps to 0-255 in between. Matrices
+ * are only composed when the first one cannot leave that range for any
+ * input; otherwise the clamp is baked into the curves, or a new stage
+ * starts when the next matrix mixes channels. Output therefore matches
+ * the unfused chain apart from the dropped intermediate rounding (at
+ * most a code value or two).
+ *
+ * Usage:
+ * @code
+ * ColorPipeline pipeline;
+ * for (const auto& filter : filters) {
+ *     if (!pipeline.append(filter)) break;  // Not fusable: split the chain here
+ * }
+ * pipeline.apply(row, width);
+ * @endcode
+ */
+class ColorPipeline {
+public:
+    static constexpr size_t BLOCK_PIXELS = 1024;  // 4 KB of RGBA8 per block
+
+    /**
+     * @brief Check if a filter can be folded into a pipeline
+     * @param filter Filter settings
+     * @return true for affine filters and posterize
+     */
+    [[nodiscard]] static bool isFusable(const FilterSettings& filter);
+
+    /**
+     * @brief Fold a filter into the end of the pipeline
+     * @param filter Filter settings
+     * @return false if the filter is not fusable (pipeline unchanged)
+     */
+    bool append(const FilterSettings& filter);
+
+    /**
+     * @brief Apply every stage to contiguous RGBA8 pixels in place
+     * @param pixels First pixel
+     * @param pixelCount Number of pixels
+     */
+    void apply(uint8_t* pixels, size_t pixelCount) const;
+
+    /**
+     * @brief Remove all stages
+     */
+    void clear();
+
+    [[nodiscard]] bool empty() const { return m_stages.empty(); }
+    [[nodiscard]] size_t getStageCount() const { return m_stages.size(); }
+    [[nodiscard]] size_t getEffectCount() const { return m_effectCount; }
+    [[nodiscard]] const std::vector<FusedColorStage>& getStages() const { return m_stages; }
+
+private:
+    std::vector<FusedColorStage> m_stages;
+    size_t m_effectCount = 0;
+
+    /**
+     * @brief Fold an affine transform into the last stage, or start a new one
+     */
+    void foldMatrix(const ColorMatrix& matrix);
+
+    /**
+     * @brief Fold a posterize filter into the curves of the last stage
+     */
+    void foldPosterize(const FilterSettings& filter);
+
+    /**
+     * @brief Get the last stage with its curves initialized
+     */
+    FusedColorStage& lastStageWithLut();
+};
+
+} // namespace effects
+} // namespace clipforge
+
+#endif // CLIPFORGE_COLOR_PIPELINE_H
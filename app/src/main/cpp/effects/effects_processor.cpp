@@ -1,9 +1,114 @@
 #include "effects_processor.h"
+#include "../utils/logger.h"
+#include <algorithm>
 
 namespace clipforge {
 namespace effects {
 
-// Placeholder implementation
+// ============================================================================
+// EffectsProcessor Implementation
+// ============================================================================
+
+EffectsProcessor::EffectsProcessor(size_t threadCount)
+    : m_pool(threadCount) {
+    LOG_INFO("CPU effects processor created (%zu threads)", m_pool.getThreadCount());
+}
+
+bool EffectsProcessor::process(const models::EffectChain& chain, uint8_t* pixels,
+                               int32_t width, int32_t height, int32_t stride) {
+    if (!pixels || width <= 0 || height <= 0 || stride < width * 4) {
+        LOG_ERROR("EffectsProcessor: invalid frame (%dx%d, stride %d)", width, height, stride);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ImageView image{pixels, width, height, stride};
+    buildTiles(width, height);
+
+    // Group consecutive point filters so each tile is visited once per group
+    std::vector<FilterSettings> pointRun;
+    for (const auto& effect : chain.getEffects()) {
+        if (!effect || !effect->isEnabled()) continue;
+
+        if (!FilterLibrary::isSupported(effect->getType())) {
+            LOG_DEBUG("EffectsProcessor: no CPU path for effect %s", effect->getName().c_str());
+            continue;
+        }
+
+        FilterSettings settings = FilterLibrary::resolve(*effect);
+        if (FilterLibrary::isPointFilter(settings.type)) {
+            pointRun.push_back(settings);
+            continue;
+        }
+
+        runPointPass(pointRun, image);
+        pointRun.clear();
+        runNeighbourhoodPass(settings, image);
+    }
+    runPointPass(pointRun, image);
+
+    return true;
+}
+
+void EffectsProcessor::buildTiles(int32_t width, int32_t height) {
+    m_tiles.clear();
+    for (int32_t y = 0; y < height; y += TILE_SIZE) {
+        for (int32_t x = 0; x < width; x += TILE_SIZE) {
+            m_tiles.push_back(TileRect{x, y, std::min(TILE_SIZE, width - x),
+                                       std::min(TILE_SIZE, height - y)});
+        }
+    }
+}
+
+void EffectsProcessor::runPointPass(const std::vector<FilterSettings>& filters,
+                                    const ImageView& image) {
+    if (filters.empty()) return;
+
+    // Fusable colour effects compile into matrix + curve passes; the rest
+    // (such as vignette) are grouped for the per-pixel shader port. Every
+    // step works on the tile while it is hot.
+    struct Step {
+        ColorPipeline pipeline;
+        std::vector<FilterSettings> shaderFilters;
+    };
+    std::vector<Step> steps;
+    for (const auto& filter : filters) {
+        if (ColorPipeline::isFusable(filter)) {
+            if (steps.empty() || !steps.back().shaderFilters.empty()) steps.emplace_back();
+            steps.back().pipeline.append(filter);
+        } else {
+            if (steps.empty() || !steps.back().pipeline.empty()) steps.emplace_back();
+            steps.back().shaderFilters.push_back(filter);
+        }
+    }
+
+    for (const auto& step : steps) {
+        if (!step.pipeline.empty()) {
+            LOG_DEBUG("EffectsProcessor: fused %zu color effects into %zu stages",
+                      step.pipeline.getEffectCount(), step.pipeline.getStageCount());
+        }
+    }
+
+    m_pool.parallelFor(m_tiles.size(), [&](size_t i) {
+        const TileRect& tile = m_tiles[i];
+        for (const auto& step : steps) {
+            if (step.pipeline.empty()) {
+                FilterLibrary::applyPointFilters(step.shaderFilters, image, tile);
+                continue;
+            }
+            for (int32_t y = tile.y; y < tile.y + tile.height; ++y) {
+                step.pipeline.apply(image.row(y) + static_cast<ptrdiff_t>(tile.x) * 4,
+                                    static_cast<size_t>(tile.width));
+            }
+        }
+    });
+}
+
+void EffectsProcessor::runNeighbourhoodPass(const FilterSettings& filter, const ImageView& image) {
+    // BLUR_STANDARD is the only neighbourhood filter
+    m_blur.apply(image, filter.radius, filter.intensity, filter.quality, m_pool);
+}
 
 } // namespace effects
 } // namespace clipforge
@@ -1,13 +1,98 @@
 #ifndef CLIPFORGE_EFFECTS_PROCESSOR_H
 #define CLIPFORGE_EFFECTS_PROCESSOR_H
 
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+#include "../models/effect.h"
+#include "../utils/thread_pool.h"
+#include "filter_library.h"
+#include "color_pipeline.h"
+#include "blur_filter.h"
+
 namespace clipforge {
 namespace effects {
 
-// Placeholder for effects processor
-// TODO: Implement GPU-accelerated effect processing
+/**
+ * @class EffectsProcessor
+ * @brief CPU renderer for effect chains on RGBA8 frames
+ *
+ * The frame is split into square tiles small enough to stay in cache
+ * and processed by a thread pool. Consecutive per-pixel effects are
+ * fused into one pass over each tile, with colour adjustments compiled
+ * into a single matrix and curve (see ColorPipeline); a neighbourhood
+ * effect such as blur reads the whole previous result, so it runs as
+ * separate full-frame passes (see BlurFilter). Output matches the GLSL
+ * effects (see FilterLibrary), which makes this the renderer for GPU-less
+ * machines and the reference for golden-image comparisons.
+ *
+ * Thread-safe; concurrent process() calls are serialized.
+ *
+ * Usage:
+ * @code
+ * EffectsProcessor processor(config.maxRenderThreads);
+ * processor.process(clip->getEffectChain(), pixels, width, height, width * 4);
+ * @endcode
+ */
+class EffectsProcessor {
+public:
+    static constexpr int32_t TILE_SIZE = 64;  // 64x64 RGBA8 = 16 KB per tile
+
+    /**
+     * @brief Create a processor
+     * @param threadCount Rendering threads (including the caller)
+     */
+    explicit EffectsProcessor(size_t threadCount);
+
+    // Prevent copying
+    EffectsProcessor(const EffectsProcessor&) = delete;
+    EffectsProcessor& operator=(const EffectsProcessor&) = delete;
+
+    /**
+     * @brief Apply an effect chain to a frame in place
+     * @param chain Effects to apply in order; disabled and unsupported ones are skipped
+     * @param pixels RGBA8 pixels, top row first
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param stride Bytes per row
+     * @return true if the frame was processed
+     */
+    bool process(const models::EffectChain& chain, uint8_t* pixels,
+                 int32_t width, int32_t height, int32_t stride);
+
+    /**
+     * @brief Get number of rendering threads
+     * @return Thread count
+     */
+    [[nodiscard]] size_t getThreadCount() const { return m_pool.getThreadCount(); }
+
+private:
+    utils::ThreadPool m_pool;
+    BlurFilter m_blur;                // Owns the scratch frames for blur passes
+    std::vector<TileRect> m_tiles;
+    std::mutex m_mutex;
+
+    /**
+     * @brief Split a frame into tiles
+     * @param width Width in pixels
+     * @param height Height in pixels
+     */
+    void buildTiles(int32_t width, int32_t height);
+
+    /**
+     * @brief Run fused point filters over every tile
+     */
+    void runPointPass(const std::vector<FilterSettings>& filters, const ImageView& image);
+
+    /**
+     * @brief Run a neighbourhood filter, leaving the result in image
+     */
+    void runNeighbourhoodPass(const FilterSettings& filter, const ImageView& image);
+};
 
 } // namespace effects
 } // namespace clipforge
 
-#endif
+#endif // CLIPFORGE_EFFECTS_PROCESSOR_H
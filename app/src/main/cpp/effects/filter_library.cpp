@@ -1,9 +1,276 @@
 #include "filter_library.h"
+#include <algorithm>
+#include <cmath>
 
 namespace clipforge {
 namespace effects {
 
-// Placeholder implementation
+namespace {
+
+constexpr float LUMA_R = 0.299f;
+constexpr float LUMA_G = 0.587f;
+constexpr float LUMA_B = 0.114f;
+
+/**
+ * @brief Get a parameter value, or a default if the effect lacks it
+ */
+float parameterOr(const models::Effect& effect, const char* name, float fallback) {
+    for (const auto& param : effect.getParameters()) {
+        if (param.name == name) {
+            return param.value;
+        }
+    }
+    return fallback;
+}
+
+inline float mix(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+inline float clamp01(float value) {
+    return std::min(1.0f, std::max(0.0f, value));
+}
+
+inline float smoothstep(float edge0, float edge1, float x) {
+    if (edge0 == edge1) {
+        return x < edge0 ? 0.0f : 1.0f;
+    }
+    float t = clamp01((x - edge0) / (edge1 - edge0));
+    return t * t * (3.0f - 2.0f * t);
+}
+
+/**
+ * @brief Round to the nearest 8-bit code value, as an RGBA8 target stores it
+ */
+inline uint8_t toByte(float value) {
+    return static_cast<uint8_t>(std::lround(clamp01(value) * 255.0f));
+}
+
+inline void loadPixel(const uint8_t* pixel, float rgba[4]) {
+    for (int c = 0; c < 4; ++c) {
+        rgba[c] = static_cast<float>(pixel[c]) * (1.0f / 255.0f);
+    }
+}
+
+inline void storePixel(const float rgba[4], uint8_t* pixel) {
+    for (int c = 0; c < 4; ++c) {
+        pixel[c] = toByte(rgba[c]);
+    }
+}
+
+inline void quantize(float rgba[4]) {
+    for (int c = 0; c < 4; ++c) {
+        rgba[c] = static_cast<float>(toByte(rgba[c])) * (1.0f / 255.0f);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// FilterLibrary Implementation
+// ============================================================================
+
+bool FilterLibrary::isSupported(models::EffectType type) {
+    switch (type) {
+        case models::EffectType::FILTER_BW:
+        case models::EffectType::FILTER_SEPIA:
+        case models::EffectType::COLOR_BRIGHTNESS:
+        case models::EffectType::COLOR_CONTRAST:
+        case models::EffectType::COLOR_SATURATION:
+        case models::EffectType::COLOR_TEMPERATURE:
+        case models::EffectType::COLOR_TINT:
+        case models::EffectType::SPECIAL_INVERT:
+        case models::EffectType::SPECIAL_POSTERIZE:
+        case models::EffectType::SPECIAL_VIGNETTE:
+        case models::EffectType::BLUR_STANDARD:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool FilterLibrary::isPointFilter(models::EffectType type) {
+    return isSupported(type) && type != models::EffectType::BLUR_STANDARD;
+}
+
+FilterSettings FilterLibrary::resolve(const models::Effect& effect) {
+    FilterSettings settings;
+    settings.type = effect.getType();
+    settings.intensity = effect.getIntensity();
+
+    // Defaults match the GPU effect parameter definitions
+    switch (settings.type) {
+        case models::EffectType::COLOR_BRIGHTNESS:
+            settings.amount = parameterOr(effect, "brightness", 0.0f);
+            break;
+        case models::EffectType::COLOR_CONTRAST:
+            settings.amount = parameterOr(effect, "contrast", 1.0f);
+            break;
+        case models::EffectType::COLOR_SATURATION:
+            settings.amount = parameterOr(effect, "saturation", 1.0f);
+            break;
+        case models::EffectType::COLOR_TEMPERATURE:
+            settings.amount = parameterOr(effect, "temperature", 0.0f);
+            break;
+        case models::EffectType::COLOR_TINT:
+            settings.amount = parameterOr(effect, "tint", 0.0f);
+            break;
+        case models::EffectType::SPECIAL_POSTERIZE:
+            settings.levels = parameterOr(effect, "levels", 128.0f);
+            break;
+        case models::EffectType::SPECIAL_VIGNETTE:
+            // VignetteEffect uploads intensity scaled by softness
+            settings.radius = parameterOr(effect, "radius", 0.5f);
+            settings.intensity *= parameterOr(effect, "softness", 0.3f);
+            break;
+        case models::EffectType::BLUR_STANDARD:
+            settings.radius = parameterOr(effect, "radius", 5.0f);
+            settings.quality = parameterOr(effect, "quality", 1.0f) < 0.5f
+                ? BlurQuality::FAST : BlurQuality::HIGH;
+            break;
+        default:
+            break;
+    }
+    return settings;
+}
+
+bool FilterLibrary::toColorMatrix(const FilterSettings& filter, ColorMatrix& outMatrix) {
+    switch (filter.type) {
+        case models::EffectType::COLOR_BRIGHTNESS:
+            outMatrix = ColorMatrix::brightness(filter.amount, filter.intensity);
+            return true;
+        case models::EffectType::COLOR_CONTRAST:
+            outMatrix = ColorMatrix::contrast(filter.amount, filter.intensity);
+            return true;
+        case models::EffectType::COLOR_SATURATION:
+            outMatrix = ColorMatrix::saturation(filter.amount, filter.intensity);
+            return true;
+        case models::EffectType::FILTER_BW:
+            outMatrix = ColorMatrix::grayscale(filter.intensity);
+            return true;
+        case models::EffectType::FILTER_SEPIA:
+            outMatrix = ColorMatrix::sepia(filter.intensity);
+            return true;
+        case models::EffectType::COLOR_TEMPERATURE:
+            outMatrix = ColorMatrix::temperature(filter.amount, filter.intensity);
+            return true;
+        case models::EffectType::COLOR_TINT:
+            outMatrix = ColorMatrix::tint(filter.amount, filter.intensity);
+            return true;
+        case models::EffectType::SPECIAL_INVERT:
+            outMatrix = ColorMatrix::invert(filter.intensity);
+            return true;
+        default:
+            return false;
+    }
+}
+
+void FilterLibrary::applyPointFilters(const std::vector<FilterSettings>& filters,
+                                      const ImageView& image, const TileRect& tile) {
+    if (filters.empty()) return;
+
+    const float invWidth = 1.0f / static_cast<float>(image.width);
+    const float invHeight = 1.0f / static_cast<float>(image.height);
+
+    for (int32_t y = tile.y; y < tile.y + tile.height; ++y) {
+        uint8_t* pixel = image.row(y) + static_cast<ptrdiff_t>(tile.x) * 4;
+        float v = (static_cast<float>(y) + 0.5f) * invHeight;
+
+        for (int32_t x = tile.x; x < tile.x + tile.width; ++x, pixel += 4) {
+            float u = (static_cast<float>(x) + 0.5f) * invWidth;
+            float rgba[4];
+            loadPixel(pixel, rgba);
+
+            for (size_t i = 0; i < filters.size(); ++i) {
+                shadePixel(filters[i], u, v, rgba);
+                if (i + 1 < filters.size()) {
+                    quantize(rgba);  // Intermediate pass written to RGBA8
+                }
+            }
+
+            storePixel(rgba, pixel);
+        }
+    }
+}
+
+void FilterLibrary::shadePixel(const FilterSettings& filter, float u, float v, float rgba[4]) {
+    float r = rgba[0];
+    float g = rgba[1];
+    float b = rgba[2];
+    float t = filter.intensity;
+
+    switch (filter.type) {
+        case models::EffectType::FILTER_BW: {
+            // FRAGMENT_GRAYSCALE
+            float gray = r * LUMA_R + g * LUMA_G + b * LUMA_B;
+            rgba[0] = mix(r, gray, t);
+            rgba[1] = mix(g, gray, t);
+            rgba[2] = mix(b, gray, t);
+            break;
+        }
+        case models::EffectType::FILTER_SEPIA: {
+            rgba[0] = mix(r, r * 0.393f + g * 0.769f + b * 0.189f, t);
+            rgba[1] = mix(g, r * 0.349f + g * 0.686f + b * 0.168f, t);
+            rgba[2] = mix(b, r * 0.272f + g * 0.534f + b * 0.131f, t);
+            break;
+        }
+        case models::EffectType::COLOR_BRIGHTNESS: {
+            rgba[0] = mix(r, r + filter.amount, t);
+            rgba[1] = mix(g, g + filter.amount, t);
+            rgba[2] = mix(b, b + filter.amount, t);
+            break;
+        }
+        case models::EffectType::COLOR_CONTRAST: {
+            rgba[0] = mix(r, (r - 0.5f) * filter.amount + 0.5f, t);
+            rgba[1] = mix(g, (g - 0.5f) * filter.amount + 0.5f, t);
+            rgba[2] = mix(b, (b - 0.5f) * filter.amount + 0.5f, t);
+            break;
+        }
+        case models::EffectType::COLOR_SATURATION: {
+            float gray = r * LUMA_R + g * LUMA_G + b * LUMA_B;
+            rgba[0] = mix(r, mix(gray, r, filter.amount), t);
+            rgba[1] = mix(g, mix(gray, g, filter.amount), t);
+            rgba[2] = mix(b, mix(gray, b, filter.amount), t);
+            break;
+        }
+        case models::EffectType::COLOR_TEMPERATURE: {
+            rgba[0] = mix(r, r + 0.1f * filter.amount, t);
+            rgba[2] = mix(b, b - 0.1f * filter.amount, t);
+            break;
+        }
+        case models::EffectType::COLOR_TINT: {
+            rgba[1] = mix(g, g + 0.1f * filter.amount, t);
+            break;
+        }
+        case models::EffectType::SPECIAL_INVERT: {
+            // FRAGMENT_INVERT
+            rgba[0] = mix(r, 1.0f - r, t);
+            rgba[1] = mix(g, 1.0f - g, t);
+            rgba[2] = mix(b, 1.0f - b, t);
+            break;
+        }
+        case models::EffectType::SPECIAL_POSTERIZE: {
+            // FRAGMENT_POSTERIZE (alpha included, as in the shader)
+            for (int c = 0; c < 4; ++c) {
+                rgba[c] = mix(rgba[c], std::floor(rgba[c] * filter.levels) / filter.levels, t);
+            }
+            break;
+        }
+        case models::EffectType::SPECIAL_VIGNETTE: {
+            // FRAGMENT_VIGNETTE (not mixed by intensity)
+            float dx = u - 0.5f;
+            float dy = v - 0.5f;
+            float dist = std::sqrt(dx * dx + dy * dy) * 1.414f;
+            float vignette = smoothstep(filter.radius + t, filter.radius - t, dist);
+            rgba[0] = r * vignette;
+            rgba[1] = g * vignette;
+            rgba[2] = b * vignette;
+            break;
+        }
+        default:
+            break;
+    }
+}
 
 } // namespace effects
 } // namespace clipforge
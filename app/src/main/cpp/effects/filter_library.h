@@ -1,13 +1,140 @@
 #ifndef CLIPFORGE_FILTER_LIBRARY_H
 #define CLIPFORGE_FILTER_LIBRARY_H
 
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "../models/effect.h"
+#include "color_kernels.h"
+
 namespace clipforge {
 namespace effects {
 
-// Placeholder for filter library
-// TODO: Implement 50+ built-in filters
+/**
+ * @struct ImageView
+ * @brief Non-owning view of an RGBA8 image
+ */
+struct ImageView {
+    uint8_t* data = nullptr;       // First byte of the top row
+    int32_t width = 0;             // Width in pixels
+    int32_t height = 0;            // Height in pixels
+    int32_t stride = 0;            // Bytes per row
+
+    [[nodiscard]] uint8_t* row(int32_t y) const {
+        return data + static_cast<ptrdiff_t>(y) * stride;
+    }
+};
+
+/**
+ * @struct TileRect
+ * @brief Rectangular region of an image
+ */
+struct TileRect {
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+};
+
+/**
+ * @enum BlurQuality
+ * @brief Blur algorithm trade-off
+ */
+enum class BlurQuality {
+    FAST = 0,          // Three box passes, cost independent of radius
+    HIGH = 1,          // Exact separable Gaussian
+};
+
+/**
+ * @struct FilterSettings
+ * @brief Shader uniforms resolved from a models::Effect
+ *
+ * Values mirror what the GPU effects upload, including their parameter
+ * defaults, so CPU and GPU output agree for the same effect.
+ */
+struct FilterSettings {
+    models::EffectType type = models::EffectType::FILTER_BW;
+    float intensity = 1.0f;        // uIntensity
+    float amount = 0.0f;           // Brightness/temperature/tint offset, contrast or saturation factor
+    float radius = 0.0f;           // uRadius (blur: pixels, vignette: normalized)
+    float levels = 0.0f;           // uLevels (posterize)
+    BlurQuality quality = BlurQuality::HIGH;  // Blur algorithm
+};
+
+/**
+ * @class FilterLibrary
+ * @brief CPU implementations of the built-in effect shaders
+ *
+ * Each filter reproduces the math of its GLSL counterpart in
+ * gpu/shader_sources.h on normalized floats. Results are rounded to
+ * 8 bits after every filter, like a GPU rendering each effect pass into
+ * an RGBA8 target, so output matches the shaders to within one or two
+ * code values (mediump and texture filtering differences).
+ *
+ * Colour adjustments without a shader (brightness, contrast, saturation,
+ * temperature, tint, sepia) use the standard formulas, mixed by intensity
+ * like the shaders.
+ */
+class FilterLibrary {
+public:
+    /**
+     * @brief Check if an effect type has a CPU implementation
+     * @param type Effect type
+     * @return true if supported
+     */
+    [[nodiscard]] static bool isSupported(models::EffectType type);
+
+    /**
+     * @brief Check if an effect reads only the pixel it writes
+     * @param type Effect type
+     * @return true for per-pixel filters that can be fused per tile
+     */
+    [[nodiscard]] static bool isPointFilter(models::EffectType type);
+
+    /**
+     * @brief Resolve shader-equivalent settings for an effect
+     * @param effect Effect model
+     * @return Filter settings
+     */
+    [[nodiscard]] static FilterSettings resolve(const models::Effect& effect);
+
+    /**
+     * @brief Express a filter as a color matrix if it is affine
+     * @param filter Filter settings
+     * @param outMatrix Receives the equivalent transform
+     * @return true for brightness, contrast, saturation, temperature, tint,
+     *         grayscale, sepia and invert
+     *
+     * Affine filters run through the vectorized ColorKernels instead of
+     * the per-pixel shader port.
+     */
+    static bool toColorMatrix(const FilterSettings& filter, ColorMatrix& outMatrix);
+
+    /**
+     * @brief Apply a run of point filters to a tile in place
+     * @param filters Filters in chain order (all point filters)
+     * @param image Image to modify
+     * @param tile Region to process
+     *
+     * Each pixel is loaded once and passed through every filter while it
+     * is in registers.
+     */
+    static void applyPointFilters(const std::vector<FilterSettings>& filters,
+                                  const ImageView& image, const TileRect& tile);
+
+private:
+    /**
+     * @brief Shade one pixel with a point filter
+     * @param filter Filter settings
+     * @param u Horizontal texture coordinate of the pixel centre
+     * @param v Vertical texture coordinate of the pixel centre
+     * @param rgba Normalized colour, modified in place
+     */
+    static void shadePixel(const FilterSettings& filter, float u, float v, float rgba[4]);
+};
 
 } // namespace effects
 } // namespace clipforge
 
-#endif
+#endif // CLIPFORGE_FILTER_LIBRARY_H
@@ -0,0 +1,105 @@
+#include "encoder_backend.h"
+#include "software_encoder.h"
+#include "../utils/logger.h"
+
+namespace clipforge {
+namespace encoding {
+
+// ===== EncoderBackend Implementation =====
+
+std::unique_ptr<EncoderBackend> EncoderBackend::create(const VideoEncodingConfig& config) {
+    if (config.useHardwareEncoding) {
+        return std::make_unique<MediaCodecBackend>();
+    }
+    return std::make_unique<SoftwareEncoderBackend>();
+}
+
+size_t getFrameSize(ColorFormat format, int width, int height) {
+    size_t pixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+    size_t chroma = static_cast<size_t>((width + 1) / 2) * static_cast<size_t>((height + 1) / 2);
+
+    switch (format) {
+        case ColorFormat::NV12:
+        case ColorFormat::NV21:
+        case ColorFormat::YUV420P:
+            return pixels + 2 * chroma;
+        case ColorFormat::RGBA:
+            return pixels * 4;
+        default:
+            return 0;
+    }
+}
+
+// ===== MediaCodecBackend Implementation =====
+
+MediaCodecBackend::~MediaCodecBackend() {
+    close();
+}
+
+bool MediaCodecBackend::open(const VideoEncodingConfig& config) {
+    if (m_mediaCodec) {
+        return true;
+    }
+
+    // In a real implementation, this would:
+    // 1. Create a MediaCodec instance for the specified codec
+    // 2. Configure it with the VideoEncodingConfig parameters
+    // 3. Create input/output surfaces if needed
+    // 4. Start the codec
+
+    m_config = config;
+    m_mediaCodec = reinterpret_cast<void*>(1);  // Placeholder
+
+    LOG_INFO("VideoEncoder: MediaCodec initialized");
+    return true;
+}
+
+int64_t MediaCodecBackend::encode(const uint8_t* frameData, int64_t timestampMs, bool keyFrame,
+                                  std::vector<uint8_t>& packet) {
+    (void)frameData;
+    (void)timestampMs;
+
+    if (!m_mediaCodec) {
+        m_lastError = "MediaCodec not initialized";
+        return -1;
+    }
+
+    if (keyFrame) {
+        // Request IDR frame from MediaCodec
+        LOG_DEBUG("VideoEncoder: IDR frame requested");
+    }
+
+    // In a real implementation, this would queue the input buffer, then
+    // dequeue output buffers into the packet
+    packet.clear();
+    return static_cast<int64_t>(getFrameSize(m_config.inputFormat, m_config.width, m_config.height));
+}
+
+void MediaCodecBackend::close() {
+    if (!m_mediaCodec) {
+        return;
+    }
+
+    // In a real implementation, this would:
+    // 1. Drain remaining output buffers
+    // 2. Stop the MediaCodec
+    // 3. Release input/output buffers and the codec instance
+
+    m_mediaCodec = nullptr;
+    m_inputSurface = nullptr;
+
+    LOG_INFO("VideoEncoder: MediaCodec released");
+}
+
+bool MediaCodecBackend::setBitrate(int bitrate) {
+    m_config.bitrate = bitrate;
+
+    // Apply dynamic bitrate change to MediaCodec
+    if (m_mediaCodec) {
+        LOG_INFO("VideoEncoder: Bitrate updated to %d bps", bitrate);
+    }
+    return true;
+}
+
+} // namespace encoding
+} // namespace clipforge
@@ -0,0 +1,121 @@
+#ifndef CLIPFORGE_ENCODER_BACKEND_H
+#define CLIPFORGE_ENCODER_BACKEND_H
+
+#include "video_encoder.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace clipforge {
+namespace encoding {
+
+/**
+ * @class EncoderBackend
+ * @brief Codec implementation behind VideoEncoder
+ *
+ * VideoEncoder handles configuration, state and statistics; a backend
+ * only turns frames into bytes. Backends are created per encoding
+ * session by create() and used from one thread.
+ */
+class EncoderBackend {
+public:
+    virtual ~EncoderBackend() = default;
+
+    /**
+     * @brief Create the backend for a configuration
+     * @param config Encoding configuration; useHardwareEncoding selects
+     *               MediaCodec, otherwise the software backend is used
+     * @return Backend, not yet opened
+     */
+    [[nodiscard]] static std::unique_ptr<EncoderBackend> create(const VideoEncodingConfig& config);
+
+    /**
+     * @brief Get backend name for logs
+     */
+    [[nodiscard]] virtual const char* getName() const = 0;
+
+    /**
+     * @brief Prepare the codec
+     * @param config Encoding configuration
+     * @return true if ready to encode
+     */
+    virtual bool open(const VideoEncodingConfig& config) = 0;
+
+    /**
+     * @brief Encode one frame
+     * @param frameData Frame in the configured input format, tightly packed
+     * @param timestampMs Presentation time
+     * @param keyFrame Encode as a keyframe
+     * @param packet Receives the encoded bytes, if the backend exposes them
+     * @return Bytes produced, or -1 on failure
+     */
+    virtual int64_t encode(const uint8_t* frameData, int64_t timestampMs, bool keyFrame,
+                           std::vector<uint8_t>& packet) = 0;
+
+    /**
+     * @brief Flush pending output and release the codec
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief Change the target bitrate while encoding
+     * @return true if applied (or not applicable)
+     */
+    virtual bool setBitrate(int bitrate) {
+        (void)bitrate;
+        return true;
+    }
+
+    /**
+     * @brief Get codec configuration data that precedes the first packet
+     * @return Header bytes (may be empty)
+     */
+    [[nodiscard]] virtual std::vector<uint8_t> getStreamHeader() const { return {}; }
+
+    /**
+     * @brief Get last error message
+     */
+    [[nodiscard]] const std::string& getLastError() const { return m_lastError; }
+
+protected:
+    std::string m_lastError;
+};
+
+/**
+ * @class MediaCodecBackend
+ * @brief Android MediaCodec hardware encoder
+ *
+ * The MediaCodec calls are not wired up yet: frames are accepted and
+ * accounted at their raw size, but no bytes are produced.
+ */
+class MediaCodecBackend : public EncoderBackend {
+public:
+    MediaCodecBackend() = default;
+    ~MediaCodecBackend() override;
+
+    [[nodiscard]] const char* getName() const override { return "MediaCodec"; }
+    bool open(const VideoEncodingConfig& config) override;
+    int64_t encode(const uint8_t* frameData, int64_t timestampMs, bool keyFrame,
+                   std::vector<uint8_t>& packet) override;
+    void close() override;
+    bool setBitrate(int bitrate) override;
+
+private:
+    VideoEncodingConfig m_config;
+
+    // Hardware encoder handles
+    void* m_mediaCodec = nullptr;
+    void* m_inputSurface = nullptr;
+};
+
+/**
+ * @brief Get the size of one frame in a color format
+ * @return Size in bytes, or 0 for an unknown format
+ */
+[[nodiscard]] size_t getFrameSize(ColorFormat format, int width, int height);
+
+} // namespace encoding
+} // namespace clipforge
+
+#endif // CLIPFORGE_ENCODER_BACKEND_H
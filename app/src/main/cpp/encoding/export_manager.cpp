@@ -1,14 +1,51 @@
 #include "export_manager.h"
+#include "../audio/audio_mixer.h"
 #include "../utils/logger.h"
 #include <chrono>
 #include <thread>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <cstdio>
 
 namespace clipforge {
 namespace encoding {
 
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+int64_t elapsedUs(SteadyClock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - start).count();
+}
+
+/**
+ * @brief Mixer source for a timeline track; plays silence until decoding is wired up
+ */
+class PendingDecodeSource : public audio::AudioSource {
+public:
+    explicit PendingDecodeSource(size_t channels) : m_channels(channels) {}
+
+    [[nodiscard]] size_t getChannelCount() const override { return m_channels; }
+
+    size_t read(float* const* channels, size_t frames) override {
+        for (size_t c = 0; c < m_channels; c++) {
+            std::fill_n(channels[c], frames, 0.0f);
+        }
+        return frames;
+    }
+
+private:
+    size_t m_channels;
+};
+
+} // anonymous namespace
+
 // ===== ExportManager Implementation =====
 
 ExportManager::ExportManager()
@@ -30,8 +67,8 @@ ExportManager::~ExportManager() {
 
 bool ExportManager::setConfig(const ExportConfig& config) {
     if (m_exporting) {
-        m_lastError = "Cannot configure while export is in progress";
-        LOG_ERROR("ExportManager: %s", m_lastError.c_str());
+        setError("Cannot configure while export is in progress");
+        LOG_ERROR("ExportManager: Cannot configure while export is in progress");
         return false;
     }
 
@@ -68,8 +105,8 @@ int64_t ExportManager::getEstimatedFileSize() const {
 
 bool ExportManager::startExport() {
     if (!m_config.timeline) {
-        m_lastError = "Timeline not configured";
-        LOG_ERROR("ExportManager: %s", m_lastError.c_str());
+        setError("Timeline not configured");
+        LOG_ERROR("ExportManager: Timeline not configured");
         return false;
     }
 
@@ -78,10 +115,18 @@ bool ExportManager::startExport() {
         return false;
     }
 
+    // Reap the thread of a previous export
+    if (m_exportThread && m_exportThread->joinable()) {
+        m_exportThread->join();
+    }
+
     m_exporting = true;
     m_cancelled = false;
     m_complete = false;
+    setError("");
     m_progress = ExportProgress{};
+    m_progress.totalFrames = static_cast<int64_t>(
+        (m_config.durationMs * m_config.frameRate) / 1000);
     m_startTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
 
@@ -211,41 +256,54 @@ std::string ExportManager::getStatistics() const {
     return oss.str();
 }
 
+std::string ExportManager::getErrorMessage() const {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    return m_lastError;
+}
+
+bool ExportManager::hasError() const {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    return !m_lastError.empty();
+}
+
+void ExportManager::setError(const std::string& message) {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    m_lastError = message;
+}
+
+void ExportManager::setPipelineError(const std::string& message) {
+    {
+        std::lock_guard<std::mutex> lock(m_errorMutex);
+        if (m_lastError.empty()) {
+            m_lastError = message;
+        }
+    }
+    m_pipelineFailed = true;
+}
+
 void ExportManager::exportThread() {
     LOG_INFO("ExportManager: Export thread started");
 
     try {
-        // Phase 1: Encode Video
-        if (!m_cancelled) {
-            m_progress.currentPhase = "Video";
-            LOG_INFO("ExportManager: Starting video encoding");
-            if (!encodeVideo()) {
-                m_lastError = "Video encoding failed";
-                LOG_ERROR("ExportManager: %s", m_lastError.c_str());
-                m_exporting = false;
-                return;
-            }
-        }
-
-        // Phase 2: Encode Audio
+        // Phase 1: Encode video and audio, muxing packets as they arrive
         if (!m_cancelled) {
-            m_progress.currentPhase = "Audio";
-            LOG_INFO("ExportManager: Starting audio encoding");
-            if (!encodeAudio()) {
-                m_lastError = "Audio encoding failed";
-                LOG_ERROR("ExportManager: %s", m_lastError.c_str());
+            LOG_INFO("ExportManager: Starting encoding (%s)",
+                     m_config.parallelEncoding ? "video and audio concurrently" : "audio, then video");
+            if (!encodeStreams()) {
+                setPipelineError("Encoding failed");   // Kept only if no stage reported why
+                LOG_ERROR("ExportManager: %s", getErrorMessage().c_str());
                 m_exporting = false;
                 return;
             }
         }
 
-        // Phase 3: Mux Streams
+        // Phase 2: Finalize the container
         if (!m_cancelled) {
             m_progress.currentPhase = "Muxing";
-            LOG_INFO("ExportManager: Starting stream multiplexing");
+            LOG_INFO("ExportManager: Finalizing container");
             if (!muxStreams()) {
-                m_lastError = "Stream muxing failed";
-                LOG_ERROR("ExportManager: %s", m_lastError.c_str());
+                setError("Stream muxing failed");
+                LOG_ERROR("ExportManager: Stream muxing failed");
                 m_exporting = false;
                 return;
             }
@@ -261,20 +319,351 @@ void ExportManager::exportThread() {
         updateProgress();
 
     } catch (const std::exception& e) {
-        m_lastError = std::string("Export exception: ") + e.what();
-        LOG_ERROR("ExportManager: %s", m_lastError.c_str());
+        setError(std::string("Export exception: ") + e.what());
+        LOG_ERROR("ExportManager: Export exception: %s", e.what());
     }
 
     m_exporting = false;
 }
 
-bool ExportManager::encodeVideo() {
+bool ExportManager::encodeStreams() {
     if (!m_config.timeline) {
-        m_lastError = "Timeline not available";
+        setError("Timeline not available");
+        return false;
+    }
+
+    const bool chunked = m_config.segmentCount > 1;
+    if (!chunked) {
+        if (!m_videoEncoder->configure(makeEncoderConfig())) {
+            setError(m_videoEncoder->getLastError());
+            return false;
+        }
+
+        if (!m_videoEncoder->start()) {
+            setError(m_videoEncoder->getLastError());
+            return false;
+        }
+        m_streamHeader = m_videoEncoder->getStreamHeader();
+    } else {
+        // Segments share one configuration, so a short-lived encoder
+        // validates it and provides the header they all have in common
+        VideoEncoder probe;
+        if (!probe.configure(makeEncoderConfig()) || !probe.start()) {
+            setError(probe.getLastError());
+            return false;
+        }
+        m_streamHeader = probe.getStreamHeader();
+        probe.stop();
+    }
+
+    m_progress.totalAudioSamples = static_cast<int64_t>(
+        (m_config.durationMs * m_config.audioSampleRate) / 1000);
+    if (!chunked) {
+        m_effectsProcessor = std::make_unique<effects::EffectsProcessor>(
+            static_cast<size_t>(std::max(1, m_config.encodingThreads)));
+    }
+    m_pipelineFailed = false;
+    m_videoFramesDone = 0;
+    m_audioSamplesDone = 0;
+    m_audioBusyUs = 0;
+    m_encodeStart = SteadyClock::now();
+
+    FrameQueue decoded(PIPELINE_DEPTH);
+    FrameQueue processed(PIPELINE_DEPTH);
+    PacketQueue videoPackets(PIPELINE_DEPTH);
+    BufferQueue spentPackets(PIPELINE_DEPTH * 2);
+
+    // Without parallel encoding audio runs first, so its queue holds every packet
+    int64_t audioPacketCount = (m_progress.totalAudioSamples + AUDIO_FRAME_SAMPLES - 1) / AUDIO_FRAME_SAMPLES;
+    PacketQueue audioPackets(m_config.parallelEncoding
+        ? AUDIO_PACKET_DEPTH : static_cast<size_t>(audioPacketCount) + 1);
+
+    std::unique_ptr<std::thread> audioThread;
+    if (m_config.parallelEncoding) {
+        m_progress.currentPhase = "Encoding";
+        m_videoStart = m_encodeStart;
+        audioThread = std::make_unique<std::thread>(&ExportManager::audioStage, this, std::ref(audioPackets));
+    } else {
+        m_progress.currentPhase = "Audio";
+        audioStage(audioPackets);
+        m_progress.currentPhase = "Video";
+        m_videoStart = SteadyClock::now();
+    }
+
+    // Video stages on their own threads, mux on this one
+    std::vector<std::thread> videoThreads;
+    if (chunked) {
+        videoThreads.emplace_back(&ExportManager::segmentStage, this, std::ref(videoPackets));
+    } else {
+        videoThreads.emplace_back(&ExportManager::decodeStage, this, std::ref(decoded));
+        videoThreads.emplace_back(&ExportManager::effectsStage, this, std::ref(decoded), std::ref(processed));
+        videoThreads.emplace_back(&ExportManager::encodeStage, this, std::ref(processed),
+                                  std::ref(videoPackets), std::ref(spentPackets));
+    }
+    muxStage(videoPackets, audioPackets, chunked ? nullptr : &spentPackets);
+
+    for (auto& thread : videoThreads) {
+        thread.join();
+    }
+    if (audioThread) {
+        audioThread->join();
+    }
+
+    if (!chunked) {
+        // Frames still queued after a cancel give their buffers back
+        PipelineFrame frame;
+        while (decoded.tryPop(frame) || processed.tryPop(frame)) {
+            m_videoEncoder->releaseInputBuffer(frame.pixels);
+        }
+        m_videoEncoder->stop();
+    }
+    m_effectsProcessor.reset();
+    m_streamHeader.clear();
+
+    LOG_INFO("ExportManager: %lld frames and %lld audio samples encoded in %.1f ms",
+             static_cast<long long>(m_progress.framesEncoded),
+             static_cast<long long>(m_progress.audioSamplesProcessed),
+             static_cast<double>(elapsedUs(m_encodeStart)) / 1000.0);
+
+    if (m_pipelineFailed) {
         return false;
     }
+    m_progress.videoProgress = 1.0f;
+    m_progress.audioProgress = 1.0f;
+    return !m_cancelled;
+}
+
+void ExportManager::decodeStage(FrameQueue& output) {
+    const int64_t totalFrames = m_progress.totalFrames;
+    int64_t busyUs = 0;
+
+    for (int64_t frameNum = 0; frameNum < totalFrames && !m_cancelled; ++frameNum) {
+        auto start = SteadyClock::now();
+
+        PipelineFrame frame;
+        if (!composeFrame(*m_videoEncoder, frameNum, frame)) {
+            setPipelineError(m_videoEncoder->getLastError());
+            break;
+        }
+
+        busyUs += elapsedUs(start);
+        if (!output.push(frame)) {
+            m_videoEncoder->releaseInputBuffer(frame.pixels);
+            break;  // Downstream stopped
+        }
+    }
+
+    output.close();
+    LOG_DEBUG("ExportManager: decode stage busy %.1f ms", static_cast<double>(busyUs) / 1000.0);
+}
+
+void ExportManager::effectsStage(FrameQueue& input, FrameQueue& output) {
+    int64_t busyUs = 0;
+    PipelineFrame frame;
+
+    while (!m_cancelled && input.pop(frame)) {
+        auto start = SteadyClock::now();
+
+        applyEffects(frame, *m_effectsProcessor);
+
+        busyUs += elapsedUs(start);
+        if (!output.push(frame)) {
+            m_videoEncoder->releaseInputBuffer(frame.pixels);
+            break;
+        }
+    }
+
+    input.close();
+    output.close();
+    LOG_DEBUG("ExportManager: effects stage busy %.1f ms", static_cast<double>(busyUs) / 1000.0);
+}
+
+void ExportManager::encodeStage(FrameQueue& input, PacketQueue& output, BufferQueue& spent) {
+    const auto& encoderConfig = m_videoEncoder->getConfig();
+    const int64_t keyFrameInterval = std::max(1, encoderConfig.keyFrameInterval);
+    int64_t busyUs = 0;
+    PipelineFrame frame;
+
+    while (!m_cancelled && input.pop(frame)) {
+        auto start = SteadyClock::now();
+
+        // A buffer back from the muxer becomes the encoder's next output buffer
+        EncodedPacket packet;
+        spent.tryPop(packet.data);
+        if (!encodeFrame(*m_videoEncoder, frame, keyFrameInterval, packet)) {
+            std::string error = m_videoEncoder->getLastError();
+            LOG_ERROR("ExportManager: encoding frame %lld failed: %s",
+                      static_cast<long long>(frame.index), error.c_str());
+            setPipelineError(error);
+            break;
+        }
+        m_videoFramesDone++;
+
+        busyUs += elapsedUs(start);
+        if (!output.push(packet)) {
+            break;
+        }
+    }
+
+    input.close();
+    output.close();
+    LOG_DEBUG("ExportManager: encode stage busy %.1f ms", static_cast<double>(busyUs) / 1000.0);
+}
 
-    // Configure video encoder
+void ExportManager::segmentStage(PacketQueue& output) {
+    const int64_t totalFrames = m_progress.totalFrames;
+    const VideoEncodingConfig encoderConfig = makeEncoderConfig();
+    const int64_t keyFrameInterval = std::max(1, encoderConfig.keyFrameInterval);
+
+    // Segments are whole GOPs, so every one starts on a frame the single-pass
+    // encoder would also make a keyframe, and the stitched stream has the same layout
+    int64_t segmentCount = std::max(1, m_config.segmentCount);
+    int64_t gops = (totalFrames + keyFrameInterval - 1) / keyFrameInterval;
+    int64_t segmentFrames = std::max<int64_t>(1, (gops + segmentCount - 1) / segmentCount) * keyFrameInterval;
+    segmentCount = (totalFrames + segmentFrames - 1) / segmentFrames;
+
+    std::vector<VideoSegment> segments(static_cast<size_t>(segmentCount));
+    for (int64_t i = 0; i < segmentCount; i++) {
+        VideoSegment& segment = segments[static_cast<size_t>(i)];
+        segment.firstFrame = i * segmentFrames;
+        segment.endFrame = std::min(totalFrames, segment.firstFrame + segmentFrames);
+    }
+
+    LOG_INFO("ExportManager: %lld frames in %lld segments of %lld frames on %d threads",
+             static_cast<long long>(totalFrames), static_cast<long long>(segmentCount),
+             static_cast<long long>(segmentFrames), std::max(1, m_config.encodingThreads));
+
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+
+    // Encode on a pool; the pool hands segments out in order, so the
+    // earliest ones finish first and stitching can start right away
+    std::thread workers([&] {
+        utils::ThreadPool pool(static_cast<size_t>(std::max(1, m_config.encodingThreads)));
+        std::vector<std::unique_ptr<effects::EffectsProcessor>> processors(pool.getThreadCount());
+
+        pool.parallelForThreaded(segments.size(), [&](size_t index, size_t thread) {
+            if (!processors[thread]) {
+                processors[thread] = std::make_unique<effects::EffectsProcessor>(1);
+            }
+            encodeSegment(encoderConfig, *processors[thread], output, segments[index]);
+
+            {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                segments[index].done = true;
+            }
+            doneCondition.notify_all();
+        });
+    });
+
+    // Stitch: pass each segment's packets on in order as soon as it is done
+    for (VideoSegment& segment : segments) {
+        {
+            std::unique_lock<std::mutex> lock(doneMutex);
+            while (!segment.done) {
+                doneCondition.wait(lock);
+            }
+        }
+
+        if (!segment.error.empty()) {
+            setPipelineError(segment.error);
+            break;
+        }
+
+        std::ifstream spill;
+        if (!segment.spillPath.empty()) {
+            spill.open(segment.spillPath, std::ios::binary);
+        }
+
+        bool delivered = true;
+        for (EncodedPacket& packet : segment.packets) {
+            if (!segment.spillPath.empty()) {
+                packet.data.resize(static_cast<size_t>(packet.size));
+                if (!spill.read(reinterpret_cast<char*>(packet.data.data()), packet.size)) {
+                    setPipelineError("Failed to read back " + segment.spillPath);
+                    delivered = false;
+                    break;
+                }
+            }
+            if (!output.push(packet)) {
+                delivered = false;
+                break;
+            }
+        }
+        segment.packets.clear();
+        segment.packets.shrink_to_fit();
+        if (!delivered || m_cancelled) break;
+    }
+
+    // Stops the remaining segments early if stitching ended
+    output.close();
+    workers.join();
+
+    for (const VideoSegment& segment : segments) {
+        if (!segment.spillPath.empty()) {
+            std::remove(segment.spillPath.c_str());
+        }
+    }
+}
+
+void ExportManager::encodeSegment(const VideoEncodingConfig& encoderConfig,
+                                  effects::EffectsProcessor& processor,
+                                  const PacketQueue& output, VideoSegment& segment) {
+    const int64_t keyFrameInterval = std::max(1, encoderConfig.keyFrameInterval);
+
+    // Each segment gets its own encoder instance
+    VideoEncoder encoder;
+    if (!encoder.configure(encoderConfig) || !encoder.start()) {
+        segment.error = encoder.getLastError();
+        return;
+    }
+
+    // Packet data waits on disk rather than in memory until the stitcher
+    // gets to this segment; a backend exposes either every packet or none
+    std::ofstream spill;
+    std::vector<uint8_t> spareData;
+
+    segment.packets.reserve(static_cast<size_t>(segment.endFrame - segment.firstFrame));
+    for (int64_t frameNum = segment.firstFrame; frameNum < segment.endFrame; ++frameNum) {
+        if (m_cancelled || output.isClosed()) break;
+
+        PipelineFrame frame;
+        if (!composeFrame(encoder, frameNum, frame)) {
+            segment.error = encoder.getLastError();
+            break;
+        }
+        applyEffects(frame, processor);
+
+        // The encoder gets the spare buffer back, so the two alternate
+        EncodedPacket packet;
+        packet.data.swap(spareData);
+        if (!encodeFrame(encoder, frame, keyFrameInterval, packet)) {
+            segment.error = encoder.getLastError();
+            LOG_ERROR("ExportManager: encoding frame %lld failed: %s",
+                      static_cast<long long>(frameNum), segment.error.c_str());
+            break;
+        }
+
+        if (!packet.data.empty()) {
+            if (!spill.is_open()) {
+                segment.spillPath = m_config.outputPath + ".part" + std::to_string(segment.firstFrame);
+                spill.open(segment.spillPath, std::ios::binary | std::ios::trunc);
+            }
+            if (!spill.write(reinterpret_cast<const char*>(packet.data.data()),
+                             static_cast<std::streamsize>(packet.data.size()))) {
+                segment.error = "Failed to write " + segment.spillPath;
+                break;
+            }
+            spareData.swap(packet.data);
+        }
+        segment.packets.push_back(std::move(packet));
+        m_videoFramesDone++;
+    }
+
+    encoder.stop();
+}
+
+VideoEncodingConfig ExportManager::makeEncoderConfig() const {
     VideoEncodingConfig encoderConfig;
     encoderConfig.outputPath = m_config.outputPath;
     encoderConfig.codec = m_config.codec;
@@ -282,89 +671,229 @@ bool ExportManager::encodeVideo() {
     encoderConfig.height = m_config.height;
     encoderConfig.frameRate = m_config.frameRate;
     encoderConfig.bitrate = getPresetBitrate(m_config.quality);
+    encoderConfig.inputFormat = ColorFormat::RGBA;
+    encoderConfig.useHardwareEncoding = m_config.useHardwareEncoding;
+    encoderConfig.inputBufferCount = FRAMES_IN_FLIGHT;
+    return encoderConfig;
+}
+
+bool ExportManager::composeFrame(VideoEncoder& encoder, int64_t index, PipelineFrame& frame) {
+    frame.index = index;
+    frame.timestampMs = index * 1000 / m_config.frameRate;
+    frame.size = static_cast<size_t>(m_config.width) * static_cast<size_t>(m_config.height) * 4;
 
-    if (!m_videoEncoder->configure(encoderConfig)) {
-        m_lastError = m_videoEncoder->getLastError();
+    // FRAMES_IN_FLIGHT buffers cover every queue slot and stage, so this
+    // only waits while a later stage is about to hand one back
+    frame.pixels = encoder.getInputBuffer(frame.size, -1);
+    if (!frame.pixels) {
         return false;
     }
 
-    if (!m_videoEncoder->start()) {
-        m_lastError = m_videoEncoder->getLastError();
-        return false;
+    // Opaque black canvas; source decoding is not wired up yet
+    uint8_t* pixels = frame.pixels;
+    for (size_t i = 0; i < frame.size; i += 4) {
+        pixels[i] = 0;
+        pixels[i + 1] = 0;
+        pixels[i + 2] = 0;
+        pixels[i + 3] = 0xFF;
     }
+    return true;
+}
 
-    // Simulate video encoding progress
-    int64_t totalFrames = m_progress.totalFrames;
-    for (int64_t frameNum = 0; frameNum < totalFrames && !m_cancelled; ++frameNum) {
-        // Simulate frame encoding
-        uint8_t dummyFrame[4] = {0, 0, 0, 0};
-        m_videoEncoder->encodeFrame(dummyFrame, frameNum * (1000 / m_config.frameRate), false);
-
-        // Update progress every 10 frames
-        if (frameNum % 10 == 0) {
-            m_progress.framesEncoded = frameNum;
-            m_progress.videoProgress = static_cast<float>(frameNum) / static_cast<float>(totalFrames);
-            m_progress.totalProgress = m_progress.videoProgress * 0.5f;  // Video is 50% of total
-
-            auto currentTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::system_clock::now().time_since_epoch()).count();
-            auto elapsedMs = currentTimeMs - m_startTimeMs;
-            if (elapsedMs > 0) {
-                float fps = (static_cast<float>(frameNum) * 1000.0f) / static_cast<float>(elapsedMs);
-                m_progress.estimatedRemainingSeconds = static_cast<float>(totalFrames - frameNum) / std::max(1.0f, fps);
-            }
+void ExportManager::applyEffects(PipelineFrame& frame, effects::EffectsProcessor& processor) const {
+    for (const auto& clip : m_config.timeline->getClipsAtTime(frame.timestampMs)) {
+        if (clip && !clip->getEffectChain().isEmpty()) {
+            processor.process(clip->getEffectChain(), frame.pixels,
+                              m_config.width, m_config.height, m_config.width * 4);
+        }
+    }
+}
 
-            updateProgress();
+bool ExportManager::encodeFrame(VideoEncoder& encoder, const PipelineFrame& frame,
+                                int64_t keyFrameInterval, EncodedPacket& packet) {
+    packet.index = frame.index;
+    packet.timestampMs = frame.timestampMs;
+    packet.keyFrame = frame.index % keyFrameInterval == 0;
 
-            // Simulate some processing time
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    int64_t bytesBefore = encoder.getBytesEncoded();
+    if (!encoder.submitInputBuffer(frame.pixels, frame.size, frame.timestampMs, packet.keyFrame)) {
+        return false;
+    }
+    packet.size = encoder.getBytesEncoded() - bytesBefore;
+    encoder.takeLastPacket(packet.data);
+    return true;
+}
+
+void ExportManager::audioStage(PacketQueue& output) {
+    const int64_t totalSamples = m_progress.totalAudioSamples;
+    const int64_t packetBytes = static_cast<int64_t>(m_config.audioBitrate) * AUDIO_FRAME_SAMPLES
+        / std::max(1, m_config.audioSampleRate) / 8;
+    int64_t busyUs = 0;
+
+    // Every timeline track goes through the mixer for its volume, pan and EQ
+    audio::AudioMixer mixer(m_config.audioSampleRate);
+    for (const auto& track : m_config.timeline->getAllAudioTracks()) {
+        if (!track) continue;
+
+        size_t channels = track->getMetadata().channels >= 2 ? 2 : 1;
+        int slot = mixer.addTrack(std::make_shared<PendingDecodeSource>(channels));
+        if (slot >= 0) {
+            mixer.setTrackSettings(slot, audio::MixerTrackSettings::fromTrack(*track));
         }
     }
 
-    m_videoEncoder->stop();
-    m_progress.videoProgress = 1.0f;
+    std::vector<float> left(audio::AudioMixer::BLOCK_SIZE);
+    std::vector<float> right(audio::AudioMixer::BLOCK_SIZE);
+    constexpr int64_t BLOCKS_PER_PACKET = AUDIO_FRAME_SAMPLES / static_cast<int64_t>(audio::AudioMixer::BLOCK_SIZE);
 
-    return !m_cancelled;
-}
+    for (int64_t sample = 0; sample < totalSamples && !m_cancelled; sample += AUDIO_FRAME_SAMPLES) {
+        auto start = SteadyClock::now();
 
-bool ExportManager::encodeAudio() {
-    // Calculate total audio samples
-    m_progress.totalAudioSamples = static_cast<int64_t>(
-        (m_config.durationMs * m_config.audioSampleRate) / 1000);
+        for (int64_t block = 0; block < BLOCKS_PER_PACKET; block++) {
+            mixer.renderBlock(left.data(), right.data());
+        }
 
-    // Simulate audio encoding progress
-    for (int64_t sample = 0; sample < m_progress.totalAudioSamples && !m_cancelled; ++sample) {
-        m_progress.audioSamplesProcessed = sample;
-        m_progress.audioProgress = static_cast<float>(sample) / static_cast<float>(m_progress.totalAudioSamples);
-        m_progress.totalProgress = 0.5f + (m_progress.audioProgress * 0.25f);  // Audio is 25% of total
+        // Compression is not wired up yet; packets carry the nominal bitrate
+        EncodedPacket packet;
+        packet.index = sample / AUDIO_FRAME_SAMPLES;
+        packet.timestampMs = sample * 1000 / m_config.audioSampleRate;
+        packet.size = packetBytes;
+        packet.keyFrame = true;
+        m_audioSamplesDone = std::min(sample + AUDIO_FRAME_SAMPLES, totalSamples);
+
+        busyUs += elapsedUs(start);
+        m_audioBusyUs = busyUs;
+        if (!output.push(packet)) {
+            break;  // Muxer stopped
+        }
 
-        if (sample % 44100 == 0) {  // Update every second
-            updateProgress();
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        // Running alone (no parallel encoding), this thread owns the progress
+        if (!m_config.parallelEncoding && packet.index % 64 == 0) {
+            refreshProgress();
         }
     }
 
-    m_progress.audioProgress = 1.0f;
-    return !m_cancelled;
+    output.close();
+    LOG_DEBUG("ExportManager: audio stage busy %.1f ms", static_cast<double>(busyUs) / 1000.0);
 }
 
-bool ExportManager::muxStreams() {
-    // Simulate muxing progress
-    int steps = 100;
-    for (int step = 0; step < steps && !m_cancelled; ++step) {
-        m_progress.muxingProgress = static_cast<float>(step) / static_cast<float>(steps);
-        m_progress.totalProgress = 0.75f + (m_progress.muxingProgress * 0.25f);  // Muxing is 25% of total
-
-        if (step % 10 == 0) {
-            updateProgress();
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+void ExportManager::muxStage(PacketQueue& videoInput, PacketQueue& audioInput, BufferQueue* spent) {
+    int64_t videoBytes = 0;
+    int64_t audioBytes = 0;
+    int64_t packetsMuxed = 0;
+
+    // Until a container muxer exists, a backend with a stream header (the
+    // software one) has its video written to the output as an elementary
+    // stream; audio is only accounted
+    std::ofstream file;
+    if (!m_streamHeader.empty()) {
+        file.open(m_config.outputPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(m_streamHeader.data()),
+                   static_cast<std::streamsize>(m_streamHeader.size()));
+        if (!file) {
+            setPipelineError("Cannot write output file: " + m_config.outputPath);
+            LOG_ERROR("ExportManager: Cannot write output file: %s", m_config.outputPath.c_str());
+            videoInput.close();
+            audioInput.close();
+            return;
+        }
+    }
+
+    // Hold the next packet of each stream and write the earlier one first,
+    // so the streams interleave in timestamp order as they arrive
+    EncodedPacket video;
+    EncodedPacket audio;
+    bool haveVideo = videoInput.pop(video);
+    bool haveAudio = audioInput.pop(audio);
+
+    while (!m_cancelled && (haveVideo || haveAudio)) {
+        bool writeVideo = haveVideo && (!haveAudio || video.timestampMs <= audio.timestampMs);
+
+        if (writeVideo) {
+            if (file.is_open() && !video.data.empty()) {
+                file.write(reinterpret_cast<const char*>(video.data.data()),
+                           static_cast<std::streamsize>(video.data.size()));
+            }
+            videoBytes += video.size;
+            m_progress.framesEncoded = video.index + 1;
+            if (spent && !video.data.empty()) {
+                spent->tryPush(video.data);
+            }
+            haveVideo = videoInput.pop(video);
+        } else {
+            audioBytes += audio.size;
+            haveAudio = audioInput.pop(audio);
+        }
+
+        if (++packetsMuxed % 10 == 0) {
+            refreshProgress();
         }
     }
 
+    videoInput.close();
+    audioInput.close();
+
+    if (file.is_open() && !file.flush()) {
+        setPipelineError("Failed writing output file: " + m_config.outputPath);
+        LOG_ERROR("ExportManager: Failed writing output file: %s", m_config.outputPath.c_str());
+    }
+    LOG_DEBUG("ExportManager: muxed %lld video bytes, %lld audio bytes",
+              static_cast<long long>(videoBytes), static_cast<long long>(audioBytes));
+}
+
+bool ExportManager::muxStreams() {
+    // Container trailer and index; packets were written during encoding
     m_progress.muxingProgress = 1.0f;
+    updateProgress();
     return !m_cancelled;
 }
 
+void ExportManager::refreshProgress() {
+    const int64_t totalFrames = m_progress.totalFrames;
+    const int64_t totalSamples = m_progress.totalAudioSamples;
+    const int64_t framesDone = m_videoFramesDone.load();
+    const int64_t samplesDone = m_audioSamplesDone.load();
+    const auto now = SteadyClock::now();
+
+    m_progress.audioSamplesProcessed = samplesDone;
+    m_progress.videoProgress = totalFrames > 0
+        ? static_cast<float>(framesDone) / static_cast<float>(totalFrames) : 1.0f;
+    m_progress.audioProgress = totalSamples > 0
+        ? static_cast<float>(samplesDone) / static_cast<float>(totalSamples) : 1.0f;
+    m_progress.muxingProgress = totalFrames > 0
+        ? static_cast<float>(m_progress.framesEncoded) / static_cast<float>(totalFrames) : 1.0f;
+
+    // Each stream's remaining time is extrapolated from its own measured
+    // rate, so streams are weighted by what they actually cost. Video is
+    // timed by wall clock, as its stages overlap; audio by the time it was
+    // busy, since it runs ahead and then waits on the muxer. Until every
+    // unfinished stream has produced something the total is left as is.
+    auto remainingSeconds = [](float progress, double elapsed) {
+        if (progress >= 1.0f) return 0.0;
+        if (progress <= 0.0f || elapsed < 0.0) return -1.0;
+        return elapsed * (1.0 - progress) / progress;
+    };
+    double videoRemaining = remainingSeconds(m_progress.videoProgress,
+                                             std::chrono::duration<double>(now - m_videoStart).count());
+    double audioRemaining = remainingSeconds(m_progress.audioProgress,
+                                             static_cast<double>(m_audioBusyUs.load()) / 1e6);
+
+    if (videoRemaining >= 0.0 && audioRemaining >= 0.0) {
+        // Concurrent streams finish with the slower one; sequential ones add up
+        double remaining = m_config.parallelEncoding
+            ? std::max(videoRemaining, audioRemaining)
+            : videoRemaining + audioRemaining;
+        double elapsed = std::chrono::duration<double>(now - m_encodeStart).count();
+        float total = elapsed + remaining > 0.0 ? static_cast<float>(elapsed / (elapsed + remaining)) : 0.0f;
+
+        // Extrapolation jitters; never report going backwards
+        m_progress.totalProgress = std::max(m_progress.totalProgress, std::min(total, 0.99f));
+        m_progress.estimatedRemainingSeconds = static_cast<float>(remaining);
+    }
+
+    updateProgress();
+}
+
 void ExportManager::updateProgress() {
     if (m_progressCallback) {
         m_progressCallback(m_progress);
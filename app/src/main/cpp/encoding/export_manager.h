@@ -2,13 +2,18 @@
 #define CLIPFORGE_EXPORT_MANAGER_H
 
 #include "video_encoder.h"
-#include "../models/timeline.h"
+#include "../models/timeline_snapshot.h"
+#include "../effects/effects_processor.h"
+#include "../utils/spsc_queue.h"
+#include "../utils/thread_pool.h"
 #include <memory>
 #include <string>
 #include <vector>
 #include <functional>
 #include <atomic>
+#include <mutex>
 #include <thread>
+#include <chrono>
 
 namespace clipforge {
 namespace encoding {
@@ -59,12 +64,13 @@ struct ExportConfig {
     bool useHardwareEncoding = true;
     int encodingThreads = 2;
     bool parallelEncoding = true;
+    int segmentCount = 1;              // Video segments encoded in parallel (1 = single pass)
 
     // Duration
     int64_t durationMs = 0;
 
-    // Timeline
-    std::shared_ptr<models::Timeline> timeline;
+    // Timeline state to export; edits made during the export do not reach it
+    std::shared_ptr<const models::TimelineSnapshot> timeline;
 };
 
 /**
@@ -99,10 +105,36 @@ struct ExportProgress {
  * - Cancellation support
  * - Error recovery
  *
+ * Video is exported by a pipeline of four stages, each on its own
+ * thread: decode (compose the timeline frame), effects, encode and mux.
+ * Stages hand frames and packets to the next through bounded lock-free
+ * SPSC queues, so all four work on different frames at once and export
+ * time approaches that of the slowest stage rather than their sum. The
+ * queues hold PIPELINE_DEPTH items, and memory stays bounded whatever
+ * the export length: frames are composed straight into the encoder's
+ * input buffers, and the muxer hands packet buffers back to the encode
+ * stage, so a steady-state export does not allocate or copy per frame.
+ *
+ * With segmentCount > 1 the video is instead cut into that many runs of
+ * whole GOPs (keyFrameInterval frames), each rendered and encoded by its
+ * own encoder instance on a pool of encodingThreads threads. Finished
+ * segments are stitched in order into the muxer's packet stream; since
+ * every segment starts where the single-pass encoder places a keyframe,
+ * the stream has the same frame and keyframe layout either way.
+ *
+ * With parallelEncoding, audio is mixed (AudioMixer) and encoded on a
+ * fifth thread at the same time. The muxer interleaves both packet
+ * streams in timestamp order as they arrive, leaving only the container
+ * trailer for the final phase. Without it, audio is encoded first.
+ *
+ * Overall progress is weighted by measured cost: each stream's remaining
+ * time is extrapolated from its own rate so far, and totalProgress is
+ * elapsed time over elapsed plus remaining.
+ *
  * Usage:
  * @code
  * auto manager = std::make_shared<ExportManager>();
- * ExportConfig config{timeline, "output.mp4", ExportFormat::MP4};
+ * ExportConfig config{timeline->snapshot(), "output.mp4", ExportFormat::MP4};
  * manager->setProgressCallback([](const ExportProgress& p) {
  *     printf("Progress: %.1f%%\n", p.totalProgress * 100);
  * });
@@ -280,15 +312,60 @@ public:
      * @brief Get error message if export failed
      * @return Error description
      */
-    [[nodiscard]] std::string getErrorMessage() const { return m_lastError; }
+    [[nodiscard]] std::string getErrorMessage() const;
 
     /**
      * @brief Check if export had error
      * @return true if error occurred
      */
-    [[nodiscard]] bool hasError() const { return !m_lastError.empty(); }
+    [[nodiscard]] bool hasError() const;
 
 private:
+    static constexpr size_t PIPELINE_DEPTH = 2;        // Queued items between two stages
+    static constexpr int FRAMES_IN_FLIGHT = static_cast<int>(PIPELINE_DEPTH) * 2 + 3;   // Queued plus one per stage
+    static constexpr size_t AUDIO_PACKET_DEPTH = 16;   // Audio packets queued for the muxer
+    static constexpr int64_t AUDIO_FRAME_SAMPLES = 1024;   // Samples per audio packet (AAC frame)
+
+    /**
+     * @struct PipelineFrame
+     * @brief A frame travelling through the video stages
+     */
+    struct PipelineFrame {
+        int64_t index = 0;
+        int64_t timestampMs = 0;
+        uint8_t* pixels = nullptr;      // Encoder input buffer, RGBA8 at the export resolution
+        size_t size = 0;                // Bytes
+    };
+
+    /**
+     * @struct EncodedPacket
+     * @brief Encoder output handed to the muxer
+     */
+    struct EncodedPacket {
+        int64_t index = 0;
+        int64_t timestampMs = 0;
+        int64_t size = 0;               // Bytes
+        bool keyFrame = false;
+        std::vector<uint8_t> data;      // Encoded bytes; empty if the encoder does not expose them
+    };
+
+    /**
+     * @struct VideoSegment
+     * @brief Frames [firstFrame, endFrame) encoded by one encoder instance
+     */
+    struct VideoSegment {
+        int64_t firstFrame = 0;
+        int64_t endFrame = 0;
+        std::vector<EncodedPacket> packets;
+        std::string spillPath;          // Packet data written to disk until stitched
+        std::string error;              // Set if the segment failed
+        bool done = false;              // Guarded by the stitcher's mutex
+    };
+
+    using FrameQueue = utils::SpscQueue<PipelineFrame>;
+    using PacketQueue = utils::SpscQueue<EncodedPacket>;
+    using BufferQueue = utils::SpscQueue<std::vector<uint8_t>>;
+
     ExportConfig m_config;
     ExportProgress m_progress;
     ProgressCallback m_progressCallback;
@@ -300,32 +377,131 @@ private:
     std::unique_ptr<std::thread> m_exportThread;
     std::shared_ptr<VideoEncoder> m_videoEncoder;
 
+    // Video pipeline
+    std::unique_ptr<effects::EffectsProcessor> m_effectsProcessor;
+    std::atomic<bool> m_pipelineFailed{false};
+    std::vector<uint8_t> m_streamHeader;        // Written before the first video packet
+
+    // Progress accounting; the counters are written by the producing stages
+    using SteadyClock = std::chrono::steady_clock;
+    std::atomic<int64_t> m_videoFramesDone{0};
+    std::atomic<int64_t> m_audioSamplesDone{0};
+    std::atomic<int64_t> m_audioBusyUs{0};      // Audio time spent mixing and encoding
+    SteadyClock::time_point m_encodeStart;
+    SteadyClock::time_point m_videoStart;
+
+    mutable std::mutex m_errorMutex;            // Guards m_lastError; pipeline stages report concurrently
     std::string m_lastError;
     int64_t m_startTimeMs = 0;
 
+    /**
+     * @brief Replace the error message
+     * @param message Error description
+     */
+    void setError(const std::string& message);
+
+    /**
+     * @brief Fail the pipeline, keeping the first stage's error
+     * @param message Error description; dropped if an error is already recorded
+     */
+    void setPipelineError(const std::string& message);
+
     /**
      * @brief Main export thread function
      */
     void exportThread();
 
     /**
-     * @brief Encode video from timeline
+     * @brief Encode video and audio and mux their packets
      * @return true if successful
      */
-    bool encodeVideo();
+    bool encodeStreams();
 
     /**
-     * @brief Mix and encode audio
-     * @return true if successful
+     * @brief Compose timeline frames into encoder input buffers (decode stage)
+     * @param output Receives frames in order; closed when done
+     */
+    void decodeStage(FrameQueue& output);
+
+    /**
+     * @brief Apply the effect chains of the clips on each frame (effects stage)
+     */
+    void effectsStage(FrameQueue& input, FrameQueue& output);
+
+    /**
+     * @brief Feed frames to the video encoder (encode stage)
+     * @param spent Packet buffers the muxer is done with, reused for output
+     */
+    void encodeStage(FrameQueue& input, PacketQueue& output, BufferQueue& spent);
+
+    /**
+     * @brief Encode GOP-aligned segments in parallel and stitch them (chunked export)
+     * @param output Receives the packets of all segments in frame order
+     */
+    void segmentStage(PacketQueue& output);
+
+    /**
+     * @brief Render and encode one segment with its own encoder
+     * @param encoderConfig Encoder settings shared by all segments
+     * @param processor The calling thread's effects processor
+     * @param output Stitched stream; once closed the segment stops early
+     * @param segment Segment to encode; receives packets or an error
+     */
+    void encodeSegment(const VideoEncodingConfig& encoderConfig, effects::EffectsProcessor& processor,
+                       const PacketQueue& output, VideoSegment& segment);
+
+    /**
+     * @brief Build the video encoder settings for this export
+     */
+    [[nodiscard]] VideoEncodingConfig makeEncoderConfig() const;
+
+    /**
+     * @brief Compose a timeline frame straight into an encoder input buffer
+     * @param encoder Encoder the frame will be submitted to
+     * @return false if no buffer could be dequeued
+     */
+    bool composeFrame(VideoEncoder& encoder, int64_t index, PipelineFrame& frame);
+
+    /**
+     * @brief Apply the effect chains of the clips visible on a frame
+     */
+    void applyEffects(PipelineFrame& frame, effects::EffectsProcessor& processor) const;
+
+    /**
+     * @brief Encode one frame, keyframes every keyFrameInterval frames
+     *
+     * Submits the frame's input buffer, which returns to the encoder's pool.
+     *
+     * @return false if the encoder failed
+     */
+    static bool encodeFrame(VideoEncoder& encoder, const PipelineFrame& frame,
+                            int64_t keyFrameInterval, EncodedPacket& packet);
+
+    /**
+     * @brief Mix the audio tracks and encode them (audio stage)
+     * @param output Receives packets in order; closed when done
+     */
+    void audioStage(PacketQueue& output);
+
+    /**
+     * @brief Interleave video and audio packets into the container (mux stage)
+     * @param spent Receives written video packet buffers for reuse (may be null)
      */
-    bool encodeAudio();
+    void muxStage(PacketQueue& videoInput, PacketQueue& audioInput, BufferQueue* spent);
 
     /**
-     * @brief Mux video and audio into container
+     * @brief Finalize the container after all packets are written
      * @return true if successful
      */
     bool muxStreams();
 
+    /**
+     * @brief Recompute progress from the stage counters and trigger callback
+     *
+     * Called only by the thread that owns m_progress at the time.
+     */
+    void refreshProgress();
+
     /**
      * @brief Update progress and trigger callback
      */
@@ -0,0 +1,103 @@
+#include "software_encoder.h"
+#include "yuv_converter.h"
+#include "../utils/logger.h"
+#include <cstdio>
+#include <cstring>
+
+namespace clipforge {
+namespace encoding {
+
+namespace {
+
+constexpr char FRAME_MARKER[] = "FRAME\n";
+constexpr size_t FRAME_MARKER_SIZE = sizeof(FRAME_MARKER) - 1;
+
+} // anonymous namespace
+
+// ===== SoftwareEncoderBackend Implementation =====
+
+bool SoftwareEncoderBackend::open(const VideoEncodingConfig& config) {
+    if (getFrameSize(config.inputFormat, config.width, config.height) == 0) {
+        m_lastError = "Unsupported input format";
+        return false;
+    }
+
+    m_config = config;
+    m_lumaSize = static_cast<size_t>(config.width) * static_cast<size_t>(config.height);
+    m_chromaWidth = static_cast<size_t>((config.width + 1) / 2);
+    m_chromaSize = m_chromaWidth * static_cast<size_t>((config.height + 1) / 2);
+
+    LOG_INFO("VideoEncoder: software backend opened (%dx%d Y4M)", config.width, config.height);
+    return true;
+}
+
+int64_t SoftwareEncoderBackend::encode(const uint8_t* frameData, int64_t timestampMs, bool keyFrame,
+                                       std::vector<uint8_t>& packet) {
+    // Every Y4M frame is independent, so each one is a keyframe
+    (void)timestampMs;
+    (void)keyFrame;
+
+    if (m_lumaSize == 0) {
+        m_lastError = "Software encoder not opened";
+        return -1;
+    }
+
+    packet.resize(FRAME_MARKER_SIZE + m_lumaSize + 2 * m_chromaSize);
+    std::memcpy(packet.data(), FRAME_MARKER, FRAME_MARKER_SIZE);
+    convertToI420(frameData, packet.data() + FRAME_MARKER_SIZE);
+
+    return static_cast<int64_t>(packet.size());
+}
+
+void SoftwareEncoderBackend::close() {
+    m_lumaSize = 0;
+}
+
+std::vector<uint8_t> SoftwareEncoderBackend::getStreamHeader() const {
+    char header[128];
+    int length = std::snprintf(header, sizeof(header),
+                               "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XCOLORRANGE=%s\n",
+                               m_config.width, m_config.height, m_config.frameRate,
+                               m_config.fullRange ? "FULL" : "LIMITED");
+    if (length <= 0) return {};
+    return std::vector<uint8_t>(header, header + length);
+}
+
+void SoftwareEncoderBackend::convertToI420(const uint8_t* frameData, uint8_t* planes) const {
+    uint8_t* uPlane = planes + m_lumaSize;
+    uint8_t* vPlane = uPlane + m_chromaSize;
+
+    switch (m_config.inputFormat) {
+        case ColorFormat::YUV420P:
+            std::memcpy(planes, frameData, m_lumaSize + 2 * m_chromaSize);
+            break;
+
+        case ColorFormat::NV12:
+        case ColorFormat::NV21: {
+            // Split the interleaved chroma plane
+            std::memcpy(planes, frameData, m_lumaSize);
+            const uint8_t* chroma = frameData + m_lumaSize;
+            uint8_t* first = m_config.inputFormat == ColorFormat::NV12 ? uPlane : vPlane;
+            uint8_t* second = m_config.inputFormat == ColorFormat::NV12 ? vPlane : uPlane;
+            for (size_t i = 0; i < m_chromaSize; i++) {
+                first[i] = chroma[2 * i];
+                second[i] = chroma[2 * i + 1];
+            }
+            break;
+        }
+
+        case ColorFormat::RGBA:
+            convertRgba(frameData, planes);
+            break;
+    }
+}
+
+void SoftwareEncoderBackend::convertRgba(const uint8_t* rgba, uint8_t* planes) const {
+    effects::ImageView source{const_cast<uint8_t*>(rgba), m_config.width, m_config.height,
+                              m_config.width * 4};
+    YuvImage i420 = YuvImage::packed(ColorFormat::YUV420P, planes, m_config.width, m_config.height);
+    YuvConverter::rgbaToYuv(source, i420, m_config.colorSpace, m_config.fullRange);
+}
+
+} // namespace encoding
+} // namespace clipforge
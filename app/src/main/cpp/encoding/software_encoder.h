@@ -0,0 +1,58 @@
+#ifndef CLIPFORGE_SOFTWARE_ENCODER_H
+#define CLIPFORGE_SOFTWARE_ENCODER_H
+
+#include "encoder_backend.h"
+#include <vector>
+#include <cstdint>
+
+namespace clipforge {
+namespace encoding {
+
+/**
+ * @class SoftwareEncoderBackend
+ * @brief Device-independent encoder producing a YUV4MPEG2 (Y4M) stream
+ *
+ * Stands in for a codec where MediaCodec is unavailable, e.g. headless
+ * export on Linux hosts. Every frame is converted to planar I420 and
+ * emitted uncompressed as a Y4M "FRAME" packet; the stream header from
+ * getStreamHeader() plus the packets in order form a file that ffmpeg
+ * and most players read directly. Converting and copying real pixels
+ * makes its throughput and byte counts measurable, but at raw size.
+ *
+ * RGBA input is converted by YuvConverter with BT.601 (colorSpace 0)
+ * or BT.709 (colorSpace 1) coefficients, in the range fullRange selects.
+ */
+class SoftwareEncoderBackend : public EncoderBackend {
+public:
+    SoftwareEncoderBackend() = default;
+
+    [[nodiscard]] const char* getName() const override { return "Software (Y4M)"; }
+    bool open(const VideoEncodingConfig& config) override;
+    int64_t encode(const uint8_t* frameData, int64_t timestampMs, bool keyFrame,
+                   std::vector<uint8_t>& packet) override;
+    void close() override;
+    [[nodiscard]] std::vector<uint8_t> getStreamHeader() const override;
+
+private:
+    VideoEncodingConfig m_config;
+    size_t m_lumaSize = 0;
+    size_t m_chromaWidth = 0;
+    size_t m_chromaSize = 0;
+
+    /**
+     * @brief Convert a frame into I420 planes
+     * @param frameData Input frame
+     * @param planes Destination: Y, then U, then V
+     */
+    void convertToI420(const uint8_t* frameData, uint8_t* planes) const;
+
+    /**
+     * @brief Convert RGBA into I420 planes
+     */
+    void convertRgba(const uint8_t* rgba, uint8_t* planes) const;
+};
+
+} // namespace encoding
+} // namespace clipforge
+
+#endif // CLIPFORGE_SOFTWARE_ENCODER_H
@@ -1,10 +1,14 @@
 #include "video_encoder.h"
+#include "encoder_backend.h"
+#include "yuv_converter.h"
 #include "../utils/logger.h"
 #include <cstring>
 #include <cmath>
 #include <atomic>
 #include <mutex>
 #include <chrono>
+#include <new>
+#include <algorithm>
 
 namespace clipforge {
 namespace encoding {
@@ -12,8 +16,7 @@ namespace encoding {
 // ===== VideoEncoder Implementation =====
 
 VideoEncoder::VideoEncoder()
-    : m_configured(false), m_encoding(false), m_paused(false),
-      m_mediaCodec(nullptr), m_inputSurface(nullptr) {
+    : m_configured(false), m_encoding(false), m_paused(false) {
     LOG_DEBUG("VideoEncoder created");
 }
 
@@ -21,14 +24,15 @@ VideoEncoder::~VideoEncoder() {
     if (m_encoding) {
         stop();
     }
-    releaseMediaCodec();
+    releaseBackend();
+    freeInputBuffers();
     LOG_DEBUG("VideoEncoder destroyed");
 }
 
 bool VideoEncoder::configure(const VideoEncodingConfig& config) {
     if (m_encoding) {
-        m_lastError = "Cannot configure while encoding is in progress";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+        setError("Cannot configure while encoding is in progress");
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
@@ -40,27 +44,27 @@ bool VideoEncoder::configure(const VideoEncodingConfig& config) {
 
     // Validate configuration
     if (config.width <= 0 || config.height <= 0) {
-        m_lastError = "Invalid resolution: width and height must be positive";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+        setError("Invalid resolution: width and height must be positive");
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
     if (config.frameRate <= 0 || config.frameRate > 120) {
-        m_lastError = "Invalid frame rate: must be between 1 and 120";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+        setError("Invalid frame rate: must be between 1 and 120");
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
     if (config.bitrate <= 0) {
-        m_lastError = "Invalid bitrate: must be positive";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+        setError("Invalid bitrate: must be positive");
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
     // Check codec support
     if (!isCodecSupported(config.codec)) {
-        m_lastError = "Codec not supported on this device";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+        setError("Codec not supported on this device");
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
@@ -74,8 +78,8 @@ bool VideoEncoder::configure(const VideoEncodingConfig& config) {
 
 bool VideoEncoder::start() {
     if (!m_configured) {
-        m_lastError = "Encoder not configured";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+        setError("Encoder not configured");
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
@@ -84,12 +88,18 @@ bool VideoEncoder::start() {
         return true;
     }
 
-    if (!initializeMediaCodec()) {
-        m_lastError = "Failed to initialize MediaCodec";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+    if (!initializeBackend()) {
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(m_inputMutex);
+        m_inputBufferSize = getFrameSize(m_config.inputFormat, m_config.width, m_config.height);
+        m_inputBuffers.reserve(static_cast<size_t>(std::max(1, m_config.inputBufferCount)));
+        m_inputPoolOpen = true;
+    }
+
     m_encoding = true;
     m_paused = false;
     m_stats.frameCount = 0;
@@ -105,13 +115,12 @@ bool VideoEncoder::stop() {
         return true;
     }
 
-    // Process any remaining output buffers
-    processOutputBuffers();
-
     m_encoding = false;
     m_paused = false;
 
-    releaseMediaCodec();
+    // Closing the backend flushes any pending output
+    releaseBackend();
+    freeInputBuffers();
 
     LOG_INFO("VideoEncoder stopped");
     return true;
@@ -141,7 +150,7 @@ bool VideoEncoder::resume() {
 
 bool VideoEncoder::encodeFrame(const uint8_t* frameData, int64_t timestampMs, bool isKeyFrame) {
     if (!m_encoding) {
-        m_lastError = "Encoder not active";
+        setError("Encoder not active");
         return false;
     }
 
@@ -150,126 +159,215 @@ bool VideoEncoder::encodeFrame(const uint8_t* frameData, int64_t timestampMs, bo
     }
 
     if (!frameData) {
-        m_lastError = "Null frame data";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+        setError("Null frame data");
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
-    // Calculate expected frame size
-    int frameSize = 0;
-    switch (m_config.inputFormat) {
-        case ColorFormat::NV12:
-        case ColorFormat::NV21:
-            frameSize = (m_config.width * m_config.height * 3) / 2;
-            break;
-        case ColorFormat::YUV420P:
-            frameSize = (m_config.width * m_config.height * 3) / 2;
-            break;
-        case ColorFormat::RGBA:
-            frameSize = m_config.width * m_config.height * 4;
-            break;
-        default:
-            m_lastError = "Unknown color format";
-            return false;
+    bool keyFrame = isKeyFrame || m_forceKeyFrame;
+    m_forceKeyFrame = false;
+
+    int64_t bytes = m_backend->encode(frameData, timestampMs, keyFrame, m_lastPacket);
+    if (bytes < 0) {
+        setError(m_backend->getLastError());
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
+        return false;
     }
 
-    // Queue frame for encoding
-    // This is a simplified implementation - actual MediaCodec interaction would happen here
     m_stats.frameCount++;
     m_stats.encodedPercentage = static_cast<float>(m_stats.frameCount) / static_cast<float>(m_stats.totalFrames);
-    m_stats.bytesEncoded += frameSize;
+    m_stats.bytesEncoded += bytes;
 
     if (m_stats.frameCount % m_config.frameRate == 0) {
         LOG_DEBUG("VideoEncoder: Encoded %lld frames (%.1f%%)",
              m_stats.frameCount, m_stats.encodedPercentage * 100.0f);
     }
 
-    // Request keyframe if requested
-    if (isKeyFrame) {
-        forceKeyframe();
-    }
-
-    // Process output buffers periodically
-    if (m_stats.frameCount % 30 == 0) {
-        processOutputBuffers();
-    }
-
     return true;
 }
 
 bool VideoEncoder::encodeFrameWithStride(const uint8_t* frameData, int width, int height,
                                          int stride, int64_t timestampMs) {
     if (!m_encoding) {
-        m_lastError = "Encoder not active";
+        setError("Encoder not active");
         return false;
     }
 
     if (width != m_config.width || height != m_config.height) {
-        m_lastError = "Frame dimensions do not match configured resolution";
+        setError("Frame dimensions do not match configured resolution");
         LOG_ERROR("VideoEncoder: %s (got %dx%d, expected %dx%d)",
-             m_lastError.c_str(), width, height, m_config.width, m_config.height);
+             getLastError().c_str(), width, height, m_config.width, m_config.height);
+        return false;
+    }
+
+    if (stride < width * 4) {
+        setError("Stride is smaller than an RGBA row");
+        LOG_ERROR("VideoEncoder: %s (stride %d, width %d)", getLastError().c_str(), stride, width);
+        return false;
+    }
+
+    uint8_t* buffer = getInputBuffer(m_inputBufferSize, 0);
+    if (!buffer) {
+        LOG_ERROR("VideoEncoder: No input buffer for strided frame: %s", getLastError().c_str());
         return false;
     }
 
-    // Encode with stride information
-    return encodeFrame(frameData, timestampMs, false);
+    effects::ImageView rgba{const_cast<uint8_t*>(frameData), width, height, stride};
+    if (m_config.inputFormat == ColorFormat::RGBA) {
+        // Drop the row padding
+        const size_t rowBytes = static_cast<size_t>(width) * 4;
+        for (int32_t y = 0; y < height; y++) {
+            std::memcpy(buffer + static_cast<size_t>(y) * rowBytes, rgba.row(y), rowBytes);
+        }
+    } else {
+        YuvImage yuv = YuvImage::packed(m_config.inputFormat, buffer, width, height);
+        if (!YuvConverter::rgbaToYuv(rgba, yuv, m_config.colorSpace, m_config.fullRange)) {
+            releaseInputBuffer(buffer);
+            setError("Color conversion failed");
+            LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
+            return false;
+        }
+    }
+
+    return submitInputBuffer(buffer, m_inputBufferSize, timestampMs, false);
 }
 
-uint8_t* VideoEncoder::getInputBuffer(size_t size) {
-    if (!m_encoding) {
-        m_lastError = "Encoder not active";
+uint8_t* VideoEncoder::getInputBuffer(size_t size, int timeoutMs) {
+    std::unique_lock<std::mutex> lock(m_inputMutex);
+    if (!m_inputPoolOpen) {
+        setError("Encoder not active");
+        return nullptr;
+    }
+
+    if (size == 0 || size > m_inputBufferSize) {
+        setError("Input buffer size exceeds frame size");
         return nullptr;
     }
 
-    // In a real implementation, this would acquire a direct buffer from MediaCodec
-    // For now, allocate a temporary buffer
-    static thread_local std::vector<uint8_t> buffer;
-    if (buffer.size() < size) {
-        buffer.resize(size);
+    // Reuse an idle buffer first, grow the pool only up to its limit
+    const size_t maxBuffers = static_cast<size_t>(std::max(1, m_config.inputBufferCount));
+    uint8_t* data = nullptr;
+    auto dequeue = [&] {
+        if (!m_inputPoolOpen) {
+            return true;
+        }
+        for (auto& buffer : m_inputBuffers) {
+            if (!buffer.dequeued) {
+                buffer.dequeued = true;
+                data = buffer.data;
+                return true;
+            }
+        }
+        if (m_inputBuffers.size() < maxBuffers) {
+            InputBuffer buffer;
+            buffer.data = static_cast<uint8_t*>(
+                ::operator new(m_inputBufferSize, std::align_val_t{INPUT_BUFFER_ALIGNMENT}));
+            buffer.dequeued = true;
+            m_inputBuffers.push_back(buffer);
+            data = buffer.data;
+            return true;
+        }
+        return false;
+    };
+
+    if (timeoutMs < 0) {
+        m_inputAvailable.wait(lock, dequeue);
+    } else if (!dequeue() && timeoutMs > 0) {
+        m_inputAvailable.wait_for(lock, std::chrono::milliseconds(timeoutMs), dequeue);
     }
-    return buffer.data();
+    return data;
 }
 
-bool VideoEncoder::submitInputBuffer(uint8_t* data, size_t size, int64_t timestampMs) {
+bool VideoEncoder::submitInputBuffer(uint8_t* data, size_t size, int64_t timestampMs, bool isKeyFrame) {
     if (!m_encoding) {
-        m_lastError = "Encoder not active";
+        setError("Encoder not active");
         return false;
     }
 
-    if (!data || size == 0) {
-        m_lastError = "Invalid buffer data";
+    if (!data || size != m_inputBufferSize) {
+        setError("Invalid buffer data");
         return false;
     }
 
-    // Submit buffer to encoder (simplified)
+    {
+        std::lock_guard<std::mutex> lock(m_inputMutex);
+        if (!findDequeuedBuffer(data)) {
+            setError("Buffer was not dequeued from this encoder");
+            return false;
+        }
+    }
+
+    // The backend reads the frame in place and has drained it on return
+    bool encoded = encodeFrame(data, timestampMs, isKeyFrame);
+    releaseInputBuffer(data);
+    return encoded;
+}
+
+bool VideoEncoder::releaseInputBuffer(uint8_t* data) {
+    {
+        std::lock_guard<std::mutex> lock(m_inputMutex);
+        InputBuffer* buffer = findDequeuedBuffer(data);
+        if (!buffer) {
+            return false;
+        }
+        buffer->dequeued = false;
+    }
+    m_inputAvailable.notify_one();
     return true;
 }
 
-int64_t VideoEncoder::processOutputBuffers() {
-    if (!m_mediaCodec) {
-        return 0;
+VideoEncoder::InputBuffer* VideoEncoder::findDequeuedBuffer(const uint8_t* data) {
+    for (auto& buffer : m_inputBuffers) {
+        if (buffer.data == data) {
+            return buffer.dequeued ? &buffer : nullptr;
+        }
     }
+    return nullptr;
+}
+
+void VideoEncoder::freeInputBuffers() {
+    {
+        std::lock_guard<std::mutex> lock(m_inputMutex);
+        size_t outstanding = 0;
+        for (auto& buffer : m_inputBuffers) {
+            if (buffer.dequeued) {
+                outstanding++;
+            }
+            ::operator delete(buffer.data, std::align_val_t{INPUT_BUFFER_ALIGNMENT});
+        }
+        if (outstanding > 0) {
+            LOG_WARNING("VideoEncoder: %zu input buffers freed while dequeued", outstanding);
+        }
+        m_inputBuffers.clear();
+        m_inputPoolOpen = false;
+    }
+
+    // Wake clients waiting for a buffer; they get nullptr
+    m_inputAvailable.notify_all();
+}
 
-    // In a real implementation, this would dequeue output buffers from MediaCodec
-    // and write them to the output file
-    int64_t bytesWritten = 0;
+std::vector<uint8_t> VideoEncoder::getStreamHeader() const {
+    return m_backend ? m_backend->getStreamHeader() : std::vector<uint8_t>{};
+}
 
-    // Simplified: return accumulated bytes
-    return bytesWritten;
+const char* VideoEncoder::getBackendName() const {
+    return m_backend ? m_backend->getName() : "none";
 }
 
 bool VideoEncoder::setBitrate(int bitrate) {
     if (bitrate <= 0) {
-        m_lastError = "Invalid bitrate value";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+        setError("Invalid bitrate value");
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
     m_config.bitrate = bitrate;
 
-    // If encoding, apply dynamic bitrate change to MediaCodec
-    if (m_encoding && m_mediaCodec) {
-        LOG_INFO("VideoEncoder: Bitrate updated to %d bps", bitrate);
+    // If encoding, apply dynamic bitrate change to the backend
+    if (m_encoding && m_backend && !m_backend->setBitrate(bitrate)) {
+        setError(m_backend->getLastError());
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
+        return false;
     }
 
     return true;
@@ -277,24 +375,19 @@ bool VideoEncoder::setBitrate(int bitrate) {
 
 bool VideoEncoder::forceKeyframe() {
     if (!m_encoding) {
-        m_lastError = "Encoder not active";
-        return false;
-    }
-
-    if (!m_mediaCodec) {
-        m_lastError = "MediaCodec not initialized";
+        setError("Encoder not active");
         return false;
     }
 
-    // Request IDR frame from MediaCodec
-    LOG_DEBUG("VideoEncoder: IDR frame requested");
+    // Applied to the next encoded frame
+    m_forceKeyFrame = true;
     return true;
 }
 
 bool VideoEncoder::setQualityLevel(int level) {
     if (level < 0 || level > 51) {
-        m_lastError = "Quality level must be between 0 and 51";
-        LOG_ERROR("VideoEncoder: %s", m_lastError.c_str());
+        setError("Quality level must be between 0 and 51");
+        LOG_ERROR("VideoEncoder: %s", getLastError().c_str());
         return false;
     }
 
@@ -361,6 +454,21 @@ int VideoEncoder::getRecommendedBitrate(int width, int height, int frameRate, in
     return recommendedBitrate;
 }
 
+std::string VideoEncoder::getLastError() const {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    return m_lastError;
+}
+
+bool VideoEncoder::hasError() const {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    return !m_lastError.empty();
+}
+
+void VideoEncoder::setError(const std::string& message) {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    m_lastError = message;
+}
+
 std::string VideoEncoder::codecToMimeType(VideoCodec codec) {
     switch (codec) {
         case VideoCodec::H264:
@@ -380,37 +488,31 @@ int VideoEncoder::calculateBitrate() const {
         m_config.qualityLevel / 25);  // Normalize 0-51 to 0-2
 }
 
-bool VideoEncoder::initializeMediaCodec() {
-    if (m_mediaCodec) {
+bool VideoEncoder::initializeBackend() {
+    if (m_backend) {
         return true;
     }
 
-    // In a real implementation, this would:
-    // 1. Create a MediaCodec instance for the specified codec
-    // 2. Configure it with the VideoEncodingConfig parameters
-    // 3. Create input/output surfaces if needed
-    // 4. Start the codec
-
-    m_mediaCodec = reinterpret_cast<void*>(1);  // Placeholder
+    m_backend = EncoderBackend::create(m_config);
+    if (!m_backend->open(m_config)) {
+        setError(std::string("Failed to initialize ") + m_backend->getName() +
+                 ": " + m_backend->getLastError());
+        m_backend.reset();
+        return false;
+    }
 
-    LOG_INFO("VideoEncoder: MediaCodec initialized");
+    m_forceKeyFrame = false;
+    LOG_INFO("VideoEncoder: using %s backend", m_backend->getName());
     return true;
 }
 
-void VideoEncoder::releaseMediaCodec() {
-    if (!m_mediaCodec) {
+void VideoEncoder::releaseBackend() {
+    if (!m_backend) {
         return;
     }
 
-    // In a real implementation, this would:
-    // 1. Stop the MediaCodec
-    // 2. Release input/output buffers
-    // 3. Release the codec instance
-
-    m_mediaCodec = nullptr;
-    m_inputSurface = nullptr;
-
-    LOG_INFO("VideoEncoder: MediaCodec released");
+    m_backend->close();
+    m_backend.reset();
 }
 
 } // namespace encoding
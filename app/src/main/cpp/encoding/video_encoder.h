@@ -6,10 +6,14 @@
 #include <vector>
 #include <cstdint>
 #include <functional>
+#include <mutex>
+#include <condition_variable>
 
 namespace clipforge {
 namespace encoding {
 
+class EncoderBackend;
+
 /**
  * @enum VideoCodec
  * @brief Supported video codecs
@@ -86,6 +90,8 @@ struct VideoEncodingConfig {
     // Input
     ColorFormat inputFormat = ColorFormat::NV12;
     int colorSpace = 0;               // SMPTE 170M (0) or BT.709 (1)
+    bool fullRange = false;           // Full-range (0-255) YUV instead of 16-235
+    int inputBufferCount = 4;         // Encoder-owned buffers for getInputBuffer()
 
     // Flags
     bool enableLowLatency = false;
@@ -108,11 +114,12 @@ struct EncodingStats {
 
 /**
  * @class VideoEncoder
- * @brief Hardware-accelerated video encoder
+ * @brief Video encoder with pluggable codec backends
  *
- * Provides interface to Android's MediaCodec for video encoding.
- * Supports multiple codecs and quality presets with real-time
- * progress monitoring.
+ * Encodes through Android's MediaCodec when useHardwareEncoding is set,
+ * otherwise through the software backend (see EncoderBackend), so
+ * exports also run headless. Supports multiple codecs and quality
+ * presets with real-time progress monitoring.
  *
  * Usage:
  * @code
@@ -211,11 +218,17 @@ public:
     bool encodeFrame(const uint8_t* frameData, int64_t timestampMs, bool isKeyFrame = false);
 
     /**
-     * @brief Queue frame with stride information
-     * @param frameData Frame data pointer
+     * @brief Queue an RGBA frame with padded rows
+     *
+     * Converts the rows into an input buffer in the configured input
+     * format (YuvConverter, using colorSpace and fullRange), so renderer
+     * output can be encoded without a separate conversion pass. Needs an
+     * idle input buffer.
+     *
+     * @param frameData First byte of the top RGBA row
      * @param width Frame width in pixels
      * @param height Frame height in pixels
-     * @param stride Bytes per row (may differ from width)
+     * @param stride Bytes per row (at least width * 4)
      * @param timestampMs Frame timestamp
      * @return true if successful
      */
@@ -224,19 +237,38 @@ public:
 
     /**
      * @brief Get input buffer for direct writing (zero-copy)
-     * @param size Size of buffer needed
+     *
+     * Dequeues one of inputBufferCount encoder-owned, 64-byte aligned
+     * frame buffers; the caller owns it until it is handed back with
+     * submitInputBuffer() or releaseInputBuffer(). Buffers are allocated
+     * on first use and reused afterwards. Thread-safe.
+     *
+     * @param size Size of buffer needed (at most one input frame)
+     * @param timeoutMs Time to wait for a free buffer (0 = don't wait, -1 = forever)
      * @return Pointer to buffer, nullptr if unavailable
      */
-    [[nodiscard]] uint8_t* getInputBuffer(size_t size);
+    [[nodiscard]] uint8_t* getInputBuffer(size_t size, int timeoutMs = 0);
 
     /**
      * @brief Submit input buffer for encoding
+     *
+     * Encodes straight from the buffer, which returns to the pool once
+     * the backend has drained it.
+     *
      * @param data Data pointer (from getInputBuffer)
      * @param size Data size
      * @param timestampMs Frame timestamp
+     * @param isKeyFrame Force keyframe (IDR)
      * @return true if submitted
      */
-    bool submitInputBuffer(uint8_t* data, size_t size, int64_t timestampMs);
+    bool submitInputBuffer(uint8_t* data, size_t size, int64_t timestampMs, bool isKeyFrame = false);
+
+    /**
+     * @brief Return an input buffer to the pool without encoding it
+     * @param data Data pointer (from getInputBuffer)
+     * @return true if the buffer was dequeued from this encoder
+     */
+    bool releaseInputBuffer(uint8_t* data);
 
     // ===== Monitoring =====
 
@@ -278,6 +310,32 @@ public:
      */
     [[nodiscard]] int64_t getBytesEncoded() const { return m_stats.bytesEncoded; }
 
+    // ===== Output =====
+
+    /**
+     * @brief Get the bytes produced by the last encodeFrame() call
+     * @return Packet data (empty if the backend does not expose output)
+     */
+    [[nodiscard]] const std::vector<uint8_t>& getLastPacket() const { return m_lastPacket; }
+
+    /**
+     * @brief Take the last packet without copying
+     * @param packet Receives the packet data; its old buffer is reused
+     */
+    void takeLastPacket(std::vector<uint8_t>& packet) { packet.swap(m_lastPacket); }
+
+    /**
+     * @brief Get codec header bytes that precede the first packet
+     * @return Header data (empty if none or not started)
+     */
+    [[nodiscard]] std::vector<uint8_t> getStreamHeader() const;
+
+    /**
+     * @brief Get name of the active backend
+     * @return Backend name, or "none" before start()
+     */
+    [[nodiscard]] const char* getBackendName() const;
+
     // ===== Quality Control =====
 
     /**
@@ -336,18 +394,18 @@ public:
      * @brief Get last error message
      * @return Error description
      */
-    [[nodiscard]] std::string getLastError() const { return m_lastError; }
+    [[nodiscard]] std::string getLastError() const;
 
     /**
      * @brief Check if encoder is in error state
      * @return true if error occurred
      */
-    [[nodiscard]] bool hasError() const { return !m_lastError.empty(); }
+    [[nodiscard]] bool hasError() const;
 
     /**
      * @brief Clear error state
      */
-    void clearError() { m_lastError.clear(); }
+    void clearError() { setError(""); }
 
 private:
     VideoEncodingConfig m_config;
@@ -355,28 +413,59 @@ private:
     bool m_encoding = false;
     bool m_paused = false;
     EncodingStats m_stats;
+    mutable std::mutex m_errorMutex;    // Guards m_lastError; the export stages share one encoder
     std::string m_lastError;
 
-    // Hardware encoder pointers
-    void* m_mediaCodec = nullptr;
-    void* m_inputSurface = nullptr;
+    // Codec backend, created by start()
+    std::unique_ptr<EncoderBackend> m_backend;
+    std::vector<uint8_t> m_lastPacket;
+    bool m_forceKeyFrame = false;
 
     /**
-     * @brief Initialize MediaCodec
+     * @struct InputBuffer
+     * @brief One encoder-owned input frame
+     */
+    struct InputBuffer {
+        uint8_t* data = nullptr;        // INPUT_BUFFER_ALIGNMENT aligned
+        bool dequeued = false;          // Owned by a client until submitted or released
+    };
+
+    static constexpr size_t INPUT_BUFFER_ALIGNMENT = 64;
+
+    // Input buffer pool, guarded by m_inputMutex
+    std::vector<InputBuffer> m_inputBuffers;
+    size_t m_inputBufferSize = 0;
+    bool m_inputPoolOpen = false;
+    std::mutex m_inputMutex;
+    std::condition_variable m_inputAvailable;
+
+    /**
+     * @brief Create and open the backend for the current configuration
      * @return true if successful
      */
-    bool initializeMediaCodec();
+    bool initializeBackend();
+
+    /**
+     * @brief Close and destroy the backend
+     */
+    void releaseBackend();
+
+    /**
+     * @brief Replace the error message
+     * @param message Error description
+     */
+    void setError(const std::string& message);
 
     /**
-     * @brief Release MediaCodec resources
+     * @brief Find a dequeued input buffer (m_inputMutex held)
+     * @return Buffer, nullptr if the pointer is not one dequeued from this encoder
      */
-    void releaseMediaCodec();
+    InputBuffer* findDequeuedBuffer(const uint8_t* data);
 
     /**
-     * @brief Process output buffers
-     * @return Number of bytes written
+     * @brief Free all input buffers
      */
-    int64_t processOutputBuffers();
+    void freeInputBuffers();
 
     /**
      * @brief Calculate bitrate from quality level
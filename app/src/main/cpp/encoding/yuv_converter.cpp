@@ -0,0 +1,711 @@
+#include "yuv_converter.h"
+#include "../effects/color_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CLIPFORGE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CLIPFORGE_NEON_KERNELS 1
+#include <arm_neon.h>
+#endif
+
+namespace clipforge {
+namespace encoding {
+
+using effects::ColorKernels;
+using effects::SimdLevel;
+
+namespace {
+
+constexpr int32_t BAND_ROWS = 32;              // Rows per conversion task (even)
+constexpr int32_t FORWARD_SHIFT = 14;          // Q14 towards YUV
+constexpr int32_t INVERSE_SHIFT = 13;          // Q13 back to RGB, so 2.11 * 8192 fits 16 bits
+
+/**
+ * @struct ForwardCoefficients
+ * @brief RGB to YUV weights in Q14
+ *
+ * Chroma is computed from the sum of a 2x2 block, hence its extra 2-bit shift.
+ */
+struct ForwardCoefficients {
+    int16_t y[3];
+    int16_t u[3];
+    int16_t v[3];
+    int32_t yBias;                 // Luma offset plus rounding
+    int32_t cBias;                 // 128 plus rounding, for 2x2 sums
+};
+
+/**
+ * @struct InverseCoefficients
+ * @brief YUV to RGB weights in Q13
+ */
+struct InverseCoefficients {
+    int16_t y;                     // Luma scale
+    int16_t rv;
+    int16_t gu;
+    int16_t gv;
+    int16_t bu;
+    int16_t yOffset;               // 16 (limited) or 0 (full)
+};
+
+/**
+ * @struct ChromaRow
+ * @brief Where one row of Cb and Cr samples goes
+ */
+struct ChromaRow {
+    uint8_t* u = nullptr;
+    uint8_t* v = nullptr;
+    int32_t step = 1;              // 1 for planar, 2 for interleaved
+};
+
+inline int16_t toFixed(double value, int32_t shift) {
+    return static_cast<int16_t>(std::lround(value * static_cast<double>(1 << shift)));
+}
+
+void lumaWeights(int colorSpace, double& kr, double& kb) {
+    kr = colorSpace == 1 ? 0.2126 : 0.299;
+    kb = colorSpace == 1 ? 0.0722 : 0.114;
+}
+
+ForwardCoefficients forwardCoefficients(int colorSpace, bool fullRange) {
+    double kr = 0.0;
+    double kb = 0.0;
+    lumaWeights(colorSpace, kr, kb);
+    double ys = fullRange ? 1.0 : 219.0 / 255.0;
+    double cs = fullRange ? 1.0 : 224.0 / 255.0;
+
+    // Middle terms are derived so white stays white and grey has no chroma
+    ForwardCoefficients k{};
+    k.y[0] = toFixed(kr * ys, FORWARD_SHIFT);
+    k.y[2] = toFixed(kb * ys, FORWARD_SHIFT);
+    k.y[1] = static_cast<int16_t>(toFixed(ys, FORWARD_SHIFT) - k.y[0] - k.y[2]);
+    k.u[0] = toFixed(-kr / (2.0 * (1.0 - kb)) * cs, FORWARD_SHIFT);
+    k.u[2] = toFixed(0.5 * cs, FORWARD_SHIFT);
+    k.u[1] = static_cast<int16_t>(-k.u[0] - k.u[2]);
+    k.v[0] = toFixed(0.5 * cs, FORWARD_SHIFT);
+    k.v[2] = toFixed(-kb / (2.0 * (1.0 - kr)) * cs, FORWARD_SHIFT);
+    k.v[1] = static_cast<int16_t>(-k.v[0] - k.v[2]);
+
+    k.yBias = ((fullRange ? 0 : 16) << FORWARD_SHIFT) + (1 << (FORWARD_SHIFT - 1));
+    k.cBias = (128 << (FORWARD_SHIFT + 2)) + (1 << (FORWARD_SHIFT + 1));
+    return k;
+}
+
+InverseCoefficients inverseCoefficients(int colorSpace, bool fullRange) {
+    double kr = 0.0;
+    double kb = 0.0;
+    lumaWeights(colorSpace, kr, kb);
+    double kg = 1.0 - kr - kb;
+    double ys = fullRange ? 1.0 : 255.0 / 219.0;
+    double cs = fullRange ? 1.0 : 255.0 / 224.0;
+
+    InverseCoefficients k{};
+    k.y = toFixed(ys, INVERSE_SHIFT);
+    k.rv = toFixed(2.0 * (1.0 - kr) * cs, INVERSE_SHIFT);
+    k.gu = toFixed(-2.0 * (1.0 - kb) * kb / kg * cs, INVERSE_SHIFT);
+    k.gv = toFixed(-2.0 * (1.0 - kr) * kr / kg * cs, INVERSE_SHIFT);
+    k.bu = toFixed(2.0 * (1.0 - kb) * cs, INVERSE_SHIFT);
+    k.yOffset = static_cast<int16_t>(fullRange ? 0 : 16);
+    return k;
+}
+
+inline uint8_t clampByte(int32_t value) {
+    return static_cast<uint8_t>(std::min(255, std::max(0, value)));
+}
+
+ChromaRow chromaRow(const YuvImage& image, int32_t row) {
+    ChromaRow c;
+    switch (image.format) {
+        case ColorFormat::NV12:
+        case ColorFormat::NV21: {
+            uint8_t* base = image.u + static_cast<ptrdiff_t>(row) * image.uStride;
+            bool uFirst = image.format == ColorFormat::NV12;
+            c.u = uFirst ? base : base + 1;
+            c.v = uFirst ? base + 1 : base;
+            c.step = 2;
+            break;
+        }
+        default:
+            c.u = image.u + static_cast<ptrdiff_t>(row) * image.uStride;
+            c.v = image.v + static_cast<ptrdiff_t>(row) * image.vStride;
+            c.step = 1;
+            break;
+    }
+    return c;
+}
+
+// ===== Scalar kernels =====
+
+/**
+ * @brief Convert pixels [x, width) of a row pair; x must be even
+ */
+void forwardScalar(const uint8_t* row0, const uint8_t* row1, uint8_t* y0, uint8_t* y1,
+                   const ChromaRow& c, int32_t x, int32_t width, const ForwardCoefficients& k) {
+    for (; x < width; x += 2) {
+        int32_t x1 = std::min(x + 1, width - 1);
+        const uint8_t* pixels[4] = {row0 + x * 4, row0 + x1 * 4, row1 + x * 4, row1 + x1 * 4};
+        uint8_t* lumas[4] = {y0 + x, y0 + x1, y1 + x, y1 + x1};
+
+        int32_t sum[3] = {0, 0, 0};
+        for (int i = 0; i < 4; ++i) {
+            const uint8_t* p = pixels[i];
+            *lumas[i] = clampByte((k.y[0] * p[0] + k.y[1] * p[1] + k.y[2] * p[2] + k.yBias) >> FORWARD_SHIFT);
+            sum[0] += p[0];
+            sum[1] += p[1];
+            sum[2] += p[2];
+        }
+
+        ptrdiff_t offset = static_cast<ptrdiff_t>(x / 2) * c.step;
+        c.u[offset] = clampByte((k.u[0] * sum[0] + k.u[1] * sum[1] + k.u[2] * sum[2] + k.cBias) >>
+                                (FORWARD_SHIFT + 2));
+        c.v[offset] = clampByte((k.v[0] * sum[0] + k.v[1] * sum[1] + k.v[2] * sum[2] + k.cBias) >>
+                                (FORWARD_SHIFT + 2));
+    }
+}
+
+/**
+ * @brief Convert pixels [x, width) of a row; x must be even
+ */
+void inverseScalar(const uint8_t* yRow, const ChromaRow& c, uint8_t* out, int32_t x, int32_t width,
+                   const InverseCoefficients& k) {
+    constexpr int32_t round = 1 << (INVERSE_SHIFT - 1);
+    for (; x < width; ++x) {
+        ptrdiff_t offset = static_cast<ptrdiff_t>(x / 2) * c.step;
+        int32_t luma = k.y * (yRow[x] - k.yOffset) + round;
+        int32_t u = c.u[offset] - 128;
+        int32_t v = c.v[offset] - 128;
+
+        uint8_t* p = out + x * 4;
+        p[0] = clampByte((luma + k.rv * v) >> INVERSE_SHIFT);
+        p[1] = clampByte((luma + k.gu * u + k.gv * v) >> INVERSE_SHIFT);
+        p[2] = clampByte((luma + k.bu * u) >> INVERSE_SHIFT);
+        p[3] = 0xFF;
+    }
+}
+
+// ===== x86 kernels =====
+
+#if defined(CLIPFORGE_X86_KERNELS)
+
+/**
+ * @brief Dot products of four RGBA pixels held as 16-bit values
+ * @param lo Pixels 0-1, hi pixels 2-3
+ * @param coef Weights repeated as (r, g, b, 0)
+ * @return 32-bit results in pixel order
+ */
+__attribute__((target("sse4.1")))
+inline __m128i dotSse41(__m128i lo, __m128i hi, __m128i coef) {
+    return _mm_hadd_epi32(_mm_madd_epi16(lo, coef), _mm_madd_epi16(hi, coef));
+}
+
+__attribute__((target("sse4.1")))
+void forwardSse41(const uint8_t* row0, const uint8_t* row1, uint8_t* y0, uint8_t* y1,
+                  const ChromaRow& c, int32_t width, const ForwardCoefficients& k) {
+    const __m128i yCoef = _mm_setr_epi16(k.y[0], k.y[1], k.y[2], 0, k.y[0], k.y[1], k.y[2], 0);
+    const __m128i uCoef = _mm_setr_epi16(k.u[0], k.u[1], k.u[2], 0, k.u[0], k.u[1], k.u[2], 0);
+    const __m128i vCoef = _mm_setr_epi16(k.v[0], k.v[1], k.v[2], 0, k.v[0], k.v[1], k.v[2], 0);
+    const __m128i yBias = _mm_set1_epi32(k.yBias);
+    const __m128i cBias = _mm_set1_epi32(k.cBias);
+    const __m128i interleave = c.u < c.v ? _mm_setr_epi8(0, 2, 1, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0)
+                                         : _mm_setr_epi8(2, 0, 3, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    int32_t x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 4));
+        __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 4));
+        __m128i lo0 = _mm_cvtepu8_epi16(p0);
+        __m128i hi0 = _mm_cvtepu8_epi16(_mm_srli_si128(p0, 8));
+        __m128i lo1 = _mm_cvtepu8_epi16(p1);
+        __m128i hi1 = _mm_cvtepu8_epi16(_mm_srli_si128(p1, 8));
+
+        for (int r = 0; r < 2; ++r) {
+            __m128i luma = _mm_srai_epi32(_mm_add_epi32(dotSse41(r ? lo1 : lo0, r ? hi1 : hi0, yCoef), yBias),
+                                          FORWARD_SHIFT);
+            __m128i words = _mm_packus_epi32(luma, luma);
+            int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+            std::memcpy((r ? y1 : y0) + x, &bytes, 4);
+        }
+
+        // Chroma is linear, so the pixel dot products add up to the block's
+        __m128i lo = _mm_add_epi16(lo0, lo1);
+        __m128i hi = _mm_add_epi16(hi0, hi1);
+        __m128i uv = _mm_hadd_epi32(dotSse41(lo, hi, uCoef), dotSse41(lo, hi, vCoef));   // u0 u1 v0 v1
+        uv = _mm_srai_epi32(_mm_add_epi32(uv, cBias), FORWARD_SHIFT + 2);
+        __m128i words = _mm_packus_epi32(uv, uv);
+        __m128i bytes = _mm_packus_epi16(words, words);
+
+        ptrdiff_t offset = static_cast<ptrdiff_t>(x / 2) * c.step;
+        if (c.step == 2) {
+            int32_t pairs = _mm_cvtsi128_si32(_mm_shuffle_epi8(bytes, interleave));
+            std::memcpy(std::min(c.u, c.v) + offset, &pairs, 4);
+        } else {
+            int32_t packed = _mm_cvtsi128_si32(bytes);
+            std::memcpy(c.u + offset, &packed, 2);
+            std::memcpy(c.v + offset, reinterpret_cast<const uint8_t*>(&packed) + 2, 2);
+        }
+    }
+    forwardScalar(row0, row1, y0, y1, c, x, width, k);
+}
+
+__attribute__((target("avx2")))
+inline __m256i dotAvx2(__m256i lo, __m256i hi, __m256i coef) {
+    // Per 128-bit lane hadd leaves pixels as 0 1 4 5 | 2 3 6 7
+    __m256i sums = _mm256_hadd_epi32(_mm256_madd_epi16(lo, coef), _mm256_madd_epi16(hi, coef));
+    return _mm256_permutevar8x32_epi32(sums, _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7));
+}
+
+__attribute__((target("avx2")))
+void forwardAvx2(const uint8_t* row0, const uint8_t* row1, uint8_t* y0, uint8_t* y1,
+                 const ChromaRow& c, int32_t width, const ForwardCoefficients& k) {
+    const __m256i yCoef = _mm256_setr_epi16(k.y[0], k.y[1], k.y[2], 0, k.y[0], k.y[1], k.y[2], 0,
+                                            k.y[0], k.y[1], k.y[2], 0, k.y[0], k.y[1], k.y[2], 0);
+    const __m256i uCoef = _mm256_setr_epi16(k.u[0], k.u[1], k.u[2], 0, k.u[0], k.u[1], k.u[2], 0,
+                                            k.u[0], k.u[1], k.u[2], 0, k.u[0], k.u[1], k.u[2], 0);
+    const __m256i vCoef = _mm256_setr_epi16(k.v[0], k.v[1], k.v[2], 0, k.v[0], k.v[1], k.v[2], 0,
+                                            k.v[0], k.v[1], k.v[2], 0, k.v[0], k.v[1], k.v[2], 0);
+    const __m256i yBias = _mm256_set1_epi32(k.yBias);
+    const __m256i cBias = _mm256_set1_epi32(k.cBias);
+    const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    const __m128i interleave = c.u < c.v ? _mm_setr_epi8(0, 4, 1, 5, 2, 6, 3, 7, 0, 0, 0, 0, 0, 0, 0, 0)
+                                         : _mm_setr_epi8(4, 0, 5, 1, 6, 2, 7, 3, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    int32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const uint8_t* s0 = row0 + x * 4;
+        const uint8_t* s1 = row1 + x * 4;
+        __m256i lo0 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s0)));
+        __m256i hi0 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s0 + 16)));
+        __m256i lo1 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s1)));
+        __m256i hi1 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + 16)));
+
+        for (int r = 0; r < 2; ++r) {
+            __m256i luma = _mm256_srai_epi32(
+                _mm256_add_epi32(dotAvx2(r ? lo1 : lo0, r ? hi1 : hi0, yCoef), yBias), FORWARD_SHIFT);
+            __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(luma), _mm256_extracti128_si256(luma, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>((r ? y1 : y0) + x), _mm_packus_epi16(words, words));
+        }
+
+        // u0 u1 v0 v1 | u2 u3 v2 v3, then reordered to u0-u3 v0-v3
+        __m256i lo = _mm256_add_epi16(lo0, lo1);
+        __m256i hi = _mm256_add_epi16(hi0, hi1);
+        __m256i uv = _mm256_hadd_epi32(dotAvx2(lo, hi, uCoef), dotAvx2(lo, hi, vCoef));
+        uv = _mm256_permutevar8x32_epi32(uv, order);
+        uv = _mm256_srai_epi32(_mm256_add_epi32(uv, cBias), FORWARD_SHIFT + 2);
+        __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(uv), _mm256_extracti128_si256(uv, 1));
+        __m128i bytes = _mm_packus_epi16(words, words);
+
+        ptrdiff_t offset = static_cast<ptrdiff_t>(x / 2) * c.step;
+        if (c.step == 2) {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(std::min(c.u, c.v) + offset),
+                             _mm_shuffle_epi8(bytes, interleave));
+        } else {
+            int32_t u = _mm_cvtsi128_si32(bytes);
+            int32_t v = _mm_extract_epi32(bytes, 1);
+            std::memcpy(c.u + offset, &u, 4);
+            std::memcpy(c.v + offset, &v, 4);
+        }
+    }
+    forwardScalar(row0, row1, y0, y1, c, x, width, k);
+}
+
+__attribute__((target("sse4.1")))
+void inverseSse41(const uint8_t* yRow, const ChromaRow& c, uint8_t* out, int32_t width,
+                  const InverseCoefficients& k) {
+    const __m128i yScale = _mm_set1_epi32(k.y);
+    const __m128i yOffset = _mm_set1_epi32(k.yOffset);
+    const __m128i center = _mm_set1_epi32(128);
+    const __m128i round = _mm_set1_epi32(1 << (INVERSE_SHIFT - 1));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi32(255);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const bool uFirst = c.u < c.v;
+
+    int32_t x = 0;
+    for (; x + 4 <= width; x += 4) {
+        int32_t lumaBytes = 0;
+        std::memcpy(&lumaBytes, yRow + x, 4);
+        __m128i luma = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(lumaBytes));
+
+        // Each chroma sample covers two pixels
+        ptrdiff_t offset = static_cast<ptrdiff_t>(x / 2) * c.step;
+        __m128i u;
+        __m128i v;
+        if (c.step == 2) {
+            int32_t pairs = 0;
+            std::memcpy(&pairs, std::min(c.u, c.v) + offset, 4);
+            __m128i chroma = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(pairs));
+            __m128i first = _mm_shuffle_epi32(chroma, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128i second = _mm_shuffle_epi32(chroma, _MM_SHUFFLE(3, 3, 1, 1));
+            u = uFirst ? first : second;
+            v = uFirst ? second : first;
+        } else {
+            uint16_t uBytes = 0;
+            uint16_t vBytes = 0;
+            std::memcpy(&uBytes, c.u + offset, 2);
+            std::memcpy(&vBytes, c.v + offset, 2);
+            u = _mm_shuffle_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(uBytes)), _MM_SHUFFLE(1, 1, 0, 0));
+            v = _mm_shuffle_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(vBytes)), _MM_SHUFFLE(1, 1, 0, 0));
+        }
+        u = _mm_sub_epi32(u, center);
+        v = _mm_sub_epi32(v, center);
+
+        __m128i base = _mm_add_epi32(_mm_mullo_epi32(_mm_sub_epi32(luma, yOffset), yScale), round);
+        __m128i r = _mm_add_epi32(base, _mm_mullo_epi32(v, _mm_set1_epi32(k.rv)));
+        __m128i g = _mm_add_epi32(base, _mm_add_epi32(_mm_mullo_epi32(u, _mm_set1_epi32(k.gu)),
+                                                      _mm_mullo_epi32(v, _mm_set1_epi32(k.gv))));
+        __m128i b = _mm_add_epi32(base, _mm_mullo_epi32(u, _mm_set1_epi32(k.bu)));
+        r = _mm_min_epi32(_mm_max_epi32(_mm_srai_epi32(r, INVERSE_SHIFT), zero), max);
+        g = _mm_min_epi32(_mm_max_epi32(_mm_srai_epi32(g, INVERSE_SHIFT), zero), max);
+        b = _mm_min_epi32(_mm_max_epi32(_mm_srai_epi32(b, INVERSE_SHIFT), zero), max);
+
+        __m128i rgba = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)),
+                                    _mm_or_si128(_mm_slli_epi32(b, 16), alpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), rgba);
+    }
+    inverseScalar(yRow, c, out, x, width, k);
+}
+
+__attribute__((target("avx2")))
+void inverseAvx2(const uint8_t* yRow, const ChromaRow& c, uint8_t* out, int32_t width,
+                 const InverseCoefficients& k) {
+    const __m256i yScale = _mm256_set1_epi32(k.y);
+    const __m256i yOffset = _mm256_set1_epi32(k.yOffset);
+    const __m256i center = _mm256_set1_epi32(128);
+    const __m256i round = _mm256_set1_epi32(1 << (INVERSE_SHIFT - 1));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi32(255);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m256i duplicate = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i evens = _mm256_setr_epi32(0, 0, 2, 2, 4, 4, 6, 6);
+    const __m256i odds = _mm256_setr_epi32(1, 1, 3, 3, 5, 5, 7, 7);
+    const bool uFirst = c.u < c.v;
+
+    int32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m256i luma = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(yRow + x)));
+
+        // Each chroma sample covers two pixels
+        ptrdiff_t offset = static_cast<ptrdiff_t>(x / 2) * c.step;
+        __m256i u;
+        __m256i v;
+        if (c.step == 2) {
+            __m256i chroma = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(std::min(c.u, c.v) + offset)));
+            __m256i first = _mm256_permutevar8x32_epi32(chroma, evens);
+            __m256i second = _mm256_permutevar8x32_epi32(chroma, odds);
+            u = uFirst ? first : second;
+            v = uFirst ? second : first;
+        } else {
+            int32_t uBytes = 0;
+            int32_t vBytes = 0;
+            std::memcpy(&uBytes, c.u + offset, 4);
+            std::memcpy(&vBytes, c.v + offset, 4);
+            u = _mm256_permutevar8x32_epi32(_mm256_cvtepu8_epi32(_mm_cvtsi32_si128(uBytes)), duplicate);
+            v = _mm256_permutevar8x32_epi32(_mm256_cvtepu8_epi32(_mm_cvtsi32_si128(vBytes)), duplicate);
+        }
+        u = _mm256_sub_epi32(u, center);
+        v = _mm256_sub_epi32(v, center);
+
+        __m256i base = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(luma, yOffset), yScale), round);
+        __m256i r = _mm256_add_epi32(base, _mm256_mullo_epi32(v, _mm256_set1_epi32(k.rv)));
+        __m256i g = _mm256_add_epi32(base, _mm256_add_epi32(_mm256_mullo_epi32(u, _mm256_set1_epi32(k.gu)),
+                                                            _mm256_mullo_epi32(v, _mm256_set1_epi32(k.gv))));
+        __m256i b = _mm256_add_epi32(base, _mm256_mullo_epi32(u, _mm256_set1_epi32(k.bu)));
+        r = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(r, INVERSE_SHIFT), zero), max);
+        g = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(g, INVERSE_SHIFT), zero), max);
+        b = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(b, INVERSE_SHIFT), zero), max);
+
+        __m256i rgba = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                                       _mm256_or_si256(_mm256_slli_epi32(b, 16), alpha));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x * 4), rgba);
+    }
+    inverseScalar(yRow, c, out, x, width, k);
+}
+
+#endif // CLIPFORGE_X86_KERNELS
+
+// ===== ARM kernels =====
+
+#if defined(CLIPFORGE_NEON_KERNELS)
+
+inline uint8x8_t lumaNeon(const uint8x8x4_t& px, const ForwardCoefficients& k) {
+    uint16x8_t r = vmovl_u8(px.val[0]);
+    uint16x8_t g = vmovl_u8(px.val[1]);
+    uint16x8_t b = vmovl_u8(px.val[2]);
+    const uint32x4_t bias = vdupq_n_u32(static_cast<uint32_t>(k.yBias));
+    const auto cr = static_cast<uint16_t>(k.y[0]);
+    const auto cg = static_cast<uint16_t>(k.y[1]);
+    const auto cb = static_cast<uint16_t>(k.y[2]);
+
+    uint32x4_t lo = vmlal_n_u16(vmlal_n_u16(vmull_n_u16(vget_low_u16(r), cr), vget_low_u16(g), cg),
+                                vget_low_u16(b), cb);
+    uint32x4_t hi = vmlal_n_u16(vmlal_n_u16(vmull_n_u16(vget_high_u16(r), cr), vget_high_u16(g), cg),
+                                vget_high_u16(b), cb);
+    uint16x8_t words = vcombine_u16(vshrn_n_u32(vaddq_u32(lo, bias), FORWARD_SHIFT),
+                                    vshrn_n_u32(vaddq_u32(hi, bias), FORWARD_SHIFT));
+    return vqmovn_u16(words);
+}
+
+inline uint16x4_t chromaNeon(int16x4_t r, int16x4_t g, int16x4_t b, const int16_t coef[3], int32_t bias) {
+    int32x4_t sum = vmlal_n_s16(vmlal_n_s16(vmull_n_s16(r, coef[0]), g, coef[1]), b, coef[2]);
+    return vqshrun_n_s32(vaddq_s32(sum, vdupq_n_s32(bias)), FORWARD_SHIFT + 2);
+}
+
+void forwardNeon(const uint8_t* row0, const uint8_t* row1, uint8_t* y0, uint8_t* y1,
+                 const ChromaRow& c, int32_t width, const ForwardCoefficients& k) {
+    static const uint8_t UV_ORDER[8] = {0, 4, 1, 5, 2, 6, 3, 7};
+    static const uint8_t VU_ORDER[8] = {4, 0, 5, 1, 6, 2, 7, 3};
+    const uint8x8_t interleave = vld1_u8(c.u < c.v ? UV_ORDER : VU_ORDER);
+
+    int32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        uint8x8x4_t p0 = vld4_u8(row0 + x * 4);
+        uint8x8x4_t p1 = vld4_u8(row1 + x * 4);
+        vst1_u8(y0 + x, lumaNeon(p0, k));
+        vst1_u8(y1 + x, lumaNeon(p1, k));
+
+        // Pairwise adds give the 2x2 block sums directly
+        int16x4_t r = vreinterpret_s16_u16(vadd_u16(vpaddl_u8(p0.val[0]), vpaddl_u8(p1.val[0])));
+        int16x4_t g = vreinterpret_s16_u16(vadd_u16(vpaddl_u8(p0.val[1]), vpaddl_u8(p1.val[1])));
+        int16x4_t b = vreinterpret_s16_u16(vadd_u16(vpaddl_u8(p0.val[2]), vpaddl_u8(p1.val[2])));
+        uint8x8_t bytes = vqmovn_u16(vcombine_u16(chromaNeon(r, g, b, k.u, k.cBias),
+                                                  chromaNeon(r, g, b, k.v, k.cBias)));   // u0-u3 v0-v3
+
+        ptrdiff_t offset = static_cast<ptrdiff_t>(x / 2) * c.step;
+        if (c.step == 2) {
+            vst1_u8(std::min(c.u, c.v) + offset, vtbl1_u8(bytes, interleave));
+        } else {
+            uint32_t u = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+            uint32_t v = vget_lane_u32(vreinterpret_u32_u8(bytes), 1);
+            std::memcpy(c.u + offset, &u, 4);
+            std::memcpy(c.v + offset, &v, 4);
+        }
+    }
+    forwardScalar(row0, row1, y0, y1, c, x, width, k);
+}
+
+inline uint8x8_t channelNeon(int32x4_t lo, int32x4_t hi) {
+    return vqmovn_u16(vcombine_u16(vqshrun_n_s32(lo, INVERSE_SHIFT), vqshrun_n_s32(hi, INVERSE_SHIFT)));
+}
+
+void inverseNeon(const uint8_t* yRow, const ChromaRow& c, uint8_t* out, int32_t width,
+                 const InverseCoefficients& k) {
+    static const uint8_t DUPLICATE[8] = {0, 0, 1, 1, 2, 2, 3, 3};
+    static const uint8_t EVENS[8] = {0, 0, 2, 2, 4, 4, 6, 6};
+    static const uint8_t ODDS[8] = {1, 1, 3, 3, 5, 5, 7, 7};
+    const uint8x8_t duplicate = vld1_u8(DUPLICATE);
+    const uint8x8_t evens = vld1_u8(EVENS);
+    const uint8x8_t odds = vld1_u8(ODDS);
+    const int16x8_t yOffset = vdupq_n_s16(k.yOffset);
+    const int16x8_t center = vdupq_n_s16(128);
+    const int32x4_t round = vdupq_n_s32(1 << (INVERSE_SHIFT - 1));
+    const bool uFirst = c.u < c.v;
+
+    int32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        int16x8_t luma = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(yRow + x))), yOffset);
+
+        // Each chroma sample covers two pixels
+        ptrdiff_t offset = static_cast<ptrdiff_t>(x / 2) * c.step;
+        uint8x8_t uBytes;
+        uint8x8_t vBytes;
+        if (c.step == 2) {
+            uint8x8_t chroma = vld1_u8(std::min(c.u, c.v) + offset);
+            uint8x8_t first = vtbl1_u8(chroma, evens);
+            uint8x8_t second = vtbl1_u8(chroma, odds);
+            uBytes = uFirst ? first : second;
+            vBytes = uFirst ? second : first;
+        } else {
+            uint32_t uWord = 0;
+            uint32_t vWord = 0;
+            std::memcpy(&uWord, c.u + offset, 4);
+            std::memcpy(&vWord, c.v + offset, 4);
+            uBytes = vtbl1_u8(vreinterpret_u8_u32(vdup_n_u32(uWord)), duplicate);
+            vBytes = vtbl1_u8(vreinterpret_u8_u32(vdup_n_u32(vWord)), duplicate);
+        }
+        int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uBytes)), center);
+        int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vBytes)), center);
+
+        int32x4_t baseLo = vaddq_s32(vmull_n_s16(vget_low_s16(luma), k.y), round);
+        int32x4_t baseHi = vaddq_s32(vmull_n_s16(vget_high_s16(luma), k.y), round);
+
+        uint8x8x4_t px;
+        px.val[0] = channelNeon(vmlal_n_s16(baseLo, vget_low_s16(v), k.rv),
+                                vmlal_n_s16(baseHi, vget_high_s16(v), k.rv));
+        px.val[1] = channelNeon(vmlal_n_s16(vmlal_n_s16(baseLo, vget_low_s16(u), k.gu), vget_low_s16(v), k.gv),
+                                vmlal_n_s16(vmlal_n_s16(baseHi, vget_high_s16(u), k.gu), vget_high_s16(v), k.gv));
+        px.val[2] = channelNeon(vmlal_n_s16(baseLo, vget_low_s16(u), k.bu),
+                                vmlal_n_s16(baseHi, vget_high_s16(u), k.bu));
+        px.val[3] = vdup_n_u8(0xFF);
+        vst4_u8(out + x * 4, px);
+    }
+    inverseScalar(yRow, c, out, x, width, k);
+}
+
+#endif // CLIPFORGE_NEON_KERNELS
+
+using ForwardRows = void (*)(const uint8_t*, const uint8_t*, uint8_t*, uint8_t*,
+                             const ChromaRow&, int32_t, const ForwardCoefficients&);
+using InverseRow = void (*)(const uint8_t*, const ChromaRow&, uint8_t*, int32_t,
+                            const InverseCoefficients&);
+
+void forwardScalarRows(const uint8_t* row0, const uint8_t* row1, uint8_t* y0, uint8_t* y1,
+                       const ChromaRow& c, int32_t width, const ForwardCoefficients& k) {
+    forwardScalar(row0, row1, y0, y1, c, 0, width, k);
+}
+
+void inverseScalarRow(const uint8_t* yRow, const ChromaRow& c, uint8_t* out, int32_t width,
+                      const InverseCoefficients& k) {
+    inverseScalar(yRow, c, out, 0, width, k);
+}
+
+ForwardRows selectForward() {
+    switch (ColorKernels::getLevel()) {
+#if defined(CLIPFORGE_X86_KERNELS)
+        case SimdLevel::AVX2:
+            return forwardAvx2;
+        case SimdLevel::SSE41:
+            return forwardSse41;
+#endif
+#if defined(CLIPFORGE_NEON_KERNELS)
+        case SimdLevel::NEON:
+            return forwardNeon;
+#endif
+        default:
+            return forwardScalarRows;
+    }
+}
+
+InverseRow selectInverse() {
+    switch (ColorKernels::getLevel()) {
+#if defined(CLIPFORGE_X86_KERNELS)
+        case SimdLevel::AVX2:
+            return inverseAvx2;
+        case SimdLevel::SSE41:
+            return inverseSse41;
+#endif
+#if defined(CLIPFORGE_NEON_KERNELS)
+        case SimdLevel::NEON:
+            return inverseNeon;
+#endif
+        default:
+            return inverseScalarRow;
+    }
+}
+
+bool isValid(const effects::ImageView& rgba, const YuvImage& yuv) {
+    if (!rgba.data || rgba.width <= 0 || rgba.height <= 0) return false;
+    if (rgba.width != yuv.width || rgba.height != yuv.height) return false;
+    if (!yuv.y || !yuv.u) return false;
+
+    switch (yuv.format) {
+        case ColorFormat::NV12:
+        case ColorFormat::NV21:
+            return true;
+        case ColorFormat::YUV420P:
+            return yuv.v != nullptr;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Run a band function over the rows, on the pool if there is one
+ */
+template <typename BandFn>
+void forEachBand(int32_t height, utils::ThreadPool* pool, const BandFn& band) {
+    auto bands = static_cast<size_t>((height + BAND_ROWS - 1) / BAND_ROWS);
+    auto run = [&](size_t index) {
+        int32_t begin = static_cast<int32_t>(index) * BAND_ROWS;
+        band(begin, std::min(height, begin + BAND_ROWS));
+    };
+
+    if (pool && bands > 1) {
+        pool->parallelFor(bands, run);
+    } else {
+        for (size_t i = 0; i < bands; ++i) {
+            run(i);
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// YuvImage Implementation
+// ============================================================================
+
+YuvImage YuvImage::packed(ColorFormat format, uint8_t* data, int32_t width, int32_t height) {
+    int32_t chromaWidth = (width + 1) / 2;
+    int32_t chromaHeight = (height + 1) / 2;
+
+    YuvImage image;
+    image.format = format;
+    image.width = width;
+    image.height = height;
+    image.y = data;
+    image.yStride = width;
+    image.u = data + static_cast<ptrdiff_t>(width) * height;
+
+    if (format == ColorFormat::YUV420P) {
+        image.uStride = chromaWidth;
+        image.v = image.u + static_cast<ptrdiff_t>(chromaWidth) * chromaHeight;
+        image.vStride = chromaWidth;
+    } else {
+        image.uStride = chromaWidth * 2;
+    }
+    return image;
+}
+
+// ============================================================================
+// YuvConverter Implementation
+// ============================================================================
+
+bool YuvConverter::rgbaToYuv(const effects::ImageView& rgba, const YuvImage& yuv,
+                             int colorSpace, bool fullRange, utils::ThreadPool* pool) {
+    if (!isValid(rgba, yuv)) {
+        return false;
+    }
+
+    const ForwardCoefficients k = forwardCoefficients(colorSpace, fullRange);
+    const ForwardRows convert = selectForward();
+    const int32_t height = yuv.height;
+
+    // Bands hold an even number of rows, so each owns whole chroma rows
+    forEachBand(height, pool, [&](int32_t begin, int32_t end) {
+        for (int32_t y = begin; y < end; y += 2) {
+            int32_t y1 = std::min(y + 1, height - 1);
+            convert(rgba.row(y), rgba.row(y1),
+                    yuv.y + static_cast<ptrdiff_t>(y) * yuv.yStride,
+                    yuv.y + static_cast<ptrdiff_t>(y1) * yuv.yStride,
+                    chromaRow(yuv, y / 2), yuv.width, k);
+        }
+    });
+    return true;
+}
+
+bool YuvConverter::yuvToRgba(const YuvImage& yuv, const effects::ImageView& rgba,
+                             int colorSpace, bool fullRange, utils::ThreadPool* pool) {
+    if (!isValid(rgba, yuv)) {
+        return false;
+    }
+
+    const InverseCoefficients k = inverseCoefficients(colorSpace, fullRange);
+    const InverseRow convert = selectInverse();
+
+    forEachBand(yuv.height, pool, [&](int32_t begin, int32_t end) {
+        for (int32_t y = begin; y < end; ++y) {
+            convert(yuv.y + static_cast<ptrdiff_t>(y) * yuv.yStride, chromaRow(yuv, y / 2),
+                    rgba.row(y), yuv.width, k);
+        }
+    });
+    return true;
+}
+
+} // namespace encoding
+} // namespace clipforge
@@ -0,0 +1,89 @@
+#ifndef CLIPFORGE_YUV_CONVERTER_H
+#define CLIPFORGE_YUV_CONVERTER_H
+
+#include "video_encoder.h"
+#include "../effects/filter_library.h"
+#include "../utils/thread_pool.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace clipforge {
+namespace encoding {
+
+/**
+ * @struct YuvImage
+ * @brief Non-owning view of a 4:2:0 image in NV12, NV21 or YUV420P layout
+ *
+ * Chroma planes have (width + 1) / 2 by (height + 1) / 2 samples. For
+ * NV12/NV21, u points at the interleaved chroma plane and v is unused.
+ */
+struct YuvImage {
+    ColorFormat format = ColorFormat::NV12;
+    uint8_t* y = nullptr;          // Luma plane
+    uint8_t* u = nullptr;          // Cb plane, or the interleaved chroma plane
+    uint8_t* v = nullptr;          // Cr plane (YUV420P only)
+    int32_t width = 0;             // Width in pixels
+    int32_t height = 0;            // Height in pixels
+    int32_t yStride = 0;           // Bytes per luma row
+    int32_t uStride = 0;           // Bytes per Cb (or interleaved chroma) row
+    int32_t vStride = 0;           // Bytes per Cr row
+
+    /**
+     * @brief View a tightly packed frame, laid out as getFrameSize() counts it
+     * @param format NV12, NV21 or YUV420P
+     * @param data First byte of the frame
+     * @param width Width in pixels
+     * @param height Height in pixels
+     */
+    [[nodiscard]] static YuvImage packed(ColorFormat format, uint8_t* data,
+                                         int32_t width, int32_t height);
+};
+
+/**
+ * @class YuvConverter
+ * @brief RGBA8 <-> 4:2:0 YUV conversion with runtime ISA dispatch
+ *
+ * Converts with BT.601 (colorSpace 0) or BT.709 (colorSpace 1) weights
+ * into full-range (0-255) or limited-range (16-235 luma, 16-240 chroma)
+ * YUV. The instruction set follows ColorKernels::getLevel(), so
+ * ColorKernels::setLevel() also selects it here.
+ *
+ * The math is fixed point (Q14 towards YUV, Q13 back), so every level
+ * produces bit-identical output. Towards YUV, chroma is the average of
+ * each 2x2 block (centred siting, as in JPEG and C420jpeg); back to RGB
+ * each chroma sample is repeated over its block. Odd sizes repeat the
+ * last row and column. Strides are arbitrary, and with a pool the rows
+ * are split into bands converted in parallel. Alpha is ignored towards
+ * YUV and set to 255 back.
+ */
+class YuvConverter {
+public:
+    /**
+     * @brief Convert RGBA8 into YUV
+     * @param rgba Source image
+     * @param yuv Destination; must have the same size as rgba
+     * @param colorSpace 0 for BT.601, 1 for BT.709
+     * @param fullRange Full-range instead of limited-range output
+     * @param pool Threads to split the rows across (null: caller only)
+     * @return false if the images are empty, differ in size or yuv is not a YUV format
+     */
+    static bool rgbaToYuv(const effects::ImageView& rgba, const YuvImage& yuv,
+                          int colorSpace, bool fullRange, utils::ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Convert YUV into RGBA8
+     * @param yuv Source image
+     * @param rgba Destination; must have the same size as yuv
+     * @param colorSpace 0 for BT.601, 1 for BT.709
+     * @param fullRange Source is full-range instead of limited-range
+     * @param pool Threads to split the rows across (null: caller only)
+     * @return false if the images are empty, differ in size or yuv is not a YUV format
+     */
+    static bool yuvToRgba(const YuvImage& yuv, const effects::ImageView& rgba,
+                          int colorSpace, bool fullRange, utils::ThreadPool* pool = nullptr);
+};
+
+} // namespace encoding
+} // namespace clipforge
+
+#endif // CLIPFORGE_YUV_CONVERTER_H
@@ -1,5 +1,7 @@
 #include "blur_effect.h"
+#include "../../effects/blur_filter.h"
 #include "../../utils/logger.h"
+#include <algorithm>
 
 namespace clipforge {
 namespace gpu {
@@ -11,16 +13,54 @@ GaussianBlurEffect::GaussianBlurEffect()
     : GPUEffect("GaussianBlur", EffectCategory::BLUR, nullptr) {
     defineParameter("intensity", "uIntensity", 1.0f, 0.0f, 1.0f);
     defineParameter("radius", "uRadius", 5.0f, 0.5f, 50.0f);
+    defineParameter("quality", "uQuality", 1.0f, 0.0f, 1.0f);
 
     LOGI("GaussianBlurEffect created");
 }
 
+GaussianBlurEffect::~GaussianBlurEffect() {
+    releaseTargets();
+}
+
 std::vector<EffectParameter> GaussianBlurEffect::getParameters() const {
     return GPUEffect::getParameters();
 }
 
+bool GaussianBlurEffect::apply(GLuint inputTexture, GLuint outputFramebuffer, int width, int height) {
+    if (!isAvailable() || !m_enabled) {
+        return GPUEffect::apply(inputTexture, outputFramebuffer, width, height);
+    }
+
+    buildPasses();
+    if (m_passes.size() > 1 && !ensureTargets(width, height)) {
+        LOGE("GaussianBlurEffect: failed to create intermediate targets");
+        return false;
+    }
+
+    // Intermediate passes blur fully; only the last mixes with the input
+    float intensity = m_intensity;
+    m_originalTexture = inputTexture;
+    GLuint source = inputTexture;
+    bool success = true;
+
+    for (size_t i = 0; i < m_passes.size() && success; ++i) {
+        bool last = i + 1 == m_passes.size();
+        m_currentPass = i;
+        m_intensity = last ? intensity : 1.0f;
+
+        GLuint target = last ? outputFramebuffer : m_framebuffers[i % 2];
+        success = GPUEffect::apply(source, target, width, height);
+        source = m_textures[i % 2];
+    }
+
+    m_intensity = intensity;
+    return success;
+}
+
 void GaussianBlurEffect::applyCustomUniforms(GLuint inputTexture, int width, int height) {
-    if (!m_shader) return;
+    if (!m_shader || m_currentPass >= m_passes.size()) return;
+
+    const BlurPass& pass = m_passes[m_currentPass];
 
     // Calculate texel size
     float texelWidth = 1.0f / width;
@@ -28,7 +68,97 @@ void GaussianBlurEffect::applyCustomUniforms(GLuint inputTexture, int width, int
     glm::vec2 texelSize(texelWidth, texelHeight);
 
     m_shader->setUniform("uTexelSize", texelSize);
-    m_shader->setUniform("uRadius", getParameter("radius"));
+    m_shader->setUniform("uDirection", pass.horizontal ? glm::vec2(1.0f, 0.0f) : glm::vec2(0.0f, 1.0f));
+    m_shader->setUniform("uTapCount", static_cast<int>(pass.offsets.size()));
+    m_shader->setUniformArray("uOffsets", pass.offsets.data(), pass.offsets.size());
+    m_shader->setUniformArray("uWeights", pass.weights.data(), pass.weights.size());
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_originalTexture);
+    m_shader->setUniform("uOriginal", 1);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void GaussianBlurEffect::buildPasses() {
+    using ::clipforge::effects::BlurKernel;
+
+    float radius = getParameter("radius");
+    m_passes.clear();
+
+    std::vector<std::vector<float>> kernels;
+    if (getParameter("quality") >= 0.5f) {
+        kernels.push_back(BlurKernel::gaussianWeights(radius));
+    } else {
+        for (int32_t boxRadius : BlurKernel::boxRadii(radius)) {
+            if (boxRadius == 0) continue;
+            kernels.emplace_back(static_cast<size_t>(boxRadius) + 1,
+                                 1.0f / static_cast<float>(2 * boxRadius + 1));
+        }
+    }
+
+    for (bool horizontal : {true, false}) {
+        for (const auto& kernel : kernels) {
+            BlurPass pass;
+            pass.horizontal = horizontal;
+            BlurKernel::linearTaps(kernel, pass.offsets, pass.weights);
+            pass.offsets.resize(std::min(pass.offsets.size(), MAX_TAPS));
+            pass.weights.resize(pass.offsets.size());
+            m_passes.push_back(std::move(pass));
+        }
+    }
+
+    // Radius too small for any box: a single identity tap still mixes correctly
+    if (m_passes.empty()) {
+        m_passes.push_back(BlurPass{true, {0.0f}, {1.0f}});
+    }
+}
+
+bool GaussianBlurEffect::ensureTargets(int width, int height) {
+    if (m_framebuffers[0] != 0 && width == m_targetWidth && height == m_targetHeight) {
+        return true;
+    }
+    releaseTargets();
+
+    for (size_t i = 0; i < m_framebuffers.size(); ++i) {
+        glGenTextures(1, &m_textures[i]);
+        glBindTexture(GL_TEXTURE_2D, m_textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glGenFramebuffers(1, &m_framebuffers[i]);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffers[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textures[i], 0);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            releaseTargets();
+            return false;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_targetWidth = width;
+    m_targetHeight = height;
+    return true;
+}
+
+void GaussianBlurEffect::releaseTargets() {
+    for (size_t i = 0; i < m_framebuffers.size(); ++i) {
+        if (m_framebuffers[i] != 0) {
+            glDeleteFramebuffers(1, &m_framebuffers[i]);
+            m_framebuffers[i] = 0;
+        }
+        if (m_textures[i] != 0) {
+            glDeleteTextures(1, &m_textures[i]);
+            m_textures[i] = 0;
+        }
+    }
+    m_targetWidth = 0;
+    m_targetHeight = 0;
 }
 
 // ===== VignetteEffect Implementation =====
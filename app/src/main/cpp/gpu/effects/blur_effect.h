@@ -2,6 +2,8 @@
 #define CLIPFORGE_BLUR_EFFECT_H
 
 #include "../gpu_effect.h"
+#include <array>
+#include <vector>
 
 namespace clipforge {
 namespace gpu {
@@ -11,16 +13,25 @@ namespace effects {
  * @class GaussianBlurEffect
  * @brief High-quality Gaussian blur effect
  *
- * Implements separable 2D Gaussian blur for efficient processing.
- * Can be applied as single pass for performance or multi-pass for quality.
+ * Implements separable 2D Gaussian blur for efficient processing, with
+ * the weights of the CPU renderer (effects::BlurKernel). Quality 1 runs
+ * the full Gaussian as one horizontal and one vertical pass; quality 0
+ * approximates it with three short box passes per direction.
  */
 class GaussianBlurEffect : public GPUEffect {
 public:
+    static constexpr size_t MAX_TAPS = 26;   // Matches uOffsets/uWeights in FRAGMENT_BLUR
+
     /**
      * @brief Create Gaussian blur effect
      */
     GaussianBlurEffect();
 
+    /**
+     * @brief Destructor - releases intermediate render targets
+     */
+    ~GaussianBlurEffect() override;
+
     /**
      * @brief Set blur radius in pixels
      * @param radius Blur radius (0.5 to 50.0 pixels)
@@ -33,10 +44,57 @@ public:
      */
     [[nodiscard]] float getRadius() const { return getParameter("radius"); }
 
+    /**
+     * @brief Set blur quality
+     * @param quality 0 for the box approximation, 1 for the exact Gaussian
+     */
+    void setQuality(float quality) { setParameter("quality", quality); }
+
     std::vector<EffectParameter> getParameters() const override;
+
+    /**
+     * @brief Render all blur passes through intermediate targets
+     */
+    bool apply(GLuint inputTexture, GLuint outputFramebuffer, int width, int height) override;
+
     void applyCustomUniforms(GLuint inputTexture, int width, int height) override;
 
 private:
+    /**
+     * @struct BlurPass
+     * @brief Uniforms for one directional pass
+     */
+    struct BlurPass {
+        bool horizontal = true;
+        std::vector<float> offsets;
+        std::vector<float> weights;
+    };
+
+    std::vector<BlurPass> m_passes;
+    size_t m_currentPass = 0;
+    GLuint m_originalTexture = 0;
+
+    // Ping-pong targets for all but the last pass
+    std::array<GLuint, 2> m_framebuffers{};
+    std::array<GLuint, 2> m_textures{};
+    int m_targetWidth = 0;
+    int m_targetHeight = 0;
+
+    /**
+     * @brief Build the passes for the current radius and quality
+     */
+    void buildPasses();
+
+    /**
+     * @brief Create or resize the intermediate targets
+     * @return true if both targets are usable
+     */
+    bool ensureTargets(int width, int height);
+
+    /**
+     * @brief Delete the intermediate targets
+     */
+    void releaseTargets();
 };
 
 /**
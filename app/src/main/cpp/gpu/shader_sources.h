@@ -205,8 +205,10 @@ void main() {
 // ===== BLUR EFFECTS =====
 
 /**
- * @brief Gaussian blur shader
- * Separable 2-pass Gaussian blur (X then Y)
+ * @brief Separable blur shader, one direction per pass
+ * Symmetric kernel with neighbouring texels merged into GL_LINEAR taps
+ * (see effects::BlurKernel). Gaussian: X then Y; box approximation:
+ * three passes per direction. The last pass mixes with uOriginal.
  */
 inline constexpr std::string_view FRAGMENT_BLUR = R"glsl(
 #version 300 es
@@ -214,33 +216,27 @@ precision mediump float;
 
 in vec2 vTexCoord;
 uniform sampler2D uTexture;
-uniform vec2 uTexelSize;      // 1.0 / texture_size
-uniform float uRadius;         // Blur radius in pixels
+uniform sampler2D uOriginal;   // Unblurred input, for the intensity mix
+uniform vec2 uTexelSize;       // 1.0 / texture_size
+uniform vec2 uDirection;       // (1, 0) horizontal, (0, 1) vertical
+uniform int uTapCount;         // Taps used, centre included
+uniform float uOffsets[26];    // Tap offsets in texels, centre first
+uniform float uWeights[26];    // Weight of each tap (per side)
 uniform float uIntensity;
 
 out vec4 outColor;
 
-const int KERNEL_SIZE = 9;
-const float KERNEL[9] = float[](
-    0.077847, 0.123177, 0.077847,
-    0.123177, 0.195346, 0.123177,
-    0.077847, 0.123177, 0.077847
-);
-
 void main() {
-    vec4 result = vec4(0.0);
-    vec2 offset = uTexelSize * uRadius;
-
-    int idx = 0;
-    for (int y = -1; y <= 1; y++) {
-        for (int x = -1; x <= 1; x++) {
-            vec2 sampleCoord = vTexCoord + vec2(float(x), float(y)) * offset;
-            result += texture(uTexture, sampleCoord) * KERNEL[idx];
-            idx++;
-        }
+    highp vec2 step = uDirection * uTexelSize;
+    vec4 result = texture(uTexture, vTexCoord) * uWeights[0];
+
+    for (int i = 1; i < uTapCount; i++) {
+        highp vec2 offset = step * uOffsets[i];
+        result += (texture(uTexture, vTexCoord + offset) +
+                   texture(uTexture, vTexCoord - offset)) * uWeights[i];
     }
 
-    vec4 color = texture(uTexture, vTexCoord);
+    vec4 color = texture(uOriginal, vTexCoord);
     outColor = mix(color, result, uIntensity);
 }
 )glsl";
@@ -20,6 +20,11 @@ using namespace clipforge::utils;
 static std::map<jlong, std::shared_ptr<VideoEngine>> g_engineMap;
 static std::mutex g_engineMutex;
 
+// Preview frame currently exposed to Java per engine. Holding the buffer
+// keeps the direct ByteBuffer valid until the next fetch or release.
+static std::map<jlong, FrameBufferPtr> g_pinnedFrames;
+static std::mutex g_pinnedFramesMutex;
+
 /**
  * @brief Get engine by pointer handle
  * @param enginePtr Pointer as jlong
@@ -51,10 +56,28 @@ static jlong storeEngine(const std::shared_ptr<VideoEngine>& engine) {
  * @param enginePtr Pointer as jlong
  */
 static void removeEngine(jlong enginePtr) {
+    {
+        std::lock_guard<std::mutex> lock(g_pinnedFramesMutex);
+        g_pinnedFrames.erase(enginePtr);
+    }
     std::lock_guard<std::mutex> lock(g_engineMutex);
     g_engineMap.erase(enginePtr);
 }
 
+/**
+ * @brief Pin a frame for an engine, releasing the previous one
+ * @param enginePtr Pointer as jlong
+ * @param frame Frame to pin (nullptr to release only)
+ */
+static void pinFrame(jlong enginePtr, FrameBufferPtr frame) {
+    std::lock_guard<std::mutex> lock(g_pinnedFramesMutex);
+    if (frame) {
+        g_pinnedFrames[enginePtr] = std::move(frame);
+    } else {
+        g_pinnedFrames.erase(enginePtr);
+    }
+}
+
 // ============================================================================
 // JNI_OnLoad / JNI_OnUnload
 // ============================================================================
@@ -212,15 +235,15 @@ Java_com_ucworks_clipforge_NativeLib_addClip(JNIEnv* env, jclass clazz, jlong en
         }
 
         std::string path = JNIBridge::jstring_to_string(env, sourcePath);
-        std::string clipId = engine->addClip(path, startPosition, trackIndex);
+        auto clip = engine->addClip(path, startPosition, trackIndex);
 
-        if (clipId.empty()) {
+        if (!clip) {
             JNIBridge::throw_java_exception(env, "java/lang/RuntimeException",
                                            engine->getErrorMessage());
             return nullptr;
         }
 
-        return JNIBridge::string_to_jstring(env, clipId);
+        return JNIBridge::string_to_jstring(env, engine->getClipId(clip));
     } catch (const std::exception& e) {
         LOG_ERROR("Error adding clip: %s", e.what());
         JNIBridge::throw_java_exception(env, "java/lang/RuntimeException", e.what());
@@ -245,8 +268,8 @@ Java_com_ucworks_clipforge_NativeLib_removeClip(JNIEnv* env, jclass clazz, jlong
             return JNI_FALSE;
         }
 
-        std::string id = JNIBridge::jstring_to_string(env, clipId);
-        bool result = engine->removeClip(id);
+        auto clip = engine->findClip(JNIBridge::jstring_to_string(env, clipId));
+        bool result = engine->removeClip(clip);
 
         if (!result) {
             JNIBridge::throw_java_exception(env, "java/lang/RuntimeException",
@@ -321,6 +344,50 @@ Java_com_ucworks_clipforge_NativeLib_getEffectCount(JNIEnv* env, jclass clazz, j
     }
 }
 
+/**
+ * @brief Undo the last timeline edit
+ *
+ * Java Signature: native boolean undo(long enginePtr)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ucworks_clipforge_NativeLib_undo(JNIEnv* env, jclass clazz, jlong enginePtr) {
+    JNI_POSSIBLE_UNUSED(env);
+    JNI_POSSIBLE_UNUSED(clazz);
+    try {
+        auto engine = getEngine(enginePtr);
+        if (!engine) {
+            return JNI_FALSE;
+        }
+
+        return engine->undo() ? JNI_TRUE : JNI_FALSE;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error undoing edit: %s", e.what());
+        return JNI_FALSE;
+    }
+}
+
+/**
+ * @brief Redo the last undone timeline edit
+ *
+ * Java Signature: native boolean redo(long enginePtr)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ucworks_clipforge_NativeLib_redo(JNIEnv* env, jclass clazz, jlong enginePtr) {
+    JNI_POSSIBLE_UNUSED(env);
+    JNI_POSSIBLE_UNUSED(clazz);
+    try {
+        auto engine = getEngine(enginePtr);
+        if (!engine) {
+            return JNI_FALSE;
+        }
+
+        return engine->redo() ? JNI_TRUE : JNI_FALSE;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error redoing edit: %s", e.what());
+        return JNI_FALSE;
+    }
+}
+
 // ============================================================================
 // Preview Control
 // ============================================================================
@@ -385,6 +452,74 @@ Java_com_ucworks_clipforge_NativeLib_getPreviewPosition(JNIEnv* env, jclass claz
     }
 }
 
+/**
+ * @brief Get preview frame at a time without copying
+ *
+ * Returns a read-only direct ByteBuffer over the engine's RGBA frame,
+ * which the preview cache shares with other readers. The buffer stays
+ * valid until the next getPreviewFrame or releasePreviewFrame call for
+ * this engine; Java must not touch it afterwards.
+ *
+ * Java Signature: native ByteBuffer getPreviewFrame(long enginePtr, long timeMs,
+ *                                                    int[] outSize)
+ */
+JNIEXPORT jobject JNICALL
+Java_com_ucworks_clipforge_NativeLib_getPreviewFrame(JNIEnv* env, jclass clazz, jlong enginePtr,
+                                                    jlong timeMs, jintArray outSize) {
+    JNI_POSSIBLE_UNUSED(clazz);
+    try {
+        auto engine = getEngine(enginePtr);
+        if (!engine) {
+            return nullptr;
+        }
+
+        auto frame = engine->getPreviewFrame(timeMs);
+        if (!frame) {
+            pinFrame(enginePtr, nullptr);
+            return nullptr;
+        }
+
+        if (outSize && env->GetArrayLength(outSize) >= 2) {
+            jint size[2] = {frame->getWidth(), frame->getHeight()};
+            env->SetIntArrayRegion(outSize, 0, 2, size);
+        }
+
+        // The pixels are shared once published, so Java only gets a read-only view
+        jobject direct = env->NewDirectByteBuffer(const_cast<uint8_t*>(frame->data()),
+                                                  static_cast<jlong>(frame->size()));
+        if (!direct) {
+            return nullptr;
+        }
+        jclass bufferClass = env->GetObjectClass(direct);
+        jmethodID asReadOnly = env->GetMethodID(bufferClass, "asReadOnlyBuffer", "()Ljava/nio/ByteBuffer;");
+        jobject byteBuffer = asReadOnly ? env->CallObjectMethod(direct, asReadOnly) : nullptr;
+        env->DeleteLocalRef(bufferClass);
+        env->DeleteLocalRef(direct);
+        if (!byteBuffer) {
+            return nullptr;
+        }
+
+        pinFrame(enginePtr, std::move(frame));
+        return byteBuffer;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error getting preview frame: %s", e.what());
+        JNIBridge::throw_java_exception(env, "java/lang/RuntimeException", e.what());
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Release the frame returned by getPreviewFrame
+ *
+ * Java Signature: native void releasePreviewFrame(long enginePtr)
+ */
+JNIEXPORT void JNICALL
+Java_com_ucworks_clipforge_NativeLib_releasePreviewFrame(JNIEnv* env, jclass clazz, jlong enginePtr) {
+    JNI_POSSIBLE_UNUSED(env);
+    JNI_POSSIBLE_UNUSED(clazz);
+    pinFrame(enginePtr, nullptr);
+}
+
 // ============================================================================
 // Export/Rendering
 // ============================================================================
@@ -551,6 +686,28 @@ Java_com_ucworks_clipforge_NativeLib_saveProject(JNIEnv* env, jclass clazz, jlon
     }
 }
 
+/**
+ * @brief Autosave the current project
+ *
+ * Java Signature: native boolean autosaveProject(long enginePtr)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ucworks_clipforge_NativeLib_autosaveProject(JNIEnv* env, jclass clazz, jlong enginePtr) {
+    JNI_POSSIBLE_UNUSED(env);
+    JNI_POSSIBLE_UNUSED(clazz);
+    try {
+        auto engine = getEngine(enginePtr);
+        if (!engine) {
+            return JNI_FALSE;
+        }
+
+        return engine->autosaveProject() ? JNI_TRUE : JNI_FALSE;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error autosaving project: %s", e.what());
+        return JNI_FALSE;
+    }
+}
+
 /**
  * @brief Get recent projects
  *
@@ -610,8 +767,8 @@ Java_com_ucworks_clipforge_NativeLib_trimClip(JNIEnv* env, jclass clazz, jlong e
             return JNI_FALSE;
         }
 
-        std::string id = JNIBridge::jstring_to_string(env, clipId);
-        return engine->trimClip(id, trimStart, trimEnd) ? JNI_TRUE : JNI_FALSE;
+        auto clip = engine->findClip(JNIBridge::jstring_to_string(env, clipId));
+        return engine->trimClip(clip, trimStart, trimEnd) ? JNI_TRUE : JNI_FALSE;
     } catch (const std::exception& e) {
         LOG_ERROR("Error trimming clip: %s", e.what());
         return JNI_FALSE;
@@ -633,8 +790,8 @@ Java_com_ucworks_clipforge_NativeLib_setClipSpeed(JNIEnv* env, jclass clazz, jlo
             return JNI_FALSE;
         }
 
-        std::string id = JNIBridge::jstring_to_string(env, clipId);
-        return engine->setClipSpeed(id, speed) ? JNI_TRUE : JNI_FALSE;
+        auto clip = engine->findClip(JNIBridge::jstring_to_string(env, clipId));
+        return engine->setClipSpeed(clip, speed) ? JNI_TRUE : JNI_FALSE;
     } catch (const std::exception& e) {
         LOG_ERROR("Error setting clip speed: %s", e.what());
         return JNI_FALSE;
@@ -656,8 +813,8 @@ Java_com_ucworks_clipforge_NativeLib_setClipVolume(JNIEnv* env, jclass clazz, jl
             return JNI_FALSE;
         }
 
-        std::string id = JNIBridge::jstring_to_string(env, clipId);
-        return engine->setClipVolume(id, volume) ? JNI_TRUE : JNI_FALSE;
+        auto clip = engine->findClip(JNIBridge::jstring_to_string(env, clipId));
+        return engine->setClipVolume(clip, volume) ? JNI_TRUE : JNI_FALSE;
     } catch (const std::exception& e) {
         LOG_ERROR("Error setting clip volume: %s", e.what());
         return JNI_FALSE;
@@ -710,7 +867,7 @@ Java_com_ucworks_clipforge_NativeLib_applyEffect(JNIEnv* env, jclass clazz, jlon
             return JNI_FALSE;
         }
 
-        std::string id = JNIBridge::jstring_to_string(env, clipId);
+        auto clip = engine->findClip(JNIBridge::jstring_to_string(env, clipId));
         std::string name = JNIBridge::jstring_to_string(env, effectName);
 
         auto effect = engine->createEffect(name);
@@ -718,7 +875,7 @@ Java_com_ucworks_clipforge_NativeLib_applyEffect(JNIEnv* env, jclass clazz, jlon
             return JNI_FALSE;
         }
 
-        return engine->applyEffect(id, effect) ? JNI_TRUE : JNI_FALSE;
+        return engine->applyEffect(clip, effect) ? JNI_TRUE : JNI_FALSE;
     } catch (const std::exception& e) {
         LOG_ERROR("Error applying effect: %s", e.what());
         return JNI_FALSE;
@@ -740,10 +897,10 @@ Java_com_ucworks_clipforge_NativeLib_removeEffect(JNIEnv* env, jclass clazz, jlo
             return JNI_FALSE;
         }
 
-        std::string id = JNIBridge::jstring_to_string(env, clipId);
+        auto clip = engine->findClip(JNIBridge::jstring_to_string(env, clipId));
         std::string effectIdx = JNIBridge::jstring_to_string(env, effectId);
 
-        return engine->removeEffect(id, effectIdx) ? JNI_TRUE : JNI_FALSE;
+        return engine->removeEffect(clip, effectIdx) ? JNI_TRUE : JNI_FALSE;
     } catch (const std::exception& e) {
         LOG_ERROR("Error removing effect: %s", e.what());
         return JNI_FALSE;
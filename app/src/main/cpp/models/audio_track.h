@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 #include <cstdint>
+#include "../utils/slot_map.h"
 
 namespace clipforge {
 namespace models {
@@ -51,6 +52,11 @@ struct AudioMetadata {
                       duration(0), peakLevel(0.0f), rmsLevel(0.0f) {}
 };
 
+class AudioTrack;
+
+/** @brief Runtime handle of an audio track in its timeline; not persisted */
+using AudioTrackHandle = utils::SlotHandle<AudioTrack>;
+
 /**
  * @class AudioTrack
  * @brief Represents an audio track that can contain one or more audio clips
@@ -95,6 +101,18 @@ public:
      */
     [[nodiscard]] const std::string& getId() const { return m_id; }
 
+    /**
+     * @brief Get the track's handle in the timeline holding it
+     * @return Handle, or a null handle if the track is in no timeline
+     */
+    [[nodiscard]] AudioTrackHandle getHandle() const { return m_handle; }
+
+    /**
+     * @brief Set the track's handle (Timeline only)
+     * @param handle Handle from the timeline's track store
+     */
+    void setHandle(AudioTrackHandle handle) { m_handle = handle; }
+
     /**
      * @brief Get track name
      * @return Display name
@@ -329,6 +347,7 @@ public:
 
 private:
     std::string m_id;
+    AudioTrackHandle m_handle;     // Set while in a timeline
     std::string m_name;
     std::string m_type;            // "main", "voiceover", "music", "sfx"
     std::string m_sourceFile;      // Source audio file path
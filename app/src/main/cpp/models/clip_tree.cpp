@@ -0,0 +1,238 @@
+#include "clip_tree.h"
+#include <algorithm>
+#include <limits>
+#include <string>
+
+namespace clipforge {
+namespace models {
+
+namespace {
+
+bool keyLess(const VideoClip& a, const VideoClip& b) {
+    if (a.getTrackIndex() != b.getTrackIndex()) return a.getTrackIndex() < b.getTrackIndex();
+    if (a.getStartPosition() != b.getStartPosition()) return a.getStartPosition() < b.getStartPosition();
+    return a.getId() < b.getId();
+}
+
+uint64_t priorityOf(const VideoClip& clip) {
+    // Mixed so similar IDs ("clip_1", "clip_2") still spread across the range
+    uint64_t hash = std::hash<std::string>()(clip.getId());
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+} // namespace
+
+// ============================================================================
+// ClipTree::Node
+// ============================================================================
+
+struct ClipTree::Node {
+    ClipPtr clip;
+    NodePtr left;
+    NodePtr right;
+    uint64_t priority;
+    size_t size;
+    int64_t minStart;              // Earliest start in the subtree
+    int64_t maxEnd;                // Latest end in the subtree
+
+    Node(ClipPtr c, NodePtr l, NodePtr r, uint64_t p)
+        : clip(std::move(c)), left(std::move(l)), right(std::move(r)), priority(p) {
+        size = 1;
+        minStart = clip->getStartPosition();
+        maxEnd = clip->getEndPosition();
+        for (const auto* child : {left.get(), right.get()}) {
+            if (!child) continue;
+            size += child->size;
+            minStart = std::min(minStart, child->minStart);
+            maxEnd = std::max(maxEnd, child->maxEnd);
+        }
+    }
+
+    static NodePtr make(ClipPtr clip, NodePtr left, NodePtr right, uint64_t priority) {
+        return std::make_shared<const Node>(std::move(clip), std::move(left), std::move(right), priority);
+    }
+
+    static NodePtr with(const NodePtr& node, NodePtr left, NodePtr right) {
+        if (left == node->left && right == node->right) return node;
+        return make(node->clip, std::move(left), std::move(right), node->priority);
+    }
+
+    // Heap order with ties broken by key, so the shape is unique
+    static bool above(const Node& a, const VideoClip& clip, uint64_t priority) {
+        if (a.priority != priority) return a.priority > priority;
+        return keyLess(*a.clip, clip);
+    }
+
+    /**
+     * @brief Split into keys below and above a clip's key (which is absent)
+     */
+    static void split(const NodePtr& node, const VideoClip& key, NodePtr& below, NodePtr& above) {
+        if (!node) {
+            below = nullptr;
+            above = nullptr;
+        } else if (keyLess(*node->clip, key)) {
+            NodePtr rest;
+            split(node->right, key, rest, above);
+            below = with(node, node->left, std::move(rest));
+        } else {
+            NodePtr rest;
+            split(node->left, key, below, rest);
+            above = with(node, std::move(rest), node->right);
+        }
+    }
+
+    /**
+     * @brief Join two trees where every key in a is below every key in b
+     */
+    static NodePtr merge(const NodePtr& a, const NodePtr& b) {
+        if (!a) return b;
+        if (!b) return a;
+        if (above(*a, *b->clip, b->priority)) {
+            return with(a, a->left, merge(a->right, b));
+        }
+        return with(b, merge(a, b->left), b->right);
+    }
+
+    static NodePtr insert(const NodePtr& node, const ClipPtr& clip, uint64_t priority) {
+        if (!node) return make(clip, nullptr, nullptr, priority);
+
+        if (sameKey(*node->clip, *clip)) {
+            return make(clip, node->left, node->right, node->priority);
+        }
+        if (!above(*node, *clip, priority)) {
+            NodePtr below, over;
+            split(node, *clip, below, over);
+            return make(clip, std::move(below), std::move(over), priority);
+        }
+        if (keyLess(*clip, *node->clip)) {
+            return with(node, insert(node->left, clip, priority), node->right);
+        }
+        return with(node, node->left, insert(node->right, clip, priority));
+    }
+
+    static NodePtr erase(const NodePtr& node, const VideoClip& key) {
+        if (!node) return node;
+        if (sameKey(*node->clip, key)) return merge(node->left, node->right);
+        if (keyLess(key, *node->clip)) return with(node, erase(node->left, key), node->right);
+        return with(node, node->left, erase(node->right, key));
+    }
+
+    static void queryPoint(const Node* node, int64_t timeMs, ClipList& out) {
+        if (!node || node->minStart > timeMs || node->maxEnd < timeMs) return;
+        queryPoint(node->left.get(), timeMs, out);
+        if (node->clip->getStartPosition() <= timeMs && node->clip->getEndPosition() >= timeMs) {
+            out.push_back(node->clip);
+        }
+        queryPoint(node->right.get(), timeMs, out);
+    }
+
+    static void collect(const Node* node, ClipList& out) {
+        if (!node) return;
+        collect(node->left.get(), out);
+        out.push_back(node->clip);
+        collect(node->right.get(), out);
+    }
+
+    /**
+     * @brief Split into keys below a clip's key, the clip with that key
+     *        (null if absent) and keys above it
+     */
+    static void splitAt(const NodePtr& node, const VideoClip& key, NodePtr& below, ClipPtr& equal, NodePtr& above) {
+        if (!node) {
+            below = nullptr;
+            equal = nullptr;
+            above = nullptr;
+        } else if (sameKey(*node->clip, key)) {
+            below = node->left;
+            equal = node->clip;
+            above = node->right;
+        } else if (keyLess(*node->clip, key)) {
+            NodePtr rest;
+            splitAt(node->right, key, rest, equal, above);
+            below = with(node, node->left, std::move(rest));
+        } else {
+            NodePtr rest;
+            splitAt(node->left, key, below, equal, rest);
+            above = with(node, std::move(rest), node->right);
+        }
+    }
+
+    static void reportAll(const Node* node, bool removed, const ChangeCallback& onChange) {
+        if (!node) return;
+        reportAll(node->left.get(), removed, onChange);
+        if (removed) {
+            onChange(node->clip, nullptr);
+        } else {
+            onChange(nullptr, node->clip);
+        }
+        reportAll(node->right.get(), removed, onChange);
+    }
+
+    static void diff(const NodePtr& from, const NodePtr& to, const ChangeCallback& onChange) {
+        if (from == to) return;
+        if (!from || !to) {
+            reportAll(from ? from.get() : to.get(), from != nullptr, onChange);
+            return;
+        }
+
+        if (sameKey(*from->clip, *to->clip)) {
+            diff(from->left, to->left, onChange);
+            if (from->clip != to->clip) onChange(from->clip, to->clip);
+            diff(from->right, to->right, onChange);
+            return;
+        }
+
+        // Roots differ: cut the newer tree at the older root's key. Only the
+        // nodes on the cut path are copied, so shared subtrees still compare
+        // equal below and are skipped.
+        NodePtr below, above;
+        ClipPtr equal;
+        splitAt(to, *from->clip, below, equal, above);
+
+        diff(from->left, below, onChange);
+        if (from->clip != equal) onChange(from->clip, equal);
+        diff(from->right, above, onChange);
+    }
+};
+
+// ============================================================================
+// ClipTree Implementation
+// ============================================================================
+
+ClipTree ClipTree::insert(ClipPtr clip) const {
+    if (!clip) return *this;
+    uint64_t priority = priorityOf(*clip);
+    return ClipTree(Node::insert(m_root, clip, priority));
+}
+
+ClipTree ClipTree::erase(const VideoClip& clip) const {
+    return ClipTree(Node::erase(m_root, clip));
+}
+
+size_t ClipTree::size() const {
+    return m_root ? m_root->size : 0;
+}
+
+void ClipTree::queryPoint(int64_t timeMs, ClipList& out) const {
+    Node::queryPoint(m_root.get(), timeMs, out);
+}
+
+void ClipTree::collect(ClipList& out) const {
+    out.reserve(out.size() + size());
+    Node::collect(m_root.get(), out);
+}
+
+bool ClipTree::sameKey(const VideoClip& a, const VideoClip& b) {
+    return a.getTrackIndex() == b.getTrackIndex() && a.getStartPosition() == b.getStartPosition() &&
+           a.getId() == b.getId();
+}
+
+void ClipTree::diff(const ClipTree& from, const ClipTree& to, const ChangeCallback& onChange) {
+    Node::diff(from.m_root, to.m_root, onChange);
+}
+
+} // namespace models
+} // namespace clipforge
@@ -0,0 +1,96 @@
+#ifndef CLIPFORGE_CLIP_TREE_H
+#define CLIPFORGE_CLIP_TREE_H
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include "video_clip.h"
+
+namespace clipforge {
+namespace models {
+
+/**
+ * @class ClipTree
+ * @brief Persistent ordered set of immutable clips
+ *
+ * A treap ordered by (track, start, ID) whose nodes are never modified:
+ * insert() and erase() copy the O(log n) nodes on the search path and
+ * share the rest with the original, so copying a tree is O(1) and old
+ * versions stay valid. Priorities are a hash of the clip ID, which makes
+ * the shape depend only on the contents; diff() uses that to skip every
+ * subtree two versions share.
+ *
+ * Nodes also track their subtree's time span for point queries.
+ */
+class ClipTree {
+public:
+    using ClipPtr = std::shared_ptr<const VideoClip>;
+    using ClipList = std::vector<ClipPtr>;
+    using ChangeCallback = std::function<void(const ClipPtr& from, const ClipPtr& to)>;
+
+    ClipTree() = default;
+
+    /**
+     * @brief Get a tree with a clip added
+     * @param clip Clip to add; replaces a clip with the same key
+     * @return New tree
+     */
+    [[nodiscard]] ClipTree insert(ClipPtr clip) const;
+
+    /**
+     * @brief Get a tree without a clip
+     * @param clip Clip whose key is removed
+     * @return New tree; shares this one if the key is absent
+     */
+    [[nodiscard]] ClipTree erase(const VideoClip& clip) const;
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const { return m_root == nullptr; }
+
+    /**
+     * @brief Collect clips covering a time, in key order
+     * @param timeMs Time in milliseconds; a clip's start and end both count
+     * @param out Receives matching clips
+     */
+    void queryPoint(int64_t timeMs, ClipList& out) const;
+
+    /**
+     * @brief Collect every clip in key order
+     * @param out Receives the clips
+     */
+    void collect(ClipList& out) const;
+
+    /**
+     * @brief Check whether two clips have the same key
+     * @return true if track, start and ID match
+     */
+    static bool sameKey(const VideoClip& a, const VideoClip& b);
+
+    /**
+     * @brief Report the differences between two trees
+     * @param from Older tree
+     * @param to Newer tree
+     * @param onChange Called with (old, nullptr) for removed keys,
+     *                 (nullptr, new) for added keys and (old, new) for
+     *                 keys whose clip was replaced
+     *
+     * Keys are reported in order. For trees derived from each other this
+     * takes O(d log n) for d differences, since shared subtrees are skipped.
+     */
+    static void diff(const ClipTree& from, const ClipTree& to, const ChangeCallback& onChange);
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    NodePtr m_root;
+
+    explicit ClipTree(NodePtr root) : m_root(std::move(root)) {}
+};
+
+} // namespace models
+} // namespace clipforge
+
+#endif // CLIPFORGE_CLIP_TREE_H
@@ -0,0 +1,753 @@
+#include "edit_journal.h"
+#include "../utils/logger.h"
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clipforge {
+namespace models {
+
+namespace {
+
+// ===== File format =====
+//
+// JournalHeader, then records of
+//   uint32 payloadLength, uint32 checksum (FNV-1a of the payload),
+//   payload: uint64 sequence, uint32 op, op fields.
+// Integers and floats are fixed width in native byte order, strings are
+// uint32 length + bytes. Sequences increase by one per record; the
+// header holds the sequence the first record follows.
+
+constexpr char MAGIC[4] = {'C', 'F', 'J', 'L'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+constexpr size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t);
+constexpr uint32_t MAX_PAYLOAD = 16 * 1024 * 1024;
+
+constexpr uint32_t TRACK_ENABLED = 1u << 0;
+constexpr uint32_t TRACK_MUTED = 1u << 1;
+constexpr uint32_t TRACK_SOLO = 1u << 2;
+constexpr uint32_t TRACK_LOCKED = 1u << 3;
+
+constexpr auto LAST_EFFECT_TYPE = static_cast<uint32_t>(EffectType::SPECIAL_VIGNETTE);
+
+struct JournalHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t reserved;
+    uint64_t baseSequence;
+};
+
+uint32_t checksum(const char* data, size_t size) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+template <typename T>
+void appendValue(std::string& out, T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void appendString(std::string& out, const std::string& value) {
+    appendValue(out, static_cast<uint32_t>(value.size()));
+    out += value;
+}
+
+/**
+ * @class PayloadReader
+ * @brief Bounds-checked reads from one record payload
+ */
+class PayloadReader {
+public:
+    PayloadReader(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (m_size - m_offset < sizeof(value)) return false;
+        std::memcpy(&value, m_data + m_offset, sizeof(value));
+        m_offset += sizeof(value);
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        uint32_t length = 0;
+        if (!read(length) || m_size - m_offset < length) return false;
+        value.assign(m_data + m_offset, length);
+        m_offset += length;
+        return true;
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+};
+
+/**
+ * @brief Step to the next intact record
+ * @param bytes Journal contents
+ * @param offset Record start; advanced past the record
+ * @param sequence Receives the record's sequence
+ * @param op Receives the record's operation
+ * @param payload Receives a reader positioned after the op
+ * @return false at the end of the journal or at a torn record
+ */
+bool nextRecord(const std::string& bytes, size_t& offset, uint64_t& sequence, uint32_t& op,
+                PayloadReader& payload) {
+    if (bytes.size() - offset < RECORD_HEADER_SIZE) return false;
+
+    uint32_t length = 0;
+    uint32_t expected = 0;
+    std::memcpy(&length, bytes.data() + offset, sizeof(length));
+    std::memcpy(&expected, bytes.data() + offset + sizeof(length), sizeof(expected));
+
+    const char* data = bytes.data() + offset + RECORD_HEADER_SIZE;
+    if (length > MAX_PAYLOAD || bytes.size() - offset - RECORD_HEADER_SIZE < length ||
+        checksum(data, length) != expected) {
+        return false;
+    }
+
+    payload = PayloadReader(data, length);
+    if (!payload.read(sequence) || !payload.read(op)) return false;
+
+    offset += RECORD_HEADER_SIZE + length;
+    return true;
+}
+
+/**
+ * @brief Index of an effect among a clip's serializable effects
+ * @return Index, or -1 if the effect is not there or not serializable
+ */
+int64_t serializableIndex(const VideoClip& clip, const std::string& effectId) {
+    int64_t index = 0;
+    for (const auto& effect : clip.getEffects()) {
+        if (!effect || !effect->isSerializable()) continue;
+        if (effect->getId() == effectId) return index;
+        index++;
+    }
+    return -1;
+}
+
+std::shared_ptr<Effect> serializableEffectAt(const VideoClip& clip, uint32_t target) {
+    uint32_t index = 0;
+    for (const auto& effect : clip.getEffects()) {
+        if (!effect || !effect->isSerializable()) continue;
+        if (index++ == target) return effect;
+    }
+    return nullptr;
+}
+
+void appendEffect(std::string& out, const Effect& effect) {
+    appendValue(out, static_cast<uint32_t>(effect.getType()));
+    appendString(out, effect.getName());
+    appendValue(out, effect.getIntensity());
+    appendValue(out, static_cast<uint32_t>(effect.isEnabled() ? 1 : 0));
+    appendValue(out, static_cast<uint32_t>(effect.getParameters().size()));
+    for (const auto& parameter : effect.getParameters()) {
+        appendString(out, parameter.name);
+        appendValue(out, parameter.value);
+        appendValue(out, parameter.minValue);
+        appendValue(out, parameter.maxValue);
+        appendValue(out, parameter.defaultValue);
+    }
+}
+
+std::shared_ptr<Effect> readEffect(PayloadReader& in) {
+    uint32_t type = 0, enabled = 0, parameterCount = 0;
+    float intensity = 0.0f;
+    std::string name;
+    if (!in.read(type) || type > LAST_EFFECT_TYPE || !in.readString(name) || !in.read(intensity) ||
+        !in.read(enabled) || !in.read(parameterCount)) {
+        return nullptr;
+    }
+
+    auto effect = std::make_shared<Effect>(static_cast<EffectType>(type), name);
+    for (uint32_t i = 0; i < parameterCount; i++) {
+        std::string parameterName;
+        float value = 0.0f, minValue = 0.0f, maxValue = 0.0f, defaultValue = 0.0f;
+        if (!in.readString(parameterName) || !in.read(value) || !in.read(minValue) ||
+            !in.read(maxValue) || !in.read(defaultValue)) {
+            return nullptr;
+        }
+        effect->addParameter(EffectParameter(parameterName, value, minValue, maxValue, defaultValue));
+    }
+    effect->setIntensity(intensity);
+    effect->setEnabled(enabled != 0);
+    return effect;
+}
+
+bool applyClipAdded(Timeline& timeline, PayloadReader& in) {
+    std::string id, sourceFile, name;
+    int64_t startPosition = 0, duration = 0, trimStart = 0, trimEnd = 0;
+    int32_t trackIndex = 0;
+    float speed = 0.0f, volume = 0.0f;
+    VideoClipMetadata metadata;
+    if (!in.readString(id) || !in.readString(sourceFile) || !in.readString(name) ||
+        !in.read(startPosition) || !in.read(duration) || !in.read(trimStart) || !in.read(trimEnd) ||
+        !in.read(trackIndex) || !in.read(speed) || !in.read(volume) ||
+        !in.read(metadata.fileSize) || !in.read(metadata.duration) || !in.read(metadata.width) ||
+        !in.read(metadata.height) || !in.read(metadata.frameRate) || !in.read(metadata.bitRate) ||
+        !in.readString(metadata.codecName) || !in.readString(metadata.mimeType)) {
+        return false;
+    }
+
+    auto clip = std::make_shared<VideoClip>(id, sourceFile);
+    clip->setName(name);
+    clip->setStartPosition(startPosition);
+    clip->setTrackIndex(trackIndex);
+    clip->setDuration(duration);
+    clip->setTrimStart(trimStart);
+    clip->setTrimEnd(trimEnd);
+    clip->setSpeed(speed);
+    clip->setVolume(volume);
+    metadata.sourceFile = sourceFile;
+    clip->setMetadata(metadata);
+
+    uint32_t effectCount = 0;
+    if (!in.read(effectCount)) return false;
+    for (uint32_t i = 0; i < effectCount; i++) {
+        auto effect = readEffect(in);
+        if (!effect) return false;
+        clip->applyEffect(effect);
+    }
+    return timeline.addClip(clip);
+}
+
+bool applyAudioTrackAdded(Timeline& timeline, PayloadReader& in) {
+    std::string id, name, type, sourceFile;
+    uint32_t flags = 0;
+    float volume = 0.0f, pan = 0.0f, bass = 0.0f, midrange = 0.0f, treble = 0.0f;
+    float reverb = 0.0f, compression = 0.0f, pitchShift = 0.0f;
+    if (!in.readString(id) || !in.readString(name) || !in.readString(type) || !in.readString(sourceFile) ||
+        !in.read(flags) || !in.read(volume) || !in.read(pan) || !in.read(bass) || !in.read(midrange) ||
+        !in.read(treble) || !in.read(reverb) || !in.read(compression) || !in.read(pitchShift)) {
+        return false;
+    }
+
+    auto track = std::make_shared<AudioTrack>(id, name, type);
+    track->setSourceFile(sourceFile);
+    track->setEnabled((flags & TRACK_ENABLED) != 0);
+    track->setMuted((flags & TRACK_MUTED) != 0);
+    track->setSolo((flags & TRACK_SOLO) != 0);
+    track->setLocked((flags & TRACK_LOCKED) != 0);
+    track->setVolume(volume);
+    track->setPan(pan);
+    track->setBass(bass);
+    track->setMidrange(midrange);
+    track->setTreble(treble);
+    track->setReverb(reverb);
+    track->setCompression(compression);
+    track->setPitchShift(pitchShift);
+    return timeline.addAudioTrack(track);
+}
+
+/**
+ * @brief Apply one record to a timeline
+ * @return false if the record is malformed or does not match the timeline
+ */
+bool applyRecord(Timeline& timeline, JournalOp op, PayloadReader& in) {
+    if (op == JournalOp::CLIP_ADDED) return applyClipAdded(timeline, in);
+    if (op == JournalOp::AUDIO_TRACK_ADDED) return applyAudioTrackAdded(timeline, in);
+
+    // Every other record starts with the ID of the clip or track it edits,
+    // resolved to a handle once
+    std::string id;
+    if (!in.readString(id)) return false;
+
+    switch (op) {
+        case JournalOp::CLIP_REMOVED:
+            return timeline.removeClip(timeline.findClip(id));
+
+        case JournalOp::CLIP_MOVED: {
+            int64_t startPosition = 0;
+            int32_t trackIndex = 0;
+            return in.read(startPosition) && in.read(trackIndex) &&
+                   timeline.moveClip(timeline.findClip(id), startPosition, trackIndex);
+        }
+
+        case JournalOp::CLIP_TRIMMED: {
+            int64_t trimStart = 0, trimEnd = 0, duration = 0;
+            auto clip = timeline.getClip(timeline.findClip(id));
+            if (!clip || !in.read(trimStart) || !in.read(trimEnd) || !in.read(duration)) return false;
+            clip->setTrimStart(trimStart);
+            clip->setTrimEnd(trimEnd);
+            clip->setDuration(duration);
+            return timeline.refreshClip(clip->getHandle());
+        }
+
+        case JournalOp::CLIP_SPEED:
+        case JournalOp::CLIP_VOLUME: {
+            float value = 0.0f;
+            auto clip = timeline.getClip(timeline.findClip(id));
+            if (!clip || !in.read(value)) return false;
+            if (op == JournalOp::CLIP_SPEED) {
+                clip->setSpeed(value);
+            } else {
+                clip->setVolume(value);
+            }
+            return timeline.touchClip(clip->getHandle());
+        }
+
+        case JournalOp::EFFECT_ADDED: {
+            auto clip = timeline.getClip(timeline.findClip(id));
+            auto effect = clip ? readEffect(in) : nullptr;
+            if (!effect) return false;
+            clip->applyEffect(effect);
+            return timeline.touchClip(clip->getHandle());
+        }
+
+        case JournalOp::EFFECT_REMOVED: {
+            uint32_t index = 0;
+            auto clip = timeline.getClip(timeline.findClip(id));
+            if (!clip || !in.read(index)) return false;
+            auto effect = serializableEffectAt(*clip, index);
+            return effect && clip->removeEffect(effect->getId()) && timeline.touchClip(clip->getHandle());
+        }
+
+        case JournalOp::EFFECT_PARAMETER: {
+            uint32_t index = 0;
+            std::string name;
+            float value = 0.0f;
+            auto clip = timeline.getClip(timeline.findClip(id));
+            if (!clip || !in.read(index) || !in.readString(name) || !in.read(value)) return false;
+            auto effect = serializableEffectAt(*clip, index);
+            return effect && effect->setParameterValue(name, value) && timeline.touchClip(clip->getHandle());
+        }
+
+        case JournalOp::AUDIO_TRACK_REMOVED:
+            return timeline.removeAudioTrack(timeline.findAudioTrack(id));
+
+        case JournalOp::AUDIO_TRACK_VOLUME: {
+            float volume = 0.0f;
+            auto track = timeline.getAudioTrack(timeline.findAudioTrack(id));
+            if (!track || !in.read(volume)) return false;
+            track->setVolume(volume);
+            return timeline.touchAudioTrack(track->getHandle());
+        }
+
+        case JournalOp::AUDIO_TRACK_MUTED: {
+            uint32_t muted = 0;
+            auto track = timeline.getAudioTrack(timeline.findAudioTrack(id));
+            if (!track || !in.read(muted)) return false;
+            track->setMuted(muted != 0);
+            return timeline.touchAudioTrack(track->getHandle());
+        }
+
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+// ===== EditJournal Implementation =====
+
+EditJournal::~EditJournal() {
+    close();
+}
+
+std::string EditJournal::pathFor(const std::string& projectPath) {
+    return projectPath + ".journal";
+}
+
+bool EditJournal::open(const std::string& journalPath) {
+    close();
+
+    m_fd = ::open(journalPath.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        LOG_ERROR("EditJournal: cannot open %s: %s", journalPath.c_str(), std::strerror(errno));
+        return false;
+    }
+    m_path = journalPath;
+
+    std::string bytes;
+    JournalHeader header{};
+    if (!readFile(bytes)) {
+        close();
+        return false;
+    }
+    if (bytes.size() >= sizeof(header)) {
+        std::memcpy(&header, bytes.data(), sizeof(header));
+    }
+
+    if (bytes.size() < sizeof(header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != FORMAT_VERSION || header.byteOrderMark != BYTE_ORDER_MARK) {
+        if (!bytes.empty()) {
+            LOG_WARNING("EditJournal: %s has an unknown format, starting a new journal", journalPath.c_str());
+        }
+        if (!writeHeader(0)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    // Keep the intact prefix; a crash can only tear the last record
+    size_t offset = sizeof(header);
+    uint64_t lastSequence = header.baseSequence;
+    uint64_t sequence = 0;
+    uint32_t op = 0;
+    PayloadReader payload(nullptr, 0);
+    size_t recordStart = offset;
+    while (nextRecord(bytes, offset, sequence, op, payload) && sequence == lastSequence + 1) {
+        lastSequence = sequence;
+        recordStart = offset;
+    }
+
+    if (recordStart < bytes.size()) {
+        LOG_WARNING("EditJournal: dropping %zu bytes of torn records from %s",
+                    bytes.size() - recordStart, journalPath.c_str());
+        if (ftruncate(m_fd, static_cast<off_t>(recordStart)) != 0) {
+            LOG_ERROR("EditJournal: cannot truncate %s", journalPath.c_str());
+            close();
+            return false;
+        }
+    }
+
+    m_fileSize = recordStart;
+    m_lastSequence = lastSequence;
+    m_baseSequence = header.baseSequence;
+    LOG_INFO("EditJournal: opened %s (last sequence %llu)", journalPath.c_str(),
+             static_cast<unsigned long long>(m_lastSequence));
+    return true;
+}
+
+void EditJournal::close() {
+    if (m_fd < 0) return;
+
+    sync();
+    ::close(m_fd);
+    m_fd = -1;
+    m_path.clear();
+    m_fileSize = 0;
+    m_lastSequence = 0;
+    m_baseSequence = 0;
+    m_pending.clear();
+}
+
+void EditJournal::recordClipAdded(const VideoClip& clip) {
+    if (!isOpen()) return;
+
+    const VideoClipMetadata& metadata = clip.getMetadata();
+    beginRecord(JournalOp::CLIP_ADDED);
+    appendString(m_record, clip.getId());
+    appendString(m_record, clip.getSourceFile());
+    appendString(m_record, clip.getName());
+    appendValue(m_record, clip.getStartPosition());
+    appendValue(m_record, clip.getDuration());
+    appendValue(m_record, clip.getTrimStart());
+    appendValue(m_record, clip.getTrimEnd());
+    appendValue(m_record, clip.getTrackIndex());
+    appendValue(m_record, clip.getSpeed());
+    appendValue(m_record, clip.getVolume());
+    appendValue(m_record, metadata.fileSize);
+    appendValue(m_record, metadata.duration);
+    appendValue(m_record, metadata.width);
+    appendValue(m_record, metadata.height);
+    appendValue(m_record, metadata.frameRate);
+    appendValue(m_record, metadata.bitRate);
+    appendString(m_record, metadata.codecName);
+    appendString(m_record, metadata.mimeType);
+
+    uint32_t effectCount = 0;
+    size_t countOffset = m_record.size();
+    appendValue(m_record, effectCount);
+    for (const auto& effect : clip.getEffects()) {
+        if (!effect || !effect->isSerializable()) continue;
+        appendEffect(m_record, *effect);
+        effectCount++;
+    }
+    std::memcpy(&m_record[countOffset], &effectCount, sizeof(effectCount));
+    commitRecord();
+}
+
+void EditJournal::recordClipRemoved(const std::string& clipId) {
+    if (!isOpen()) return;
+
+    beginRecord(JournalOp::CLIP_REMOVED);
+    appendString(m_record, clipId);
+    commitRecord();
+}
+
+void EditJournal::recordClipMoved(const VideoClip& clip) {
+    if (!isOpen()) return;
+
+    beginRecord(JournalOp::CLIP_MOVED);
+    appendString(m_record, clip.getId());
+    appendValue(m_record, clip.getStartPosition());
+    appendValue(m_record, clip.getTrackIndex());
+    commitRecord();
+}
+
+void EditJournal::recordClipTrimmed(const VideoClip& clip) {
+    if (!isOpen()) return;
+
+    beginRecord(JournalOp::CLIP_TRIMMED);
+    appendString(m_record, clip.getId());
+    appendValue(m_record, clip.getTrimStart());
+    appendValue(m_record, clip.getTrimEnd());
+    appendValue(m_record, clip.getDuration());
+    commitRecord();
+}
+
+void EditJournal::recordClipSpeed(const VideoClip& clip) {
+    if (!isOpen()) return;
+
+    beginRecord(JournalOp::CLIP_SPEED);
+    appendString(m_record, clip.getId());
+    appendValue(m_record, clip.getSpeed());
+    commitRecord();
+}
+
+void EditJournal::recordClipVolume(const VideoClip& clip) {
+    if (!isOpen()) return;
+
+    beginRecord(JournalOp::CLIP_VOLUME);
+    appendString(m_record, clip.getId());
+    appendValue(m_record, clip.getVolume());
+    commitRecord();
+}
+
+void EditJournal::recordEffectAdded(const VideoClip& clip, const Effect& effect) {
+    if (!isOpen() || !effect.isSerializable()) return;
+
+    beginRecord(JournalOp::EFFECT_ADDED);
+    appendString(m_record, clip.getId());
+    appendEffect(m_record, effect);
+    commitRecord();
+}
+
+void EditJournal::recordEffectRemoved(const VideoClip& clip, const std::string& effectId) {
+    if (!isOpen()) return;
+
+    int64_t index = serializableIndex(clip, effectId);
+    if (index < 0) return;
+
+    beginRecord(JournalOp::EFFECT_REMOVED);
+    appendString(m_record, clip.getId());
+    appendValue(m_record, static_cast<uint32_t>(index));
+    commitRecord();
+}
+
+void EditJournal::recordEffectParameter(const VideoClip& clip, const Effect& effect,
+                                        const std::string& parameterName) {
+    if (!isOpen()) return;
+
+    int64_t index = serializableIndex(clip, effect.getId());
+    if (index < 0) return;
+
+    beginRecord(JournalOp::EFFECT_PARAMETER);
+    appendString(m_record, clip.getId());
+    appendValue(m_record, static_cast<uint32_t>(index));
+    appendString(m_record, parameterName);
+    appendValue(m_record, effect.getParameterValue(parameterName));
+    commitRecord();
+}
+
+void EditJournal::recordAudioTrackAdded(const AudioTrack& track) {
+    if (!isOpen()) return;
+
+    beginRecord(JournalOp::AUDIO_TRACK_ADDED);
+    appendString(m_record, track.getId());
+    appendString(m_record, track.getName());
+    appendString(m_record, track.getType());
+    appendString(m_record, track.getSourceFile());
+    appendValue(m_record, (track.isEnabled() ? TRACK_ENABLED : 0) | (track.isMuted() ? TRACK_MUTED : 0) |
+                          (track.isSolo() ? TRACK_SOLO : 0) | (track.isLocked() ? TRACK_LOCKED : 0));
+    appendValue(m_record, track.getVolume());
+    appendValue(m_record, track.getPan());
+    appendValue(m_record, track.getBass());
+    appendValue(m_record, track.getMidrange());
+    appendValue(m_record, track.getTreble());
+    appendValue(m_record, track.getReverb());
+    appendValue(m_record, track.getCompression());
+    appendValue(m_record, track.getPitchShift());
+    commitRecord();
+}
+
+void EditJournal::recordAudioTrackRemoved(const std::string& trackId) {
+    if (!isOpen()) return;
+
+    beginRecord(JournalOp::AUDIO_TRACK_REMOVED);
+    appendString(m_record, trackId);
+    commitRecord();
+}
+
+void EditJournal::recordAudioTrackVolume(const AudioTrack& track) {
+    if (!isOpen()) return;
+
+    beginRecord(JournalOp::AUDIO_TRACK_VOLUME);
+    appendString(m_record, track.getId());
+    appendValue(m_record, track.getVolume());
+    commitRecord();
+}
+
+void EditJournal::recordAudioTrackMuted(const AudioTrack& track) {
+    if (!isOpen()) return;
+
+    beginRecord(JournalOp::AUDIO_TRACK_MUTED);
+    appendString(m_record, track.getId());
+    appendValue(m_record, static_cast<uint32_t>(track.isMuted() ? 1 : 0));
+    commitRecord();
+}
+
+bool EditJournal::sync() {
+    if (!isOpen()) return false;
+
+    if (!writePending()) return false;
+    if (fdatasync(m_fd) != 0) {
+        LOG_ERROR("EditJournal: cannot sync %s: %s", m_path.c_str(), std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool EditJournal::reset(uint64_t baseSequence) {
+    if (!isOpen()) return false;
+
+    m_pending.clear();
+    if (!writeHeader(baseSequence) || fdatasync(m_fd) != 0) {
+        LOG_ERROR("EditJournal: cannot reset %s", m_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+size_t EditJournal::replay(Timeline& timeline, uint64_t afterSequence) const {
+    std::string bytes;
+    if (!isOpen() || !readFile(bytes) || bytes.size() < sizeof(JournalHeader)) {
+        return 0;
+    }
+
+    JournalHeader header{};
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.baseSequence > afterSequence) {
+        // Replaying past the gap would silently produce the wrong timeline
+        LOG_ERROR("EditJournal: %s starts after sequence %llu, the snapshot ends at %llu; not replaying",
+                  m_path.c_str(), static_cast<unsigned long long>(header.baseSequence),
+                  static_cast<unsigned long long>(afterSequence));
+        return 0;
+    }
+
+    size_t applied = 0;
+    size_t skipped = 0;
+    size_t offset = sizeof(header);
+    uint64_t sequence = 0;
+    uint32_t op = 0;
+    PayloadReader payload(nullptr, 0);
+
+    // One batch keeps the replay linear in the number of records
+    timeline.beginBatch();
+    while (offset < m_fileSize && nextRecord(bytes, offset, sequence, op, payload)) {
+        if (sequence <= afterSequence) continue;
+
+        if (applyRecord(timeline, static_cast<JournalOp>(op), payload)) {
+            applied++;
+        } else {
+            skipped++;
+        }
+    }
+    timeline.commitBatch();
+
+    if (skipped > 0) {
+        LOG_WARNING("EditJournal: skipped %zu records that no longer match the timeline", skipped);
+    }
+    LOG_INFO("EditJournal: replayed %zu records from %s", applied, m_path.c_str());
+    return applied;
+}
+
+void EditJournal::beginRecord(JournalOp op) {
+    m_record.assign(RECORD_HEADER_SIZE, '\0');
+    appendValue(m_record, m_lastSequence + 1);
+    appendValue(m_record, static_cast<uint32_t>(op));
+}
+
+void EditJournal::commitRecord() {
+    auto length = static_cast<uint32_t>(m_record.size() - RECORD_HEADER_SIZE);
+    uint32_t sum = checksum(m_record.data() + RECORD_HEADER_SIZE, length);
+    std::memcpy(&m_record[0], &length, sizeof(length));
+    std::memcpy(&m_record[sizeof(length)], &sum, sizeof(sum));
+
+    m_pending += m_record;
+    m_lastSequence++;
+
+    if (m_pending.size() >= WRITE_BATCH_BYTES) {
+        writePending();
+    }
+}
+
+bool EditJournal::writePending() {
+    size_t written = 0;
+    while (written < m_pending.size()) {
+        ssize_t result = ::write(m_fd, m_pending.data() + written, m_pending.size() - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) {
+            LOG_ERROR("EditJournal: cannot write %s: %s", m_path.c_str(), std::strerror(errno));
+            // Drop the partial write so the records can be retried intact
+            if (ftruncate(m_fd, static_cast<off_t>(m_fileSize)) != 0) {
+                LOG_ERROR("EditJournal: cannot roll back %s", m_path.c_str());
+            }
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+
+    m_fileSize += m_pending.size();
+    m_pending.clear();
+    return true;
+}
+
+bool EditJournal::writeHeader(uint64_t baseSequence) {
+    JournalHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.baseSequence = baseSequence;
+
+    // O_APPEND: after truncation the header lands at offset 0
+    if (ftruncate(m_fd, 0) != 0 || ::write(m_fd, &header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))) {
+        LOG_ERROR("EditJournal: cannot write header to %s", m_path.c_str());
+        return false;
+    }
+
+    m_fileSize = sizeof(header);
+    m_lastSequence = baseSequence;
+    m_baseSequence = baseSequence;
+    return true;
+}
+
+bool EditJournal::readFile(std::string& out) const {
+    struct stat info {};
+    if (fstat(m_fd, &info) != 0) {
+        LOG_ERROR("EditJournal: cannot stat %s", m_path.c_str());
+        return false;
+    }
+
+    out.resize(static_cast<size_t>(info.st_size));
+    size_t done = 0;
+    while (done < out.size()) {
+        ssize_t result = pread(m_fd, &out[done], out.size() - done, static_cast<off_t>(done));
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) {
+            LOG_ERROR("EditJournal: cannot read %s", m_path.c_str());
+            return false;
+        }
+        done += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+} // namespace models
+} // namespace clipforge
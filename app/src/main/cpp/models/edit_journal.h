@@ -0,0 +1,232 @@
+#ifndef CLIPFORGE_EDIT_JOURNAL_H
+#define CLIPFORGE_EDIT_JOURNAL_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "timeline.h"
+
+namespace clipforge {
+namespace models {
+
+/**
+ * @enum JournalOp
+ * @brief Timeline mutations recorded by EditJournal
+ */
+enum class JournalOp : uint32_t {
+    CLIP_ADDED = 1,
+    CLIP_REMOVED,
+    CLIP_MOVED,
+    CLIP_TRIMMED,
+    CLIP_SPEED,
+    CLIP_VOLUME,
+    EFFECT_ADDED,
+    EFFECT_REMOVED,
+    EFFECT_PARAMETER,
+    AUDIO_TRACK_ADDED,
+    AUDIO_TRACK_REMOVED,
+    AUDIO_TRACK_VOLUME,
+    AUDIO_TRACK_MUTED
+};
+
+/**
+ * @class EditJournal
+ * @brief Append-only log of timeline edits on top of a project snapshot
+ *
+ * Each edit is appended as a checksummed record with an increasing
+ * sequence number. Records are buffered and reach the disk with one
+ * write and fdatasync per sync() call, so an autosave costs the size of
+ * the edits since the last one rather than the size of the project.
+ *
+ * A snapshot written by ProjectFileWriter stores the last sequence it
+ * includes; after it is on disk the journal is reset() past that
+ * sequence. Recovery loads the snapshot and replays the newer records.
+ * A record torn by a crash is dropped when the journal is opened.
+ *
+ * Effects are addressed by their position among the clip's
+ * serializable effects, since effect IDs are regenerated on load.
+ * Non-serializable effects are not recorded.
+ *
+ * Usage:
+ * @code
+ * EditJournal journal;
+ * journal.open(EditJournal::pathFor(projectPath));
+ * journal.replay(*timeline, project->getJournalSequence());
+ * clip->setSpeed(2.0f);
+ * journal.recordClipSpeed(*clip);
+ * journal.sync();
+ * @endcode
+ */
+class EditJournal {
+public:
+    static constexpr size_t WRITE_BATCH_BYTES = 64 * 1024;  // Pending bytes written without waiting for sync()
+
+    EditJournal() = default;
+
+    /**
+     * @brief Destructor - writes pending records and closes the file
+     */
+    ~EditJournal();
+
+    // Prevent copying
+    EditJournal(const EditJournal&) = delete;
+    EditJournal& operator=(const EditJournal&) = delete;
+
+    /**
+     * @brief Get the journal path that belongs to a project file
+     * @param projectPath Project file path
+     * @return Journal path
+     */
+    [[nodiscard]] static std::string pathFor(const std::string& projectPath);
+
+    /**
+     * @brief Open or create a journal
+     * @param journalPath Journal file path
+     * @return true if the journal is ready for appending
+     *
+     * A torn record at the end is truncated away; a file of another
+     * format is discarded and started afresh.
+     */
+    bool open(const std::string& journalPath);
+
+    /**
+     * @brief Write pending records and close the file
+     */
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_fd >= 0; }
+
+    /**
+     * @brief Get the sequence number of the last record
+     * @return Last sequence, or the reset() base if the journal is empty
+     */
+    [[nodiscard]] uint64_t getLastSequence() const { return m_lastSequence; }
+
+    /**
+     * @brief Get the sequence the journal continues from
+     * @return Last sequence of the snapshot the journal was reset() to
+     */
+    [[nodiscard]] uint64_t getBaseSequence() const { return m_baseSequence; }
+
+    /**
+     * @brief Get the journal size including records not yet written
+     * @return Size in bytes
+     */
+    [[nodiscard]] size_t getSize() const { return m_fileSize + m_pending.size(); }
+
+    // ===== Recording =====
+    // No-ops while the journal is closed
+
+    void recordClipAdded(const VideoClip& clip);
+    void recordClipRemoved(const std::string& clipId);
+    void recordClipMoved(const VideoClip& clip);
+
+    /**
+     * @brief Record a clip's trim points and duration
+     * @param clip Clip after the edit
+     */
+    void recordClipTrimmed(const VideoClip& clip);
+
+    void recordClipSpeed(const VideoClip& clip);
+    void recordClipVolume(const VideoClip& clip);
+
+    /**
+     * @brief Record an effect appended to a clip
+     * @param clip Clip after the effect was applied
+     * @param effect The effect, with its parameters
+     */
+    void recordEffectAdded(const VideoClip& clip, const Effect& effect);
+
+    /**
+     * @brief Record an effect removal
+     * @param clip Clip still holding the effect; call before removing it
+     * @param effectId ID of the effect about to be removed
+     */
+    void recordEffectRemoved(const VideoClip& clip, const std::string& effectId);
+
+    /**
+     * @brief Record an effect parameter change
+     * @param clip Clip holding the effect
+     * @param effect Effect after the change
+     * @param parameterName Changed parameter
+     */
+    void recordEffectParameter(const VideoClip& clip, const Effect& effect,
+                               const std::string& parameterName);
+
+    void recordAudioTrackAdded(const AudioTrack& track);
+    void recordAudioTrackRemoved(const std::string& trackId);
+    void recordAudioTrackVolume(const AudioTrack& track);
+    void recordAudioTrackMuted(const AudioTrack& track);
+
+    // ===== Persistence =====
+
+    /**
+     * @brief Write pending records and flush them to storage
+     * @return true if every record so far is durable
+     */
+    bool sync();
+
+    /**
+     * @brief Drop all records after a snapshot has been written
+     * @param baseSequence Last sequence included in the snapshot
+     * @return true if the journal was truncated and synced
+     */
+    bool reset(uint64_t baseSequence);
+
+    /**
+     * @brief Apply journaled edits to a timeline
+     * @param timeline Timeline loaded from the snapshot
+     * @param afterSequence Snapshot's journal sequence; older records are skipped
+     * @return Number of records applied
+     *
+     * Records that no longer match the timeline are skipped with a warning.
+     * Nothing is applied if the journal starts after afterSequence, since
+     * the edits in between are missing; check getBaseSequence() first.
+     */
+    size_t replay(Timeline& timeline, uint64_t afterSequence) const;
+
+private:
+    int m_fd = -1;
+    std::string m_path;
+    size_t m_fileSize = 0;         // Bytes on disk
+    uint64_t m_lastSequence = 0;
+    uint64_t m_baseSequence = 0;   // Header sequence; records follow it
+    std::string m_pending;         // Records not yet written
+    std::string m_record;          // Record being built
+
+    /**
+     * @brief Start a record in m_record
+     * @param op Operation being recorded
+     */
+    void beginRecord(JournalOp op);
+
+    /**
+     * @brief Seal m_record and queue it for writing
+     */
+    void commitRecord();
+
+    /**
+     * @brief Append the pending records to the file
+     * @return true if written; on failure the file is rolled back
+     */
+    bool writePending();
+
+    /**
+     * @brief Truncate the file to a fresh header
+     * @param baseSequence Sequence stored in the header
+     * @return true if written
+     */
+    bool writeHeader(uint64_t baseSequence);
+
+    /**
+     * @brief Read the whole journal file
+     * @param out Receives the file contents
+     * @return true if read
+     */
+    bool readFile(std::string& out) const;
+};
+
+} // namespace models
+} // namespace clipforge
+
+#endif // CLIPFORGE_EDIT_JOURNAL_H
@@ -1,5 +1,6 @@
 #include "effect.h"
-#include <ctime>
+#include "../utils/id_generator.h"
+#include <chrono>
 #include <algorithm>
 
 namespace clipforge {
@@ -10,7 +11,7 @@ namespace models {
 // ============================================================================
 
 Effect::Effect(EffectType type, const std::string& name)
-    : m_type(type), m_id(generateId()), m_name(name.empty() ? "Unnamed Effect" : name),
+    : m_type(type), m_id(utils::generateId("eff")), m_name(name.empty() ? "Unnamed Effect" : name),
       m_createdAt(std::chrono::system_clock::now().time_since_epoch().count() / 1000000) {
     // Initialize parameters based on effect type
     if (type == EffectType::COLOR_BRIGHTNESS) {
@@ -19,6 +20,13 @@ Effect::Effect(EffectType type, const std::string& name)
         addParameter(EffectParameter("contrast", 1.0f, 0.5f, 2.0f, 1.0f));
     } else if (type == EffectType::COLOR_SATURATION) {
         addParameter(EffectParameter("saturation", 1.0f, 0.0f, 2.0f, 1.0f));
+    } else if (type == EffectType::COLOR_TEMPERATURE) {
+        addParameter(EffectParameter("temperature", 0.0f, -1.0f, 1.0f, 0.0f));
+    } else if (type == EffectType::COLOR_TINT) {
+        addParameter(EffectParameter("tint", 0.0f, -1.0f, 1.0f, 0.0f));
+    } else if (type == EffectType::BLUR_STANDARD) {
+        addParameter(EffectParameter("radius", 5.0f, 0.5f, 50.0f, 5.0f));
+        addParameter(EffectParameter("quality", 1.0f, 0.0f, 1.0f, 1.0f));  // 0 fast, 1 high
     }
 }
 
@@ -60,17 +68,6 @@ void Effect::setIntensity(float intensity) {
     m_intensity = std::max(0.0f, std::min(1.0f, intensity));
 }
 
-std::string Effect::generateId() {
-    // Simple UUID-like string generation
-    // In production, use proper UUID library
-    static unsigned int counter = 0;
-    std::string id = "eff_";
-    id += std::to_string(std::time(nullptr));
-    id += "_";
-    id += std::to_string(++counter);
-    return id;
-}
-
 // ============================================================================
 // EffectChain Implementation
 // ============================================================================
@@ -203,12 +203,6 @@ private:
     bool m_enabled = true;         // Whether effect is active
     int64_t m_createdAt;           // Creation timestamp
     bool m_serializable = true;    // Can be saved to project
-
-    /**
-     * @brief Generate unique ID for this effect
-     * @return UUID string
-     */
-    static std::string generateId();
 };
 
 /**
@@ -0,0 +1,160 @@
+#include "overlap_validator.h"
+#include <algorithm>
+#include <functional>
+
+namespace clipforge {
+namespace models {
+
+namespace {
+
+// Above this share of touched clips a full sweep is cheaper than re-querying
+constexpr size_t FULL_SWEEP_DIVISOR = 4;
+
+bool byTrackAndStart(const std::shared_ptr<VideoClip>& a, const std::shared_ptr<VideoClip>& b) {
+    if (!a || !b) return false;
+    if (a->getTrackIndex() != b->getTrackIndex()) {
+        return a->getTrackIndex() < b->getTrackIndex();
+    }
+    return a->getStartPosition() < b->getStartPosition();
+}
+
+bool spansIntersect(const VideoClip& a, const VideoClip& b) {
+    return a.getStartPosition() < b.getEndPosition() && b.getStartPosition() < a.getEndPosition();
+}
+
+ClipOverlap makeOverlap(const std::shared_ptr<VideoClip>& a, const std::shared_ptr<VideoClip>& b) {
+    bool aFirst = a->getStartPosition() <= b->getStartPosition();
+    ClipOverlap overlap;
+    overlap.first = aFirst ? a : b;
+    overlap.second = aFirst ? b : a;
+    overlap.trackIndex = a->getTrackIndex();
+    overlap.start = std::max(a->getStartPosition(), b->getStartPosition());
+    overlap.end = std::min(a->getEndPosition(), b->getEndPosition());
+    return overlap;
+}
+
+void sortOverlaps(OverlapValidator::OverlapList::iterator begin,
+                  OverlapValidator::OverlapList::iterator end) {
+    std::stable_sort(begin, end, [](const ClipOverlap& a, const ClipOverlap& b) {
+        if (a.trackIndex != b.trackIndex) return a.trackIndex < b.trackIndex;
+        if (a.start != b.start) return a.start < b.start;
+        return a.first->getStartPosition() < b.first->getStartPosition();
+    });
+}
+
+} // namespace
+
+// ============================================================================
+// OverlapValidator Implementation
+// ============================================================================
+
+void OverlapValidator::findOverlaps(const ClipList& clips, OverlapList& out) {
+    // Timeline keeps this order; only edits that bypassed it need a sorted copy
+    const ClipList* sorted = &clips;
+    ClipList copy;
+    if (!std::is_sorted(clips.begin(), clips.end(), byTrackAndStart)) {
+        copy = clips;
+        std::stable_sort(copy.begin(), copy.end(), byTrackAndStart);
+        sorted = &copy;
+    }
+
+    // Min-heap on end position of the clips still running at the sweep line
+    std::vector<const std::shared_ptr<VideoClip>*> active;
+    auto endsLater = [](const std::shared_ptr<VideoClip>* a, const std::shared_ptr<VideoClip>* b) {
+        return (*a)->getEndPosition() > (*b)->getEndPosition();
+    };
+
+    size_t firstOut = out.size();
+    int32_t track = 0;
+    for (const auto& clip : *sorted) {
+        if (!clip) continue;
+
+        if (active.empty() || clip->getTrackIndex() != track) {
+            active.clear();
+            track = clip->getTrackIndex();
+        }
+
+        // Clips ending at or before this start cannot reach any later clip
+        while (!active.empty() && (*active.front())->getEndPosition() <= clip->getStartPosition()) {
+            std::pop_heap(active.begin(), active.end(), endsLater);
+            active.pop_back();
+        }
+
+        for (const auto* running : active) {
+            if (spansIntersect(**running, *clip)) {
+                out.push_back(makeOverlap(*running, clip));
+            }
+        }
+
+        active.push_back(&clip);
+        std::push_heap(active.begin(), active.end(), endsLater);
+    }
+
+    sortOverlaps(out.begin() + static_cast<std::ptrdiff_t>(firstOut), out.end());
+}
+
+void OverlapValidator::markTouched(const std::shared_ptr<VideoClip>& clip) {
+    if (!clip || !m_valid) return;
+    m_touched[clip.get()] = clip;
+}
+
+void OverlapValidator::markRemoved(const VideoClip* clip) {
+    if (!clip || !m_valid) return;
+    m_touched[clip] = nullptr;
+}
+
+void OverlapValidator::invalidate() {
+    m_valid = false;
+    m_touched.clear();
+}
+
+const OverlapValidator::OverlapList& OverlapValidator::validate(const ClipList& clips,
+                                                                const TrackIndexMap& index) {
+    if (m_valid && m_touched.size() <= clips.size() / FULL_SWEEP_DIVISOR) {
+        if (!m_touched.empty()) {
+            revalidateTouched(index);
+        }
+        return m_overlaps;
+    }
+
+    m_overlaps.clear();
+    findOverlaps(clips, m_overlaps);
+    m_touched.clear();
+    m_valid = true;
+    return m_overlaps;
+}
+
+void OverlapValidator::revalidateTouched(const TrackIndexMap& index) {
+    auto isTouched = [this](const VideoClip* clip) { return m_touched.count(clip) > 0; };
+
+    m_overlaps.erase(std::remove_if(m_overlaps.begin(), m_overlaps.end(),
+                                    [&](const ClipOverlap& o) {
+                                        return isTouched(o.first.get()) || isTouched(o.second.get());
+                                    }),
+                     m_overlaps.end());
+
+    ClipList candidates;
+    for (const auto& [key, clip] : m_touched) {
+        if (!clip) continue;
+
+        auto it = index.find(clip->getTrackIndex());
+        if (it == index.end()) continue;
+
+        candidates.clear();
+        it->second.queryRange(clip->getStartPosition(), clip->getEndPosition(), candidates);
+        for (const auto& other : candidates) {
+            if (!other || other == clip) continue;
+            // A pair of touched clips is reported once, from the lower address
+            if (isTouched(other.get()) && std::less<const VideoClip*>()(other.get(), key)) continue;
+            if (spansIntersect(*clip, *other)) {
+                m_overlaps.push_back(makeOverlap(clip, other));
+            }
+        }
+    }
+
+    sortOverlaps(m_overlaps.begin(), m_overlaps.end());
+    m_touched.clear();
+}
+
+} // namespace models
+} // namespace clipforge
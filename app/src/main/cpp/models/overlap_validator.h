@@ -0,0 +1,104 @@
+#ifndef CLIPFORGE_OVERLAP_VALIDATOR_H
+#define CLIPFORGE_OVERLAP_VALIDATOR_H
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "video_clip.h"
+#include "timeline_index.h"
+
+namespace clipforge {
+namespace models {
+
+/**
+ * @struct ClipOverlap
+ * @brief Two clips on the same track whose spans intersect
+ */
+struct ClipOverlap {
+    std::shared_ptr<VideoClip> first;   // Clip starting first
+    std::shared_ptr<VideoClip> second;  // Clip starting inside first
+    int32_t trackIndex = 0;             // Track both clips are on
+    int64_t start = 0;                  // Start of the shared span (ms)
+    int64_t end = 0;                    // End of the shared span (ms, exclusive)
+};
+
+/**
+ * @class OverlapValidator
+ * @brief Finds every same-track clip overlap, incrementally
+ *
+ * A full check sweeps each track in start order with a min-heap of the
+ * clips still running, so it costs O(n log n + k) for k overlaps, and
+ * O(n) in practice for a timeline whose tracks rarely overlap. The clip
+ * list must be sorted by (track, start) as Timeline keeps it; an
+ * unsorted list is sorted in a copy first.
+ *
+ * Between checks the owner reports the clips it added, moved or
+ * removed. The next validate() then drops the cached overlaps of those
+ * clips and re-queries only them against their track's interval index,
+ * in O(d log n + k) for d touched clips. Spans are treated as half-open,
+ * so clips that merely touch do not overlap.
+ */
+class OverlapValidator {
+public:
+    using ClipList = std::vector<std::shared_ptr<VideoClip>>;
+    using OverlapList = std::vector<ClipOverlap>;
+    using TrackIndexMap = std::map<int32_t, TrackIntervalIndex>;
+
+    OverlapValidator() = default;
+
+    /**
+     * @brief Find all overlaps in a clip list with a full sweep
+     * @param clips Clips, ideally sorted by track then start
+     * @param out Receives overlaps ordered by track, then by start of the later clip
+     */
+    static void findOverlaps(const ClipList& clips, OverlapList& out);
+
+    /**
+     * @brief Record a clip that was added or whose span or track changed
+     * @param clip Clip to recheck
+     */
+    void markTouched(const std::shared_ptr<VideoClip>& clip);
+
+    /**
+     * @brief Record a clip that was removed
+     * @param clip Removed clip
+     */
+    void markRemoved(const VideoClip* clip);
+
+    /**
+     * @brief Force a full sweep on the next validate()
+     */
+    void invalidate();
+
+    /**
+     * @brief Bring the overlap list up to date
+     * @param clips Current clips, sorted by track then start
+     * @param index Current per-track interval indexes
+     * @return All overlaps, ordered as findOverlaps() orders them
+     */
+    const OverlapList& validate(const ClipList& clips, const TrackIndexMap& index);
+
+    /**
+     * @brief Check if validate() would only revisit touched clips
+     * @return true if no full sweep is pending
+     */
+    [[nodiscard]] bool isIncremental() const { return m_valid; }
+
+private:
+    OverlapList m_overlaps;
+    std::unordered_map<const VideoClip*, std::shared_ptr<VideoClip>> m_touched; // Null when removed
+    bool m_valid = false;          // m_overlaps is correct for every untouched clip
+
+    /**
+     * @brief Recheck touched clips against their tracks
+     * @param index Current per-track interval indexes
+     */
+    void revalidateTouched(const TrackIndexMap& index);
+};
+
+} // namespace models
+} // namespace clipforge
+
+#endif // CLIPFORGE_OVERLAP_VALIDATOR_H
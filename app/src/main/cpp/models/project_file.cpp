@@ -0,0 +1,655 @@
+#include "project_file.h"
+#include "../utils/logger.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clipforge {
+namespace models {
+
+namespace {
+
+// ===== File format =====
+//
+// FileHeader, then the clip, effect, parameter and audio track tables
+// and the string pool, each starting on an 8-byte boundary. Records are
+// fixed size; strings are (offset, length) references into the pool,
+// which stores each distinct string once. A clip owns a contiguous run
+// of effects, an effect a run of parameters. Readers accept records
+// larger than they know, so fields can be appended without a version
+// bump. Native byte order, checked through byteOrderMark.
+// journalSequence is the last EditJournal record the snapshot includes.
+// checksum covers the header (with checksum zeroed) and every byte up to
+// the end of the string pool, so corruption inside a record is caught
+// on open rather than loaded as data.
+
+constexpr char MAGIC[4] = {'C', 'F', 'P', 'J'};
+constexpr uint32_t FORMAT_VERSION = 3;
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+constexpr uint32_t FLAG_HARDWARE_ACCEL = 1u << 0;
+
+constexpr uint32_t TRACK_ENABLED = 1u << 0;
+constexpr uint32_t TRACK_MUTED = 1u << 1;
+constexpr uint32_t TRACK_SOLO = 1u << 2;
+constexpr uint32_t TRACK_LOCKED = 1u << 3;
+
+struct StringRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct TableHeader {
+    uint64_t offset;
+    uint64_t count;
+    uint32_t recordSize;
+    uint32_t reserved;
+};
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t flags;
+    int32_t width;
+    int32_t height;
+    float frameRate;
+    int32_t maxTracks;
+    StringRef colorSpace;
+    int64_t currentPosition;
+    uint64_t journalSequence;
+    TableHeader clips;
+    TableHeader effects;
+    TableHeader parameters;
+    TableHeader audioTracks;
+    uint64_t stringOffset;
+    uint64_t stringBytes;
+    uint64_t checksum;
+};
+
+struct ClipRecord {
+    int64_t startPosition;
+    int64_t duration;
+    int64_t trimStart;
+    int64_t trimEnd;
+    int64_t sourceFileSize;
+    int64_t sourceDuration;
+    int64_t sourceBitRate;
+    StringRef id;
+    StringRef name;
+    StringRef sourceFile;
+    StringRef codecName;
+    StringRef mimeType;
+    int32_t trackIndex;
+    float speed;
+    float volume;
+    int32_t sourceWidth;
+    int32_t sourceHeight;
+    float sourceFrameRate;
+    uint32_t firstEffect;
+    uint32_t effectCount;
+};
+
+struct EffectRecord {
+    uint32_t type;
+    StringRef name;
+    float intensity;
+    uint32_t enabled;
+    uint32_t firstParameter;
+    uint32_t parameterCount;
+    uint32_t reserved;
+};
+
+struct ParameterRecord {
+    StringRef name;
+    float value;
+    float minValue;
+    float maxValue;
+    float defaultValue;
+};
+
+struct AudioTrackRecord {
+    int64_t bitRate;
+    int64_t duration;
+    StringRef id;
+    StringRef name;
+    StringRef type;
+    StringRef sourceFile;
+    StringRef codecName;
+    uint32_t flags;
+    float volume;
+    float pan;
+    float bass;
+    float midrange;
+    float treble;
+    float reverb;
+    float compression;
+    float pitchShift;
+    int32_t sampleRate;
+    int32_t channels;
+    float peakLevel;
+    float rmsLevel;
+    uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable_v<ClipRecord> && sizeof(ClipRecord) % 8 == 0);
+static_assert(std::is_trivially_copyable_v<EffectRecord> && sizeof(EffectRecord) % 8 == 0);
+static_assert(std::is_trivially_copyable_v<ParameterRecord> && sizeof(ParameterRecord) % 8 == 0);
+static_assert(std::is_trivially_copyable_v<AudioTrackRecord> && sizeof(AudioTrackRecord) % 8 == 0);
+
+constexpr auto LAST_EFFECT_TYPE = static_cast<uint32_t>(EffectType::SPECIAL_VIGNETTE);
+
+size_t alignUp(size_t value) {
+    return (value + 7) & ~size_t{7};
+}
+
+/**
+ * @brief 64-bit checksum of a byte range
+ *
+ * FNV-style multiply-xor over 8-byte words in four independent lanes,
+ * so a large file hashes at memory speed instead of one multiply per
+ * byte. Each step is invertible, so a change to any single word always
+ * changes the result.
+ */
+uint64_t checksum(const uint8_t* data, size_t length, uint64_t seed) {
+    constexpr uint64_t PRIME = 0x100000001b3ULL;
+    uint64_t lanes[4] = {seed ^ 0xcbf29ce484222325ULL, seed ^ 0x84222325cbf29ce4ULL,
+                         seed ^ 0x9e3779b97f4a7c15ULL, seed ^ 0xc2b2ae3d27d4eb4fULL};
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            uint64_t word;
+            std::memcpy(&word, data + i + lane * 8, sizeof(word));
+            lanes[lane] = (lanes[lane] ^ word) * PRIME;
+        }
+    }
+    for (; i < length; ++i) {
+        lanes[0] = (lanes[0] ^ data[i]) * PRIME;
+    }
+
+    uint64_t hash = length;
+    for (uint64_t lane : lanes) {
+        hash = (hash ^ lane) * PRIME;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+uint64_t checksumFile(const uint8_t* base, const FileHeader& header) {
+    FileHeader unsummed = header;
+    unsummed.checksum = 0;
+    uint64_t seed = checksum(reinterpret_cast<const uint8_t*>(&unsummed), sizeof(unsummed), 0);
+    size_t end = static_cast<size_t>(header.stringOffset + header.stringBytes);
+    return checksum(base + sizeof(FileHeader), end - sizeof(FileHeader), seed);
+}
+
+bool syncFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = fsync(fd) == 0;
+    close(fd);
+    return synced;
+}
+
+/**
+ * @class StringPool
+ * @brief Interns strings for the pool section
+ */
+class StringPool {
+public:
+    StringRef intern(const std::string& value) {
+        auto it = m_refs.find(value);
+        if (it != m_refs.end()) {
+            return it->second;
+        }
+
+        StringRef ref{static_cast<uint32_t>(m_bytes.size()), static_cast<uint32_t>(value.size())};
+        m_bytes += value;
+        m_refs.emplace(value, ref);
+        return ref;
+    }
+
+    [[nodiscard]] const std::string& getBytes() const { return m_bytes; }
+
+private:
+    std::string m_bytes;
+    std::unordered_map<std::string, StringRef> m_refs;
+};
+
+template <typename Record>
+TableHeader makeTable(size_t& offset, const std::vector<Record>& records) {
+    TableHeader table{};
+    table.offset = offset;
+    table.count = records.size();
+    table.recordSize = sizeof(Record);
+    offset = alignUp(offset + records.size() * sizeof(Record));
+    return table;
+}
+
+} // namespace
+
+// ===== ProjectFileWriter Implementation =====
+
+bool ProjectFileWriter::write(const std::string& projectPath, const Timeline& timeline,
+                              uint64_t journalSequence) {
+    StringPool strings;
+    std::vector<ClipRecord> clips;
+    std::vector<EffectRecord> effects;
+    std::vector<ParameterRecord> parameters;
+    std::vector<AudioTrackRecord> audioTracks;
+
+    clips.reserve(timeline.getClipCount());
+    for (const auto& clip : timeline.getAllClips()) {
+        if (!clip) continue;
+
+        const VideoClipMetadata& metadata = clip->getMetadata();
+        ClipRecord record{};
+        record.startPosition = clip->getStartPosition();
+        record.duration = clip->getDuration();
+        record.trimStart = clip->getTrimStart();
+        record.trimEnd = clip->getTrimEnd();
+        record.sourceFileSize = metadata.fileSize;
+        record.sourceDuration = metadata.duration;
+        record.sourceBitRate = metadata.bitRate;
+        record.id = strings.intern(clip->getId());
+        record.name = strings.intern(clip->getName());
+        record.sourceFile = strings.intern(metadata.sourceFile);
+        record.codecName = strings.intern(metadata.codecName);
+        record.mimeType = strings.intern(metadata.mimeType);
+        record.trackIndex = clip->getTrackIndex();
+        record.speed = clip->getSpeed();
+        record.volume = clip->getVolume();
+        record.sourceWidth = metadata.width;
+        record.sourceHeight = metadata.height;
+        record.sourceFrameRate = metadata.frameRate;
+        record.firstEffect = static_cast<uint32_t>(effects.size());
+
+        for (const auto& effect : clip->getEffects()) {
+            if (!effect || !effect->isSerializable()) continue;
+
+            EffectRecord effectRecord{};
+            effectRecord.type = static_cast<uint32_t>(effect->getType());
+            effectRecord.name = strings.intern(effect->getName());
+            effectRecord.intensity = effect->getIntensity();
+            effectRecord.enabled = effect->isEnabled() ? 1 : 0;
+            effectRecord.firstParameter = static_cast<uint32_t>(parameters.size());
+
+            for (const auto& parameter : effect->getParameters()) {
+                parameters.push_back({strings.intern(parameter.name), parameter.value,
+                                      parameter.minValue, parameter.maxValue, parameter.defaultValue});
+            }
+            effectRecord.parameterCount = static_cast<uint32_t>(parameters.size()) - effectRecord.firstParameter;
+            effects.push_back(effectRecord);
+        }
+        record.effectCount = static_cast<uint32_t>(effects.size()) - record.firstEffect;
+        clips.push_back(record);
+    }
+
+    for (const auto& track : timeline.getAllAudioTracks()) {
+        if (!track) continue;
+
+        const AudioMetadata& metadata = track->getMetadata();
+        AudioTrackRecord record{};
+        record.bitRate = metadata.bitRate;
+        record.duration = metadata.duration;
+        record.id = strings.intern(track->getId());
+        record.name = strings.intern(track->getName());
+        record.type = strings.intern(track->getType());
+        record.sourceFile = strings.intern(track->getSourceFile());
+        record.codecName = strings.intern(metadata.codecName);
+        record.flags = (track->isEnabled() ? TRACK_ENABLED : 0) | (track->isMuted() ? TRACK_MUTED : 0) |
+                       (track->isSolo() ? TRACK_SOLO : 0) | (track->isLocked() ? TRACK_LOCKED : 0);
+        record.volume = track->getVolume();
+        record.pan = track->getPan();
+        record.bass = track->getBass();
+        record.midrange = track->getMidrange();
+        record.treble = track->getTreble();
+        record.reverb = track->getReverb();
+        record.compression = track->getCompression();
+        record.pitchShift = track->getPitchShift();
+        record.sampleRate = metadata.sampleRate;
+        record.channels = metadata.channels;
+        record.peakLevel = metadata.peakLevel;
+        record.rmsLevel = metadata.rmsLevel;
+        audioTracks.push_back(record);
+    }
+
+    // Lay out the file
+    const TimelineProperties& properties = timeline.getProperties();
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.flags = properties.useHardwareAccel ? FLAG_HARDWARE_ACCEL : 0;
+    header.width = properties.width;
+    header.height = properties.height;
+    header.frameRate = properties.frameRate;
+    header.maxTracks = properties.maxTracks;
+    header.colorSpace = strings.intern(properties.colorSpace);
+    header.currentPosition = timeline.getCurrentPosition();
+    header.journalSequence = journalSequence;
+
+    if (strings.getBytes().size() > UINT32_MAX) {
+        LOG_ERROR("ProjectFileWriter: string pool too large for %s", projectPath.c_str());
+        return false;
+    }
+
+    size_t offset = alignUp(sizeof(FileHeader));
+    header.clips = makeTable(offset, clips);
+    header.effects = makeTable(offset, effects);
+    header.parameters = makeTable(offset, parameters);
+    header.audioTracks = makeTable(offset, audioTracks);
+    header.stringOffset = offset;
+    header.stringBytes = strings.getBytes().size();
+
+    // Assemble the image in memory so the checksum can go in the header
+    std::string image(static_cast<size_t>(header.stringOffset + header.stringBytes), '\0');
+    auto* bytes = reinterpret_cast<uint8_t*>(image.data());
+    auto copyTable = [bytes](const TableHeader& table, const void* records) {
+        if (table.count > 0) {
+            std::memcpy(bytes + table.offset, records, static_cast<size_t>(table.count * table.recordSize));
+        }
+    };
+    copyTable(header.clips, clips.data());
+    copyTable(header.effects, effects.data());
+    copyTable(header.parameters, parameters.data());
+    copyTable(header.audioTracks, audioTracks.data());
+    std::memcpy(bytes + header.stringOffset, strings.getBytes().data(), static_cast<size_t>(header.stringBytes));
+    header.checksum = checksumFile(bytes, header);
+    std::memcpy(bytes, &header, sizeof(header));
+
+    std::string tempPath = projectPath + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_ERROR("ProjectFileWriter: cannot create %s", tempPath.c_str());
+        return false;
+    }
+    file.write(image.data(), static_cast<std::streamsize>(image.size()));
+    file.close();
+
+    // Durable before the rename, as callers may drop their journal afterwards
+    if (!file || !syncFile(tempPath) || std::rename(tempPath.c_str(), projectPath.c_str()) != 0) {
+        LOG_ERROR("ProjectFileWriter: failed to write %s", projectPath.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    LOG_INFO("ProjectFileWriter: wrote %s (%zu clips, %zu bytes)", projectPath.c_str(), clips.size(),
+             image.size());
+    return true;
+}
+
+// ===== ProjectFile Implementation =====
+
+std::unique_ptr<ProjectFile> ProjectFile::open(const std::string& projectPath) {
+    int fd = ::open(projectPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_ERROR("ProjectFile: cannot open %s", projectPath.c_str());
+        return nullptr;
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+        close(fd);
+        LOG_WARNING("ProjectFile: %s is truncated", projectPath.c_str());
+        return nullptr;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR("ProjectFile: cannot map %s", projectPath.c_str());
+        return nullptr;
+    }
+
+    std::unique_ptr<ProjectFile> project(new ProjectFile());
+    project->m_mapping = mapping;
+    project->m_mappingSize = size;
+
+    const auto* base = static_cast<const uint8_t*>(mapping);
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION ||
+        header.byteOrderMark != BYTE_ORDER_MARK) {
+        LOG_WARNING("ProjectFile: %s has an unknown format", projectPath.c_str());
+        return nullptr;
+    }
+
+    auto mapTable = [&](const TableHeader& table, size_t minRecordSize, Table& out) {
+        if (table.recordSize < minRecordSize || table.offset % 8 != 0 || table.offset > size ||
+            table.count > (size - table.offset) / table.recordSize) {
+            return false;
+        }
+        out.records = base + table.offset;
+        out.count = static_cast<size_t>(table.count);
+        out.stride = table.recordSize;
+        return true;
+    };
+
+    if (!mapTable(header.clips, sizeof(ClipRecord), project->m_clips) ||
+        !mapTable(header.effects, sizeof(EffectRecord), project->m_effects) ||
+        !mapTable(header.parameters, sizeof(ParameterRecord), project->m_parameters) ||
+        !mapTable(header.audioTracks, sizeof(AudioTrackRecord), project->m_audioTracks) ||
+        header.stringOffset < sizeof(FileHeader) || header.stringOffset > size ||
+        header.stringBytes > size - header.stringOffset || checksumFile(base, header) != header.checksum) {
+        LOG_WARNING("ProjectFile: %s is corrupt", projectPath.c_str());
+        return nullptr;
+    }
+    project->m_strings = reinterpret_cast<const char*>(base + header.stringOffset);
+    project->m_stringBytes = static_cast<size_t>(header.stringBytes);
+
+    TimelineProperties& properties = project->m_properties;
+    std::string_view colorSpace;
+    properties.width = header.width;
+    properties.height = header.height;
+    properties.frameRate = header.frameRate;
+    properties.maxTracks = header.maxTracks;
+    properties.useHardwareAccel = (header.flags & FLAG_HARDWARE_ACCEL) != 0;
+    if (project->getString(header.colorSpace.offset, header.colorSpace.length, colorSpace)) {
+        properties.colorSpace = colorSpace;
+    }
+    project->m_currentPosition = header.currentPosition;
+    project->m_journalSequence = header.journalSequence;
+
+    return project;
+}
+
+ProjectFile::~ProjectFile() {
+    if (m_mapping) {
+        munmap(m_mapping, m_mappingSize);
+    }
+}
+
+bool ProjectFile::getString(uint32_t offset, uint32_t length, std::string_view& out) const {
+    if (offset > m_stringBytes || length > m_stringBytes - offset) {
+        return false;
+    }
+    out = std::string_view(m_strings + offset, length);
+    return true;
+}
+
+ProjectFile::ClipInfo ProjectFile::getClipInfo(size_t index) const {
+    ClipInfo info;
+    if (index >= m_clips.count) {
+        return info;
+    }
+
+    ClipRecord record;
+    std::memcpy(&record, m_clips.records + index * m_clips.stride, sizeof(record));
+    getString(record.id.offset, record.id.length, info.id);
+    getString(record.name.offset, record.name.length, info.name);
+    getString(record.sourceFile.offset, record.sourceFile.length, info.sourceFile);
+    info.startPosition = record.startPosition;
+    info.duration = record.duration;
+    info.trackIndex = record.trackIndex;
+    info.effectCount = record.effectCount;
+    return info;
+}
+
+std::shared_ptr<VideoClip> ProjectFile::loadClip(size_t index) const {
+    if (index >= m_clips.count) {
+        return nullptr;
+    }
+
+    ClipRecord record;
+    std::memcpy(&record, m_clips.records + index * m_clips.stride, sizeof(record));
+
+    std::string_view id, name, sourceFile, codecName, mimeType;
+    if (!getString(record.id.offset, record.id.length, id) ||
+        !getString(record.name.offset, record.name.length, name) ||
+        !getString(record.sourceFile.offset, record.sourceFile.length, sourceFile) ||
+        !getString(record.codecName.offset, record.codecName.length, codecName) ||
+        !getString(record.mimeType.offset, record.mimeType.length, mimeType) ||
+        uint64_t{record.firstEffect} + record.effectCount > m_effects.count) {
+        return nullptr;
+    }
+
+    auto clip = std::make_shared<VideoClip>(std::string(id), std::string(sourceFile));
+    clip->setName(std::string(name));
+    clip->setStartPosition(record.startPosition);
+    clip->setTrackIndex(record.trackIndex);
+    clip->setDuration(record.duration);
+    clip->setTrimStart(record.trimStart);
+    clip->setTrimEnd(record.trimEnd);
+    clip->setSpeed(record.speed);
+    clip->setVolume(record.volume);
+
+    VideoClipMetadata metadata;
+    metadata.sourceFile = sourceFile;
+    metadata.fileSize = record.sourceFileSize;
+    metadata.duration = record.sourceDuration;
+    metadata.width = record.sourceWidth;
+    metadata.height = record.sourceHeight;
+    metadata.frameRate = record.sourceFrameRate;
+    metadata.codecName = codecName;
+    metadata.bitRate = record.sourceBitRate;
+    metadata.mimeType = mimeType;
+    clip->setMetadata(metadata);
+
+    for (uint32_t i = 0; i < record.effectCount; i++) {
+        EffectRecord effectRecord;
+        std::memcpy(&effectRecord, m_effects.records + (size_t{record.firstEffect} + i) * m_effects.stride,
+                    sizeof(effectRecord));
+
+        std::string_view effectName;
+        if (effectRecord.type > LAST_EFFECT_TYPE ||
+            !getString(effectRecord.name.offset, effectRecord.name.length, effectName) ||
+            uint64_t{effectRecord.firstParameter} + effectRecord.parameterCount > m_parameters.count) {
+            return nullptr;
+        }
+
+        // Effect IDs are runtime-only and regenerated on load
+        auto effect = std::make_shared<Effect>(static_cast<EffectType>(effectRecord.type), std::string(effectName));
+        for (uint32_t p = 0; p < effectRecord.parameterCount; p++) {
+            ParameterRecord parameter;
+            std::memcpy(&parameter,
+                        m_parameters.records + (size_t{effectRecord.firstParameter} + p) * m_parameters.stride,
+                        sizeof(parameter));
+
+            std::string_view parameterName;
+            if (!getString(parameter.name.offset, parameter.name.length, parameterName)) {
+                return nullptr;
+            }
+            effect->addParameter(EffectParameter(std::string(parameterName), parameter.value, parameter.minValue,
+                                                 parameter.maxValue, parameter.defaultValue));
+        }
+        effect->setIntensity(effectRecord.intensity);
+        effect->setEnabled(effectRecord.enabled != 0);
+        clip->applyEffect(effect);
+    }
+
+    clip->clearChangesFlag();
+    return clip;
+}
+
+std::shared_ptr<AudioTrack> ProjectFile::loadAudioTrack(size_t index) const {
+    if (index >= m_audioTracks.count) {
+        return nullptr;
+    }
+
+    AudioTrackRecord record;
+    std::memcpy(&record, m_audioTracks.records + index * m_audioTracks.stride, sizeof(record));
+
+    std::string_view id, name, type, sourceFile, codecName;
+    if (!getString(record.id.offset, record.id.length, id) ||
+        !getString(record.name.offset, record.name.length, name) ||
+        !getString(record.type.offset, record.type.length, type) ||
+        !getString(record.sourceFile.offset, record.sourceFile.length, sourceFile) ||
+        !getString(record.codecName.offset, record.codecName.length, codecName)) {
+        return nullptr;
+    }
+
+    auto track = std::make_shared<AudioTrack>(std::string(id), std::string(name), std::string(type));
+    track->setSourceFile(std::string(sourceFile));
+    track->setEnabled((record.flags & TRACK_ENABLED) != 0);
+    track->setMuted((record.flags & TRACK_MUTED) != 0);
+    track->setSolo((record.flags & TRACK_SOLO) != 0);
+    track->setLocked((record.flags & TRACK_LOCKED) != 0);
+    track->setVolume(record.volume);
+    track->setPan(record.pan);
+    track->setBass(record.bass);
+    track->setMidrange(record.midrange);
+    track->setTreble(record.treble);
+    track->setReverb(record.reverb);
+    track->setCompression(record.compression);
+    track->setPitchShift(record.pitchShift);
+
+    AudioMetadata metadata;
+    metadata.sampleRate = record.sampleRate;
+    metadata.channels = record.channels;
+    metadata.bitRate = record.bitRate;
+    metadata.duration = record.duration;
+    metadata.peakLevel = record.peakLevel;
+    metadata.rmsLevel = record.rmsLevel;
+    metadata.codecName = codecName;
+    track->setMetadata(metadata);
+
+    track->clearChangesFlag();
+    return track;
+}
+
+bool ProjectFile::loadTimeline(Timeline& timeline) const {
+    timeline.clearClips();
+    timeline.clearAudioTracks();
+    timeline.setProperties(m_properties);
+
+    // One batch keeps the load linear in the number of clips
+    bool valid = true;
+    timeline.beginBatch();
+    for (size_t i = 0; i < m_clips.count && valid; i++) {
+        auto clip = loadClip(i);
+        valid = clip && timeline.addClip(std::move(clip));
+    }
+    timeline.commitBatch();
+
+    for (size_t i = 0; i < m_audioTracks.count && valid; i++) {
+        auto track = loadAudioTrack(i);
+        valid = track && timeline.addAudioTrack(std::move(track));
+    }
+
+    if (!valid) {
+        LOG_WARNING("ProjectFile: corrupt record, project not loaded");
+        timeline.clearClips();
+        timeline.clearAudioTracks();
+        return false;
+    }
+
+    timeline.setCurrentPosition(m_currentPosition);
+    timeline.clearChangesFlag();
+    return true;
+}
+
+} // namespace models
+} // namespace clipforge
@@ -0,0 +1,164 @@
+#ifndef CLIPFORGE_PROJECT_FILE_H
+#define CLIPFORGE_PROJECT_FILE_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include "timeline.h"
+
+namespace clipforge {
+namespace models {
+
+/**
+ * @class ProjectFileWriter
+ * @brief Writes a timeline as a binary project file
+ *
+ * The file holds fixed-size clip, effect, parameter and audio track
+ * tables plus one pool of interned strings, so ProjectFile can use it
+ * straight from a read-only mapping. Effects that are not serializable
+ * are skipped.
+ */
+class ProjectFileWriter {
+public:
+    /**
+     * @brief Write a project file
+     * @param projectPath Destination; written to a temporary file, then renamed
+     * @param timeline Timeline to save
+     * @param journalSequence Last EditJournal record included in the timeline
+     * @return true if the file was written and synced
+     */
+    static bool write(const std::string& projectPath, const Timeline& timeline,
+                      uint64_t journalSequence = 0);
+};
+
+/**
+ * @class ProjectFile
+ * @brief Read-only, memory-mapped project file
+ *
+ * Opening maps the file, checks the header and table bounds and
+ * verifies the content checksum in one sequential pass; no record is
+ * parsed. Clip summaries are read
+ * from the mapping on demand; full VideoClip and AudioTrack objects
+ * are only built by loadClip(), loadAudioTrack() or loadTimeline().
+ * Instances are immutable and safe to share between threads.
+ *
+ * Usage:
+ * @code
+ * auto project = ProjectFile::open(path);
+ * auto timeline = std::make_shared<Timeline>();
+ * if (project && project->loadTimeline(*timeline)) engine->setTimeline(timeline);
+ * @endcode
+ */
+class ProjectFile {
+public:
+    /**
+     * @struct ClipInfo
+     * @brief Clip fields read without building the clip
+     *
+     * Views point into the mapping and live as long as the ProjectFile.
+     */
+    struct ClipInfo {
+        std::string_view id;
+        std::string_view name;
+        std::string_view sourceFile;
+        int64_t startPosition = 0;
+        int64_t duration = 0;
+        int32_t trackIndex = 0;
+        uint32_t effectCount = 0;
+    };
+
+    /**
+     * @brief Map a project file
+     * @param projectPath File written by ProjectFileWriter
+     * @return Project, or nullptr if missing, of another version or corrupt
+     */
+    [[nodiscard]] static std::unique_ptr<ProjectFile> open(const std::string& projectPath);
+
+    /**
+     * @brief Destructor - unmaps the file
+     */
+    ~ProjectFile();
+
+    // Prevent copying
+    ProjectFile(const ProjectFile&) = delete;
+    ProjectFile& operator=(const ProjectFile&) = delete;
+
+    [[nodiscard]] const TimelineProperties& getProperties() const { return m_properties; }
+    [[nodiscard]] int64_t getCurrentPosition() const { return m_currentPosition; }
+    [[nodiscard]] uint64_t getJournalSequence() const { return m_journalSequence; }
+    [[nodiscard]] size_t getClipCount() const { return m_clips.count; }
+    [[nodiscard]] size_t getAudioTrackCount() const { return m_audioTracks.count; }
+
+    /**
+     * @brief Read a clip's summary from the mapping
+     * @param index Clip index, in timeline order
+     * @return Summary; empty if index is out of range
+     */
+    [[nodiscard]] ClipInfo getClipInfo(size_t index) const;
+
+    /**
+     * @brief Build one clip with its effects
+     * @param index Clip index, in timeline order
+     * @return Clip, or nullptr if index or the record is invalid
+     */
+    [[nodiscard]] std::shared_ptr<VideoClip> loadClip(size_t index) const;
+
+    /**
+     * @brief Build one audio track
+     * @param index Audio track index
+     * @return Track, or nullptr if index or the record is invalid
+     */
+    [[nodiscard]] std::shared_ptr<AudioTrack> loadAudioTrack(size_t index) const;
+
+    /**
+     * @brief Replace a timeline's contents with the project
+     * @param timeline Timeline to fill; cleared first
+     * @return false if a record is corrupt (timeline is left cleared)
+     *
+     * Clips are added in one batch and the timeline is marked saved.
+     */
+    bool loadTimeline(Timeline& timeline) const;
+
+private:
+    void* m_mapping = nullptr;
+    size_t m_mappingSize = 0;
+
+    TimelineProperties m_properties;
+    int64_t m_currentPosition = 0;
+    uint64_t m_journalSequence = 0;
+
+    /**
+     * @struct Table
+     * @brief One record table inside the mapping
+     */
+    struct Table {
+        const uint8_t* records = nullptr;
+        size_t count = 0;
+        size_t stride = 0;           // Record size in the file; newer versions may append fields
+    };
+
+    Table m_clips;
+    Table m_effects;
+    Table m_parameters;
+    Table m_audioTracks;
+    const char* m_strings = nullptr;
+    size_t m_stringBytes = 0;
+
+    ProjectFile() = default;
+
+    /**
+     * @brief Resolve a string pool reference
+     * @param offset Byte offset into the pool
+     * @param length Length in bytes
+     * @param out Receives the string view
+     * @return false if the reference lies outside the pool
+     */
+    bool getString(uint32_t offset, uint32_t length, std::string_view& out) const;
+};
+
+} // namespace models
+} // namespace clipforge
+
+#endif // CLIPFORGE_PROJECT_FILE_H
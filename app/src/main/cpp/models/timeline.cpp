@@ -1,10 +1,30 @@
 #include "timeline.h"
+#include "timeline_snapshot.h"
+#include "../utils/id_generator.h"
 #include <chrono>
 #include <algorithm>
+#include <unordered_set>
 
 namespace clipforge {
 namespace models {
 
+namespace {
+
+// Effects are shared by pointer, so a copy that must not change gets its own
+std::shared_ptr<VideoClip> copyClip(const VideoClip& clip) {
+    auto copy = std::make_shared<VideoClip>(clip);
+    copy->setHandle(ClipHandle());
+    copy->getEffectChain().clear();
+    for (const auto& effect : clip.getEffects()) {
+        if (effect) {
+            copy->applyEffect(std::make_shared<Effect>(*effect));
+        }
+    }
+    return copy;
+}
+
+} // namespace
+
 // ============================================================================
 // Timeline Implementation
 // ============================================================================
@@ -27,134 +47,291 @@ void Timeline::setCurrentPosition(int64_t position) {
 }
 
 void Timeline::updateDuration() {
+    // Clips may have been edited in place, so rebuild ordering and index from scratch
+    sortClips();
+    rebuildIndex();
     calculateDuration();
+    m_overlapValidator.invalidate();
+    for (const auto& clip : m_clipList) {
+        markForSnapshot(clip);
+    }
+}
+
+void Timeline::beginBatch() {
+    ++m_batchDepth;
+}
+
+void Timeline::commitBatch() {
+    if (m_batchDepth == 0) return;
+    if (--m_batchDepth > 0) return;  // Only the outermost commit applies the batch
+    if (!m_batchDirty) return;
+
+    // Drop clips removed (or replaced under the same ID) during the batch.
+    // A clip removed and added again was appended a second time, so keep
+    // only its first entry.
+    if (m_batchRemovals > 0) {
+        std::unordered_set<const VideoClip*> kept;
+        kept.reserve(m_clipList.size());
+        m_clipList.erase(
+            std::remove_if(m_clipList.begin(), m_clipList.end(),
+                           [this, &kept](const std::shared_ptr<VideoClip>& clip) {
+                               return !m_clips.contains(clip->getHandle()) || !kept.insert(clip.get()).second;
+                           }),
+            m_clipList.end());
+    }
+
+    sortClips();
+    rebuildIndex();
+    calculateDuration();
+    m_overlapValidator.invalidate();
+    m_modifiedAt = getCurrentTimestamp();
+
+    m_batchDirty = false;
+    m_batchRemovals = 0;
 }
 
 bool Timeline::addClip(std::shared_ptr<VideoClip> clip) {
     if (!clip) return false;
 
     // Check if clip already exists
-    if (m_clipMap.find(clip->getId()) != m_clipMap.end()) {
+    auto [id, inserted] = m_clipIds.try_emplace(clip->getId());
+    if (!inserted) {
         return false;  // Clip already exists
     }
 
-    m_clipList.push_back(clip);
-    m_clipMap[clip->getId()] = clip;
+    id->second = m_clips.insert(clip);
+    clip->setHandle(id->second);
+    m_modified = true;
+    markForSnapshot(clip);
 
-    // Resort and update duration
-    sortClips();
+    if (m_batchDepth > 0) {
+        // Ordering, index and duration are rebuilt once in commitBatch()
+        m_clipList.push_back(clip);
+        m_batchDirty = true;
+        return true;
+    }
+
+    insertIntoList(clip);
+    indexClip(clip);
     calculateDuration();
-    m_modified = true;
+    m_overlapValidator.markTouched(clip);
     m_modifiedAt = getCurrentTimestamp();
 
     return true;
 }
 
-bool Timeline::removeClip(const std::string& clipId) {
-    auto it = m_clipMap.find(clipId);
-    if (it == m_clipMap.end()) {
+bool Timeline::removeClip(ClipHandle handle) {
+    auto* slot = m_clips.get(handle);
+    if (!slot) {
         return false;  // Clip not found
     }
 
-    // Remove from list
-    auto listIt = std::find_if(m_clipList.begin(), m_clipList.end(),
-                              [&clipId](const std::shared_ptr<VideoClip>& clip) {
-                                  return clip && clip->getId() == clipId;
-                              });
+    // Keep the clip alive until it is unlinked everywhere
+    auto clip = std::move(*slot);
+    m_clips.erase(handle);
+    m_clipIds.erase(clip->getId());
+    clip->setHandle(ClipHandle());
+    m_modified = true;
+    markRemovedForSnapshot(clip.get());
 
-    if (listIt != m_clipList.end()) {
-        m_clipList.erase(listIt);
+    if (m_batchDepth > 0) {
+        // List is compacted against the store in commitBatch()
+        m_batchDirty = true;
+        ++m_batchRemovals;
+        return true;
     }
 
-    // Remove from map
-    m_clipMap.erase(it);
+    // Remove from list and index
+    eraseFromList(clip.get());
+    unindexClip(clip.get());
+    m_overlapValidator.markRemoved(clip.get());
 
-    // Update duration
     calculateDuration();
+    m_modifiedAt = getCurrentTimestamp();
+
+    return true;
+}
+
+bool Timeline::moveClip(ClipHandle handle, int64_t newStartPosition, int32_t newTrackIndex) {
+    auto* slot = m_clips.get(handle);
+    if (!slot) {
+        return false;
+    }
+
+    const auto& clip = *slot;
     m_modified = true;
+    markForSnapshot(clip);
+
+    if (m_batchDepth > 0) {
+        clip->setStartPosition(newStartPosition);
+        clip->setTrackIndex(newTrackIndex);
+        m_batchDirty = true;
+        return true;
+    }
+
+    // Unlink using the old span, then reinsert at the new one
+    eraseFromList(clip.get());
+    unindexClip(clip.get());
+    clip->setStartPosition(newStartPosition);
+    clip->setTrackIndex(newTrackIndex);
+    insertIntoList(clip);
+    indexClip(clip);
+    m_overlapValidator.markTouched(clip);
+
+    calculateDuration();
     m_modifiedAt = getCurrentTimestamp();
 
     return true;
 }
 
-std::shared_ptr<VideoClip> Timeline::getClip(const std::string& clipId) const {
-    auto it = m_clipMap.find(clipId);
-    if (it != m_clipMap.end()) {
-        return it->second;
+bool Timeline::refreshClip(ClipHandle handle) {
+    auto* slot = m_clips.get(handle);
+    if (!slot) {
+        return false;
     }
-    return nullptr;
+
+    const auto& clip = *slot;
+    m_modified = true;
+    markForSnapshot(clip);
+
+    if (m_batchDepth > 0) {
+        m_batchDirty = true;
+        return true;
+    }
+
+    eraseFromList(clip.get());
+    unindexClip(clip.get());
+    insertIntoList(clip);
+    indexClip(clip);
+    m_overlapValidator.markTouched(clip);
+
+    calculateDuration();
+    m_modifiedAt = getCurrentTimestamp();
+
+    return true;
+}
+
+bool Timeline::touchClip(ClipHandle handle) {
+    auto* slot = m_clips.get(handle);
+    if (!slot) {
+        return false;
+    }
+
+    markForSnapshot(*slot);
+    m_modified = true;
+    m_modifiedAt = getCurrentTimestamp();
+    return true;
+}
+
+std::shared_ptr<VideoClip> Timeline::getClip(ClipHandle handle) const {
+    auto* slot = m_clips.get(handle);
+    return slot ? *slot : nullptr;
+}
+
+ClipHandle Timeline::findClip(const std::string& clipId) const {
+    auto it = m_clipIds.find(clipId);
+    return it != m_clipIds.end() ? it->second : ClipHandle();
 }
 
 Timeline::ClipList Timeline::getClipsOnTrack(int32_t trackIndex) const {
     ClipList result;
-    for (const auto& clip : m_clipList) {
-        if (clip && clip->getTrackIndex() == trackIndex) {
-            result.push_back(clip);
-        }
+    auto it = m_trackIndex.find(trackIndex);
+    if (it != m_trackIndex.end()) {
+        it->second.collect(result);
     }
     return result;
 }
 
 Timeline::ClipList Timeline::getClipsAtTime(int64_t timeMs) const {
     ClipList result;
-    for (const auto& clip : m_clipList) {
-        if (clip &&
-            clip->getStartPosition() <= timeMs &&
-            timeMs <= clip->getEndPosition()) {
-            result.push_back(clip);
-        }
+    for (const auto& [track, index] : m_trackIndex) {
+        index.queryPoint(timeMs, result);
+    }
+    return result;
+}
+
+Timeline::ClipList Timeline::getClipsInRange(int64_t startMs, int64_t endMs) const {
+    ClipList result;
+    for (const auto& [track, index] : m_trackIndex) {
+        index.queryRange(startMs, endMs, result);
     }
     return result;
 }
 
 void Timeline::clearClips() {
+    for (const auto& clip : m_clips) {
+        clip->setHandle(ClipHandle());
+    }
     m_clipList.clear();
-    m_clipMap.clear();
+    m_clips.clear();
+    m_clipIds.clear();
+    m_trackIndex.clear();
+    m_overlapValidator.invalidate();
+    m_clipTree = ClipTree();
+    m_frozenClips.clear();
+    m_snapshotPending.clear();
+    m_snapshot.reset();
     m_selectedClipId.clear();
     m_totalDuration = 0;
     m_modified = true;
     m_modifiedAt = getCurrentTimestamp();
 }
 
-std::string Timeline::addAudioTrack(const std::string& name, const std::string& type) {
-    auto track = std::make_shared<AudioTrack>(generateId(), name, type);
-    m_audioTrackList.push_back(track);
-    m_audioTrackMap[track->getId()] = track;
+AudioTrackHandle Timeline::addAudioTrack(const std::string& name, const std::string& type) {
+    auto track = std::make_shared<AudioTrack>(utils::generateId("tl"), name, type);
+    addAudioTrack(track);
+    return track->getHandle();
+}
+
+bool Timeline::addAudioTrack(std::shared_ptr<AudioTrack> track) {
+    if (!track) {
+        return false;
+    }
+    auto [id, inserted] = m_audioTrackIds.try_emplace(track->getId());
+    if (!inserted) {
+        return false;
+    }
+
+    id->second = m_audioTracks.insert(track);
+    track->setHandle(id->second);
+    m_audioTrackList.push_back(std::move(track));
+    markAudioTracksForSnapshot();
     m_modified = true;
     m_modifiedAt = getCurrentTimestamp();
-    return track->getId();
+    return true;
 }
 
-bool Timeline::removeAudioTrack(const std::string& trackId) {
-    auto it = m_audioTrackMap.find(trackId);
-    if (it == m_audioTrackMap.end()) {
+bool Timeline::removeAudioTrack(AudioTrackHandle handle) {
+    auto* slot = m_audioTracks.get(handle);
+    if (!slot) {
         return false;
     }
 
     // Remove from list
-    auto listIt = std::find_if(m_audioTrackList.begin(), m_audioTrackList.end(),
-                              [&trackId](const std::shared_ptr<AudioTrack>& track) {
-                                  return track && track->getId() == trackId;
-                              });
-
+    auto listIt = std::find(m_audioTrackList.begin(), m_audioTrackList.end(), *slot);
     if (listIt != m_audioTrackList.end()) {
         m_audioTrackList.erase(listIt);
     }
 
-    // Remove from map
-    m_audioTrackMap.erase(it);
+    // Remove from store
+    (*slot)->setHandle(AudioTrackHandle());
+    m_audioTrackIds.erase((*slot)->getId());
+    m_audioTracks.erase(handle);
+    markAudioTracksForSnapshot();
     m_modified = true;
     m_modifiedAt = getCurrentTimestamp();
 
     return true;
 }
 
-std::shared_ptr<AudioTrack> Timeline::getAudioTrack(const std::string& trackId) const {
-    auto it = m_audioTrackMap.find(trackId);
-    if (it != m_audioTrackMap.end()) {
-        return it->second;
-    }
-    return nullptr;
+std::shared_ptr<AudioTrack> Timeline::getAudioTrack(AudioTrackHandle handle) const {
+    auto* slot = m_audioTracks.get(handle);
+    return slot ? *slot : nullptr;
+}
+
+AudioTrackHandle Timeline::findAudioTrack(const std::string& trackId) const {
+    auto it = m_audioTrackIds.find(trackId);
+    return it != m_audioTrackIds.end() ? it->second : AudioTrackHandle();
 }
 
 std::shared_ptr<AudioTrack> Timeline::getMainAudioTrack() const {
@@ -166,9 +343,25 @@ std::shared_ptr<AudioTrack> Timeline::getMainAudioTrack() const {
     return nullptr;
 }
 
+bool Timeline::touchAudioTrack(AudioTrackHandle handle) {
+    if (!m_audioTracks.contains(handle)) {
+        return false;
+    }
+
+    markAudioTracksForSnapshot();
+    m_modified = true;
+    m_modifiedAt = getCurrentTimestamp();
+    return true;
+}
+
 void Timeline::clearAudioTracks() {
+    for (const auto& track : m_audioTracks) {
+        track->setHandle(AudioTrackHandle());
+    }
     m_audioTrackList.clear();
-    m_audioTrackMap.clear();
+    m_audioTracks.clear();
+    m_audioTrackIds.clear();
+    markAudioTracksForSnapshot();
     m_modified = true;
     m_modifiedAt = getCurrentTimestamp();
 }
@@ -185,7 +378,7 @@ std::shared_ptr<VideoClip> Timeline::getSelectedClip() const {
     if (m_selectedClipId.empty()) {
         return nullptr;
     }
-    return getClip(m_selectedClipId);
+    return getClip(findClip(m_selectedClipId));
 }
 
 bool Timeline::isValid() const {
@@ -205,47 +398,23 @@ bool Timeline::isValid() const {
 }
 
 bool Timeline::hasOverlappingClips() const {
-    for (size_t i = 0; i < m_clipList.size(); ++i) {
-        for (size_t j = i + 1; j < m_clipList.size(); ++j) {
-            const auto& clip1 = m_clipList[i];
-            const auto& clip2 = m_clipList[j];
-
-            if (!clip1 || !clip2) continue;
-
-            // Only check overlaps on same track
-            if (clip1->getTrackIndex() != clip2->getTrackIndex()) {
-                continue;
-            }
+    return !getOverlaps().empty();
+}
 
-            // Check if clips overlap
-            if (clip1->getStartPosition() < clip2->getEndPosition() &&
-                clip2->getStartPosition() < clip1->getEndPosition()) {
-                return true;
-            }
-        }
-    }
-    return false;
+const OverlapValidator::OverlapList& Timeline::getOverlaps() const {
+    return m_overlapValidator.validate(m_clipList, m_trackIndex);
 }
 
 bool Timeline::getFirstOverlap(std::shared_ptr<VideoClip>& outClip1,
                                std::shared_ptr<VideoClip>& outClip2) const {
-    for (size_t i = 0; i < m_clipList.size(); ++i) {
-        for (size_t j = i + 1; j < m_clipList.size(); ++j) {
-            const auto& clip1 = m_clipList[i];
-            const auto& clip2 = m_clipList[j];
-
-            if (!clip1 || !clip2) continue;
-            if (clip1->getTrackIndex() != clip2->getTrackIndex()) continue;
-
-            if (clip1->getStartPosition() < clip2->getEndPosition() &&
-                clip2->getStartPosition() < clip1->getEndPosition()) {
-                outClip1 = clip1;
-                outClip2 = clip2;
-                return true;
-            }
-        }
+    const auto& overlaps = getOverlaps();
+    if (overlaps.empty()) {
+        return false;
     }
-    return false;
+
+    outClip1 = overlaps.front().first;
+    outClip2 = overlaps.front().second;
+    return true;
 }
 
 int32_t Timeline::getMaxTrackInUse() const {
@@ -258,6 +427,88 @@ int32_t Timeline::getMaxTrackInUse() const {
     return maxTrack;
 }
 
+std::shared_ptr<const TimelineSnapshot> Timeline::snapshot() const {
+    if (m_snapshot) {
+        return m_snapshot;
+    }
+
+    // Path-copy only the clips edited since the last snapshot
+    for (const auto& [key, clip] : m_snapshotPending) {
+        auto frozen = m_frozenClips.find(key);
+        if (frozen != m_frozenClips.end() && (!clip || !ClipTree::sameKey(*frozen->second, *clip))) {
+            m_clipTree = m_clipTree.erase(*frozen->second);
+        }
+
+        if (clip) {
+            ClipTree::ClipPtr copy = copyClip(*clip);
+            m_clipTree = m_clipTree.insert(copy);
+            m_frozenClips[key] = std::move(copy);
+        } else if (frozen != m_frozenClips.end()) {
+            m_frozenClips.erase(frozen);
+        }
+    }
+    m_snapshotPending.clear();
+
+    // Audio tracks are few; refreeze them all on any change
+    if (m_audioTracksChanged) {
+        m_frozenAudioTracks.clear();
+        for (const auto& track : m_audioTrackList) {
+            if (track) {
+                auto copy = std::make_shared<AudioTrack>(*track);
+                copy->setHandle(AudioTrackHandle());
+                m_frozenAudioTracks.push_back(std::move(copy));
+            }
+        }
+        m_audioTracksChanged = false;
+    }
+
+    m_snapshot = std::shared_ptr<const TimelineSnapshot>(
+        new TimelineSnapshot(m_properties, m_totalDuration, m_clipTree, m_frozenAudioTracks));
+    return m_snapshot;
+}
+
+void Timeline::restore(const std::shared_ptr<const TimelineSnapshot>& target) {
+    // Also brings the tree up to date with the live clips
+    if (!target || snapshot() == target) return;
+
+    ClipTree::ClipList removed, added;
+    ClipTree::diff(m_clipTree, target->getClipTree(),
+                   [&](const ClipTree::ClipPtr& from, const ClipTree::ClipPtr& to) {
+                       if (from) removed.push_back(from);
+                       if (to) added.push_back(to);
+                   });
+
+    // Removals first: a moved clip is removed under its old key and re-added
+    beginBatch();
+    for (const auto& frozen : removed) {
+        if (auto clip = getClip(findClip(frozen->getId()))) {
+            m_frozenClips.erase(clip.get());
+            removeClip(clip->getHandle());
+        }
+    }
+    for (const auto& frozen : added) {
+        auto clip = copyClip(*frozen);
+        m_frozenClips[clip.get()] = frozen;
+        addClip(std::move(clip));
+    }
+    commitBatch();
+
+    clearAudioTracks();
+    for (const auto& frozen : target->getAllAudioTracks()) {
+        addAudioTrack(std::make_shared<AudioTrack>(*frozen));
+    }
+
+    // The live state now matches the target exactly
+    m_properties = target->getProperties();
+    m_clipTree = target->getClipTree();
+    m_snapshotPending.clear();
+    m_frozenAudioTracks = target->getAllAudioTracks();
+    m_audioTracksChanged = false;
+    m_snapshot = target;
+    m_modified = true;
+    m_modifiedAt = getCurrentTimestamp();
+}
+
 void Timeline::clearChangesFlag() {
     m_modified = false;
     for (const auto& clip : m_clipList) {
@@ -272,29 +523,112 @@ void Timeline::clearChangesFlag() {
     }
 }
 
+bool Timeline::clipLess(const std::shared_ptr<VideoClip>& a, const std::shared_ptr<VideoClip>& b) {
+    if (!a || !b) return false;
+    // First sort by track, then by start position
+    if (a->getTrackIndex() != b->getTrackIndex()) {
+        return a->getTrackIndex() < b->getTrackIndex();
+    }
+    return a->getStartPosition() < b->getStartPosition();
+}
+
 void Timeline::sortClips() {
-    std::sort(m_clipList.begin(), m_clipList.end(),
-             [](const std::shared_ptr<VideoClip>& a, const std::shared_ptr<VideoClip>& b) {
-                 if (!a || !b) return false;
-                 // First sort by track, then by start position
-                 if (a->getTrackIndex() != b->getTrackIndex()) {
-                     return a->getTrackIndex() < b->getTrackIndex();
-                 }
-                 return a->getStartPosition() < b->getStartPosition();
-             });
+    // Stable so clips sharing a start keep their insertion order
+    std::stable_sort(m_clipList.begin(), m_clipList.end(), clipLess);
 }
 
-void Timeline::calculateDuration() {
-    m_totalDuration = 0;
+void Timeline::insertIntoList(const std::shared_ptr<VideoClip>& clip) {
+    auto it = std::upper_bound(m_clipList.begin(), m_clipList.end(), clip, clipLess);
+    m_clipList.insert(it, clip);
+}
 
+void Timeline::eraseFromList(const VideoClip* clip) {
+    // Binary search on the clip's current (track, start) key
+    auto it = std::lower_bound(m_clipList.begin(), m_clipList.end(), clip,
+                               [](const std::shared_ptr<VideoClip>& a, const VideoClip* b) {
+                                   if (a->getTrackIndex() != b->getTrackIndex()) {
+                                       return a->getTrackIndex() < b->getTrackIndex();
+                                   }
+                                   return a->getStartPosition() < b->getStartPosition();
+                               });
+    while (it != m_clipList.end() && it->get() != clip &&
+           (*it)->getTrackIndex() == clip->getTrackIndex() &&
+           (*it)->getStartPosition() == clip->getStartPosition()) {
+        ++it;
+    }
+
+    // Key was changed in place since insertion; fall back to a scan
+    if (it == m_clipList.end() || it->get() != clip) {
+        it = std::find_if(m_clipList.begin(), m_clipList.end(),
+                          [clip](const std::shared_ptr<VideoClip>& c) { return c.get() == clip; });
+    }
+
+    if (it != m_clipList.end()) {
+        m_clipList.erase(it);
+    }
+}
+
+void Timeline::rebuildIndex() {
+    std::map<int32_t, ClipList> byTrack;
     for (const auto& clip : m_clipList) {
         if (clip) {
-            int64_t clipEnd = clip->getEndPosition();
-            if (clipEnd > m_totalDuration) {
-                m_totalDuration = clipEnd;
+            byTrack[clip->getTrackIndex()].push_back(clip);
+        }
+    }
+
+    m_trackIndex.clear();
+    for (const auto& [track, clips] : byTrack) {
+        m_trackIndex[track].assign(clips);
+    }
+}
+
+void Timeline::indexClip(const std::shared_ptr<VideoClip>& clip) {
+    if (!clip) return;
+    m_trackIndex[clip->getTrackIndex()].insert(clip);
+}
+
+void Timeline::unindexClip(const VideoClip* clip) {
+    if (!clip) return;
+
+    // The clip's track may have been changed in place; fall back to a full search
+    auto it = m_trackIndex.find(clip->getTrackIndex());
+    bool removed = it != m_trackIndex.end() && it->second.remove(clip);
+    if (!removed) {
+        for (it = m_trackIndex.begin(); it != m_trackIndex.end(); ++it) {
+            if (it->second.remove(clip)) {
+                removed = true;
+                break;
             }
         }
     }
+
+    if (removed && it->second.empty()) {
+        m_trackIndex.erase(it);
+    }
+}
+
+void Timeline::markForSnapshot(const std::shared_ptr<VideoClip>& clip) {
+    m_snapshotPending[clip.get()] = clip;
+    m_snapshot.reset();
+}
+
+void Timeline::markRemovedForSnapshot(const VideoClip* clip) {
+    m_snapshotPending[clip] = nullptr;
+    m_snapshot.reset();
+}
+
+void Timeline::markAudioTracksForSnapshot() {
+    m_audioTracksChanged = true;
+    m_snapshot.reset();
+}
+
+void Timeline::calculateDuration() {
+    m_totalDuration = 0;
+
+    // Each track index already tracks its latest end position
+    for (const auto& [track, index] : m_trackIndex) {
+        m_totalDuration = std::max(m_totalDuration, index.getMaxEnd());
+    }
 }
 
 int64_t Timeline::getCurrentTimestamp() {
@@ -303,14 +637,5 @@ int64_t Timeline::getCurrentTimestamp() {
     return duration_cast<milliseconds>(now.time_since_epoch()).count();
 }
 
-std::string Timeline::generateId() {
-    static unsigned int counter = 0;
-    std::string id = "tl_";
-    id += std::to_string(std::time(nullptr));
-    id += "_";
-    id += std::to_string(++counter);
-    return id;
-}
-
 } // namespace models
 } // namespace clipforge
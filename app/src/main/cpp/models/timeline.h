@@ -5,13 +5,20 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <map>
 #include <cstdint>
 #include "video_clip.h"
 #include "audio_track.h"
+#include "timeline_index.h"
+#include "overlap_validator.h"
+#include "clip_tree.h"
+#include "../utils/slot_map.h"
 
 namespace clipforge {
 namespace models {
 
+class TimelineSnapshot;
+
 /**
  * @struct TimelineProperties
  * @brief Properties of the timeline/project
@@ -39,8 +46,8 @@ class Timeline {
 public:
     using ClipList = std::vector<std::shared_ptr<VideoClip>>;
     using AudioTrackList = std::vector<std::shared_ptr<AudioTrack>>;
-    using ClipMap = std::unordered_map<std::string, std::shared_ptr<VideoClip>>;
-    using AudioTrackMap = std::unordered_map<std::string, std::shared_ptr<AudioTrack>>;
+    using ClipStore = utils::SlotMap<std::shared_ptr<VideoClip>, VideoClip>;
+    using AudioTrackStore = utils::SlotMap<std::shared_ptr<AudioTrack>, AudioTrack>;
 
     /**
      * @brief Create a new timeline
@@ -77,7 +84,10 @@ public:
      * @brief Set timeline properties
      * @param props New properties
      */
-    void setProperties(const TimelineProperties& props) { m_properties = props; }
+    void setProperties(const TimelineProperties& props) {
+        m_properties = props;
+        m_snapshot.reset();
+    }
 
     /**
      * @brief Get total duration of timeline
@@ -98,32 +108,98 @@ public:
     void setCurrentPosition(int64_t position);
 
     /**
-     * @brief Recalculate total duration based on all clips
+     * @brief Reindex all clips and recalculate total duration
+     *
+     * Prefer moveClip()/refreshClip() for single-clip edits; this
+     * rebuilds the whole time index.
      */
     void updateDuration();
 
+    // ===== Batch Editing =====
+
+    /**
+     * @brief Start a batch of clip edits
+     *
+     * While a batch is open, addClip/removeClip/moveClip/refreshClip only
+     * record the change; ordering, the time index and total duration are
+     * rebuilt once in commitBatch(). Use this for bulk imports (EDL,
+     * project load) to keep them linear in the number of clips. Time and
+     * track queries are not updated until the batch is committed.
+     * Batches may be nested; only the outermost commit applies.
+     */
+    void beginBatch();
+
+    /**
+     * @brief Apply all edits recorded since beginBatch()
+     */
+    void commitBatch();
+
+    /**
+     * @brief Check if a batch is open
+     * @return true between beginBatch() and the matching commitBatch()
+     */
+    [[nodiscard]] bool isInBatch() const { return m_batchDepth > 0; }
+
     // ===== Video Clips =====
 
     /**
      * @brief Add a video clip to the timeline
      * @param clip The clip to add
-     * @return true if successfully added
+     * @return true if successfully added; the clip's handle is then set
      */
     bool addClip(std::shared_ptr<VideoClip> clip);
 
     /**
      * @brief Remove a clip from the timeline
-     * @param clipId ID of clip to remove
+     * @param clip Handle of clip to remove
      * @return true if removed successfully
      */
-    bool removeClip(const std::string& clipId);
+    bool removeClip(ClipHandle clip);
+
+    /**
+     * @brief Move a clip to a new position and/or track
+     * @param clip Handle of clip to move
+     * @param newStartPosition New start position (ms)
+     * @param newTrackIndex New track number
+     * @return true if the clip was found and moved
+     */
+    bool moveClip(ClipHandle clip, int64_t newStartPosition, int32_t newTrackIndex);
 
     /**
-     * @brief Get a clip by ID
+     * @brief Reindex a clip after its span was changed in place
+     * @param clip Handle of clip whose start, duration or track changed
+     * @return true if the clip was found
+     *
+     * Call this after mutating a clip directly (e.g. setDuration() on
+     * split) so time queries see the new span.
+     */
+    bool refreshClip(ClipHandle clip);
+
+    /**
+     * @brief Record that a clip was edited in place
+     * @param clip Handle of clip whose fields or effects changed
+     * @return true if the clip was found
+     *
+     * Snapshots pick up in-place edits only through this or refreshClip().
+     */
+    bool touchClip(ClipHandle clip);
+
+    /**
+     * @brief Get a clip by handle
+     * @param clip The clip's handle
+     * @return Shared pointer to clip, or nullptr if the handle is stale
+     */
+    [[nodiscard]] std::shared_ptr<VideoClip> getClip(ClipHandle clip) const;
+
+    /**
+     * @brief Resolve a persistent clip ID to its handle
      * @param clipId The clip's ID
-     * @return Shared pointer to clip, or nullptr if not found
+     * @return Handle, or a null handle if not found
+     *
+     * For callers holding string IDs (JNI, project files, the journal);
+     * resolve once and use the handle afterwards.
      */
-    [[nodiscard]] std::shared_ptr<VideoClip> getClip(const std::string& clipId) const;
+    [[nodiscard]] ClipHandle findClip(const std::string& clipId) const;
 
     /**
      * @brief Get all clips in order
@@ -145,6 +221,14 @@ public:
      */
     [[nodiscard]] ClipList getClipsAtTime(int64_t timeMs) const;
 
+    /**
+     * @brief Get clips intersecting a time range
+     * @param startMs Range start in milliseconds
+     * @param endMs Range end in milliseconds (inclusive)
+     * @return Clips overlapping the range, ordered by track then start
+     */
+    [[nodiscard]] ClipList getClipsInRange(int64_t startMs, int64_t endMs) const;
+
     /**
      * @brief Get total number of clips
      * @return Clip count
@@ -168,23 +252,37 @@ public:
      * @brief Create and add a new audio track
      * @param name Display name for track
      * @param type Track type (main, voiceover, music, sfx)
-     * @return ID of created track
+     * @return Handle of created track
+     */
+    AudioTrackHandle addAudioTrack(const std::string& name = "Audio", const std::string& type = "main");
+
+    /**
+     * @brief Add an existing audio track, keeping its ID
+     * @param track Track to add (e.g. loaded from a project file)
+     * @return false if null or a track with the same ID exists
      */
-    std::string addAudioTrack(const std::string& name = "Audio", const std::string& type = "main");
+    bool addAudioTrack(std::shared_ptr<AudioTrack> track);
 
     /**
      * @brief Remove an audio track
-     * @param trackId ID of track to remove
+     * @param track Handle of track to remove
      * @return true if removed successfully
      */
-    bool removeAudioTrack(const std::string& trackId);
+    bool removeAudioTrack(AudioTrackHandle track);
 
     /**
-     * @brief Get audio track by ID
+     * @brief Get audio track by handle
+     * @param track The track's handle
+     * @return Shared pointer to track, or nullptr if the handle is stale
+     */
+    [[nodiscard]] std::shared_ptr<AudioTrack> getAudioTrack(AudioTrackHandle track) const;
+
+    /**
+     * @brief Resolve a persistent track ID to its handle
      * @param trackId The track's ID
-     * @return Shared pointer to track, or nullptr if not found
+     * @return Handle, or a null handle if not found
      */
-    [[nodiscard]] std::shared_ptr<AudioTrack> getAudioTrack(const std::string& trackId) const;
+    [[nodiscard]] AudioTrackHandle findAudioTrack(const std::string& trackId) const;
 
     /**
      * @brief Get all audio tracks
@@ -257,6 +355,17 @@ public:
      */
     [[nodiscard]] bool hasOverlappingClips() const;
 
+    /**
+     * @brief Get every pair of overlapping clips on the same track
+     * @return Overlaps ordered by track, then by start of the overlap
+     *
+     * The result is cached: after the first call only clips added, moved,
+     * refreshed or removed since the previous call are rechecked. Like
+     * time queries, spans changed in place need refreshClip() or
+     * updateDuration(), and batched edits show after commitBatch().
+     */
+    [[nodiscard]] const OverlapValidator::OverlapList& getOverlaps() const;
+
     /**
      * @brief Get first overlapping clips if any
      * @param outClip1 First overlapping clip
@@ -272,6 +381,35 @@ public:
      */
     [[nodiscard]] int32_t getMaxTrackInUse() const;
 
+    // ===== Snapshots =====
+
+    /**
+     * @brief Get an immutable snapshot of the current state
+     * @return Snapshot; shared until the next edit
+     *
+     * Only clips edited since the previous snapshot are copied, each at
+     * O(log n) cost. Call from the editing thread; the snapshot itself
+     * can be read from any thread.
+     */
+    [[nodiscard]] std::shared_ptr<const TimelineSnapshot> snapshot() const;
+
+    /**
+     * @brief Return the timeline to an earlier snapshot
+     * @param target Snapshot taken from this timeline
+     *
+     * Only clips that differ from the target are replaced, so stepping
+     * between neighbouring snapshots (undo/redo) is O(changes * log n).
+     * Clip objects held from before are no longer part of the timeline.
+     */
+    void restore(const std::shared_ptr<const TimelineSnapshot>& target);
+
+    /**
+     * @brief Record that an audio track was edited in place
+     * @param track Handle of the edited track
+     * @return true if the track was found
+     */
+    bool touchAudioTrack(AudioTrackHandle track);
+
     // ===== Persistence =====
 
     /**
@@ -300,22 +438,93 @@ private:
 
     // Clips
     ClipList m_clipList;           // All clips sorted by position
-    ClipMap m_clipMap;             // Quick lookup by ID
+    ClipStore m_clips;             // Owns the clips; lookup by handle
+    std::unordered_map<std::string, ClipHandle> m_clipIds; // Persistent ID to handle
+    std::map<int32_t, TrackIntervalIndex> m_trackIndex; // Per-track time index
     std::string m_selectedClipId;  // Currently selected clip
+    mutable OverlapValidator m_overlapValidator; // Cached same-track overlaps
 
     // Audio
     AudioTrackList m_audioTrackList;
-    AudioTrackMap m_audioTrackMap;
+    AudioTrackStore m_audioTracks;
+    std::unordered_map<std::string, AudioTrackHandle> m_audioTrackIds;
 
     // State
     bool m_modified = true;
     int64_t m_modifiedAt;
 
+    // Batch editing
+    int32_t m_batchDepth = 0;      // Nesting depth of open batches
+    bool m_batchDirty = false;     // Edits recorded since beginBatch()
+    size_t m_batchRemovals = 0;    // Removals awaiting list compaction
+
+    // Snapshots; the tree holds a frozen copy of every clip
+    mutable ClipTree m_clipTree;
+    mutable std::unordered_map<const VideoClip*, ClipTree::ClipPtr> m_frozenClips;
+    mutable std::unordered_map<const VideoClip*, std::shared_ptr<VideoClip>> m_snapshotPending; // nullptr = removed
+    mutable std::vector<std::shared_ptr<const AudioTrack>> m_frozenAudioTracks;
+    mutable bool m_audioTracksChanged = false;
+    mutable std::shared_ptr<const TimelineSnapshot> m_snapshot; // Reset by every edit
+
     /**
      * @brief Resort clip list after modification
      */
     void sortClips();
 
+    /**
+     * @brief Ordering used for the clip list (track, then start)
+     * @param a First clip
+     * @param b Second clip
+     * @return true if a sorts before b
+     */
+    static bool clipLess(const std::shared_ptr<VideoClip>& a, const std::shared_ptr<VideoClip>& b);
+
+    /**
+     * @brief Insert a clip into the sorted clip list by binary search
+     * @param clip Clip to insert
+     */
+    void insertIntoList(const std::shared_ptr<VideoClip>& clip);
+
+    /**
+     * @brief Remove a clip from the sorted clip list
+     * @param clip Clip to remove
+     */
+    void eraseFromList(const VideoClip* clip);
+
+    /**
+     * @brief Rebuild every track index from the clip list
+     */
+    void rebuildIndex();
+
+    /**
+     * @brief Add a clip to its track's interval index
+     * @param clip Clip to index
+     */
+    void indexClip(const std::shared_ptr<VideoClip>& clip);
+
+    /**
+     * @brief Remove a clip from its track's interval index
+     * @param clip Clip to remove
+     */
+    void unindexClip(const VideoClip* clip);
+
+    /**
+     * @brief Queue a clip to be frozen into the next snapshot
+     * @param clip Added or edited clip
+     */
+    void markForSnapshot(const std::shared_ptr<VideoClip>& clip);
+
+    /**
+     * @brief Queue a clip's removal from the next snapshot
+     * @param clip Removed clip
+     */
+    void markRemovedForSnapshot(const VideoClip* clip);
+
+    /**
+     * @brief Queue the audio tracks to be frozen into the next snapshot
+     */
+    void markAudioTracksForSnapshot();
+
     /**
      * @brief Recalculate total duration
      */
@@ -326,12 +535,6 @@ private:
      * @return Milliseconds since epoch
      */
     static int64_t getCurrentTimestamp();
-
-    /**
-     * @brief Generate unique ID
-     * @return UUID string
-     */
-    static std::string generateId();
 };
 
 } // namespace models
@@ -0,0 +1,120 @@
+#include "timeline_index.h"
+#include <algorithm>
+#include <limits>
+
+namespace clipforge {
+namespace models {
+
+// ============================================================================
+// TrackIntervalIndex Implementation
+// ============================================================================
+
+void TrackIntervalIndex::insert(const std::shared_ptr<VideoClip>& clip) {
+    if (!clip) return;
+
+    Entry entry;
+    entry.start = clip->getStartPosition();
+    entry.end = clip->getEndPosition();
+    entry.clip = clip;
+
+    // Insert after any clip with the same start to keep insertion order stable
+    auto it = std::upper_bound(m_entries.begin(), m_entries.end(), entry.start,
+                               [](int64_t start, const Entry& e) {
+                                   return start < e.start;
+                               });
+    auto pos = static_cast<size_t>(it - m_entries.begin());
+    m_entries.insert(it, std::move(entry));
+    m_maxEndPrefix.push_back(0);
+    updatePrefix(pos);
+}
+
+bool TrackIntervalIndex::remove(const VideoClip* clip) {
+    if (!clip) return false;
+
+    // Fast path: the clip is still where its current start says it is
+    int64_t start = clip->getStartPosition();
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), start,
+                               [](const Entry& e, int64_t t) { return e.start < t; });
+    while (it != m_entries.end() && it->start == start && it->clip.get() != clip) {
+        ++it;
+    }
+
+    // Slow path: the clip was moved without being reindexed
+    if (it == m_entries.end() || it->clip.get() != clip) {
+        it = std::find_if(m_entries.begin(), m_entries.end(),
+                          [clip](const Entry& e) { return e.clip.get() == clip; });
+        if (it == m_entries.end()) {
+            return false;
+        }
+    }
+
+    auto pos = static_cast<size_t>(it - m_entries.begin());
+    m_entries.erase(it);
+    m_maxEndPrefix.pop_back();
+    updatePrefix(pos);
+    return true;
+}
+
+void TrackIntervalIndex::assign(const ClipList& clips) {
+    m_entries.clear();
+    m_entries.reserve(clips.size());
+    for (const auto& clip : clips) {
+        if (clip) {
+            m_entries.push_back({clip->getStartPosition(), clip->getEndPosition(), clip});
+        }
+    }
+
+    std::stable_sort(m_entries.begin(), m_entries.end(),
+                     [](const Entry& a, const Entry& b) { return a.start < b.start; });
+    m_maxEndPrefix.assign(m_entries.size(), 0);
+    updatePrefix(0);
+}
+
+void TrackIntervalIndex::clear() {
+    m_entries.clear();
+    m_maxEndPrefix.clear();
+}
+
+void TrackIntervalIndex::queryPoint(int64_t timeMs, ClipList& out) const {
+    queryRange(timeMs, timeMs, out);
+}
+
+void TrackIntervalIndex::queryRange(int64_t startMs, int64_t endMs, ClipList& out) const {
+    if (m_entries.empty() || endMs < startMs) return;
+
+    // Every candidate starts at or before the end of the range
+    auto it = std::upper_bound(m_entries.begin(), m_entries.end(), endMs,
+                               [](int64_t t, const Entry& e) { return t < e.start; });
+    auto hi = static_cast<size_t>(it - m_entries.begin());
+
+    // Walk back until no earlier clip can still reach the range start
+    size_t firstOut = out.size();
+    for (size_t i = hi; i > 0; --i) {
+        if (m_maxEndPrefix[i - 1] < startMs) {
+            break;
+        }
+        const Entry& e = m_entries[i - 1];
+        if (e.end >= startMs) {
+            out.push_back(e.clip);
+        }
+    }
+    std::reverse(out.begin() + static_cast<std::ptrdiff_t>(firstOut), out.end());
+}
+
+void TrackIntervalIndex::collect(ClipList& out) const {
+    out.reserve(out.size() + m_entries.size());
+    for (const auto& e : m_entries) {
+        out.push_back(e.clip);
+    }
+}
+
+void TrackIntervalIndex::updatePrefix(size_t from) {
+    int64_t running = from > 0 ? m_maxEndPrefix[from - 1] : std::numeric_limits<int64_t>::min();
+    for (size_t i = from; i < m_entries.size(); ++i) {
+        running = std::max(running, m_entries[i].end);
+        m_maxEndPrefix[i] = running;
+    }
+}
+
+} // namespace models
+} // namespace clipforge
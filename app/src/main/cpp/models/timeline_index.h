@@ -0,0 +1,129 @@
+#ifndef CLIPFORGE_TIMELINE_INDEX_H
+#define CLIPFORGE_TIMELINE_INDEX_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "video_clip.h"
+
+namespace clipforge {
+namespace models {
+
+/**
+ * @class TrackIntervalIndex
+ * @brief Interval index over the clips of a single track
+ *
+ * Clips are kept in an array sorted by start position alongside a
+ * running maximum of their end positions. A point or range query
+ * binary-searches the last clip starting before the query end, then
+ * walks backwards only while the max-end prefix still reaches the
+ * query start, so lookups cost O(log n + k) for k results.
+ *
+ * Span values are captured at insertion time. Callers that change a
+ * clip's start or duration must remove it before the change and
+ * insert it again afterwards.
+ */
+class TrackIntervalIndex {
+public:
+    using ClipList = std::vector<std::shared_ptr<VideoClip>>;
+
+    /**
+     * @struct Entry
+     * @brief Indexed span of one clip
+     */
+    struct Entry {
+        int64_t start = 0;             // Start position (ms)
+        int64_t end = 0;               // End position (ms, inclusive)
+        std::shared_ptr<VideoClip> clip;
+    };
+
+    TrackIntervalIndex() = default;
+
+    /**
+     * @brief Insert a clip using its current span
+     * @param clip Clip to index
+     */
+    void insert(const std::shared_ptr<VideoClip>& clip);
+
+    /**
+     * @brief Remove a clip from the index
+     * @param clip Clip to remove
+     * @return true if the clip was indexed
+     */
+    bool remove(const VideoClip* clip);
+
+    /**
+     * @brief Replace contents with a set of clips in one pass
+     * @param clips Clips to index, in any order
+     *
+     * Used for bulk loads where per-clip insertion would be quadratic.
+     */
+    void assign(const ClipList& clips);
+
+    /**
+     * @brief Remove all clips
+     */
+    void clear();
+
+    /**
+     * @brief Append clips whose span contains a time
+     * @param timeMs Time in milliseconds
+     * @param out Receives matching clips in start order
+     */
+    void queryPoint(int64_t timeMs, ClipList& out) const;
+
+    /**
+     * @brief Append clips whose span intersects [startMs, endMs]
+     * @param startMs Range start in milliseconds
+     * @param endMs Range end in milliseconds
+     * @param out Receives matching clips in start order
+     */
+    void queryRange(int64_t startMs, int64_t endMs, ClipList& out) const;
+
+    /**
+     * @brief Append every indexed clip in start order
+     * @param out Receives clips
+     */
+    void collect(ClipList& out) const;
+
+    /**
+     * @brief Get indexed entries in start order
+     * @return Entry array
+     */
+    [[nodiscard]] const std::vector<Entry>& getEntries() const { return m_entries; }
+
+    /**
+     * @brief Get number of indexed clips
+     * @return Clip count
+     */
+    [[nodiscard]] size_t size() const { return m_entries.size(); }
+
+    /**
+     * @brief Check if index is empty
+     * @return true if no clips are indexed
+     */
+    [[nodiscard]] bool empty() const { return m_entries.empty(); }
+
+    /**
+     * @brief Get latest end position on this track
+     * @return End position in milliseconds, 0 if empty
+     */
+    [[nodiscard]] int64_t getMaxEnd() const {
+        return m_maxEndPrefix.empty() ? 0 : m_maxEndPrefix.back();
+    }
+
+private:
+    std::vector<Entry> m_entries;        // Sorted by start position
+    std::vector<int64_t> m_maxEndPrefix; // m_maxEndPrefix[i] = max end of entries [0, i]
+
+    /**
+     * @brief Recompute max-end prefix from an entry onwards
+     * @param from First entry whose prefix value changed
+     */
+    void updatePrefix(size_t from);
+};
+
+} // namespace models
+} // namespace clipforge
+
+#endif // CLIPFORGE_TIMELINE_INDEX_H
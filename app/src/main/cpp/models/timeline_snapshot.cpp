@@ -0,0 +1,31 @@
+#include "timeline_snapshot.h"
+
+namespace clipforge {
+namespace models {
+
+// ============================================================================
+// TimelineSnapshot Implementation
+// ============================================================================
+
+TimelineSnapshot::TimelineSnapshot(const TimelineProperties& properties, int64_t totalDuration,
+                                   ClipTree clips, AudioTrackList audioTracks)
+    : m_properties(properties),
+      m_totalDuration(totalDuration),
+      m_clips(std::move(clips)),
+      m_audioTracks(std::move(audioTracks)) {
+}
+
+TimelineSnapshot::ClipList TimelineSnapshot::getAllClips() const {
+    ClipList clips;
+    m_clips.collect(clips);
+    return clips;
+}
+
+TimelineSnapshot::ClipList TimelineSnapshot::getClipsAtTime(int64_t timeMs) const {
+    ClipList clips;
+    m_clips.queryPoint(timeMs, clips);
+    return clips;
+}
+
+} // namespace models
+} // namespace clipforge
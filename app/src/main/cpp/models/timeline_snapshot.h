@@ -0,0 +1,63 @@
+#ifndef CLIPFORGE_TIMELINE_SNAPSHOT_H
+#define CLIPFORGE_TIMELINE_SNAPSHOT_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "timeline.h"
+#include "clip_tree.h"
+
+namespace clipforge {
+namespace models {
+
+/**
+ * @class TimelineSnapshot
+ * @brief Immutable state of a timeline at one point in time
+ *
+ * Taken with Timeline::snapshot(). Clips and audio tracks are frozen
+ * copies, so a snapshot can be read from any thread while the timeline
+ * keeps being edited. Consecutive snapshots share every clip and tree
+ * node the edits in between did not touch, so keeping many of them
+ * (e.g. for undo) costs O(log n) per edit.
+ */
+class TimelineSnapshot {
+public:
+    using ClipPtr = ClipTree::ClipPtr;
+    using ClipList = ClipTree::ClipList;
+    using AudioTrackList = std::vector<std::shared_ptr<const AudioTrack>>;
+
+    [[nodiscard]] const TimelineProperties& getProperties() const { return m_properties; }
+    [[nodiscard]] int64_t getTotalDuration() const { return m_totalDuration; }
+    [[nodiscard]] size_t getClipCount() const { return m_clips.size(); }
+    [[nodiscard]] const ClipTree& getClipTree() const { return m_clips; }
+    [[nodiscard]] const AudioTrackList& getAllAudioTracks() const { return m_audioTracks; }
+
+    /**
+     * @brief Get all clips sorted by track, then start
+     * @return Clips
+     */
+    [[nodiscard]] ClipList getAllClips() const;
+
+    /**
+     * @brief Get clips covering a time, sorted by track
+     * @param timeMs Time in milliseconds
+     * @return Clips
+     */
+    [[nodiscard]] ClipList getClipsAtTime(int64_t timeMs) const;
+
+private:
+    friend class Timeline;
+
+    TimelineProperties m_properties;
+    int64_t m_totalDuration = 0;
+    ClipTree m_clips;
+    AudioTrackList m_audioTracks;
+
+    TimelineSnapshot(const TimelineProperties& properties, int64_t totalDuration, ClipTree clips,
+                     AudioTrackList audioTracks);
+};
+
+} // namespace models
+} // namespace clipforge
+
+#endif // CLIPFORGE_TIMELINE_SNAPSHOT_H
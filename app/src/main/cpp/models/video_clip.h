@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 #include "effect.h"
+#include "../utils/slot_map.h"
 
 namespace clipforge {
 namespace models {
@@ -28,6 +29,11 @@ struct VideoClipMetadata {
                           frameRate(30.0f), bitRate(0) {}
 };
 
+class VideoClip;
+
+/** @brief Runtime handle of a clip in its timeline; not persisted */
+using ClipHandle = utils::SlotHandle<VideoClip>;
+
 /**
  * @class VideoClip
  * @brief Represents a single video clip in the timeline
@@ -68,6 +74,18 @@ public:
      */
     [[nodiscard]] const std::string& getId() const { return m_id; }
 
+    /**
+     * @brief Get the clip's handle in the timeline holding it
+     * @return Handle, or a null handle if the clip is in no timeline
+     */
+    [[nodiscard]] ClipHandle getHandle() const { return m_handle; }
+
+    /**
+     * @brief Set the clip's handle (Timeline only)
+     * @param handle Handle from the timeline's clip store
+     */
+    void setHandle(ClipHandle handle) { m_handle = handle; }
+
     /**
      * @brief Get the clip name (display name)
      * @return Human-readable clip name
@@ -285,6 +303,7 @@ public:
 
 private:
     std::string m_id;
+    ClipHandle m_handle;           // Set while in a timeline
     std::string m_name;            // Display name
     std::string m_description;     // Optional description
 
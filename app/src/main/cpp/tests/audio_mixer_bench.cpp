@@ -0,0 +1,88 @@
+#include "test_util.h"
+#include "audio/audio_mixer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/**
+ * @file audio_mixer_bench.cpp
+ * @brief Tracks mixed per core in real time
+ *
+ * Renders blocks on the calling thread (one core) from sources that
+ * copy pre-decoded PCM, with and without the 3-band EQ engaged, and
+ * reports how many tracks one core could mix at the real-time rate.
+ */
+
+using namespace clipforge;
+using namespace clipforge::audio;
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+
+/**
+ * @brief Loops one second of decoded PCM, as a buffered decoder would
+ */
+class LoopSource : public AudioSource {
+public:
+    LoopSource(size_t channels, double frequency) : m_channels(channels), m_pcm(static_cast<size_t>(SAMPLE_RATE)) {
+        for (size_t i = 0; i < m_pcm.size(); ++i) {
+            m_pcm[i] = static_cast<float>(0.25 * std::sin(2.0 * M_PI * frequency * static_cast<double>(i) / SAMPLE_RATE));
+        }
+    }
+
+    size_t getChannelCount() const override { return m_channels; }
+
+    size_t read(float* const* channels, size_t frames) override {
+        size_t count = std::min(frames, m_pcm.size() - m_position);
+        for (size_t c = 0; c < m_channels; ++c) {
+            std::memcpy(channels[c], m_pcm.data() + m_position, count * sizeof(float));
+        }
+        m_position = (m_position + count) % m_pcm.size();
+        return count;
+    }
+
+private:
+    size_t m_channels;
+    std::vector<float> m_pcm;
+    size_t m_position = 0;
+};
+
+} // namespace
+
+int main() {
+    constexpr int BLOCKS = 2000;
+    float left[AudioMixer::BLOCK_SIZE];
+    float right[AudioMixer::BLOCK_SIZE];
+
+    std::printf("%6s %6s %14s %16s\n", "eq", "tracks", "x real time", "tracks per core");
+    for (bool equalized : {false, true}) {
+        for (int trackCount : {8, 32, 64}) {
+            AudioMixer mixer(SAMPLE_RATE);
+            for (int i = 0; i < trackCount; ++i) {
+                int slot = mixer.addTrack(std::make_shared<LoopSource>(2, 100.0 + i));
+                CHECK(slot >= 0);
+                MixerTrackSettings settings;
+                settings.pan = 0.1f * static_cast<float>(i % 5);
+                if (equalized) {
+                    settings.bass = 0.3f;
+                    settings.midrange = 0.1f;
+                    settings.treble = -0.2f;
+                }
+                mixer.setTrackSettings(slot, settings);
+            }
+
+            double ms = tests::bestTimeMs(3, [&] {
+                for (int b = 0; b < BLOCKS; ++b) mixer.renderBlock(left, right);
+            });
+            double audioMs = BLOCKS * static_cast<double>(AudioMixer::BLOCK_SIZE) * 1000.0 / SAMPLE_RATE;
+            double realTime = audioMs / ms;
+            std::printf("%6s %6d %14.1f %16.0f\n", equalized ? "on" : "off", trackCount, realTime,
+                        trackCount * realTime);
+        }
+    }
+    return tests::testResult();
+}
@@ -0,0 +1,116 @@
+#include "test_util.h"
+#include "click_track_fixture.h"
+#include "audio/batch_analyzer.h"
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+/**
+ * @file batch_analyzer_test.cpp
+ * @brief BatchAudioAnalyzer against one BeatTracker pass per track
+ *
+ * Tracks of mixed length and format, some spanning several segments,
+ * are analyzed on 1 to 8 threads. Every curve must be bit-identical to
+ * a single-threaded analyzeTrack() of the same track and every grid the
+ * same, whatever order the segments finished in. Progress must never
+ * go backwards, never be reported concurrently, and end at 1.
+ */
+
+using namespace clipforge;
+using namespace clipforge::audio;
+
+namespace {
+
+bool sameCurve(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+bool sameGrid(const BeatGrid& a, const BeatGrid& b) {
+    if (a.bpm != b.bpm || a.confidence != b.confidence || a.durationMs != b.durationMs ||
+        a.beats.size() != b.beats.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.beats.size(); ++i) {
+        if (a.beats[i].timestamp != b.beats[i].timestamp || a.beats[i].strength != b.beats[i].strength) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    // 40 s is four segments; the cut tracks end mid-hop
+    std::vector<std::vector<float>> pcm = {
+        tests::clickTrack(128.0f, 40, 250),
+        tests::clickTrack(95.0f, 5, 100),
+        tests::clickTrack(140.0f, 30, 0, 48000, 1, 5),
+        tests::clickTrack(110.0f, 26, 400, 44100, 2, 7),
+    };
+    pcm[1].resize(pcm[1].size() - 2 * 301);
+    pcm[3].resize(pcm[3].size() - 2 * 77);
+
+    std::vector<AudioTrackInput> tracks = {
+        {"long", pcm[0], 44100, 2},
+        {"short", pcm[1], 44100, 2},
+        {"mono48k", pcm[2], 48000, 1},
+        {"cut", pcm[3], 44100, 2},
+        {"invalid", pcm[1], 44100, 0},
+    };
+
+    // Single-threaded reference, one pass per track
+    std::vector<TrackAnalysis> expected(tracks.size() - 1);
+    for (size_t i = 0; i + 1 < tracks.size(); ++i) {
+        BeatTracker tracker(tracks[i].sampleRate, tracks[i].channels);
+        expected[i].beatGrid = tracker.analyzeTrack(tracks[i].samples);
+        expected[i].onsetCurve = tracker.getOnsetCurve();
+        expected[i].energy = tracker.getEnergyCurve();
+    }
+
+    for (size_t threads : {1, 2, 4, 8}) {
+        utils::ThreadPool pool(threads);
+        BatchAudioAnalyzer analyzer(pool);
+
+        std::vector<float> progress;
+        std::atomic<bool> inCallback{false};
+        std::atomic<int> overlaps{0};
+        analyzer.setProgressCallback([&](float value) {
+            if (inCallback.exchange(true)) overlaps++;
+            progress.push_back(value);
+            inCallback = false;
+        });
+
+        std::vector<TrackAnalysis> results;
+        CHECK(analyzer.analyze(tracks, results));
+        CHECK(!analyzer.wasCancelled());
+        CHECK(results.size() == tracks.size());
+
+        for (size_t i = 0; i + 1 < tracks.size(); ++i) {
+            CHECK(results[i].id == tracks[i].id);
+            CHECK(results[i].completed);
+            CHECK(sameCurve(results[i].onsetCurve, expected[i].onsetCurve));
+            CHECK(sameCurve(results[i].energy, expected[i].energy));
+            CHECK(sameGrid(results[i].beatGrid, expected[i].beatGrid));
+        }
+        CHECK(results.back().id == "invalid");
+        CHECK(!results.back().completed);
+
+        CHECK(overlaps == 0);
+        CHECK(!progress.empty() && progress.back() == 1.0f);
+        for (size_t i = 1; i < progress.size(); ++i) {
+            CHECK(progress[i] >= progress[i - 1]);
+        }
+    }
+
+    // Cancelled from the progress callback: stops early and reports it
+    {
+        utils::ThreadPool pool(4);
+        BatchAudioAnalyzer analyzer(pool);
+        analyzer.setProgressCallback([&analyzer](float) { analyzer.cancel(); });
+        std::vector<TrackAnalysis> results;
+        CHECK(!analyzer.analyze(tracks, results));
+        CHECK(analyzer.wasCancelled());
+        for (const TrackAnalysis& result : results) CHECK(!result.completed);
+    }
+
+    return tests::testResult();
+}
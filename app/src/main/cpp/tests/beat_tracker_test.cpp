@@ -0,0 +1,140 @@
+#include "test_util.h"
+#include "click_track_fixture.h"
+#include "audio/beat_tracker.h"
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/**
+ * @file beat_tracker_test.cpp
+ * @brief BeatTracker tempo and beat grid on a synthetic click track
+ *
+ * A 128 BPM click track must give its tempo and one beat per click.
+ * Pushing the same audio in odd chunks, or computing the onset curve in
+ * segments on any number of threads (each starting WARMUP_FRAMES early),
+ * must give bit-identical onsets and the same grid as a single pass.
+ */
+
+using namespace clipforge;
+using namespace clipforge::audio;
+
+namespace {
+
+constexpr float BPM = 128.0f;
+constexpr int SECONDS = 40;
+constexpr int32_t FIRST_CLICK_MS = 250;
+constexpr int SAMPLE_RATE = 44100;
+constexpr int CHANNELS = 2;
+constexpr double TOLERANCE_MS = 30.0;   // About 2.5 hops
+constexpr size_t SEGMENT_FRAMES = 300;
+
+bool sameCurve(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+bool sameGrid(const BeatGrid& a, const BeatGrid& b) {
+    if (a.bpm != b.bpm || a.confidence != b.confidence || a.durationMs != b.durationMs ||
+        a.beats.size() != b.beats.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.beats.size(); ++i) {
+        if (a.beats[i].timestamp != b.beats[i].timestamp || a.beats[i].strength != b.beats[i].strength) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Onset and energy curves computed segment by segment on a pool
+ */
+void segmentedCurves(const std::vector<float>& samples, size_t threads,
+                     std::vector<float>& onsets, std::vector<float>& energy) {
+    constexpr size_t HOP = BeatTracker::HOP_SIZE;
+    const size_t trackSamples = samples.size() / CHANNELS;
+    const size_t frames = (trackSamples + HOP - 1) / HOP;
+    const size_t segments = (frames + SEGMENT_FRAMES - 1) / SEGMENT_FRAMES;
+    onsets.assign(frames, 0.0f);
+    energy.assign(frames, 0.0f);
+
+    utils::ThreadPool pool(threads);
+    std::vector<std::unique_ptr<BeatTracker>> trackers(pool.getThreadCount());
+    for (auto& tracker : trackers) tracker = std::make_unique<BeatTracker>(SAMPLE_RATE, CHANNELS);
+
+    pool.parallelForThreaded(segments, [&](size_t segment, size_t thread) {
+        size_t firstFrame = segment * SEGMENT_FRAMES;
+        size_t frameCount = std::min(SEGMENT_FRAMES, frames - firstFrame);
+        size_t startFrame = firstFrame >= BeatTracker::WARMUP_FRAMES ? firstFrame - BeatTracker::WARMUP_FRAMES : 0;
+        size_t endSample = std::min((firstFrame + frameCount) * HOP, trackSamples);
+
+        BeatTracker& tracker = *trackers[thread];
+        tracker.reset();
+        tracker.push(std::span<const float>(samples).subspan(startFrame * HOP * CHANNELS,
+                                                             (endSample - startFrame * HOP) * CHANNELS));
+        if (endSample == trackSamples) tracker.flush();
+
+        size_t skip = firstFrame - startFrame;
+        std::copy_n(tracker.getOnsetCurve().begin() + static_cast<std::ptrdiff_t>(skip), frameCount,
+                    onsets.begin() + static_cast<std::ptrdiff_t>(firstFrame));
+        std::copy_n(tracker.getEnergyCurve().begin() + static_cast<std::ptrdiff_t>(skip), frameCount,
+                    energy.begin() + static_cast<std::ptrdiff_t>(firstFrame));
+    });
+}
+
+} // namespace
+
+int main() {
+    const std::vector<float> samples = tests::clickTrack(BPM, SECONDS, FIRST_CLICK_MS, SAMPLE_RATE, CHANNELS);
+
+    BeatTracker tracker(SAMPLE_RATE, CHANNELS);
+    const BeatGrid grid = tracker.analyzeTrack(samples);
+    const std::vector<float> onsets = tracker.getOnsetCurve();
+    const std::vector<float> energy = tracker.getEnergyCurve();
+
+    // Tempo and one beat on every click
+    CHECK(std::abs(grid.bpm - BPM) < 0.5f);
+    CHECK(grid.confidence > 0.0f);
+    CHECK(grid.durationMs == SECONDS * 1000);
+    CHECK(onsets.size() == (samples.size() / CHANNELS + BeatTracker::HOP_SIZE - 1) / BeatTracker::HOP_SIZE);
+
+    int clicks = 0;
+    while (tests::clickTimeMs(BPM, FIRST_CLICK_MS, clicks) < SECONDS * 1000.0) ++clicks;
+    CHECK(grid.beats.size() == static_cast<size_t>(clicks));
+    for (size_t i = 0; i < grid.beats.size(); ++i) {
+        if (i > 0) CHECK(grid.beats[i].timestamp > grid.beats[i - 1].timestamp);
+        double nearest = std::round((grid.beats[i].timestamp - FIRST_CLICK_MS) * BPM / 60000.0);
+        double clickMs = tests::clickTimeMs(BPM, FIRST_CLICK_MS, static_cast<int>(nearest));
+        CHECK(std::abs(grid.beats[i].timestamp - clickMs) <= TOLERANCE_MS);
+    }
+
+    // Odd chunks, splitting sample frames between calls
+    {
+        BeatTracker streamed(SAMPLE_RATE, CHANNELS);
+        for (size_t offset = 0; offset < samples.size(); offset += 1001) {
+            streamed.push(std::span<const float>(samples).subspan(offset, std::min<size_t>(1001, samples.size() - offset)));
+        }
+        CHECK(sameGrid(streamed.finish(), grid));
+        CHECK(sameCurve(streamed.getOnsetCurve(), onsets));
+        CHECK(sameCurve(streamed.getEnergyCurve(), energy));
+    }
+
+    // Segments on any number of threads match the single pass bit for bit
+    for (size_t threads : {1, 2, 3, 8}) {
+        std::vector<float> segmentOnsets;
+        std::vector<float> segmentEnergy;
+        segmentedCurves(samples, threads, segmentOnsets, segmentEnergy);
+        CHECK(sameCurve(segmentOnsets, onsets));
+        CHECK(sameCurve(segmentEnergy, energy));
+
+        // analyzeOnsets() on one tracker from every thread at once
+        utils::ThreadPool pool(threads);
+        std::vector<BeatGrid> grids(8);
+        pool.parallelFor(grids.size(), [&](size_t i) {
+            grids[i] = tracker.analyzeOnsets(segmentOnsets, static_cast<int64_t>(samples.size() / CHANNELS));
+        });
+        for (const BeatGrid& other : grids) CHECK(sameGrid(other, grid));
+    }
+
+    return tests::testResult();
+}
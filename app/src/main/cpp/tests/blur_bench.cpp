@@ -0,0 +1,61 @@
+#include "test_util.h"
+#include "effects/blur_filter.h"
+#include "effects/color_kernels.h"
+#include "utils/thread_pool.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+ * @file blur_bench.cpp
+ * @brief Blur cost across radii 1-50, per quality and instruction set
+ *
+ * 1080p frame on one thread, in milliseconds. FAST (three box passes)
+ * should stay flat while HIGH (Gaussian) grows with the radius. SIMD
+ * output is checked to be bit-identical to scalar first.
+ */
+
+using namespace clipforge;
+using namespace clipforge::effects;
+
+int main() {
+    constexpr int32_t WIDTH = 1920;
+    constexpr int32_t HEIGHT = 1080;
+    const float radii[] = {1.0f, 2.0f, 5.0f, 10.0f, 15.0f, 25.0f, 35.0f, 50.0f};
+    const SimdLevel levels[] = {SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::NEON};
+
+    utils::ThreadPool pool(1);
+    BlurFilter filter;
+    std::mt19937 rng(5);
+    std::vector<uint8_t> source(static_cast<size_t>(WIDTH) * HEIGHT * 4);
+    for (auto& byte : source) byte = static_cast<uint8_t>(rng());
+
+    // Agreement on a small, oddly sized crop
+    constexpr int32_t CROP_WIDTH = 203;
+    constexpr int32_t CROP_HEIGHT = 117;
+    for (BlurQuality quality : {BlurQuality::FAST, BlurQuality::HIGH}) {
+        std::vector<uint8_t> expected(source.begin(), source.begin() + CROP_WIDTH * CROP_HEIGHT * 4);
+        ColorKernels::setLevel(SimdLevel::SCALAR);
+        filter.apply(ImageView{expected.data(), CROP_WIDTH, CROP_HEIGHT, CROP_WIDTH * 4}, 7.5f, 1.0f, quality, pool);
+        for (SimdLevel level : levels) {
+            if (!ColorKernels::setLevel(level)) continue;
+            std::vector<uint8_t> actual(source.begin(), source.begin() + CROP_WIDTH * CROP_HEIGHT * 4);
+            filter.apply(ImageView{actual.data(), CROP_WIDTH, CROP_HEIGHT, CROP_WIDTH * 4}, 7.5f, 1.0f, quality, pool);
+            CHECK(actual == expected);
+        }
+    }
+
+    std::printf("%-8s %8s %10s %10s\n", "isa", "radius", "FAST ms", "HIGH ms");
+    for (SimdLevel level : levels) {
+        if (!ColorKernels::setLevel(level)) continue;
+
+        for (float radius : radii) {
+            std::vector<uint8_t> frame = source;
+            ImageView image{frame.data(), WIDTH, HEIGHT, WIDTH * 4};
+            double fastMs = tests::bestTimeMs(3, [&] { filter.apply(image, radius, 1.0f, BlurQuality::FAST, pool); });
+            double highMs = tests::bestTimeMs(3, [&] { filter.apply(image, radius, 1.0f, BlurQuality::HIGH, pool); });
+            std::printf("%-8s %8.0f %10.1f %10.1f\n", ColorKernels::getLevelName(level), radius, fastMs, highMs);
+        }
+    }
+    return tests::testResult();
+}
@@ -0,0 +1,59 @@
+#ifndef CLIPFORGE_CLICK_TRACK_FIXTURE_H
+#define CLIPFORGE_CLICK_TRACK_FIXTURE_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace clipforge {
+namespace tests {
+
+/**
+ * @brief Time of the n-th click of clickTrack(), in milliseconds
+ */
+inline double clickTimeMs(float bpm, int32_t firstClickMs, int index) {
+    return firstClickMs + index * 60000.0 / bpm;
+}
+
+/**
+ * @brief Interleaved PCM of a click track over a low noise floor
+ *
+ * Each click is a 20 ms decaying burst of a 100 Hz tone and noise, so
+ * it has energy in both the low and the high bands. Channels differ
+ * in level. Deterministic for a given seed.
+ */
+inline std::vector<float> clickTrack(float bpm, int seconds, int32_t firstClickMs,
+                                     int sampleRate = 44100, int channels = 2, uint32_t seed = 3) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+    const size_t frames = static_cast<size_t>(seconds) * static_cast<size_t>(sampleRate);
+    const size_t clickLength = static_cast<size_t>(sampleRate / 50);
+    std::vector<float> mono(frames);
+    for (auto& sample : mono) sample = 0.01f * noise(rng);
+
+    for (int click = 0;; ++click) {
+        size_t start = static_cast<size_t>(clickTimeMs(bpm, firstClickMs, click) * sampleRate / 1000.0);
+        if (start >= frames) break;
+        for (size_t i = 0; i < clickLength && start + i < frames; ++i) {
+            double t = static_cast<double>(i) / sampleRate;
+            double tone = std::sin(2.0 * M_PI * 100.0 * t);
+            mono[start + i] += static_cast<float>(std::exp(-t * 200.0) * (0.5 * tone + 0.3 * noise(rng)));
+        }
+    }
+
+    std::vector<float> samples(frames * static_cast<size_t>(channels));
+    for (size_t i = 0; i < frames; ++i) {
+        for (int c = 0; c < channels; ++c) {
+            samples[i * static_cast<size_t>(channels) + static_cast<size_t>(c)] = mono[i] * (1.0f - 0.2f * static_cast<float>(c));
+        }
+    }
+    return samples;
+}
+
+} // namespace tests
+} // namespace clipforge
+
+#endif // CLIPFORGE_CLICK_TRACK_FIXTURE_H
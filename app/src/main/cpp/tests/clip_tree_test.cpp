@@ -0,0 +1,134 @@
+#include "test_util.h"
+#include "models/clip_tree.h"
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @file clip_tree_test.cpp
+ * @brief ClipTree::diff against a merge of the two trees' clip lists
+ *
+ * Each round derives a tree from the last by random inserts, replacements
+ * and erases, then checks diff() reports exactly the changed keys, in key
+ * order, and nothing when a tree is compared with itself.
+ */
+
+using namespace clipforge;
+using namespace clipforge::models;
+
+namespace {
+
+using ClipPtr = ClipTree::ClipPtr;
+using ClipList = ClipTree::ClipList;
+
+struct Change {
+    ClipPtr from;
+    ClipPtr to;
+};
+
+bool keyLess(const VideoClip& a, const VideoClip& b) {
+    if (a.getTrackIndex() != b.getTrackIndex()) return a.getTrackIndex() < b.getTrackIndex();
+    if (a.getStartPosition() != b.getStartPosition()) return a.getStartPosition() < b.getStartPosition();
+    return a.getId() < b.getId();
+}
+
+ClipPtr makeClip(int id, int32_t track, int64_t start) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "c%d", id);
+    auto clip = std::make_shared<VideoClip>(name, "clip.mp4");
+    clip->setTrackIndex(track);
+    clip->setStartPosition(start);
+    clip->setDuration(1000);
+    return clip;
+}
+
+std::vector<Change> expectedChanges(const ClipTree& from, const ClipTree& to) {
+    ClipList before, after;
+    from.collect(before);
+    to.collect(after);
+
+    std::vector<Change> changes;
+    size_t i = 0, j = 0;
+    while (i < before.size() || j < after.size()) {
+        if (j == after.size() || (i < before.size() && keyLess(*before[i], *after[j]))) {
+            changes.push_back({before[i++], nullptr});
+        } else if (i == before.size() || keyLess(*after[j], *before[i])) {
+            changes.push_back({nullptr, after[j++]});
+        } else {
+            if (before[i] != after[j]) changes.push_back({before[i], after[j]});
+            i++;
+            j++;
+        }
+    }
+    return changes;
+}
+
+std::vector<Change> reportedChanges(const ClipTree& from, const ClipTree& to) {
+    std::vector<Change> changes;
+    ClipTree::diff(from, to, [&](const ClipPtr& a, const ClipPtr& b) { changes.push_back({a, b}); });
+    return changes;
+}
+
+bool sameChanges(const std::vector<Change>& a, const std::vector<Change>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].from != b[i].from || a[i].to != b[i].to) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(3);
+    int nextId = 0;
+
+    ClipTree tree;
+    ClipList clips;
+    for (int i = 0; i < 2000; ++i) {
+        ClipPtr clip = makeClip(nextId++, static_cast<int32_t>(rng() % 4), static_cast<int64_t>(rng() % 100000));
+        tree = tree.insert(clip);
+        clips.push_back(clip);
+    }
+
+    for (int round = 0; round < 200; ++round) {
+        ClipTree next = tree;
+        int edits = 1 + static_cast<int>(rng() % 8);
+        for (int e = 0; e < edits; ++e) {
+            size_t pick = rng() % clips.size();
+            switch (rng() % 3) {
+            case 0: {
+                ClipPtr clip = makeClip(nextId++, static_cast<int32_t>(rng() % 4), static_cast<int64_t>(rng() % 100000));
+                next = next.insert(clip);
+                clips.push_back(clip);
+                break;
+            }
+            case 1: {
+                // Same key, new clip
+                auto copy = std::make_shared<VideoClip>(*clips[pick]);
+                copy->setDuration(copy->getDuration() + 1);
+                next = next.insert(copy);
+                clips[pick] = copy;
+                break;
+            }
+            default:
+                next = next.erase(*clips[pick]);
+                clips[pick] = clips.back();
+                clips.pop_back();
+                break;
+            }
+        }
+
+        CHECK(sameChanges(reportedChanges(tree, next), expectedChanges(tree, next)));
+        CHECK(sameChanges(reportedChanges(next, tree), expectedChanges(next, tree)));
+        CHECK(reportedChanges(next, next).empty());
+        tree = next;
+    }
+
+    // Against an empty tree every clip is added or removed
+    CHECK(reportedChanges(ClipTree(), tree).size() == tree.size());
+    CHECK(reportedChanges(tree, ClipTree()).size() == tree.size());
+
+    return tests::testResult();
+}
@@ -0,0 +1,83 @@
+#include "test_util.h"
+#include "effects/color_kernels.h"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * @file color_kernels_test.cpp
+ * @brief NV12 color matrices on odd frame sizes
+ *
+ * An odd-sized frame is compared with the same frame padded to even
+ * size by repeating its last column and row. The padding only
+ * duplicates pixels inside the trailing blocks, so every original luma
+ * sample must come out the same, and every chroma sample must too, to
+ * within rounding of the block average.
+ */
+
+using namespace clipforge;
+using namespace clipforge::effects;
+
+namespace {
+
+struct Frame {
+    int32_t width;
+    int32_t height;
+    std::vector<uint8_t> y;
+    std::vector<uint8_t> uv;
+
+    Frame(int32_t w, int32_t h)
+        : width(w), height(h), y(static_cast<size_t>(w) * static_cast<size_t>(h)),
+          uv(static_cast<size_t>((w + 1) / 2 * 2) * static_cast<size_t>((h + 1) / 2)) {}
+
+    int32_t uvStride() const { return (width + 1) / 2 * 2; }
+    uint8_t& luma(int32_t x, int32_t row) { return y[static_cast<size_t>(row * width + x)]; }
+    uint8_t& chroma(int32_t x, int32_t row) { return uv[static_cast<size_t>(row * uvStride() + x)]; }
+    Nv12Image view() { return Nv12Image{y.data(), uv.data(), width, height, width, uvStride()}; }
+};
+
+} // namespace
+
+int main() {
+    const ColorMatrix matrices[] = {
+        ColorMatrix::sepia(1.0f),              // Mixes luma and chroma: converted through RGB
+        ColorMatrix::brightness(0.2f, 0.8f),   // Luma and chroma planes mapped separately
+    };
+    std::mt19937 rng(7);
+
+    for (const ColorMatrix& matrix : matrices) {
+        for (auto [width, height] : {std::pair{5, 3}, std::pair{7, 6}, std::pair{6, 5}, std::pair{1, 1}}) {
+            Frame odd(width, height);
+            for (auto& byte : odd.y) byte = static_cast<uint8_t>(rng());
+            for (auto& byte : odd.uv) byte = static_cast<uint8_t>(rng());
+
+            Frame even(width + (width & 1), height + (height & 1));
+            for (int32_t row = 0; row < even.height; ++row) {
+                for (int32_t x = 0; x < even.width; ++x) {
+                    even.luma(x, row) = odd.luma(std::min(x, width - 1), std::min(row, height - 1));
+                }
+            }
+            even.uv = odd.uv;
+
+            const Frame original = odd;
+            ColorKernels::applyNv12(matrix, odd.view());
+            ColorKernels::applyNv12(matrix, even.view());
+
+            bool lumaChanged = false;
+            for (int32_t row = 0; row < height; ++row) {
+                for (int32_t x = 0; x < width; ++x) {
+                    CHECK(odd.luma(x, row) == even.luma(x, row));
+                    lumaChanged |= odd.luma(x, row) != original.y[static_cast<size_t>(row * width + x)];
+                }
+            }
+            CHECK(lumaChanged);
+            for (size_t i = 0; i < odd.uv.size(); ++i) {
+                CHECK(std::abs(odd.uv[i] - even.uv[i]) <= 1);
+            }
+        }
+    }
+
+    return tests::testResult();
+}
@@ -0,0 +1,162 @@
+#include "test_util.h"
+#include "timeline_fixture.h"
+#include "models/edit_journal.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+/**
+ * @file edit_journal_test.cpp
+ * @brief EditJournal replay, torn tails and gaps after the snapshot
+ *
+ * Edits recorded on one timeline are replayed onto a copy built from the
+ * same snapshot and must reproduce it. A torn last record is dropped on
+ * open, trailing garbage is ignored, and a journal that starts after the
+ * snapshot is not replayed at all.
+ */
+
+using namespace clipforge;
+using namespace clipforge::models;
+
+namespace {
+
+const char* JOURNAL_PATH = "edit_journal_test.journal";
+constexpr int CLIP_COUNT = 30;
+constexpr uint64_t SNAPSHOT_SEQUENCE = 5;
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+bool sameClips(const Timeline& a, const Timeline& b) {
+    if (a.getClipCount() != b.getClipCount() || a.getTotalDuration() != b.getTotalDuration()) return false;
+    for (const auto& clip : a.getAllClips()) {
+        auto other = b.getClip(b.findClip(clip->getId()));
+        if (!other || other->getStartPosition() != clip->getStartPosition() ||
+            other->getTrackIndex() != clip->getTrackIndex() || other->getDuration() != clip->getDuration() ||
+            other->getSpeed() != clip->getSpeed() || other->getVolume() != clip->getVolume() ||
+            other->getEffectCount() != clip->getEffectCount()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Edit a timeline and journal every edit; the clip add is last
+ * @return Number of records written
+ */
+uint64_t recordEdits(Timeline& timeline, EditJournal& journal) {
+    auto moved = timeline.getClip(timeline.findClip("clip_0"));
+    CHECK(timeline.moveClip(moved->getHandle(), 90000, 2));
+    journal.recordClipMoved(*moved);
+
+    auto faster = timeline.getClip(timeline.findClip("clip_1"));
+    faster->setSpeed(2.0f);
+    CHECK(timeline.touchClip(faster->getHandle()));
+    journal.recordClipSpeed(*faster);
+
+    auto quieter = timeline.getClip(timeline.findClip("clip_4"));
+    quieter->setVolume(0.25f);
+    CHECK(timeline.touchClip(quieter->getHandle()));
+    journal.recordClipVolume(*quieter);
+
+    CHECK(timeline.removeClip(timeline.findClip("clip_2")));
+    journal.recordClipRemoved("clip_2");
+
+    auto added = std::make_shared<VideoClip>("extra", "/sdcard/extra.mp4");
+    added->setStartPosition(120000);
+    added->setDuration(3000);
+    CHECK(timeline.addClip(added));
+    journal.recordClipAdded(*added);
+    return 5;
+}
+
+} // namespace
+
+int main() {
+    std::remove(JOURNAL_PATH);
+
+    Timeline edited;
+    tests::buildProject(edited, CLIP_COUNT);
+    uint64_t records = 0;
+    {
+        EditJournal journal;
+        CHECK(journal.open(JOURNAL_PATH));
+        CHECK(journal.reset(SNAPSHOT_SEQUENCE));
+        records = recordEdits(edited, journal);
+        CHECK(journal.sync());
+        CHECK(journal.getLastSequence() == SNAPSHOT_SEQUENCE + records);
+    }
+    const std::string intact = readFile(JOURNAL_PATH);
+
+    // Full replay reproduces the edited timeline
+    {
+        EditJournal journal;
+        CHECK(journal.open(JOURNAL_PATH));
+        CHECK(journal.getBaseSequence() == SNAPSHOT_SEQUENCE);
+        CHECK(journal.getLastSequence() == SNAPSHOT_SEQUENCE + records);
+
+        Timeline recovered;
+        tests::buildProject(recovered, CLIP_COUNT);
+        CHECK(journal.replay(recovered, SNAPSHOT_SEQUENCE) == records);
+        CHECK(sameClips(recovered, edited));
+
+        // Records the snapshot already holds are skipped
+        Timeline newer;
+        tests::buildProject(newer, CLIP_COUNT);
+        CHECK(journal.replay(newer, SNAPSHOT_SEQUENCE + 2) == records - 2);
+    }
+
+    // Torn last record: dropped on open, the rest replays
+    {
+        writeFile(JOURNAL_PATH, intact.substr(0, intact.size() - 3));
+        EditJournal journal;
+        CHECK(journal.open(JOURNAL_PATH));
+        CHECK(journal.getLastSequence() == SNAPSHOT_SEQUENCE + records - 1);
+
+        Timeline recovered;
+        tests::buildProject(recovered, CLIP_COUNT);
+        CHECK(journal.replay(recovered, SNAPSHOT_SEQUENCE) == records - 1);
+        CHECK(!recovered.getClip(recovered.findClip("extra")));
+        CHECK(recovered.getClipCount() == static_cast<size_t>(CLIP_COUNT) - 1);
+    }
+
+    // Trailing garbage after the last whole record
+    {
+        writeFile(JOURNAL_PATH, intact + std::string(11, '\x5a'));
+        EditJournal journal;
+        CHECK(journal.open(JOURNAL_PATH));
+        CHECK(journal.getLastSequence() == SNAPSHOT_SEQUENCE + records);
+
+        Timeline recovered;
+        tests::buildProject(recovered, CLIP_COUNT);
+        CHECK(journal.replay(recovered, SNAPSHOT_SEQUENCE) == records);
+        CHECK(sameClips(recovered, edited));
+    }
+
+    // Journal continues a newer snapshot than the one loaded: nothing applied
+    {
+        writeFile(JOURNAL_PATH, intact);
+        EditJournal journal;
+        CHECK(journal.open(JOURNAL_PATH));
+
+        Timeline stale;
+        tests::buildProject(stale, CLIP_COUNT);
+        Timeline untouched;
+        tests::buildProject(untouched, CLIP_COUNT);
+        CHECK(journal.getBaseSequence() > SNAPSHOT_SEQUENCE - 2);
+        CHECK(journal.replay(stale, SNAPSHOT_SEQUENCE - 2) == 0);
+        CHECK(sameClips(stale, untouched));
+    }
+
+    std::remove(JOURNAL_PATH);
+    return tests::testResult();
+}
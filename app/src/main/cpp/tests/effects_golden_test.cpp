@@ -0,0 +1,191 @@
+#include "test_util.h"
+#include "effects/effects_processor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * @file effects_golden_test.cpp
+ * @brief CPU effects against the GPU shaders
+ *
+ * The reference evaluates the fragment shaders in gpu/shader_sources.h
+ * per pixel in double precision, with clamp-to-edge sampling and an
+ * RGBA8 render target (rounded after each pass). EffectsProcessor must
+ * match it to within one 8-bit step per render pass, and its output must
+ * not depend on the thread count.
+ */
+
+using namespace clipforge;
+using models::EffectType;
+
+namespace {
+
+using Image = std::vector<uint8_t>;
+
+// ===== Shader reference =====
+
+size_t pixelOffset(int x, int y, int width) {
+    return (static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * 4;
+}
+
+uint8_t toUnorm8(double value) {
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0, 1.0) * 255.0));
+}
+
+/**
+ * @brief One pass of a per-pixel shader (FILTER_BW ... SPECIAL_VIGNETTE)
+ */
+Image renderPointShader(EffectType type, const Image& src, int width, int height) {
+    Image dst(src.size());
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            size_t offset = pixelOffset(x, y, width);
+            double in[4];
+            double out[4];
+            for (int c = 0; c < 4; ++c) out[c] = in[c] = src[offset + static_cast<size_t>(c)] / 255.0;
+
+            switch (type) {
+                case EffectType::FILTER_BW: {
+                    double gray = in[0] * 0.299 + in[1] * 0.587 + in[2] * 0.114;
+                    out[0] = out[1] = out[2] = gray;
+                    break;
+                }
+                case EffectType::SPECIAL_INVERT:
+                    for (int c = 0; c < 3; ++c) out[c] = 1.0 - in[c];
+                    break;
+                case EffectType::SPECIAL_POSTERIZE:
+                    for (int c = 0; c < 4; ++c) out[c] = std::floor(in[c] * 128.0) / 128.0;
+                    break;
+                case EffectType::SPECIAL_VIGNETTE: {
+                    double u = (x + 0.5) / width - 0.5;
+                    double v = (y + 0.5) / height - 0.5;
+                    double d = std::sqrt(u * u + v * v) * 1.414;
+                    double t = std::clamp((d - 0.8) / (0.2 - 0.8), 0.0, 1.0);
+                    double vignette = t * t * (3.0 - 2.0 * t);
+                    for (int c = 0; c < 3; ++c) out[c] = in[c] * vignette;
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            for (int c = 0; c < 4; ++c) dst[offset + static_cast<size_t>(c)] = toUnorm8(out[c]);
+        }
+    }
+    return dst;
+}
+
+/**
+ * @brief FRAGMENT_BLUR as GaussianBlurEffect runs it at HIGH quality
+ *
+ * A horizontal then a vertical pass, each into an RGBA8 target. The
+ * shader's merged bilinear taps read exactly the discrete Gaussian with
+ * clamp-to-edge, so that is evaluated directly: sigma = radius / 3,
+ * truncated at ceil(radius).
+ */
+Image renderBlurShader(const Image& src, int width, int height, double radius) {
+    int reach = static_cast<int>(std::ceil(radius));
+    double sigma = radius / 3.0;
+    std::vector<double> weights(static_cast<size_t>(reach) + 1);
+    double total = 0.0;
+    for (int k = 0; k <= reach; ++k) {
+        weights[static_cast<size_t>(k)] = std::exp(-k * k / (2.0 * sigma * sigma));
+        total += (k == 0 ? 1.0 : 2.0) * weights[static_cast<size_t>(k)];
+    }
+
+    auto pass = [&](const Image& in, int dx, int dy) {
+        Image out(in.size());
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < 4; ++c) {
+                    double sum = 0.0;
+                    for (int k = -reach; k <= reach; ++k) {
+                        int sx = std::clamp(x + k * dx, 0, width - 1);
+                        int sy = std::clamp(y + k * dy, 0, height - 1);
+                        sum += in[pixelOffset(sx, sy, width) + static_cast<size_t>(c)] / 255.0 *
+                               weights[static_cast<size_t>(std::abs(k))];
+                    }
+                    out[pixelOffset(x, y, width) + static_cast<size_t>(c)] = toUnorm8(sum / total);
+                }
+            }
+        }
+        return out;
+    };
+    return pass(pass(src, 1, 0), 0, 1);
+}
+
+Image renderShader(EffectType type, const Image& src, int width, int height) {
+    // 5 px is the blur radius parameter's default
+    return type == EffectType::BLUR_STANDARD ? renderBlurShader(src, width, height, 5.0)
+                                             : renderPointShader(type, src, width, height);
+}
+
+// ===== Helpers =====
+
+Image noiseImage(int width, int height, uint32_t seed) {
+    Image image(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    std::mt19937 rng(seed);
+    for (auto& byte : image) byte = static_cast<uint8_t>(rng());
+    return image;
+}
+
+models::EffectChain makeChain(std::initializer_list<EffectType> types) {
+    models::EffectChain chain;
+    for (EffectType type : types) {
+        chain.addEffect(std::make_shared<models::Effect>(type, "golden"));
+    }
+    return chain;
+}
+
+int maxDifference(const Image& a, const Image& b) {
+    int difference = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        difference = std::max(difference, std::abs(a[i] - b[i]));
+    }
+    return difference;
+}
+
+} // namespace
+
+int main() {
+    effects::EffectsProcessor single(1);
+    effects::EffectsProcessor pooled(8);
+
+    // Not a multiple of the 64 px tile, so edge tiles are partial
+    for (auto [width, height] : {std::pair{640, 360}, std::pair{333, 197}}) {
+        Image source = noiseImage(width, height, 1);
+        int stride = width * 4;
+
+        for (EffectType type : {EffectType::FILTER_BW, EffectType::SPECIAL_INVERT, EffectType::SPECIAL_POSTERIZE,
+                                EffectType::SPECIAL_VIGNETTE, EffectType::BLUR_STANDARD}) {
+            Image cpu = source;
+            CHECK(pooled.process(makeChain({type}), cpu.data(), width, height, stride));
+            int passes = type == EffectType::BLUR_STANDARD ? 2 : 1;
+            CHECK(maxDifference(cpu, renderShader(type, source, width, height)) <= passes);
+        }
+
+        // A chain renders as one shader pass per effect
+        Image cpu = source;
+        CHECK(pooled.process(makeChain({EffectType::FILTER_BW, EffectType::BLUR_STANDARD, EffectType::SPECIAL_VIGNETTE}),
+                             cpu.data(), width, height, stride));
+        Image golden = renderShader(EffectType::FILTER_BW, source, width, height);
+        golden = renderShader(EffectType::BLUR_STANDARD, golden, width, height);
+        golden = renderShader(EffectType::SPECIAL_VIGNETTE, golden, width, height);
+        CHECK(maxDifference(cpu, golden) <= 4);
+
+        // Tiling and thread count must not change a single byte
+        auto mixed = makeChain({EffectType::COLOR_BRIGHTNESS, EffectType::COLOR_CONTRAST, EffectType::FILTER_SEPIA,
+                                EffectType::BLUR_STANDARD, EffectType::SPECIAL_VIGNETTE});
+        Image a = source;
+        Image b = source;
+        CHECK(single.process(mixed, a.data(), width, height, stride));
+        CHECK(pooled.process(mixed, b.data(), width, height, stride));
+        CHECK(a == b);
+    }
+
+    return tests::testResult();
+}
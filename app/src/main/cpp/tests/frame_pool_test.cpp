@@ -0,0 +1,101 @@
+#include "test_util.h"
+#include "core/frame_buffer.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+ * @file frame_pool_test.cpp
+ * @brief FramePool reuse, free limit, counters and concurrent borrowing
+ *
+ * Several threads borrow buffers, stamp them with their own byte and
+ * check the stamp survives, so a buffer handed to two borrowers at once
+ * is caught. Buffers released after the pool is gone must not crash.
+ */
+
+using namespace clipforge;
+using namespace clipforge::core;
+
+int main() {
+    {
+        FramePool pool(2);
+        CHECK(pool.acquire(0, 10) == nullptr);
+
+        FrameBufferPtr first = pool.acquire(64, 32);
+        const FrameBuffer* address = first.get();
+        CHECK(first->getStride() == 64 * 4);
+        CHECK(pool.getStats().buffersInUse == 1);
+
+        first.reset();
+        FramePoolStats stats = pool.getStats();
+        CHECK(stats.buffersInUse == 0);
+        CHECK(stats.buffersFree == 1);
+
+        // Same byte size, new shape
+        FrameBufferPtr again = pool.acquire(32, 64);
+        CHECK(again.get() == address);
+        CHECK(again->getWidth() == 32);
+        CHECK(pool.getStats().reuses == 1);
+        CHECK(pool.getStats().allocations == 1);
+
+        FrameBufferPtr other = pool.acquire(16, 16);
+        CHECK(other.get() != address);
+        again.reset();
+        other.reset();
+        CHECK(pool.getStats().buffersFree == 2);
+        pool.clear();
+        CHECK(pool.getStats().buffersFree == 0);
+        CHECK(pool.getStats().bytesPooled == 0);
+    }
+
+    {
+        // Dropping many frames at once keeps only the free limit pooled
+        FramePool pool(2);
+        std::vector<FrameBufferPtr> frames;
+        for (int i = 0; i < 6; ++i) frames.push_back(pool.acquire(16, 16));
+        frames.clear();
+        FramePoolStats stats = pool.getStats();
+        CHECK(stats.buffersFree == 2);
+        CHECK(stats.bytesPooled == 2 * 16 * 16 * 4);
+    }
+
+    {
+        FramePool pool(4);
+        std::atomic<int> collisions{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&pool, &collisions, t] {
+                const uint8_t stamp = static_cast<uint8_t>(t + 1);
+                for (int i = 0; i < 20000; ++i) {
+                    FrameBufferPtr buffer = pool.acquire(16, 16);
+                    std::memset(buffer->data(), stamp, buffer->size());
+                    FrameBufferPtr shared = buffer;   // Extra borrower, as a cache would hold
+                    for (size_t b = 0; b < shared->size(); ++b) {
+                        if (shared->data()[b] != stamp) {
+                            collisions++;
+                            break;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        CHECK(collisions == 0);
+        FramePoolStats stats = pool.getStats();
+        CHECK(stats.buffersInUse == 0);
+        CHECK(stats.allocations <= 4);   // One buffer per thread at a time
+    }
+
+    // A buffer released after its pool
+    FrameBufferPtr survivor;
+    {
+        FramePool pool;
+        survivor = pool.acquire(8, 8);
+    }
+    survivor->data()[0] = 1;
+    survivor.reset();
+
+    return tests::testResult();
+}
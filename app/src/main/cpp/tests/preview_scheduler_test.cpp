@@ -0,0 +1,138 @@
+#include "test_util.h"
+#include "core/preview_scheduler.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file preview_scheduler_test.cpp
+ * @brief Headless PreviewScheduler playback with a synthetic frame source
+ *
+ * Plays 51 frames at 100 fps. Presented frames must arrive in order and,
+ * together with the dropped count, account for every frame exactly once,
+ * including when slow frames force drops and repeats. Stopping from the
+ * present and finished callbacks must not deadlock.
+ */
+
+using namespace clipforge;
+using namespace clipforge::core;
+
+namespace {
+
+constexpr float FRAME_RATE = 100.0f;
+constexpr int64_t END_MS = 500;
+constexpr int64_t FRAME_COUNT = 51;     // Frames 0-50
+
+/**
+ * @brief Wait for a condition, giving up after a few seconds
+ */
+template <typename Predicate>
+bool waitFor(Predicate done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+struct Session {
+    std::mutex mutex;
+    std::vector<int64_t> presented;
+    std::atomic<bool> finished{false};
+};
+
+/**
+ * @brief Play the whole range and check order and accounting
+ * @param slowRenders Frames whose rendering outlasts the decode-ahead queue
+ * @param slowPresents Frames whose presentation oversleeps later deadlines
+ */
+PreviewStats play(const std::vector<int64_t>& slowRenders, const std::vector<int64_t>& slowPresents) {
+    PreviewScheduler scheduler;
+    Session session;
+
+    auto source = [&slowRenders](int64_t index, int64_t, PreviewFrame&) {
+        for (int64_t slow : slowRenders) {
+            if (slow == index) std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        }
+        return true;
+    };
+    auto present = [&session, &slowPresents](const PreviewFrame& frame) {
+        {
+            std::lock_guard<std::mutex> lock(session.mutex);
+            session.presented.push_back(frame.frameIndex);
+        }
+        for (int64_t slow : slowPresents) {
+            if (slow == frame.frameIndex) std::this_thread::sleep_for(std::chrono::milliseconds(35));
+        }
+    };
+    CHECK(scheduler.start(source, FRAME_RATE, 0, END_MS, present, [&session] { session.finished = true; }));
+    CHECK(waitFor([&session] { return session.finished.load(); }));
+    CHECK(!scheduler.isRunning());
+
+    PreviewStats stats = scheduler.getStats();
+    std::lock_guard<std::mutex> lock(session.mutex);
+    CHECK(!session.presented.empty());
+    for (size_t i = 1; i < session.presented.size(); ++i) {
+        CHECK(session.presented[i] > session.presented[i - 1]);
+    }
+    CHECK(stats.framesPresented == static_cast<int64_t>(session.presented.size()));
+
+    // Each frame is either presented or dropped, never both or twice
+    CHECK(stats.framesPresented + stats.framesDropped == FRAME_COUNT);
+    return stats;
+}
+
+} // namespace
+
+int main() {
+    play({}, {});
+
+    // Renders stalled past the four frames decoded ahead: repeats, then drops
+    PreviewStats starved = play({15, 35}, {});
+    CHECK(starved.framesRepeated > 0);
+    CHECK(starved.framesDropped > 0);
+
+    // Presenter oversleeps while later frames are already queued
+    PreviewStats overslept = play({}, {10, 30});
+    CHECK(overslept.framesDropped > 0);
+
+    // stop() from the present callback
+    {
+        PreviewScheduler scheduler;
+        std::atomic<int> presentedAfterStop{0};
+        std::atomic<bool> stopped{false};
+        scheduler.start([](int64_t, int64_t, PreviewFrame&) { return true; }, FRAME_RATE, 0, END_MS,
+                        [&](const PreviewFrame& frame) {
+                            if (stopped) presentedAfterStop++;
+                            if (frame.frameIndex >= 5 && !stopped) {
+                                stopped = true;
+                                scheduler.stop();
+                            }
+                        });
+        CHECK(waitFor([&stopped] { return stopped.load(); }));
+        CHECK(!scheduler.isRunning());
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        CHECK(presentedAfterStop == 0);
+    }
+
+    // stop() from the finished callback, then a restart
+    {
+        PreviewScheduler scheduler;
+        std::atomic<int> finishedCount{0};
+        auto source = [](int64_t, int64_t, PreviewFrame&) { return true; };
+        auto onFinished = [&] {
+            finishedCount++;
+            scheduler.stop();
+        };
+        CHECK(scheduler.start(source, FRAME_RATE, 400, END_MS, nullptr, onFinished));
+        CHECK(waitFor([&finishedCount] { return finishedCount == 1; }));
+        CHECK(scheduler.start(source, FRAME_RATE, 400, END_MS, nullptr, onFinished));
+        CHECK(waitFor([&finishedCount] { return finishedCount == 2; }));
+        CHECK(!scheduler.isRunning());
+    }
+
+    return tests::testResult();
+}
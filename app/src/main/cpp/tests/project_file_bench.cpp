@@ -0,0 +1,226 @@
+#include "test_util.h"
+#include "timeline_fixture.h"
+#include "models/project_file.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file project_file_bench.cpp
+ * @brief Project load time: binary ProjectFile against a JSON baseline
+ *
+ * The baseline is what a straightforward JSON save would cost: the same
+ * fields written as text, parsed into a DOM and rebuilt into a timeline.
+ * Both sides are timed warm (file in the page cache), best of five.
+ */
+
+using namespace clipforge;
+using namespace clipforge::models;
+
+namespace {
+
+const char* BINARY_PATH = "project_file_bench.cfproj";
+const char* JSON_PATH = "project_file_bench.json";
+
+// ===== JSON baseline =====
+
+struct JsonValue {
+    double number = 0.0;
+    std::string text;
+    std::vector<std::pair<std::string, JsonValue>> members;
+    std::vector<JsonValue> items;
+
+    const JsonValue& operator[](const char* key) const {
+        static const JsonValue missing;
+        for (const auto& member : members) {
+            if (member.first == key) return member.second;
+        }
+        return missing;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const char* input) : m_p(input) {}
+
+    JsonValue parseValue() {
+        skipSpace();
+        JsonValue value;
+        if (*m_p == '{') {
+            ++m_p;
+            for (skipSpace(); *m_p != '}'; skipSpace()) {
+                std::string key = parseString();
+                skipSpace();
+                ++m_p;  // ':'
+                value.members.emplace_back(std::move(key), parseValue());
+            }
+            ++m_p;
+        } else if (*m_p == '[') {
+            ++m_p;
+            for (skipSpace(); *m_p != ']'; skipSpace()) {
+                value.items.push_back(parseValue());
+            }
+            ++m_p;
+        } else if (*m_p == '"') {
+            value.text = parseString();
+        } else {
+            char* end = nullptr;
+            value.number = std::strtod(m_p, &end);
+            m_p = end;
+        }
+        return value;
+    }
+
+private:
+    const char* m_p;
+
+    void skipSpace() {
+        while (*m_p == ' ' || *m_p == '\n' || *m_p == ',') ++m_p;
+    }
+
+    std::string parseString() {
+        std::string result;
+        for (++m_p; *m_p != '"'; ++m_p) {
+            if (*m_p == '\\') ++m_p;
+            result += *m_p;
+        }
+        ++m_p;
+        return result;
+    }
+};
+
+std::string quoted(const std::string& value) {
+    return "\"" + value + "\"";
+}
+
+void writeJson(const Timeline& timeline, const std::string& path) {
+    std::ostringstream out;
+    out.precision(9);
+    out << "{\"clips\":[";
+    for (const auto& clip : timeline.getAllClips()) {
+        const VideoClipMetadata& metadata = clip->getMetadata();
+        out << "{\"id\":" << quoted(clip->getId()) << ",\"name\":" << quoted(clip->getName())
+            << ",\"source\":" << quoted(clip->getSourceFile()) << ",\"start\":" << clip->getStartPosition()
+            << ",\"duration\":" << clip->getDuration() << ",\"track\":" << clip->getTrackIndex()
+            << ",\"trimStart\":" << clip->getTrimStart() << ",\"trimEnd\":" << clip->getTrimEnd()
+            << ",\"speed\":" << clip->getSpeed() << ",\"volume\":" << clip->getVolume()
+            << ",\"codec\":" << quoted(metadata.codecName) << ",\"mime\":" << quoted(metadata.mimeType)
+            << ",\"width\":" << metadata.width << ",\"height\":" << metadata.height
+            << ",\"frameRate\":" << metadata.frameRate << ",\"bitRate\":" << metadata.bitRate
+            << ",\"fileSize\":" << metadata.fileSize << ",\"sourceDuration\":" << metadata.duration
+            << ",\"effects\":[";
+        for (const auto& effect : clip->getEffects()) {
+            out << "{\"type\":" << static_cast<int>(effect->getType()) << ",\"name\":" << quoted(effect->getName())
+                << ",\"intensity\":" << effect->getIntensity() << ",\"enabled\":" << effect->isEnabled()
+                << ",\"parameters\":[";
+            for (const auto& parameter : effect->getParameters()) {
+                out << "{\"name\":" << quoted(parameter.name) << ",\"value\":" << parameter.value
+                    << ",\"min\":" << parameter.minValue << ",\"max\":" << parameter.maxValue
+                    << ",\"default\":" << parameter.defaultValue << "},";
+            }
+            out << "]},";
+        }
+        out << "]},";
+    }
+    out << "]}";
+    std::ofstream(path) << out.str();
+}
+
+size_t loadJson(const std::string& path, Timeline& timeline) {
+    std::ifstream in(path);
+    std::string text(std::istreambuf_iterator<char>(in), {});
+    JsonValue root = JsonParser(text.c_str()).parseValue();
+
+    timeline.clearClips();
+    timeline.beginBatch();
+    for (const auto& item : root["clips"].items) {
+        auto clip = std::make_shared<VideoClip>(item["id"].text, item["source"].text);
+        clip->setName(item["name"].text);
+        clip->setStartPosition(static_cast<int64_t>(item["start"].number));
+        clip->setDuration(static_cast<int64_t>(item["duration"].number));
+        clip->setTrackIndex(static_cast<int>(item["track"].number));
+        clip->setTrimStart(static_cast<int64_t>(item["trimStart"].number));
+        clip->setTrimEnd(static_cast<int64_t>(item["trimEnd"].number));
+        clip->setSpeed(static_cast<float>(item["speed"].number));
+        clip->setVolume(static_cast<float>(item["volume"].number));
+
+        VideoClipMetadata metadata = clip->getMetadata();
+        metadata.codecName = item["codec"].text;
+        metadata.mimeType = item["mime"].text;
+        metadata.width = static_cast<int>(item["width"].number);
+        metadata.height = static_cast<int>(item["height"].number);
+        metadata.frameRate = static_cast<float>(item["frameRate"].number);
+        metadata.bitRate = static_cast<int64_t>(item["bitRate"].number);
+        metadata.fileSize = static_cast<int64_t>(item["fileSize"].number);
+        metadata.duration = static_cast<int64_t>(item["sourceDuration"].number);
+        clip->setMetadata(metadata);
+
+        for (const auto& effectItem : item["effects"].items) {
+            auto effect = std::make_shared<Effect>(static_cast<EffectType>(static_cast<int>(effectItem["type"].number)),
+                                                   effectItem["name"].text);
+            for (const auto& parameter : effectItem["parameters"].items) {
+                effect->addParameter(EffectParameter(parameter["name"].text, static_cast<float>(parameter["value"].number),
+                                                     static_cast<float>(parameter["min"].number),
+                                                     static_cast<float>(parameter["max"].number),
+                                                     static_cast<float>(parameter["default"].number)));
+            }
+            effect->setIntensity(static_cast<float>(effectItem["intensity"].number));
+            effect->setEnabled(effectItem["enabled"].number != 0.0);
+            clip->applyEffect(effect);
+        }
+        timeline.addClip(clip);
+    }
+    timeline.commitBatch();
+    return timeline.getClipCount();
+}
+
+size_t fileSize(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return static_cast<size_t>(in.tellg());
+}
+
+} // namespace
+
+int main() {
+    std::printf("%8s %10s %10s %10s %12s %10s %10s\n", "clips", "bin KB", "json KB", "open ms", "summaries ms",
+                "load ms", "json ms");
+
+    for (int clipCount : {1000, 10000, 50000}) {
+        Timeline timeline(3840, 2160, 60.0f);
+        tests::buildProject(timeline, clipCount);
+        CHECK(ProjectFileWriter::write(BINARY_PATH, timeline));
+        writeJson(timeline, JSON_PATH);
+
+        double openMs = tests::bestTimeMs(5, [] { CHECK(ProjectFile::open(BINARY_PATH) != nullptr); });
+
+        auto project = ProjectFile::open(BINARY_PATH);
+        if (!project) break;
+        int64_t startSum = 0;
+        double summaryMs = tests::bestTimeMs(5, [&] {
+            for (size_t i = 0; i < project->getClipCount(); ++i) {
+                startSum += project->getClipInfo(i).startPosition;
+            }
+        });
+        double loadMs = tests::bestTimeMs(5, [&] {
+            Timeline loaded;
+            CHECK(project->loadTimeline(loaded));
+        });
+        double jsonMs = tests::bestTimeMs(5, [&] {
+            Timeline loaded;
+            CHECK(loadJson(JSON_PATH, loaded) == static_cast<size_t>(clipCount));
+        });
+
+        std::printf("%8d %10zu %10zu %10.3f %12.3f %10.2f %10.2f\n", clipCount, fileSize(BINARY_PATH) / 1024,
+                    fileSize(JSON_PATH) / 1024, openMs, summaryMs, loadMs, jsonMs);
+        CHECK(startSum > 0);
+    }
+
+    std::remove(BINARY_PATH);
+    std::remove(JSON_PATH);
+    return tests::testResult();
+}
@@ -0,0 +1,151 @@
+#include "test_util.h"
+#include "timeline_fixture.h"
+#include "models/project_file.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace clipforge;
+using namespace clipforge::models;
+
+namespace {
+
+const char* PROJECT_PATH = "project_file_test.cfproj";
+const char* DAMAGED_PATH = "project_file_test_damaged.cfproj";
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+bool sameClip(const VideoClip& a, const VideoClip& b) {
+    const VideoClipMetadata& ma = a.getMetadata();
+    const VideoClipMetadata& mb = b.getMetadata();
+    if (a.getName() != b.getName() || a.getSourceFile() != b.getSourceFile() ||
+        a.getStartPosition() != b.getStartPosition() || a.getDuration() != b.getDuration() ||
+        a.getTrackIndex() != b.getTrackIndex() || a.getTrimStart() != b.getTrimStart() ||
+        a.getTrimEnd() != b.getTrimEnd() || a.getSpeed() != b.getSpeed() || a.getVolume() != b.getVolume() ||
+        ma.codecName != mb.codecName || ma.mimeType != mb.mimeType || ma.fileSize != mb.fileSize ||
+        ma.frameRate != mb.frameRate || ma.width != mb.width || ma.bitRate != mb.bitRate ||
+        a.getEffectCount() != b.getEffectCount()) {
+        return false;
+    }
+
+    for (size_t e = 0; e < a.getEffectCount(); ++e) {
+        const Effect& x = *a.getEffects()[e];
+        const Effect& y = *b.getEffects()[e];
+        if (x.getType() != y.getType() || x.getName() != y.getName() || x.getIntensity() != y.getIntensity() ||
+            x.isEnabled() != y.isEnabled() || x.getParameters().size() != y.getParameters().size()) {
+            return false;
+        }
+        for (size_t p = 0; p < x.getParameters().size(); ++p) {
+            const EffectParameter& u = x.getParameters()[p];
+            const EffectParameter& v = y.getParameters()[p];
+            if (u.name != v.name || u.value != v.value || u.minValue != v.minValue ||
+                u.maxValue != v.maxValue || u.defaultValue != v.defaultValue) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void testRoundTrip(const Timeline& original) {
+    CHECK(ProjectFileWriter::write(PROJECT_PATH, original, 42));
+
+    auto project = ProjectFile::open(PROJECT_PATH);
+    CHECK(project != nullptr);
+    if (!project) return;
+
+    CHECK(project->getClipCount() == original.getClipCount());
+    CHECK(project->getJournalSequence() == 42);
+    CHECK(project->getClipInfo(0).startPosition == original.getAllClips()[0]->getStartPosition());
+    CHECK(project->getClipInfo(project->getClipCount()).id.empty());
+    CHECK(project->loadClip(project->getClipCount()) == nullptr);
+
+    Timeline loaded;
+    CHECK(project->loadTimeline(loaded));
+    CHECK(loaded.getClipCount() == original.getClipCount());
+    CHECK(!loaded.hasChanges());
+
+    int mismatches = 0;
+    for (const auto& clip : original.getAllClips()) {
+        auto copy = loaded.getClip(loaded.findClip(clip->getId()));
+        if (!copy || !sameClip(*clip, *copy)) ++mismatches;
+    }
+    CHECK(mismatches == 0);
+
+    auto track = original.getAllAudioTracks().front();
+    auto loadedTrack = loaded.getAudioTrack(loaded.findAudioTrack(track->getId()));
+    CHECK(loadedTrack != nullptr);
+    if (loadedTrack) {
+        CHECK(loadedTrack->getName() == track->getName());
+        CHECK(loadedTrack->getSourceFile() == track->getSourceFile());
+        CHECK(loadedTrack->getVolume() == track->getVolume());
+        CHECK(loadedTrack->getPan() == track->getPan());
+        CHECK(loadedTrack->isMuted() == track->isMuted());
+        CHECK(loadedTrack->getPitchShift() == track->getPitchShift());
+    }
+
+    const TimelineProperties& properties = loaded.getProperties();
+    CHECK(properties.colorSpace == original.getProperties().colorSpace);
+    CHECK(properties.width == original.getProperties().width);
+    CHECK(properties.maxTracks == original.getProperties().maxTracks);
+    CHECK(properties.useHardwareAccel == original.getProperties().useHardwareAccel);
+    CHECK(loaded.getCurrentPosition() == original.getCurrentPosition());
+}
+
+void testTruncated(const std::string& bytes) {
+    for (size_t length : {size_t{0}, size_t{16}, bytes.size() / 2, bytes.size() - 1}) {
+        writeFile(DAMAGED_PATH, bytes.substr(0, length));
+        CHECK(ProjectFile::open(DAMAGED_PATH) == nullptr);
+    }
+}
+
+void testCorrupted(const std::string& bytes) {
+    // Header field, first clip record, the middle of the tables, last string byte
+    for (size_t offset : {size_t{16}, size_t{512}, bytes.size() / 2, bytes.size() - 1}) {
+        std::string damaged = bytes;
+        damaged[offset] = static_cast<char>(damaged[offset] ^ 0x55);
+        writeFile(DAMAGED_PATH, damaged);
+        CHECK(ProjectFile::open(DAMAGED_PATH) == nullptr);
+    }
+
+    std::string wrongVersion = bytes;
+    wrongVersion[4] = static_cast<char>(wrongVersion[4] + 1);
+    writeFile(DAMAGED_PATH, wrongVersion);
+    CHECK(ProjectFile::open(DAMAGED_PATH) == nullptr);
+
+    CHECK(ProjectFile::open("project_file_test_missing.cfproj") == nullptr);
+}
+
+} // namespace
+
+int main() {
+    Timeline timeline(3840, 2160, 60.0f);
+    tests::buildProject(timeline, 2000);
+
+    testRoundTrip(timeline);
+
+    std::string bytes = readFile(PROJECT_PATH);
+    CHECK(bytes.size() > 1024);
+    testTruncated(bytes);
+    testCorrupted(bytes);
+
+    // An empty timeline round-trips too
+    Timeline empty;
+    CHECK(ProjectFileWriter::write(PROJECT_PATH, empty));
+    auto project = ProjectFile::open(PROJECT_PATH);
+    Timeline loaded;
+    CHECK(project && project->loadTimeline(loaded) && loaded.getClipCount() == 0);
+
+    std::remove(PROJECT_PATH);
+    std::remove(DAMAGED_PATH);
+    return tests::testResult();
+}
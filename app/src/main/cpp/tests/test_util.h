@@ -0,0 +1,62 @@
+#ifndef CLIPFORGE_TEST_UTIL_H
+#define CLIPFORGE_TEST_UTIL_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+/**
+ * @file test_util.h
+ * @brief Minimal assertion and timing helpers for host tests and benchmarks
+ *
+ * Tests are plain executables: CHECK records failures and keeps going,
+ * and main() returns testResult() so ctest sees a non-zero exit.
+ */
+
+namespace clipforge {
+namespace tests {
+
+inline int& failureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+/**
+ * @brief Exit code for a test's main()
+ */
+inline int testResult() {
+    if (failureCount() > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failureCount());
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Best wall time of several runs, in milliseconds
+ */
+template <typename Fn>
+double bestTimeMs(int runs, Fn&& fn) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < runs; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+} // namespace tests
+} // namespace clipforge
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++clipforge::tests::failureCount();                                       \
+        }                                                                             \
+    } while (0)
+
+#endif // CLIPFORGE_TEST_UTIL_H
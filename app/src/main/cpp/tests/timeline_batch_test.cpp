@@ -0,0 +1,95 @@
+#include "test_util.h"
+#include "models/timeline.h"
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @file timeline_batch_test.cpp
+ * @brief Batched Timeline edits against the same edits applied one by one
+ *
+ * After commitBatch() the clip list, duration and time lookups must
+ * match an unbatched timeline, including when a batch removes a clip
+ * and adds the same object back.
+ */
+
+using namespace clipforge;
+using namespace clipforge::models;
+
+namespace {
+
+using ClipList = std::vector<std::shared_ptr<VideoClip>>;
+
+ClipList makeClips(int count) {
+    std::mt19937 rng(4);
+    ClipList clips;
+    for (int i = 0; i < count; ++i) {
+        char id[16];
+        std::snprintf(id, sizeof(id), "c%d", i);
+        auto clip = std::make_shared<VideoClip>(id, "/a.mp4");
+        clip->setTrackIndex(static_cast<int32_t>(rng() % 3));
+        clip->setStartPosition(static_cast<int64_t>(rng() % 60000));
+        clip->setDuration(static_cast<int64_t>(1 + rng() % 5000));
+        clips.push_back(clip);
+    }
+    return clips;
+}
+
+bool sameTimeline(const Timeline& a, const Timeline& b) {
+    if (a.getClipCount() != b.getClipCount() || a.getTotalDuration() != b.getTotalDuration()) return false;
+    for (size_t i = 0; i < a.getClipCount(); ++i) {
+        if (a.getAllClips()[i]->getId() != b.getAllClips()[i]->getId()) return false;
+    }
+    for (int64_t time = 0; time < a.getTotalDuration(); time += 997) {
+        ClipList atA = a.getClipsAtTime(time);
+        ClipList atB = b.getClipsAtTime(time);
+        if (atA.size() != atB.size()) return false;
+        for (size_t i = 0; i < atA.size(); ++i) {
+            if (atA[i]->getId() != atB[i]->getId()) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    ClipList clips = makeClips(300);
+
+    Timeline single;
+    for (const auto& clip : makeClips(300)) single.addClip(clip);
+
+    // Nested batches apply once, at the outermost commit
+    Timeline batched;
+    batched.beginBatch();
+    batched.beginBatch();
+    for (size_t i = 0; i < 150; ++i) CHECK(batched.addClip(clips[i]));
+    batched.commitBatch();
+    CHECK(batched.isInBatch());
+    for (size_t i = 150; i < clips.size(); ++i) CHECK(batched.addClip(clips[i]));
+    batched.commitBatch();
+    CHECK(!batched.isInBatch());
+    CHECK(sameTimeline(batched, single));
+
+    // Remove clips and add the same objects back in one batch
+    batched.beginBatch();
+    for (size_t i = 0; i < clips.size(); i += 7) {
+        CHECK(batched.removeClip(batched.findClip(clips[i]->getId())));
+        CHECK(batched.addClip(clips[i]));
+    }
+    batched.commitBatch();
+    CHECK(batched.getClipCount() == clips.size());
+    CHECK(sameTimeline(batched, single));
+
+    // Remove, re-add and remove again leaves the clip out
+    batched.beginBatch();
+    CHECK(batched.removeClip(batched.findClip(clips[3]->getId())));
+    CHECK(batched.addClip(clips[3]));
+    CHECK(batched.removeClip(batched.findClip(clips[3]->getId())));
+    batched.commitBatch();
+    CHECK(single.removeClip(single.findClip(clips[3]->getId())));
+    CHECK(sameTimeline(batched, single));
+
+    return tests::testResult();
+}
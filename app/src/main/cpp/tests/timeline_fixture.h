@@ -0,0 +1,78 @@
+#ifndef CLIPFORGE_TIMELINE_FIXTURE_H
+#define CLIPFORGE_TIMELINE_FIXTURE_H
+
+#include "models/timeline.h"
+#include <memory>
+#include <random>
+#include <string>
+
+namespace clipforge {
+namespace tests {
+
+/**
+ * @brief Fill a timeline with a realistic project
+ *
+ * Three tracks of back-to-back clips with source metadata, zero to three
+ * effects each, and one audio track. Deterministic for a given seed.
+ */
+inline void buildProject(models::Timeline& timeline, int clipCount, uint32_t seed = 9) {
+    using namespace models;
+    std::mt19937 rng(seed);
+
+    TimelineProperties properties = timeline.getProperties();
+    properties.colorSpace = "BT.2020";
+    properties.maxTracks = 5;
+    properties.useHardwareAccel = false;
+    timeline.setProperties(properties);
+
+    timeline.beginBatch();
+    for (int i = 0; i < clipCount; ++i) {
+        auto clip = std::make_shared<VideoClip>("clip_" + std::to_string(i),
+                                                "/sdcard/DCIM/Camera/VID_" + std::to_string(i % 300) + ".mp4");
+        clip->setStartPosition((i / 3) * 2000);
+        clip->setTrackIndex(i % 3);
+        clip->setDuration(1500 + rng() % 400);
+        clip->setTrimStart(rng() % 1000);
+        clip->setTrimEnd(5000 + rng() % 1000);
+        clip->setSpeed(0.5f + static_cast<float>(rng() % 10) / 4.0f);
+        clip->setVolume(static_cast<float>(rng() % 20) / 10.0f);
+
+        VideoClipMetadata metadata = clip->getMetadata();
+        metadata.codecName = "h264";
+        metadata.mimeType = "video/avc";
+        metadata.width = 1920;
+        metadata.height = 1080;
+        metadata.frameRate = 29.97f;
+        metadata.bitRate = 12000000;
+        metadata.fileSize = 123456789 + i;
+        metadata.duration = 60000;
+        clip->setMetadata(metadata);
+
+        int effectCount = static_cast<int>(rng() % 4);
+        for (int e = 0; e < effectCount; ++e) {
+            bool blur = e % 2 != 0;
+            auto effect = std::make_shared<Effect>(blur ? EffectType::BLUR_STANDARD : EffectType::COLOR_CONTRAST,
+                                                   "fx" + std::to_string(e));
+            effect->setParameterValue(blur ? "radius" : "contrast", 1.0f + static_cast<float>(rng() % 10) / 7.0f);
+            effect->setIntensity(0.3f);
+            effect->setEnabled(e != 2);
+            clip->applyEffect(effect);
+        }
+        timeline.addClip(clip);
+    }
+    timeline.commitBatch();
+
+    auto track = timeline.getAudioTrack(timeline.addAudioTrack("Music", "music"));
+    track->setVolume(0.7f);
+    track->setPan(-0.3f);
+    track->setMuted(true);
+    track->setSourceFile("/sdcard/song.mp3");
+    track->setPitchShift(2.0f);
+
+    timeline.setCurrentPosition(12345);
+}
+
+} // namespace tests
+} // namespace clipforge
+
+#endif // CLIPFORGE_TIMELINE_FIXTURE_H
@@ -0,0 +1,90 @@
+#include "test_util.h"
+#include "models/timeline.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file timeline_import_bench.cpp
+ * @brief Clip import throughput, before and after batched edits
+ *
+ * "before" replays what Timeline::addClip used to do on every insertion
+ * (append, full sort, duration rescan) on a plain vector. The other rows
+ * are the current Timeline, one addClip at a time and inside
+ * beginBatch()/commitBatch().
+ */
+
+using namespace clipforge;
+using namespace clipforge::models;
+
+namespace {
+
+using ClipList = std::vector<std::shared_ptr<VideoClip>>;
+
+ClipList makeClips(int count) {
+    std::mt19937 rng(2);
+    ClipList clips;
+    clips.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        char id[16];
+        std::snprintf(id, sizeof(id), "c%d", i);
+        auto clip = std::make_shared<VideoClip>(id, "/a.mp4");
+        clip->setTrackIndex(static_cast<int>(rng() % 3));
+        clip->setStartPosition(rng() % 3600000);
+        clip->setDuration(1 + rng() % 20000);
+        clips.push_back(clip);
+    }
+    return clips;
+}
+
+/**
+ * @brief The pre-batch insertion path
+ */
+void importSortEveryInsert(const ClipList& clips) {
+    ClipList list;
+    std::unordered_map<std::string, std::shared_ptr<VideoClip>> map;
+    int64_t duration = 0;
+    for (const auto& clip : clips) {
+        list.push_back(clip);
+        map[clip->getId()] = clip;
+        std::sort(list.begin(), list.end(), [](const auto& a, const auto& b) {
+            if (a->getTrackIndex() != b->getTrackIndex()) return a->getTrackIndex() < b->getTrackIndex();
+            return a->getStartPosition() < b->getStartPosition();
+        });
+        duration = 0;
+        for (const auto& entry : list) duration = std::max(duration, entry->getEndPosition());
+    }
+    CHECK(duration > 0 && list.size() == clips.size());
+}
+
+} // namespace
+
+int main() {
+    std::printf("%8s %14s %14s %14s %14s\n", "clips", "before ms", "addClip ms", "batched ms", "clips/s batched");
+
+    for (int count : {1000, 5000, 10000}) {
+        ClipList clips = makeClips(count);
+
+        double beforeMs = tests::bestTimeMs(1, [&] { importSortEveryInsert(clips); });
+        double singleMs = tests::bestTimeMs(3, [&] {
+            Timeline timeline;
+            for (const auto& clip : clips) timeline.addClip(clip);
+            CHECK(timeline.getClipCount() == clips.size());
+        });
+        double batchedMs = tests::bestTimeMs(3, [&] {
+            Timeline timeline;
+            timeline.beginBatch();
+            for (const auto& clip : clips) timeline.addClip(clip);
+            timeline.commitBatch();
+            CHECK(timeline.getClipCount() == clips.size());
+        });
+
+        std::printf("%8d %14.2f %14.2f %14.2f %14.0f\n", count, beforeMs, singleMs, batchedMs,
+                    count / (batchedMs / 1000.0));
+    }
+    return tests::testResult();
+}
@@ -0,0 +1,75 @@
+#include "test_util.h"
+#include "models/timeline.h"
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file timeline_lookup_bench.cpp
+ * @brief Per-frame clip lookup on a 10k-clip timeline
+ *
+ * Scrubs an hour of timeline at 30 fps through the interval index and
+ * through a linear scan of every clip (the lookup before the index),
+ * after a round of moves and removals so the index is not fresh.
+ */
+
+using namespace clipforge;
+using namespace clipforge::models;
+
+int main() {
+    constexpr int CLIP_COUNT = 10000;
+    constexpr int64_t HOUR_MS = 3600000;
+    constexpr int64_t FRAME_MS = 33;
+
+    std::vector<std::string> ids(CLIP_COUNT);
+    for (int i = 0; i < CLIP_COUNT; ++i) {
+        char id[16];
+        std::snprintf(id, sizeof(id), "c%d", i);
+        ids[static_cast<size_t>(i)] = id;
+    }
+
+    Timeline timeline;
+    std::mt19937 rng(1);
+    timeline.beginBatch();
+    for (const auto& id : ids) {
+        auto clip = std::make_shared<VideoClip>(id, "/a.mp4");
+        clip->setTrackIndex(static_cast<int>(rng() % 3));
+        clip->setStartPosition(rng() % HOUR_MS);
+        clip->setDuration(1 + rng() % 20000);
+        timeline.addClip(clip);
+    }
+    timeline.commitBatch();
+    for (int i = 0; i < 2000; ++i) {
+        ClipHandle clip = timeline.findClip(ids[rng() % CLIP_COUNT]);
+        timeline.moveClip(clip, rng() % HOUR_MS, static_cast<int>(rng() % 4));
+    }
+    for (int i = 0; i < 500; ++i) {
+        timeline.removeClip(timeline.findClip(ids[rng() % CLIP_COUNT]));
+    }
+
+    size_t indexed = 0;
+    size_t scanned = 0;
+    double indexMs = tests::bestTimeMs(3, [&] {
+        indexed = 0;
+        for (int64_t t = 0; t < HOUR_MS; t += FRAME_MS) {
+            indexed += timeline.getClipsAtTime(t).size();
+        }
+    });
+    double scanMs = tests::bestTimeMs(3, [&] {
+        scanned = 0;
+        for (int64_t t = 0; t < HOUR_MS; t += FRAME_MS) {
+            for (const auto& clip : timeline.getAllClips()) {
+                if (clip->getStartPosition() <= t && clip->getEndPosition() >= t) ++scanned;
+            }
+        }
+    });
+    CHECK(indexed == scanned);
+
+    double frames = static_cast<double>(HOUR_MS / FRAME_MS);
+    std::printf("%zu clips, %.0f frames\n", timeline.getClipCount(), frames);
+    std::printf("  interval index  %8.3f us/frame\n", indexMs * 1000.0 / frames);
+    std::printf("  linear scan     %8.3f us/frame\n", scanMs * 1000.0 / frames);
+    return tests::testResult();
+}
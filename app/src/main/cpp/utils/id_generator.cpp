@@ -0,0 +1,36 @@
+#include "id_generator.h"
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+namespace clipforge {
+namespace utils {
+
+namespace {
+
+uint32_t sessionTag() {
+    // random_device may be deterministic on some platforms; mix in the clock
+    static const uint32_t tag = [] {
+        std::random_device device;
+        auto now = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        return device() ^ static_cast<uint32_t>(now) ^ static_cast<uint32_t>(now >> 32);
+    }();
+    return tag;
+}
+
+std::atomic<uint64_t> g_counter{0};
+
+} // namespace
+
+std::string generateId(const char* prefix) {
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "_%08" PRIx32 "_%" PRIu64, sessionTag(),
+             g_counter.fetch_add(1, std::memory_order_relaxed) + 1);
+    return prefix + std::string(suffix);
+}
+
+} // namespace utils
+} // namespace clipforge
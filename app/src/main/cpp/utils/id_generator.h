@@ -0,0 +1,23 @@
+#ifndef CLIPFORGE_ID_GENERATOR_H
+#define CLIPFORGE_ID_GENERATOR_H
+
+#include <string>
+
+namespace clipforge {
+namespace utils {
+
+/**
+ * @brief Generate a unique, persistent ID for a clip, effect or track
+ * @param prefix Kind of object, e.g. "clip"
+ * @return ID of the form prefix_<session>_<counter>
+ *
+ * Thread-safe. The counter is atomic, so IDs never repeat within a
+ * process; the random session tag keeps IDs from earlier sessions that
+ * were saved into a project from colliding with new ones.
+ */
+std::string generateId(const char* prefix);
+
+} // namespace utils
+} // namespace clipforge
+
+#endif // CLIPFORGE_ID_GENERATOR_H
@@ -1,6 +1,9 @@
 #include "logger.h"
+#ifdef __ANDROID__
 #include <android/log.h>
+#endif
 #include <cstdarg>
+#include <cstdio>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
@@ -253,6 +256,7 @@ std::string Logger::getThreadId() {
 
 void Logger::logToLogcat(LogLevel level, const std::string& tag,
                         const std::string& message) {
+#ifdef __ANDROID__
     int androidLevel;
     switch (level) {
         case LogLevel::VERBOSE: androidLevel = ANDROID_LOG_VERBOSE; break;
@@ -265,6 +269,10 @@ void Logger::logToLogcat(LogLevel level, const std::string& tag,
     }
 
     __android_log_print(androidLevel, tag.c_str(), "%s", message.c_str());
+#else
+    // Host builds (tests, benchmarks) have no logcat
+    std::fprintf(stderr, "[%s] %s: %s\n", levelToString(level).c_str(), tag.c_str(), message.c_str());
+#endif
 }
 
 // ============================================================================
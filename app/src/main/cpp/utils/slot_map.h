@@ -0,0 +1,177 @@
+#ifndef CLIPFORGE_SLOT_MAP_H
+#define CLIPFORGE_SLOT_MAP_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace clipforge {
+namespace utils {
+
+/**
+ * @class SlotHandle
+ * @brief 64-bit handle to an object in a SlotMap
+ *
+ * Low 32 bits are the slot index, high 32 bits the slot's generation
+ * when the object was inserted. The tag only keeps handles of different
+ * maps (clips, tracks) from being mixed up. A default handle is null.
+ */
+template <typename Tag>
+class SlotHandle {
+public:
+    constexpr SlotHandle() = default;
+
+    [[nodiscard]] static constexpr SlotHandle fromBits(uint64_t bits) { return SlotHandle(bits); }
+    [[nodiscard]] constexpr uint64_t toBits() const { return m_bits; }
+
+    [[nodiscard]] constexpr uint32_t index() const { return static_cast<uint32_t>(m_bits); }
+    [[nodiscard]] constexpr uint32_t generation() const { return static_cast<uint32_t>(m_bits >> 32); }
+    [[nodiscard]] constexpr bool isValid() const { return m_bits != 0; }
+    explicit constexpr operator bool() const { return isValid(); }
+
+    constexpr bool operator==(const SlotHandle& other) const { return m_bits == other.m_bits; }
+    constexpr bool operator!=(const SlotHandle& other) const { return m_bits != other.m_bits; }
+
+private:
+    template <typename, typename> friend class SlotMap;
+
+    uint64_t m_bits = 0;
+
+    explicit constexpr SlotHandle(uint64_t bits) : m_bits(bits) {}
+    constexpr SlotHandle(uint32_t index, uint32_t generation)
+        : m_bits((static_cast<uint64_t>(generation) << 32) | index) {}
+};
+
+/**
+ * @class SlotMap
+ * @brief Dense object store addressed by generational handles
+ *
+ * Values live contiguously in insertion order until an erase moves the
+ * last value into the hole, so iteration is a plain array walk. Each
+ * slot records where its value sits and bumps its generation when the
+ * value is erased, which makes stale handles miss instead of reaching
+ * whatever reuses the slot. Lookup is two array reads, with no hashing.
+ *
+ * Not thread-safe; the owner serializes access.
+ */
+template <typename T, typename Tag = T>
+class SlotMap {
+public:
+    using Handle = SlotHandle<Tag>;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    /**
+     * @brief Store a value
+     * @return Handle for it; never null
+     */
+    Handle insert(T value) {
+        uint32_t index;
+        if (m_freeHead != NO_SLOT) {
+            index = m_freeHead;
+            m_freeHead = m_slots[index].position;
+        } else {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back(Slot{});
+        }
+
+        Slot& slot = m_slots[index];
+        slot.position = static_cast<uint32_t>(m_values.size());
+        m_values.push_back(std::move(value));
+        m_owners.push_back(index);
+        return Handle(index, slot.generation);
+    }
+
+    /**
+     * @brief Remove a value
+     * @return false if the handle is null or stale
+     */
+    bool erase(Handle handle) {
+        if (!contains(handle)) return false;
+
+        Slot& slot = m_slots[handle.index()];
+        uint32_t position = slot.position;
+        uint32_t last = static_cast<uint32_t>(m_values.size() - 1);
+        if (position != last) {
+            m_values[position] = std::move(m_values[last]);
+            m_owners[position] = m_owners[last];
+            m_slots[m_owners[position]].position = position;
+        }
+        m_values.pop_back();
+        m_owners.pop_back();
+
+        // Generation 0 is skipped so no live handle is ever null
+        if (++slot.generation == 0) slot.generation = 1;
+        slot.position = m_freeHead;
+        m_freeHead = handle.index();
+        return true;
+    }
+
+    [[nodiscard]] bool contains(Handle handle) const {
+        return handle.index() < m_slots.size() && m_slots[handle.index()].generation == handle.generation();
+    }
+
+    /**
+     * @brief Look up a value
+     * @return Pointer to it, or nullptr if the handle is null or stale
+     */
+    [[nodiscard]] T* get(Handle handle) {
+        return contains(handle) ? &m_values[m_slots[handle.index()].position] : nullptr;
+    }
+
+    [[nodiscard]] const T* get(Handle handle) const {
+        return contains(handle) ? &m_values[m_slots[handle.index()].position] : nullptr;
+    }
+
+    /**
+     * @brief Remove every value; handles issued so far all go stale
+     */
+    void clear() {
+        m_values.clear();
+        m_owners.clear();
+        m_freeHead = NO_SLOT;
+        for (uint32_t i = static_cast<uint32_t>(m_slots.size()); i-- > 0;) {
+            Slot& slot = m_slots[i];
+            if (++slot.generation == 0) slot.generation = 1;
+            slot.position = m_freeHead;
+            m_freeHead = i;
+        }
+    }
+
+    void reserve(size_t capacity) {
+        m_values.reserve(capacity);
+        m_owners.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    [[nodiscard]] size_t size() const { return m_values.size(); }
+    [[nodiscard]] bool empty() const { return m_values.empty(); }
+
+    iterator begin() { return m_values.begin(); }
+    iterator end() { return m_values.end(); }
+    const_iterator begin() const { return m_values.begin(); }
+    const_iterator end() const { return m_values.end(); }
+
+private:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    /**
+     * @struct Slot
+     * @brief Value position while occupied, next free slot while not
+     */
+    struct Slot {
+        uint32_t position = NO_SLOT;
+        uint32_t generation = 1;
+    };
+
+    std::vector<T> m_values;            // Dense storage
+    std::vector<uint32_t> m_owners;     // Slot of each value
+    std::vector<Slot> m_slots;
+    uint32_t m_freeHead = NO_SLOT;
+};
+
+} // namespace utils
+} // namespace clipforge
+
+#endif // CLIPFORGE_SLOT_MAP_H
@@ -0,0 +1,197 @@
+#ifndef CLIPFORGE_SPSC_QUEUE_H
+#define CLIPFORGE_SPSC_QUEUE_H
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <utility>
+#include <cstddef>
+
+namespace clipforge {
+namespace utils {
+
+/**
+ * @class SpscQueue
+ * @brief Bounded lock-free queue for one producer and one consumer thread
+ *
+ * A ring of slots indexed by two ever-increasing counters: the producer
+ * only writes the tail, the consumer only writes the head. Each counter
+ * sits on its own cache line next to the owner's cached copy of the
+ * other one, so the two threads only touch each other's line when the
+ * cached value says the ring looks full or empty.
+ *
+ * Items are moved in and out; a popped slot is reset to T{} so handles
+ * such as shared_ptr release their object as soon as it is consumed.
+ *
+ * The blocking push()/pop() spin briefly, then back off to sleeping, so
+ * a stalled stage costs no CPU. close() ends the stream: the consumer
+ * drains what is left and then pop() fails; a push() after close fails
+ * at once, which also lets the consumer abort its producer.
+ *
+ * Usage:
+ * @code
+ * SpscQueue<FrameBufferPtr> queue(4);
+ * // Producer thread
+ * while (render(frame)) queue.push(std::move(frame));
+ * queue.close();
+ * // Consumer thread
+ * while (queue.pop(frame)) encode(frame);
+ * @endcode
+ */
+template <typename T>
+class SpscQueue {
+public:
+    static constexpr size_t CACHE_LINE = 64;
+
+    /**
+     * @brief Create a queue
+     * @param capacity Maximum queued items, rounded up to a power of two
+     */
+    explicit SpscQueue(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    // Prevent copying
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Add an item if there is room (producer only)
+     * @return false if the queue is full or closed; the item is left untouched
+     */
+    bool tryPush(T& item) {
+        if (m_closed.load(std::memory_order_relaxed)) return false;
+
+        size_t tail = m_tail.value.load(std::memory_order_relaxed);
+        if (tail - m_tail.cached == m_slots.size()) {
+            m_tail.cached = m_head.value.load(std::memory_order_acquire);
+            if (tail - m_tail.cached == m_slots.size()) return false;
+        }
+
+        m_slots[tail & m_mask] = std::move(item);
+        m_tail.value.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest item if there is one (consumer only)
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& item) {
+        size_t head = m_head.value.load(std::memory_order_relaxed);
+        if (head == m_head.cached) {
+            m_head.cached = m_tail.value.load(std::memory_order_acquire);
+            if (head == m_head.cached) return false;
+        }
+
+        T& slot = m_slots[head & m_mask];
+        item = std::move(slot);
+        slot = T{};
+        m_head.value.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Add an item, waiting for room (producer only)
+     * @param item Item to move in
+     * @param timeoutMs Longest wait in milliseconds (negative = no limit)
+     * @return false on timeout or if the queue was closed
+     */
+    bool push(T& item, int timeoutMs = -1) {
+        bool pushed = false;
+        waitFor([&] {
+            pushed = tryPush(item);
+            return pushed || isClosed();
+        }, timeoutMs);
+        return pushed;
+    }
+
+    bool push(T&& item, int timeoutMs = -1) { return push(item, timeoutMs); }
+
+    /**
+     * @brief Take the oldest item, waiting for one (consumer only)
+     * @param item Receives the item
+     * @param timeoutMs Longest wait in milliseconds (negative = no limit)
+     * @return false on timeout, or once the queue is closed and drained
+     */
+    bool pop(T& item, int timeoutMs = -1) {
+        bool popped = false;
+        waitFor([&] {
+            if (isClosed()) {
+                // Items pushed before the close are still delivered
+                popped = tryPop(item);
+                return true;
+            }
+            popped = tryPop(item);
+            return popped;
+        }, timeoutMs);
+        return popped;
+    }
+
+    /**
+     * @brief End the stream (either side)
+     */
+    void close() { m_closed.store(true, std::memory_order_release); }
+
+    /**
+     * @brief Check if close() was called
+     */
+    [[nodiscard]] bool isClosed() const { return m_closed.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get number of queued items (approximate while both sides run)
+     */
+    [[nodiscard]] size_t size() const {
+        return m_tail.value.load(std::memory_order_acquire) - m_head.value.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] size_t capacity() const { return m_slots.size(); }
+
+private:
+    /**
+     * @struct Index
+     * @brief One side's counter plus its cached view of the other side
+     */
+    struct alignas(CACHE_LINE) Index {
+        std::atomic<size_t> value{0};
+        size_t cached = 0;
+    };
+
+    Index m_head;                       // Consumer side
+    Index m_tail;                       // Producer side
+    alignas(CACHE_LINE) std::atomic<bool> m_closed{false};
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+
+    /**
+     * @brief Poll a condition with spin, yield, then sleep backoff
+     * @return false if the timeout expired first
+     */
+    template <typename Condition>
+    static bool waitFor(Condition condition, int timeoutMs) {
+        using Clock = std::chrono::steady_clock;
+        const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+
+        for (int attempt = 0;; attempt = attempt < 1024 ? attempt + 1 : attempt) {
+            if (condition()) return true;
+            if (timeoutMs >= 0 && Clock::now() >= deadline) return false;
+
+            if (attempt < 64) {
+                continue;
+            } else if (attempt < 128) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(attempt < 1024 ? 50 : 500));
+            }
+        }
+    }
+};
+
+} // namespace utils
+} // namespace clipforge
+
+#endif // CLIPFORGE_SPSC_QUEUE_H
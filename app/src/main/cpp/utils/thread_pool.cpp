@@ -0,0 +1,99 @@
+#include "thread_pool.h"
+#include "logger.h"
+#include <algorithm>
+
+namespace clipforge {
+namespace utils {
+
+// ============================================================================
+// ThreadPool Implementation
+// ============================================================================
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    size_t workers = std::max<size_t>(1, threadCount) - 1;
+    m_workers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i + 1);
+    }
+    LOG_DEBUG("ThreadPool created with %zu threads", workers + 1);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& function) {
+    parallelForThreaded(count, [&function](size_t index, size_t) { function(index); });
+}
+
+void ThreadPool::parallelForThreaded(size_t count, const std::function<void(size_t, size_t)>& function) {
+    if (count == 0) return;
+
+    // Nothing to share: skip the hand-off entirely
+    if (m_workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            function(i, 0);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> loopLock(m_loopMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_function = &function;
+        m_count = count;
+        m_nextIndex = 0;
+        m_activeWorkers = m_workers.size();
+        m_generation++;
+    }
+    m_workAvailable.notify_all();
+
+    runIndices(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_workDone.wait(lock, [this] { return m_activeWorkers == 0; });
+    m_function = nullptr;
+}
+
+void ThreadPool::workerLoop(size_t thread) {
+    uint64_t seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this, seenGeneration] {
+                return m_stopping || m_generation != seenGeneration;
+            });
+            if (m_stopping) return;
+            seenGeneration = m_generation;
+        }
+
+        runIndices(thread);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_activeWorkers--;
+        }
+        m_workDone.notify_one();
+    }
+}
+
+void ThreadPool::runIndices(size_t thread) {
+    while (true) {
+        size_t index = m_nextIndex.fetch_add(1);
+        if (index >= m_count) break;
+        (*m_function)(index, thread);
+    }
+}
+
+} // namespace utils
+} // namespace clipforge
@@ -0,0 +1,102 @@
+#ifndef CLIPFORGE_THREAD_POOL_H
+#define CLIPFORGE_THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace clipforge {
+namespace utils {
+
+/**
+ * @class ThreadPool
+ * @brief Fixed-size pool for data-parallel loops
+ *
+ * parallelFor() hands out loop indices through a shared atomic counter,
+ * so faster threads simply take more work. The calling thread takes part
+ * in the loop and the call returns once every index has been processed.
+ * One loop runs at a time; concurrent callers are serialized.
+ *
+ * Usage:
+ * @code
+ * ThreadPool pool(4);
+ * pool.parallelFor(tileCount, [&](size_t tile) { processTile(tile); });
+ * @endcode
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Create a pool
+     * @param threadCount Total threads including the caller (minimum 1)
+     */
+    explicit ThreadPool(size_t threadCount);
+
+    /**
+     * @brief Destructor - joins worker threads
+     */
+    ~ThreadPool();
+
+    // Prevent copying
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Run a function for every index in [0, count)
+     * @param count Number of indices
+     * @param function Called once per index, possibly concurrently
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& function);
+
+    /**
+     * @brief Run a function for every index, telling it which thread runs it
+     * @param count Number of indices
+     * @param function Called as function(index, thread) with thread in
+     *                 [0, getThreadCount()); 0 is the caller
+     *
+     * Lets callers keep per-thread scratch state without locking.
+     */
+    void parallelForThreaded(size_t count, const std::function<void(size_t, size_t)>& function);
+
+    /**
+     * @brief Get number of threads working on a loop
+     * @return Worker threads plus the caller
+     */
+    [[nodiscard]] size_t getThreadCount() const { return m_workers.size() + 1; }
+
+private:
+    std::vector<std::thread> m_workers;
+
+    // Current loop
+    const std::function<void(size_t, size_t)>* m_function = nullptr;
+    size_t m_count = 0;
+    std::atomic<size_t> m_nextIndex{0};
+    size_t m_activeWorkers = 0;
+    uint64_t m_generation = 0;     // Bumped for every loop so workers join it once
+    bool m_stopping = false;
+
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_workDone;
+    std::mutex m_loopMutex;        // Serializes parallelFor callers
+
+    /**
+     * @brief Worker thread main loop
+     * @param thread Index passed to parallelForThreaded functions
+     */
+    void workerLoop(size_t thread);
+
+    /**
+     * @brief Process indices of the current loop until none are left
+     */
+    void runIndices(size_t thread);
+};
+
+} // namespace utils
+} // namespace clipforge
+
+#endif // CLIPFORGE_THREAD_POOL_H
@@ -1,5 +1,7 @@
 package com.ucworks.clipforge;
 
+import java.nio.ByteBuffer;
+
 /**
  * Native library interface for ClipForge video editor.
  *
@@ -176,6 +178,22 @@ public class NativeLib {
      */
     public static native int getEffectCount(long enginePtr);
 
+    /**
+     * Undo the last timeline edit.
+     *
+     * @param enginePtr Engine pointer
+     * @return true if an edit was undone
+     */
+    public static native boolean undo(long enginePtr);
+
+    /**
+     * Redo the last undone timeline edit.
+     *
+     * @param enginePtr Engine pointer
+     * @return true if an edit was redone
+     */
+    public static native boolean redo(long enginePtr);
+
     // ========================================================================
     // Effect Management
     // ========================================================================
@@ -298,6 +316,27 @@ public class NativeLib {
      */
     public static native long getPreviewPosition(long enginePtr);
 
+    /**
+     * Get the preview frame at a time without copying.
+     *
+     * The returned read-only direct buffer wraps native RGBA pixels shared
+     * with the preview cache. It is valid only until the next
+     * getPreviewFrame or releasePreviewFrame call for this engine.
+     *
+     * @param enginePtr Engine pointer
+     * @param timeMs Time in milliseconds
+     * @param outSize Receives {width, height} if non-null (length >= 2)
+     * @return Read-only direct ByteBuffer over the frame, or null on error
+     */
+    public static native ByteBuffer getPreviewFrame(long enginePtr, long timeMs, int[] outSize);
+
+    /**
+     * Release the frame returned by getPreviewFrame.
+     *
+     * @param enginePtr Engine pointer
+     */
+    public static native void releasePreviewFrame(long enginePtr);
+
     // ========================================================================
     // Export/Rendering
     // ========================================================================
@@ -364,6 +403,15 @@ public class NativeLib {
      */
     public static native boolean loadProject(long enginePtr, String projectPath);
 
+    /**
+     * Autosave the last saved or loaded project.
+     * Only the edits since the previous autosave are written.
+     *
+     * @param enginePtr Engine pointer
+     * @return true if saved successfully
+     */
+    public static native boolean autosaveProject(long enginePtr);
+
     /**
      * Check if project has unsaved changes.
      *